@@ -9,6 +9,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -48,6 +49,12 @@ class FrameTiming {
 
   static constexpr int kStatisticsCount = kCount + 5;
 
+  /// Timestamps of the rasterization of a single view of the frame.
+  struct ViewRasterTime {
+    fml::TimePoint raster_start;
+    fml::TimePoint raster_end;
+  };
+
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
     return data_[phase] = value;
@@ -69,6 +76,15 @@ class FrameTiming {
     picture_cache_bytes_ = picture_cache_bytes;
   }
 
+  /// The raster times of the views of the frame, keyed by view ID.
+  const std::map<int64_t, ViewRasterTime>& GetViewRasterTimes() const {
+    return view_raster_times_;
+  }
+  void SetViewRasterTimes(
+      std::map<int64_t, ViewRasterTime> view_raster_times) {
+    view_raster_times_ = std::move(view_raster_times);
+  }
+
  private:
   fml::TimePoint data_[kCount];
   uint64_t frame_number_;
@@ -76,6 +92,7 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  std::map<int64_t, ViewRasterTime> view_raster_times_;
 };
 
 using TaskObserverAdd =
@@ -258,6 +275,25 @@ struct Settings {
   // Enable GPU tracing in Vulkan backends.
   bool enable_vulkan_gpu_tracing = false;
 
+  // Expand stroked paths on the Impeller worker threads before a frame is
+  // encoded instead of on the raster thread. Only honored by backends with a
+  // concurrent worker pool (currently Vulkan).
+  bool impeller_enable_parallel_geometry = false;
+
+  // Max bytes of path tessellations that Impeller keeps across frames, or 0
+  // to disable the cache. Only honored by the Vulkan backend.
+  size_t impeller_tessellation_cache_max_bytes = 0;
+
+  // Record the layer trees of the views of a frame into display lists on the
+  // concurrent worker threads, and only draw and submit them on the raster
+  // thread. Only has an effect for frames with more than one view.
+  bool enable_concurrent_view_rasterization = false;
+
+  // Start with a frame pipeline depth of 1, and only let the UI thread build a
+  // frame while the previous one rasterizes when recent frames overran their
+  // budget.
+  bool enable_adaptive_pipeline_depth = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -354,6 +390,28 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  // Max bytes of host memory used to keep display list raster cache images
+  // after they are evicted from the GPU, or 0 to disable the host tier.
+  size_t raster_cache_host_tier_max_bytes = 0;
+
+  // Max bytes of raster cache images when the images that save the least
+  // measured raster time per byte are given up first, or 0 for no limit.
+  size_t raster_cache_cost_aware_max_bytes = 0;
+
+  // Keep raster cache images within a share of the resource cache limit,
+  // giving up the least recently drawn ones first. Ignored if
+  // |raster_cache_cost_aware_max_bytes| is set.
+  bool enable_raster_cache_byte_budget = false;
+
+  // Reuse the preroll results of layer subtrees whose inputs did not change
+  // since the previous frame.
+  bool enable_retained_preroll_reuse = false;
+
+  // Deliver at most one pointer data packet to the framework per frame, and
+  // coalesce the movement samples of high rate input devices received in
+  // between. See |CoalescingPointerDataDispatcher|.
+  bool enable_pointer_data_coalescing = false;
+
   /// Enable embedder api on the embedder.
   ///
   /// This is currently only used by iOS.
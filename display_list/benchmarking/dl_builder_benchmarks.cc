@@ -86,16 +86,117 @@ bool NeedPrepareRTree(DisplayListDispatchBenchmarkType type) {
   return type != DisplayListDispatchBenchmarkType::kDefaultNoRtree;
 }
 
+// Reports the DisplayListStorage heap traffic per built DisplayList since the
+// last call to |DisplayListStorage::ResetAllocationStats|.
+void ReportStorageAllocations(benchmark::State& state) {
+  auto stats = DisplayListStorage::GetAllocationStats();
+  auto per_iteration = [&state](size_t count) {
+    return benchmark::Counter(static_cast<double>(count),
+                              benchmark::Counter::kAvgIterations);
+  };
+  state.counters["HeapAllocs"] = per_iteration(stats.heap_allocations);
+  state.counters["PoolHits"] = per_iteration(stats.pool_hits);
+  state.counters["HeapFrees"] = per_iteration(stats.heap_frees);
+}
+
+enum class DisplayListScrollBenchmarkType {
+  kStatic,
+  kScroll,
+  kJump,
+};
+
+constexpr int kScrolledRowCount = 2000;
+constexpr DlScalar kScrolledRowHeight = 48.0f;
+constexpr DlScalar kScrolledViewportWidth = 400.0f;
+constexpr DlScalar kScrolledViewportHeight = 800.0f;
+
+// Builds a tall list of rows, each made of a background, an avatar and a
+// couple of text placeholders, like the content of a long scrolling list.
+sk_sp<DisplayList> BuildScrolledList() {
+  DisplayListBuilder builder(true);
+  DlPaint background(DlColor::kWhite());
+  DlPaint avatar(DlColor::kBlue());
+  DlPaint text(DlColor::kDarkGrey());
+  for (int i = 0; i < kScrolledRowCount; i++) {
+    DlScalar y = i * kScrolledRowHeight;
+    builder.DrawRect(DlRect::MakeXYWH(0, y, kScrolledViewportWidth,
+                                      kScrolledRowHeight - 1),
+                     background);
+    builder.DrawCircle(DlPoint(24, y + 24), 16, avatar);
+    builder.DrawRect(DlRect::MakeXYWH(48, y + 8, 200, 14), text);
+    builder.DrawRect(DlRect::MakeXYWH(48, y + 28, 300, 12), text);
+  }
+  return builder.Build();
+}
+
+// Returns the cull rect of the viewport for the given frame.
+SkRect GetScrolledCullRect(DisplayListScrollBenchmarkType type, int frame) {
+  constexpr int kMaxOffset = static_cast<int>(
+      kScrolledRowCount * kScrolledRowHeight - kScrolledViewportHeight);
+  int offset = 0;
+  switch (type) {
+    case DisplayListScrollBenchmarkType::kStatic:
+      break;
+    case DisplayListScrollBenchmarkType::kScroll:
+      // A fling of a few pixels per frame.
+      offset = (frame * 7) % kMaxOffset;
+      break;
+    case DisplayListScrollBenchmarkType::kJump:
+      // Jumps far enough that nothing of the previous frame is visible.
+      offset = (frame * 2011) % kMaxOffset;
+      break;
+  }
+  return SkRect::MakeXYWH(0, offset, kScrolledViewportWidth,
+                          kScrolledViewportHeight);
+}
+
 }  // namespace
 
 static void BM_DisplayListBuilderDefault(benchmark::State& state,
                                          DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  DisplayListStorage::ResetAllocationStats();
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder(prepare_rtree);
+    InvokeAllRenderingOps(builder);
+    Complete(builder, type);
+  }
+  ReportStorageAllocations(state);
+}
+
+// Same as |BM_DisplayListBuilderDefault|, but every builder is pre-sized with
+// the storage size of the previous iteration's DisplayList.
+static void BM_DisplayListBuilderPresized(
+    benchmark::State& state,
+    DisplayListBuilderBenchmarkType type) {
+  bool prepare_rtree = NeedPrepareRTree(type);
+  size_t previous_size = 0u;
+  DisplayListStorage::ResetAllocationStats();
   while (state.KeepRunning()) {
+    DisplayListBuilder builder(prepare_rtree);
+    builder.ReserveStorage(previous_size);
+    InvokeAllRenderingOps(builder);
+    previous_size = builder.Build()->GetStorage().size();
+  }
+  ReportStorageAllocations(state);
+}
+
+// Same as |BM_DisplayListBuilderDefault|, but the storage pool is emptied
+// before every iteration so that no storage is recycled between them.
+static void BM_DisplayListBuilderNoStorageRecycling(
+    benchmark::State& state,
+    DisplayListBuilderBenchmarkType type) {
+  bool prepare_rtree = NeedPrepareRTree(type);
+  DisplayListStorage::ResetAllocationStats();
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    DisplayListStorage::PurgePool();
+    state.ResumeTiming();
     DisplayListBuilder builder(prepare_rtree);
     InvokeAllRenderingOps(builder);
     Complete(builder, type);
   }
+  ReportStorageAllocations(state);
 }
 
 static void BM_DisplayListBuilderWithScaleAndTranslate(
@@ -310,6 +411,38 @@ static void BM_DisplayListDispatchByVectorCull(
   }
 }
 
+static void BM_DisplayListDispatchScrolled(
+    benchmark::State& state,
+    DisplayListScrollBenchmarkType type) {
+  auto display_list = BuildScrolledList();
+  DlOpReceiverIgnore receiver;
+  int frame = 0;
+  while (state.KeepRunning()) {
+    display_list->Dispatch(receiver, GetScrolledCullRect(type, frame++));
+  }
+}
+
+static void BM_DisplayListRTreeSearchScrolled(
+    benchmark::State& state,
+    DisplayListScrollBenchmarkType type,
+    bool incremental) {
+  auto rtree = BuildScrolledList()->rtree();
+  DlRTree::IncrementalSearchState search_state;
+  std::vector<int> results;
+  int frame = 0;
+  while (state.KeepRunning()) {
+    SkRect cull_rect = GetScrolledCullRect(type, frame++);
+    if (incremental) {
+      rtree->searchIncremental(cull_rect, search_state);
+      benchmark::DoNotOptimize(search_state.results.data());
+    } else {
+      results.clear();
+      rtree->search(cull_rect, &results);
+      benchmark::DoNotOptimize(results.data());
+    }
+  }
+}
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -327,6 +460,24 @@ BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   DisplayListBuilderBenchmarkType::kBoundsAndRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DisplayListBuilderPresized,
+                  kDefault,
+                  DisplayListBuilderBenchmarkType::kDefault)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderPresized,
+                  kRtree,
+                  DisplayListBuilderBenchmarkType::kRtree)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListBuilderNoStorageRecycling,
+                  kDefault,
+                  DisplayListBuilderBenchmarkType::kDefault)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderNoStorageRecycling,
+                  kRtree,
+                  DisplayListBuilderBenchmarkType::kRtree)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderWithScaleAndTranslate,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -464,4 +615,38 @@ BENCHMARK_CAPTURE(BM_DisplayListDispatchByVectorCull,
                   DisplayListDispatchBenchmarkType::kCulledWithRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DisplayListDispatchScrolled,
+                  kStatic,
+                  DisplayListScrollBenchmarkType::kStatic)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListDispatchScrolled,
+                  kScroll,
+                  DisplayListScrollBenchmarkType::kScroll)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListDispatchScrolled,
+                  kJump,
+                  DisplayListScrollBenchmarkType::kJump)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListRTreeSearchScrolled,
+                  kScrollFull,
+                  DisplayListScrollBenchmarkType::kScroll,
+                  false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListRTreeSearchScrolled,
+                  kScrollIncremental,
+                  DisplayListScrollBenchmarkType::kScroll,
+                  true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListRTreeSearchScrolled,
+                  kJumpFull,
+                  DisplayListScrollBenchmarkType::kJump,
+                  false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListRTreeSearchScrolled,
+                  kJumpIncremental,
+                  DisplayListScrollBenchmarkType::kJump,
+                  true)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
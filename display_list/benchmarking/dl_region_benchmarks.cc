@@ -34,6 +34,32 @@ std::vector<SkIRect> GenerateRects(RNG& rng,
   return rects;
 }
 
+// Lays out glyph sized rects in lines of text, such as the damage of a text
+// heavy page, which gives span lines with many spans each.
+template <typename RNG>
+std::vector<SkIRect> GenerateTextRects(RNG& rng,
+                                       int32_t left,
+                                       int32_t top,
+                                       int lineCount,
+                                       int glyphCount) {
+  std::uniform_int_distribution glyph_width(3, 9);
+  std::uniform_int_distribution glyph_gap(1, 6);
+  std::uniform_int_distribution space(0, 7);
+
+  std::vector<SkIRect> rects;
+  for (int line = 0; line < lineCount; ++line) {
+    int32_t x = left;
+    for (int glyph = 0; glyph < glyphCount; ++glyph) {
+      int32_t width = glyph_width(rng);
+      if (space(rng) != 0) {
+        rects.push_back(SkIRect::MakeXYWH(x, top + line * 16, width, 12));
+      }
+      x += width + glyph_gap(rng);
+    }
+  }
+  return rects;
+}
+
 template <typename RNG>
 SkIRect RandomSubRect(RNG& rng, const SkIRect& rect, double size_factor) {
   FML_DCHECK(size_factor <= 1);
@@ -202,6 +228,61 @@ void RunRegionOpBenchmark(benchmark::State& state,
   }
 }
 
+enum TextLayout {
+  // Two pages of text, the second one slightly offset from the first one.
+  kOffsetPages,
+  // A page of text and a column of rects across the middle of its lines.
+  kPageAndColumn,
+};
+
+template <typename Region>
+void RunTextRegionOpBenchmark(benchmark::State& state,
+                              RegionOp op,
+                              TextLayout layout) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  Region region1(GenerateTextRects(rng, 0, 0, 100, 200));
+
+  std::vector<SkIRect> rects;
+  switch (layout) {
+    case kOffsetPages:
+      rects = GenerateTextRects(rng, 3, 5, 100, 200);
+      break;
+    case kPageAndColumn:
+      for (int line = 0; line < 100; ++line) {
+        rects.push_back(SkIRect::MakeXYWH(600, line * 16, 40, 20));
+      }
+      break;
+  }
+  Region region2(rects);
+
+  switch (op) {
+    case kUnion:
+      while (state.KeepRunning()) {
+        Region::unionRegions(region1, region2);
+      }
+      break;
+    case kIntersection:
+      while (state.KeepRunning()) {
+        Region::intersectRegions(region1, region2);
+      }
+      break;
+  }
+}
+
+template <typename Region>
+void RunFromTextRectsBenchmark(benchmark::State& state) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  auto rects = GenerateTextRects(rng, 0, 0, 100, 200);
+
+  while (state.KeepRunning()) {
+    Region region(rects);
+  }
+}
+
 template <typename Region>
 void RunIntersectsRegionBenchmark(benchmark::State& state,
                                   int maxSize,
@@ -313,6 +394,26 @@ static void BM_SkRegion_IntersectsSingleRect(benchmark::State& state,
   RunIntersectsSingleRectBenchmark<SkRegionAdapter>(state, maxSize);
 }
 
+static void BM_DlRegion_TextOperation(benchmark::State& state,
+                                      RegionOp op,
+                                      TextLayout layout) {
+  RunTextRegionOpBenchmark<DlRegionAdapter>(state, op, layout);
+}
+
+static void BM_SkRegion_TextOperation(benchmark::State& state,
+                                      RegionOp op,
+                                      TextLayout layout) {
+  RunTextRegionOpBenchmark<SkRegionAdapter>(state, op, layout);
+}
+
+static void BM_DlRegion_FromTextRects(benchmark::State& state) {
+  RunFromTextRectsBenchmark<DlRegionAdapter>(state);
+}
+
+static void BM_SkRegion_FromTextRects(benchmark::State& state) {
+  RunFromTextRectsBenchmark<SkRegionAdapter>(state);
+}
+
 const double kSizeFactorSmall = 0.3;
 
 BENCHMARK_CAPTURE(BM_DlRegion_IntersectsSingleRect, Tiny, 30)
@@ -675,6 +776,50 @@ BENCHMARK_CAPTURE(BM_SkRegion_Operation,
                   1.0)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DlRegion_TextOperation,
+                  Union_OffsetPages,
+                  RegionOp::kUnion,
+                  TextLayout::kOffsetPages)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_TextOperation,
+                  Union_OffsetPages,
+                  RegionOp::kUnion,
+                  TextLayout::kOffsetPages)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_TextOperation,
+                  Union_PageAndColumn,
+                  RegionOp::kUnion,
+                  TextLayout::kPageAndColumn)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_TextOperation,
+                  Union_PageAndColumn,
+                  RegionOp::kUnion,
+                  TextLayout::kPageAndColumn)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_TextOperation,
+                  Intersection_OffsetPages,
+                  RegionOp::kIntersection,
+                  TextLayout::kOffsetPages)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_TextOperation,
+                  Intersection_OffsetPages,
+                  RegionOp::kIntersection,
+                  TextLayout::kOffsetPages)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_TextOperation,
+                  Intersection_PageAndColumn,
+                  RegionOp::kIntersection,
+                  TextLayout::kPageAndColumn)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_TextOperation,
+                  Intersection_PageAndColumn,
+                  RegionOp::kIntersection,
+                  TextLayout::kPageAndColumn)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_DlRegion_FromTextRects)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SkRegion_FromTextRects)->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DlRegion_FromRects, Tiny, 30)
     ->Unit(benchmark::kMicrosecond);
 BENCHMARK_CAPTURE(BM_SkRegion_FromRects, Tiny, 30)
@@ -60,7 +60,8 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       root_is_unbounded_(root_is_unbounded),
       max_root_blend_mode_(max_root_blend_mode),
       rtree_(std::move(rtree)) {
-  FML_DCHECK(storage_.capacity() == storage_.size());
+  FML_DCHECK(storage_.capacity() - storage_.size() <
+             DisplayListStorage::kDLMaxTrimSlack);
 }
 
 DisplayList::~DisplayList() {
@@ -370,9 +371,19 @@ std::vector<DlIndex> DisplayList::GetCulledIndices(
   std::vector<DlIndex> indices;
   if (!cull_rect.isEmpty()) {
     if (rtree_) {
-      std::vector<int> rect_indices;
-      rtree_->search(cull_rect, &rect_indices);
-      RTreeResultsToIndexVector(indices, rect_indices);
+      std::unique_lock<std::mutex> lock(cull_cache_mutex_, std::try_to_lock);
+      if (!lock.owns_lock()) {
+        std::vector<int> rect_indices;
+        rtree_->search(cull_rect, &rect_indices);
+        RTreeResultsToIndexVector(indices, rect_indices);
+        return indices;
+      }
+      if (rtree_->searchIncremental(cull_rect, cull_cache_.search)) {
+        cull_cache_.indices.clear();
+        RTreeResultsToIndexVector(cull_cache_.indices,
+                                  cull_cache_.search.results);
+      }
+      indices = cull_cache_.indices;
     } else {
       FillAllIndices(indices, offsets_.size());
     }
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
+#include <mutex>
+
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_storage.h"
 #include "flutter/display_list/geometry/dl_geometry_types.h"
@@ -500,6 +502,12 @@ class DisplayList : public SkRefCnt {
   ///                  primarily for debugging use
   ///
   /// @see |Dispatch(receiver, index)|
+  ///
+  /// The results of the most recent call are cached so that culling to a
+  /// cull_rect that only moved slightly since the previous frame, as when
+  /// scrolling, only has to search the newly exposed areas of the RTree.
+  /// If the set of culled rendering operations didn't change, the previous
+  /// indices are returned without walking the records again.
   std::vector<DlIndex> GetCulledIndices(const SkRect& cull_rect) const;
 
  private:
@@ -544,6 +552,16 @@ class DisplayList : public SkRefCnt {
 
   const sk_sp<const DlRTree> rtree_;
 
+  // The results of the most recent |GetCulledIndices| call.
+  struct CullCache {
+    DlRTree::IncrementalSearchState search;
+    std::vector<DlIndex> indices;
+  };
+  // Display lists may be culled from several threads at once, in which
+  // case only one of them uses the cache.
+  mutable std::mutex cull_cache_mutex_;
+  mutable CullCache cull_cache_;
+
   void DispatchOneOp(DlOpReceiver& receiver, const uint8_t* ptr) const;
 
   void RTreeResultsToIndexVector(std::vector<DlIndex>& indices,
@@ -3420,6 +3420,50 @@ TEST_F(DisplayListTest, RTreeRenderCulling) {
   }
 }
 
+TEST_F(DisplayListTest, RTreeCulledIndicesWhileScrolling) {
+  auto build_list = []() {
+    DisplayListBuilder builder(true);
+    for (int i = 0; i < 100; i++) {
+      builder.Save();
+      builder.Translate(0, i * 20);
+      builder.DrawRect(SkRect::MakeXYWH(0, 0, 100, 18),
+                       DlPaint(DlColor::kWhite()));
+      builder.DrawCircle(DlPoint(10, 9), 6, DlPaint(DlColor::kBlue()));
+      builder.DrawRect(SkRect::MakeXYWH(80, 2, 40, 10),
+                       DlPaint(DlColor::kRed()));
+      builder.Restore();
+    }
+    return builder.Build();
+  };
+  auto main = build_list();
+  auto reference = build_list();
+
+  auto test = [&main, &reference](const SkRect& cull_rect) {
+    // Moves the reference far away first so that it has nothing to reuse.
+    reference->GetCulledIndices(SkRect::MakeXYWH(-1000, -1000, 10, 10));
+    auto expected = reference->GetCulledIndices(cull_rect);
+    EXPECT_EQ(main->GetCulledIndices(cull_rect), expected)
+        << "using cull rect " << cull_rect;
+  };
+
+  SkRect cull_rect = SkRect::MakeXYWH(0, 0, 100, 300);
+  test(cull_rect);
+  test(cull_rect);
+  for (int i = 0; i < 100; i++) {
+    cull_rect.offset(0, 13.5f);
+    test(cull_rect);
+  }
+  for (int i = 0; i < 30; i++) {
+    cull_rect.offset(5, -17);
+    test(cull_rect);
+  }
+  cull_rect.offset(0, 700);
+  test(cull_rect);
+  test(SkRect::MakeXYWH(0, 1990, 100, 100));
+  test(SkRect::MakeXYWH(0, 2100, 100, 100));
+  test(SkRect::MakeXYWH(0, 0, 100, 300));
+}
+
 TEST_F(DisplayListTest, DrawSaveDrawCannotInheritOpacity) {
   DisplayListBuilder builder;
   builder.DrawCircle(SkPoint{10, 10}, 5, DlPaint());
@@ -243,6 +243,12 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   sk_sp<DisplayList> Build();
 
+  /// Pre-sizes the op storage of the DisplayList being recorded so that it
+  /// does not have to grow until |bytes| worth of ops have been recorded.
+  /// Callers that rebuild similar content every frame can pass the
+  /// |GetStorage().size()| of the previous frame's DisplayList.
+  void ReserveStorage(size_t bytes) { storage_.reserve(bytes); }
+
   ENABLE_DL_CANVAS_BACKWARDS_COMPATIBILITY
 
  private:
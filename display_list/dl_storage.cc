@@ -4,16 +4,142 @@
 
 #include "flutter/display_list/dl_storage.h"
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 namespace flutter {
 
 static constexpr inline bool is_power_of_two(int value) {
   return (value & (value - 1)) == 0;
 }
 
+namespace {
+
+std::atomic<size_t> gHeapAllocations = 0u;
+std::atomic<size_t> gPoolHits = 0u;
+std::atomic<size_t> gHeapFrees = 0u;
+
+// DisplayLists are usually built on the UI thread and disposed of on the
+// raster thread, so the pool is shared by all threads rather than being
+// thread local.
+class StoragePool {
+ public:
+  struct Buffer {
+    uint8_t* ptr = nullptr;
+    size_t capacity = 0u;
+  };
+
+  static StoragePool& Instance() {
+    static StoragePool* pool = new StoragePool();
+    return *pool;
+  }
+
+  // Takes the smallest pooled buffer that holds at least |min_capacity|
+  // bytes. Returns an empty buffer if there is none.
+  Buffer Take(size_t min_capacity) {
+    std::scoped_lock lock(mutex_);
+    auto best = buffers_.end();
+    for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
+      if (it->capacity >= min_capacity &&
+          (best == buffers_.end() || it->capacity < best->capacity)) {
+        best = it;
+      }
+    }
+    if (best == buffers_.end()) {
+      return {};
+    }
+    Buffer buffer = *best;
+    *best = buffers_.back();
+    buffers_.pop_back();
+    pooled_bytes_ -= buffer.capacity;
+    return buffer;
+  }
+
+  // Keeps |buffer| for reuse. Returns false if the pool is full, in which
+  // case the caller still owns the buffer.
+  bool Put(Buffer buffer) {
+    std::scoped_lock lock(mutex_);
+    if (buffers_.size() >= DisplayListStorage::kDLMaxPooledBuffers ||
+        pooled_bytes_ + buffer.capacity >
+            DisplayListStorage::kDLMaxPooledBytes) {
+      return false;
+    }
+    buffers_.push_back(buffer);
+    pooled_bytes_ += buffer.capacity;
+    return true;
+  }
+
+  void Purge() {
+    std::vector<Buffer> buffers;
+    {
+      std::scoped_lock lock(mutex_);
+      std::swap(buffers, buffers_);
+      pooled_bytes_ = 0u;
+    }
+    for (const Buffer& buffer : buffers) {
+      std::free(buffer.ptr);
+      gHeapFrees++;
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<Buffer> buffers_;
+  size_t pooled_bytes_ = 0u;
+};
+
+void Release(uint8_t* ptr, size_t capacity) {
+  if (!ptr) {
+    return;
+  }
+  if (capacity > 0u && StoragePool::Instance().Put({ptr, capacity})) {
+    return;
+  }
+  std::free(ptr);
+  gHeapFrees++;
+}
+
+}  // namespace
+
+DisplayListStorage::AllocationStats DisplayListStorage::GetAllocationStats() {
+  return {
+      .heap_allocations = gHeapAllocations,
+      .pool_hits = gPoolHits,
+      .heap_frees = gHeapFrees,
+  };
+}
+
+void DisplayListStorage::ResetAllocationStats() {
+  gHeapAllocations = 0u;
+  gPoolHits = 0u;
+  gHeapFrees = 0u;
+}
+
+void DisplayListStorage::PurgePool() {
+  StoragePool::Instance().Purge();
+}
+
 void DisplayListStorage::realloc(size_t count) {
-  ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
+  ptr_ = static_cast<uint8_t*>(std::realloc(ptr_, count));
   FML_CHECK(ptr_);
   allocated_ = count;
+  gHeapAllocations++;
+}
+
+void DisplayListStorage::grow(size_t min_size, size_t heap_size) {
+  StoragePool::Buffer buffer = StoragePool::Instance().Take(min_size);
+  if (!buffer.ptr) {
+    realloc(heap_size);
+    return;
+  }
+  gPoolHits++;
+  if (used_ > 0u) {
+    memcpy(buffer.ptr, ptr_, used_);
+  }
+  Release(ptr_, allocated_);
+  ptr_ = buffer.ptr;
+  allocated_ = buffer.capacity;
 }
 
 uint8_t* DisplayListStorage::allocate(size_t needed) {
@@ -23,39 +149,64 @@ uint8_t* DisplayListStorage::allocate(size_t needed) {
     // Next greater multiple of DL_BUILDER_PAGE.
     size_t new_size = (used_ + needed + kDLPageSize) & ~(kDLPageSize - 1);
     size_t old_size = allocated_;
-    realloc(new_size);
-    FML_CHECK(ptr_.get());
-    FML_CHECK(allocated_ == new_size);
+    grow(used_ + needed, new_size);
+    FML_CHECK(ptr_);
     FML_CHECK(allocated_ >= old_size);
     FML_CHECK(used_ + needed <= allocated_);
-    memset(ptr_.get() + used_, 0, allocated_ - old_size);
   }
-  uint8_t* ret = ptr_.get() + used_;
+  uint8_t* ret = ptr_ + used_;
+  // Pooled buffers hold stale ops, so the memory is cleared as it is handed
+  // out rather than when the buffer grows.
+  memset(ret, 0, needed);
   used_ += needed;
   FML_CHECK(used_ <= allocated_);
   return ret;
 }
 
+void DisplayListStorage::reserve(size_t bytes) {
+  if (bytes > allocated_) {
+    grow(bytes, (bytes + kDLPageSize - 1) & ~(kDLPageSize - 1));
+  }
+}
+
+void DisplayListStorage::trim() {
+  if (used_ == 0u) {
+    reset();
+  } else if (allocated_ - used_ >= kDLMaxTrimSlack) {
+    realloc(used_);
+  }
+}
+
 DisplayListStorage::DisplayListStorage(DisplayListStorage&& source) {
-  ptr_ = std::move(source.ptr_);
+  ptr_ = source.ptr_;
   used_ = source.used_;
   allocated_ = source.allocated_;
+  source.ptr_ = nullptr;
   source.used_ = 0u;
   source.allocated_ = 0u;
 }
 
+DisplayListStorage::~DisplayListStorage() {
+  Release(ptr_, allocated_);
+}
+
 void DisplayListStorage::reset() {
-  ptr_.reset();
+  Release(ptr_, allocated_);
+  ptr_ = nullptr;
   used_ = 0u;
   allocated_ = 0u;
 }
 
 DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& source) {
-  ptr_ = std::move(source.ptr_);
-  used_ = source.used_;
-  allocated_ = source.allocated_;
-  source.used_ = 0u;
-  source.allocated_ = 0u;
+  if (this != &source) {
+    Release(ptr_, allocated_);
+    ptr_ = source.ptr_;
+    used_ = source.used_;
+    allocated_ = source.allocated_;
+    source.ptr_ = nullptr;
+    source.used_ = 0u;
+    source.allocated_ = 0u;
+  }
   return *this;
 }
 
@@ -12,16 +12,48 @@
 namespace flutter {
 
 // Manages a buffer allocated with malloc.
+//
+// Buffers released by a DisplayListStorage are kept in a small process-wide
+// pool (bounded by kDLMaxPooledBuffers and kDLMaxPooledBytes) and handed out
+// again to storage objects that need to grow, so that the DisplayLists that
+// are rebuilt every frame do not pay for a malloc/realloc/free cycle each.
 class DisplayListStorage {
  public:
   static const constexpr size_t kDLPageSize = 4096u;
+  static const constexpr size_t kDLMaxPooledBuffers = 32u;
+  static const constexpr size_t kDLMaxPooledBytes = 2u * 1024u * 1024u;
+
+  /// Unused capacity below this size is not worth a realloc in |trim|.
+  static const constexpr size_t kDLMaxTrimSlack = 1024u;
+
+  /// Process-wide counters of the heap traffic caused by DisplayListStorage.
+  struct AllocationStats {
+    /// The number of malloc/realloc calls made to obtain or resize buffers.
+    size_t heap_allocations = 0u;
+    /// The number of buffers that were taken from the pool instead.
+    size_t pool_hits = 0u;
+    /// The number of buffers returned to the heap with free.
+    size_t heap_frees = 0u;
+  };
+
+  /// Returns the counters accumulated since the last call to
+  /// |ResetAllocationStats|.
+  static AllocationStats GetAllocationStats();
+
+  static void ResetAllocationStats();
+
+  /// Frees all buffers currently held by the pool.
+  static void PurgePool();
 
   DisplayListStorage() = default;
   DisplayListStorage(DisplayListStorage&&);
 
+  /// Returns the buffer to the pool, or frees it if the pool is full.
+  ~DisplayListStorage();
+
   /// Returns a pointer to the base of the storage.
-  uint8_t* base() { return ptr_.get(); }
-  const uint8_t* base() const { return ptr_.get(); }
+  uint8_t* base() { return ptr_; }
+  const uint8_t* base() const { return ptr_; }
 
   /// Returns the currently allocated size
   size_t size() const { return used_; }
@@ -31,12 +63,20 @@ class DisplayListStorage {
 
   /// Ensures the indicated number of bytes are available and returns
   /// a pointer to that memory within the storage while also invalidating
-  /// any other outstanding pointers into the storage.
+  /// any other outstanding pointers into the storage. The returned memory
+  /// is zero filled.
   uint8_t* allocate(size_t needed);
 
-  /// Trims the storage to the currently allocated size and invalidates
-  /// any outstanding pointers into the storage.
-  void trim() { realloc(used_); }
+  /// Ensures that the total capacity is at least |bytes| so that the storage
+  /// does not have to grow until that many bytes have been allocated, e.g.
+  /// to pre-size the storage from the size of the previous frame's
+  /// DisplayList. Invalidates any outstanding pointers into the storage.
+  void reserve(size_t bytes);
+
+  /// Trims the storage to the currently allocated size, unless the unused
+  /// capacity is less than |kDLMaxTrimSlack|, and invalidates any outstanding
+  /// pointers into the storage.
+  void trim();
 
   /// Resets the storage and allocation of the object to an empty state
   void reset();
@@ -46,10 +86,11 @@ class DisplayListStorage {
  private:
   void realloc(size_t count);
 
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
-  };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
+  // Grows the buffer to hold at least |min_size| bytes, preferably by taking
+  // a buffer from the pool and otherwise by reallocating to |heap_size|.
+  void grow(size_t min_size, size_t heap_size);
+
+  uint8_t* ptr_ = nullptr;
 
   size_t used_ = 0u;
   size_t allocated_ = 0u;
@@ -17,6 +17,7 @@ TEST(DisplayListStorage, DefaultConstructed) {
 }
 
 TEST(DisplayListStorage, Allocation) {
+  DisplayListStorage::PurgePool();
   DisplayListStorage storage;
   EXPECT_NE(storage.allocate(10u), nullptr);
   EXPECT_NE(storage.base(), nullptr);
@@ -25,6 +26,7 @@ TEST(DisplayListStorage, Allocation) {
 }
 
 TEST(DisplayListStorage, PostMove) {
+  DisplayListStorage::PurgePool();
   DisplayListStorage original;
   EXPECT_NE(original.allocate(10u), nullptr);
 
@@ -43,5 +45,74 @@ TEST(DisplayListStorage, PostMove) {
   EXPECT_EQ(moved.capacity(), DisplayListStorage::kDLPageSize);
 }
 
+TEST(DisplayListStorage, ReleasedBufferIsRecycled) {
+  DisplayListStorage::PurgePool();
+  uint8_t* base;
+  {
+    DisplayListStorage storage;
+    EXPECT_NE(storage.allocate(10u), nullptr);
+    base = storage.base();
+  }
+
+  DisplayListStorage::ResetAllocationStats();
+  DisplayListStorage storage;
+  EXPECT_NE(storage.allocate(10u), nullptr);
+  EXPECT_EQ(storage.base(), base);
+  EXPECT_EQ(storage.capacity(), DisplayListStorage::kDLPageSize);
+
+  auto stats = DisplayListStorage::GetAllocationStats();
+  EXPECT_EQ(stats.heap_allocations, 0u);
+  EXPECT_EQ(stats.pool_hits, 1u);
+}
+
+TEST(DisplayListStorage, RecycledMemoryIsZeroFilled) {
+  DisplayListStorage::PurgePool();
+  {
+    DisplayListStorage storage;
+    memset(storage.allocate(100u), 0xff, 100u);
+  }
+
+  DisplayListStorage storage;
+  uint8_t* ptr = storage.allocate(100u);
+  for (size_t i = 0; i < 100u; i++) {
+    EXPECT_EQ(ptr[i], 0u);
+  }
+}
+
+TEST(DisplayListStorage, ReserveAvoidsGrowth) {
+  DisplayListStorage::PurgePool();
+  DisplayListStorage storage;
+  storage.reserve(5 * DisplayListStorage::kDLPageSize);
+  EXPECT_EQ(storage.capacity(), 5 * DisplayListStorage::kDLPageSize);
+
+  uint8_t* base = storage.base();
+  DisplayListStorage::ResetAllocationStats();
+  for (size_t i = 0; i < 5; i++) {
+    EXPECT_NE(storage.allocate(DisplayListStorage::kDLPageSize), nullptr);
+  }
+  EXPECT_EQ(storage.base(), base);
+  EXPECT_EQ(DisplayListStorage::GetAllocationStats().heap_allocations, 0u);
+}
+
+TEST(DisplayListStorage, TrimKeepsSmallSlack) {
+  DisplayListStorage::PurgePool();
+  DisplayListStorage storage;
+  storage.allocate(DisplayListStorage::kDLPageSize - 10u);
+  storage.trim();
+  EXPECT_EQ(storage.capacity(), DisplayListStorage::kDLPageSize);
+
+  storage.reserve(4 * DisplayListStorage::kDLPageSize);
+  storage.trim();
+  EXPECT_EQ(storage.capacity(), DisplayListStorage::kDLPageSize - 10u);
+}
+
+TEST(DisplayListStorage, TrimReleasesUnusedStorage) {
+  DisplayListStorage storage;
+  storage.reserve(DisplayListStorage::kDLPageSize);
+  storage.trim();
+  EXPECT_EQ(storage.base(), nullptr);
+  EXPECT_EQ(storage.capacity(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
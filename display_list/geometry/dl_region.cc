@@ -4,6 +4,12 @@
 
 #include "flutter/display_list/geometry/dl_region.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "flutter/fml/logging.h"
 
 namespace flutter {
@@ -12,6 +18,21 @@ namespace flutter {
 // search.
 const int kBinarySearchThreshold = 10;
 
+// Number of spans in a row taken from the same line, after which span
+// merging looks for the end of the run with the span kernels below.
+const size_t kShortSpanRunLength = 4;
+
+#if defined(__ARM_NEON)
+namespace {
+
+bool AnyLaneSet(uint32x4_t mask) {
+  uint32x2_t halves = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+  return vget_lane_u64(vreinterpret_u64_u32(halves), 0) != 0;
+}
+
+}  // namespace
+#endif
+
 DlRegion::SpanBuffer::SpanBuffer(DlRegion::SpanBuffer&& m)
     : capacity_(m.capacity_), size_(m.size_), spans_(m.spans_) {
   m.size_ = 0;
@@ -131,6 +152,78 @@ DlRegion::SpanLine DlRegion::makeLine(int32_t top,
   return {top, bottom, handle};
 }
 
+// The span kernels below check 4 spans at a time where SIMD is available and
+// finish the remaining spans, including the block in which the condition
+// stops holding, with a scalar loop. Since the spans of a line are sorted,
+// skipping whole blocks gives the same result as the scalar loop alone.
+size_t DlRegion::countSpansEndingBefore(const Span* begin,
+                                        const Span* end,
+                                        int32_t x) {
+  static_assert(sizeof(Span) == 2 * sizeof(int32_t));
+  const Span* span = begin;
+#if defined(__SSE2__)
+  // Each vector holds 2 spans, with the right edges in lanes 1 and 3.
+  const __m128i threshold = _mm_set1_epi32(x);
+  while (end - span >= 4) {
+    auto spans = reinterpret_cast<const __m128i*>(span);
+    __m128i past =
+        _mm_or_si128(_mm_cmpgt_epi32(_mm_loadu_si128(spans), threshold),
+                     _mm_cmpgt_epi32(_mm_loadu_si128(spans + 1), threshold));
+    if (_mm_movemask_ps(_mm_castsi128_ps(past)) & 0b1010) {
+      break;
+    }
+    span += 4;
+  }
+#elif defined(__ARM_NEON)
+  const int32x4_t threshold = vdupq_n_s32(x);
+  while (end - span >= 4) {
+    // Loads the left edges into val[0] and the right edges into val[1].
+    int32x4x2_t edges = vld2q_s32(reinterpret_cast<const int32_t*>(span));
+    if (AnyLaneSet(vcgtq_s32(edges.val[1], threshold))) {
+      break;
+    }
+    span += 4;
+  }
+#endif
+  while (span < end && span->right <= x) {
+    ++span;
+  }
+  return span - begin;
+}
+
+size_t DlRegion::countSpansStartingBefore(const Span* begin,
+                                          const Span* end,
+                                          int32_t x) {
+  const Span* span = begin;
+#if defined(__SSE2__)
+  // Each vector holds 2 spans, with the left edges in lanes 0 and 2.
+  const __m128i threshold = _mm_set1_epi32(x);
+  while (end - span >= 4) {
+    auto spans = reinterpret_cast<const __m128i*>(span);
+    __m128i before =
+        _mm_and_si128(_mm_cmpgt_epi32(threshold, _mm_loadu_si128(spans)),
+                      _mm_cmpgt_epi32(threshold, _mm_loadu_si128(spans + 1)));
+    if ((_mm_movemask_ps(_mm_castsi128_ps(before)) & 0b0101) != 0b0101) {
+      break;
+    }
+    span += 4;
+  }
+#elif defined(__ARM_NEON)
+  const int32x4_t threshold = vdupq_n_s32(x);
+  while (end - span >= 4) {
+    int32x4x2_t edges = vld2q_s32(reinterpret_cast<const int32_t*>(span));
+    if (AnyLaneSet(vcgeq_s32(edges.val[0], threshold))) {
+      break;
+    }
+    span += 4;
+  }
+#endif
+  while (span < end && span->left < x) {
+    ++span;
+  }
+  return span - begin;
+}
+
 // Returns number of valid spans in res. For performance reasons res is never
 // downsized.
 size_t DlRegion::unionLineSpans(std::vector<Span>& res,
@@ -153,6 +246,21 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
       }
     }
 
+    // Accumulates a run of spans taken from one line. The spans of a line
+    // are sorted and don't touch, so once a span of the run doesn't merge
+    // with the last accumulated span, the rest of the run is copied as is.
+    void accumulate(const Span* begin, const Span* end) {
+      while (begin < end && begin->left <= last_) {
+        accumulate(*begin++);
+      }
+      if (begin < end) {
+        size_t count = end - begin;
+        memcpy(res.data() + len, begin, count * sizeof(Span));
+        len += count;
+        last_ = end[-1].right;
+      }
+    }
+
     size_t len = 0;
     std::vector<Span>& res;
 
@@ -173,12 +281,28 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
 
   OrderedSpanAccumulator accumulator(res);
 
+  // The number of spans added in a row from each line. Once a run gets
+  // long, the rest of it is found and added at once.
+  size_t run1 = 0;
+  size_t run2 = 0;
+
   while (true) {
     if (begin1->left < begin2->left) {
       accumulator.accumulate(*begin1++);
       if (begin1 == end1) {
         break;
       }
+      run2 = 0;
+      if (++run1 == kShortSpanRunLength) {
+        const Span* run_end =
+            begin1 + countSpansStartingBefore(begin1, end1, begin2->left);
+        accumulator.accumulate(begin1, run_end);
+        begin1 = run_end;
+        if (begin1 == end1) {
+          break;
+        }
+        run1 = 0;
+      }
     } else {
       // Either 2 is first, or they are equal, in which case add 2 now
       // and we might combine 1 with it next time around
@@ -186,19 +310,24 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
       if (begin2 == end2) {
         break;
       }
+      run1 = 0;
+      if (++run2 == kShortSpanRunLength) {
+        const Span* run_end =
+            begin2 + countSpansStartingBefore(begin2, end2, begin1->left + 1);
+        accumulator.accumulate(begin2, run_end);
+        begin2 = run_end;
+        if (begin2 == end2) {
+          break;
+        }
+        run2 = 0;
+      }
     }
   }
 
   FML_DCHECK(begin1 == end1 || begin2 == end2);
 
-  while (begin1 < end1) {
-    accumulator.accumulate(*begin1++);
-  }
-  while (begin2 < end2) {
-    accumulator.accumulate(*begin2++);
-  }
-
-  FML_DCHECK(begin1 == end1 && begin2 == end2);
+  accumulator.accumulate(begin1, end1);
+  accumulator.accumulate(begin2, end2);
 
   return accumulator.len;
 }
@@ -225,12 +354,31 @@ size_t DlRegion::intersectLineSpans(std::vector<Span>& res,
   // Pointer to the next span to be written.
   Span* new_span = res.data();
 
+  // The number of spans skipped in a row in each line. Once a run gets
+  // long, the rest of it is found and skipped at once.
+  size_t run1 = 0;
+  size_t run2 = 0;
+
   while (begin1 != end1 && begin2 != end2) {
     if (begin1->right <= begin2->left) {
-      ++begin1;
+      if (++run1 < kShortSpanRunLength) {
+        ++begin1;
+      } else {
+        begin1 += countSpansEndingBefore(begin1, end1, begin2->left);
+        run1 = 0;
+      }
+      run2 = 0;
     } else if (begin2->right <= begin1->left) {
-      ++begin2;
+      if (++run2 < kShortSpanRunLength) {
+        ++begin2;
+      } else {
+        begin2 += countSpansEndingBefore(begin2, end2, begin1->left);
+        run2 = 0;
+      }
+      run1 = 0;
     } else {
+      run1 = 0;
+      run2 = 0;
       int32_t left = std::max(begin1->left, begin2->left);
       int32_t right = std::min(begin1->right, begin2->right);
       FML_DCHECK(left < right);
@@ -646,12 +794,16 @@ bool DlRegion::intersects(const SkIRect& rect) const {
     FML_DCHECK(rect.fTop < it->bottom && it->top < rect.fBottom);
     const Span *begin, *end;
     span_buffer_.getSpans(it->chunk_handle, begin, end);
-    while (begin != end && begin->left < rect.fRight) {
-      if (begin->right > rect.fLeft) {
-        return true;
+    for (size_t run = 1; begin != end && begin->right <= rect.fLeft; run++) {
+      if (run == kShortSpanRunLength) {
+        begin += countSpansEndingBefore(begin, end, rect.fLeft);
+        break;
       }
       ++begin;
     }
+    if (begin != end && begin->left < rect.fRight) {
+      return true;
+    }
     ++it;
   }
 
@@ -152,6 +152,18 @@ class DlRegion {
 
   bool spansEqual(SpanLine& line, const Span* begin, const Span* end) const;
 
+  /// Returns the number of spans at the start of [begin, end) that end at
+  /// or before |x|. The spans must be sorted, as they are in a span line.
+  static size_t countSpansEndingBefore(const Span* begin,
+                                       const Span* end,
+                                       int32_t x);
+
+  /// Returns the number of spans at the start of [begin, end) that start
+  /// before |x|. The spans must be sorted, as they are in a span line.
+  static size_t countSpansStartingBefore(const Span* begin,
+                                         const Span* end,
+                                         int32_t x);
+
   static bool spansIntersect(const Span* begin1,
                              const Span* end1,
                              const Span* begin2,
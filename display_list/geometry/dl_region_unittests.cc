@@ -429,5 +429,73 @@ TEST(DisplayListRegion, TestAgainstSkRegion) {
   }
 }
 
+// Lays out glyph sized rects in lines of text, which gives span lines with
+// many spans each.
+std::vector<SkIRect> GenerateTextRects(std::mt19937& rng,
+                                       int32_t left,
+                                       int32_t top,
+                                       int line_count,
+                                       int glyph_count) {
+  std::uniform_int_distribution glyph_width(3, 9);
+  std::uniform_int_distribution glyph_gap(1, 6);
+  std::uniform_int_distribution space(0, 7);
+  std::vector<SkIRect> rects;
+  for (int line = 0; line < line_count; line++) {
+    int32_t x = left;
+    for (int glyph = 0; glyph < glyph_count; glyph++) {
+      int32_t width = glyph_width(rng);
+      if (space(rng) != 0) {
+        rects.push_back(
+            SkIRect::MakeXYWH(x, top + line * 16 + width % 2, width, 12));
+      }
+      x += width + glyph_gap(rng);
+    }
+  }
+  return rects;
+}
+
+TEST(DisplayListRegion, TestTextAgainstSkRegion) {
+  std::seed_seq seed{::testing::UnitTest::GetInstance()->random_seed()};
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution offset(0, 20);
+
+  for (int i = 0; i < 20; i++) {
+    std::vector<std::vector<SkIRect>> all_rects{
+        GenerateTextRects(rng, 0, 0, 30, 200),
+        GenerateTextRects(rng, offset(rng), offset(rng), 30, 200),
+        GenerateTextRects(rng, 500, offset(rng), 30, 40),
+        {SkIRect::MakeXYWH(300, 0, 50, 400), SkIRect::MakeXYWH(0, 200, 900, 8)},
+    };
+    for (const auto& rects1 : all_rects) {
+      for (const auto& rects2 : all_rects) {
+        DlRegion region1(rects1);
+        SkRegion sk_region1;
+        sk_region1.setRects(rects1.data(), rects1.size());
+        CheckEquality(region1, sk_region1);
+
+        DlRegion region2(rects2);
+        SkRegion sk_region2;
+        sk_region2.setRects(rects2.data(), rects2.size());
+
+        EXPECT_EQ(region1.intersects(region2),
+                  sk_region1.intersects(sk_region2));
+        for (const auto& r : rects2) {
+          EXPECT_EQ(region1.intersects(r), sk_region1.intersects(r));
+        }
+
+        DlRegion dl_union = DlRegion::MakeUnion(region1, region2);
+        SkRegion sk_union(sk_region1);
+        sk_union.op(sk_region2, SkRegion::kUnion_Op);
+        CheckEquality(dl_union, sk_union);
+
+        DlRegion dl_intersection = DlRegion::MakeIntersection(region1, region2);
+        SkRegion sk_intersection(sk_region1);
+        sk_intersection.op(sk_region2, SkRegion::kIntersect_Op);
+        CheckEquality(dl_intersection, sk_intersection);
+      }
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/geometry/dl_rtree.h"
+
+#include <algorithm>
+
 #include "flutter/display_list/geometry/dl_region.h"
 
 #include "flutter/fml/logging.h"
@@ -160,6 +163,82 @@ void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
   }
 }
 
+bool DlRTree::searchIncremental(const SkRect& query,
+                                IncrementalSearchState& state) const {
+  if (query == state.query) {
+    return false;
+  }
+  const SkRect previous = state.query;
+  std::vector<int>& results = state.scratch_;
+  results.clear();
+
+  SkRect overlap;
+  // The previous results can be reused if they cover at least half of the
+  // new query. Otherwise, filtering them would cost more than it saves.
+  if (!query.isEmpty() && overlap.intersect(query, previous) &&
+      overlap.width() * overlap.height() * 2 >=
+          query.width() * query.height()) {
+    // Everything that intersects the overlap is among the previous results,
+    // and everything else that intersects the query intersects one of the
+    // strips of the query outside of the previous query.
+    std::vector<int>& strip_results = state.strip_results_;
+    strip_results.clear();
+    if (query.fTop < overlap.fTop) {
+      search(SkRect::MakeLTRB(query.fLeft, query.fTop, query.fRight,
+                              overlap.fTop),
+             &strip_results);
+    }
+    if (overlap.fBottom < query.fBottom) {
+      search(SkRect::MakeLTRB(query.fLeft, overlap.fBottom, query.fRight,
+                              query.fBottom),
+             &strip_results);
+    }
+    if (query.fLeft < overlap.fLeft) {
+      search(SkRect::MakeLTRB(query.fLeft, overlap.fTop, overlap.fLeft,
+                              overlap.fBottom),
+             &strip_results);
+    }
+    if (overlap.fRight < query.fRight) {
+      search(SkRect::MakeLTRB(overlap.fRight, overlap.fTop, query.fRight,
+                              overlap.fBottom),
+             &strip_results);
+    }
+    // Leaf indices are in the order of the original rects, so sorting the
+    // strip results restores that order across strips.
+    std::sort(strip_results.begin(), strip_results.end());
+
+    // Merges the previous results that still intersect the query with the
+    // results of the strips, dropping duplicates.
+    auto strip = strip_results.begin();
+    for (int index : state.results) {
+      if (!nodes_[index].bounds.intersects(query)) {
+        continue;
+      }
+      for (; strip != strip_results.end() && *strip <= index; ++strip) {
+        if (*strip < index &&
+            (results.empty() || results.back() != *strip)) {
+          results.push_back(*strip);
+        }
+      }
+      results.push_back(index);
+    }
+    for (; strip != strip_results.end(); ++strip) {
+      if (results.empty() || results.back() != *strip) {
+        results.push_back(*strip);
+      }
+    }
+  } else {
+    search(query, &results);
+  }
+
+  state.query = query;
+  if (results == state.results) {
+    return false;
+  }
+  std::swap(state.results, state.scratch_);
+  return true;
+}
+
 std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
                                                      bool deband) const {
   // Get the indexes for the operations that intersect with the query rect.
@@ -80,6 +80,36 @@ class DlRTree : public SkRefCnt {
   /// |DlRTree::id| and |DlRTree::bounds| methods.
   void search(const SkRect& query, std::vector<int>* results) const;
 
+  /// The results of a query, kept by the caller of |searchIncremental| so
+  /// that they can be reused by the next query.
+  struct IncrementalSearchState {
+    /// The most recent query rect.
+    SkRect query = SkRect::MakeEmpty();
+
+    /// The results of |query|, in the same order as those of |search|.
+    std::vector<int> results;
+
+   private:
+    friend class DlRTree;
+
+    std::vector<int> scratch_;
+    std::vector<int> strip_results_;
+  };
+
+  /// Search the rectangles like |search|, and store the results and the
+  /// query in |state|.
+  ///
+  /// If the query overlaps most of the query previously stored in |state|,
+  /// as it does when content is scrolled by a small amount each frame, the
+  /// previous results are filtered against the new query and only the
+  /// strips of the new query that were not covered by the previous one are
+  /// searched in the tree.
+  ///
+  /// Returns true if the results differ from the ones previously stored in
+  /// |state|.
+  bool searchIncremental(const SkRect& query,
+                         IncrementalSearchState& state) const;
+
   /// Return the ID for the indicated result of a query or
   /// invalid_id if the index is not a valid leaf node index.
   int id(int result_index) const {
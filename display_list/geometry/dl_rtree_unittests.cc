@@ -319,5 +319,68 @@ TEST(DisplayListRTree, Region) {
   EXPECT_EQ(rects.size(), expected_rects.size());
 }
 
+TEST(DisplayListRTree, IncrementalSearchMatchesSearch) {
+  // A tall list of rows, each made of 3 overlapping rects.
+  const int kRows = 200;
+  std::vector<SkRect> rects;
+  for (int r = 0; r < kRows; r++) {
+    for (int c = 0; c < 3; c++) {
+      rects.push_back(SkRect::MakeXYWH(c * 90, r * 30, 100, 35));
+    }
+  }
+  DlRTree tree(rects.data(), rects.size());
+
+  DlRTree::IncrementalSearchState state;
+  std::vector<int> expected;
+  auto check = [&tree, &state, &expected](const SkRect& query) {
+    std::vector<int> previous = state.results;
+    bool changed = tree.searchIncremental(query, state);
+    expected.clear();
+    tree.search(query, &expected);
+    EXPECT_EQ(state.query, query);
+    EXPECT_EQ(state.results, expected);
+    EXPECT_EQ(changed, previous != expected);
+  };
+
+  SkRect query = SkRect::MakeXYWH(0, 0, 250, 600);
+  check(query);
+  EXPECT_FALSE(state.results.empty());
+  // Repeating the query changes nothing.
+  EXPECT_FALSE(tree.searchIncremental(query, state));
+  // Scrolling down and back up by small amounts.
+  for (int i = 0; i < 50; i++) {
+    query.offset(0, 7.5f);
+    check(query);
+  }
+  for (int i = 0; i < 20; i++) {
+    query.offset(0, -11);
+    check(query);
+  }
+  // Scrolling diagonally exposes strips on two sides.
+  for (int i = 0; i < 20; i++) {
+    query.offset(3, 5);
+    check(query);
+  }
+  // Jumps that leave little or no overlap with the previous query.
+  query.offset(0, 500);
+  check(query);
+  query = SkRect::MakeXYWH(-50, 3000, 200, 400);
+  check(query);
+  // Growing and shrinking the query in place.
+  query.setLTRB(-100, 2900, 400, 3500);
+  check(query);
+  query.setLTRB(0, 3000, 100, 3100);
+  check(query);
+  // Leaving the bounds of the tree and coming back.
+  query = SkRect::MakeXYWH(1000, 0, 100, 100);
+  check(query);
+  EXPECT_TRUE(state.results.empty());
+  query = SkRect::MakeXYWH(0, 0, 100, 100);
+  check(query);
+  // An empty query has no results.
+  check(SkRect::MakeEmpty());
+  EXPECT_TRUE(state.results.empty());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -194,11 +194,20 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  // Whether |LayerTree::Preroll| may reuse the preroll results retained by
+  // unchanged subtrees in the previous frame.
+  bool reuse_retained_prerolls() const { return reuse_retained_prerolls_; }
+
+  void set_reuse_retained_prerolls(bool reuse) {
+    reuse_retained_prerolls_ = reuse;
+  }
+
  private:
   NOT_SLIMPELLER(RasterCache raster_cache_);
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  bool reuse_retained_prerolls_ = false;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
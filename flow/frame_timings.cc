@@ -151,6 +151,22 @@ void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
   (void)status;
 }
 
+void FrameTimingsRecorder::RecordViewRasterTime(int64_t view_id,
+                                                fml::TimePoint raster_start,
+                                                fml::TimePoint raster_end) {
+  fml::Status status =
+      RecordViewRasterTimeImpl(view_id, raster_start, raster_end);
+  FML_DCHECK(status.ok());
+  (void)status;
+}
+
+std::map<int64_t, FrameTimingsRecorder::ViewRasterTime>
+FrameTimingsRecorder::GetViewRasterTimes() const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kRasterEnd);
+  return view_raster_times_;
+}
+
 fml::Status FrameTimingsRecorder::RecordVsyncImpl(fml::TimePoint vsync_start,
                                                   fml::TimePoint vsync_target) {
   std::scoped_lock state_lock(state_mutex_);
@@ -199,6 +215,22 @@ fml::Status FrameTimingsRecorder::RecordRasterStartImpl(
   return fml::Status();
 }
 
+fml::Status FrameTimingsRecorder::RecordViewRasterTimeImpl(
+    int64_t view_id,
+    fml::TimePoint raster_start,
+    fml::TimePoint raster_end) {
+  std::scoped_lock state_lock(state_mutex_);
+  if (state_ != State::kRasterStart) {
+    return fml::Status(fml::StatusCode::kFailedPrecondition,
+                       "Check failed: state_ == State::kRasterStart.");
+  }
+  view_raster_times_[view_id] = {
+      .raster_start = raster_start,
+      .raster_end = raster_end,
+  };
+  return fml::Status();
+}
+
 FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kRasterStart);
@@ -227,6 +259,7 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
+  timing_.SetViewRasterTimes(view_raster_times_);
   return timing_;
 }
 
@@ -259,6 +292,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
 
   if (state >= State::kRasterStart) {
     recorder->raster_start_ = raster_start_;
+    recorder->view_raster_times_ = view_raster_times_;
   }
 
   if (state >= State::kRasterEnd) {
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_FRAME_TIMINGS_H_
 #define FLUTTER_FLOW_FRAME_TIMINGS_H_
 
+#include <map>
 #include <mutex>
 
 #include "flutter/common/settings.h"
@@ -41,6 +42,9 @@ class FrameTimingsRecorder {
     kRasterEnd,
   };
 
+  /// Timestamps of the rasterization of a single view of a frame.
+  using ViewRasterTime = FrameTiming::ViewRasterTime;
+
   /// Default constructor, initializes the recorder with State::kUninitialized.
   FrameTimingsRecorder();
 
@@ -99,6 +103,17 @@ class FrameTimingsRecorder {
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Records when the rasterization of one of the views of the frame started
+  /// and finished. Views may be rasterized concurrently, so their times can
+  /// overlap. Must be called between `RecordRasterStart` and
+  /// `RecordRasterEnd`.
+  void RecordViewRasterTime(int64_t view_id,
+                            fml::TimePoint raster_start,
+                            fml::TimePoint raster_end);
+
+  /// The times recorded by `RecordViewRasterTime`, keyed by view ID.
+  std::map<int64_t, ViewRasterTime> GetViewRasterTimes() const;
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -130,6 +145,8 @@ class FrameTimingsRecorder {
   FML_FRIEND_TEST(FrameTimingsRecorderTest, ThrowWhenRecordBuildBeforeVsync);
   FML_FRIEND_TEST(FrameTimingsRecorderTest,
                   ThrowWhenRecordRasterBeforeBuildEnd);
+  FML_FRIEND_TEST(FrameTimingsRecorderTest,
+                  ThrowWhenRecordViewRasterTimeBeforeRasterStart);
 
   [[nodiscard]] fml::Status RecordVsyncImpl(fml::TimePoint vsync_start,
                                             fml::TimePoint vsync_target);
@@ -137,6 +154,11 @@ class FrameTimingsRecorder {
   [[nodiscard]] fml::Status RecordBuildEndImpl(fml::TimePoint build_end);
   [[nodiscard]] fml::Status RecordRasterStartImpl(fml::TimePoint raster_start);
 
+  [[nodiscard]] fml::Status RecordViewRasterTimeImpl(
+      int64_t view_id,
+      fml::TimePoint raster_start,
+      fml::TimePoint raster_end);
+
   static std::atomic<uint64_t> frame_number_gen_;
 
   mutable std::mutex state_mutex_;
@@ -157,6 +179,7 @@ class FrameTimingsRecorder {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  std::map<int64_t, ViewRasterTime> view_raster_times_;
 
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
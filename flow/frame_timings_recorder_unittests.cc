@@ -75,6 +75,38 @@ TEST(FrameTimingsRecorderTest, RecordRasterTimes) {
   ASSERT_EQ(recorder->GetPictureCacheBytes(), 0u);
 }
 
+TEST(FrameTimingsRecorderTest, RecordViewRasterTimes) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto st = fml::TimePoint::Now();
+  const auto en = st + fml::TimeDelta::FromMillisecondsF(16);
+  recorder->RecordVsync(st, en);
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+
+  const auto raster_start = fml::TimePoint::Now();
+  recorder->RecordRasterStart(raster_start);
+  // The views overlap, as they do when they are rasterized concurrently.
+  const auto view0_end = raster_start + fml::TimeDelta::FromMillisecondsF(4);
+  const auto view1_start = raster_start + fml::TimeDelta::FromMillisecondsF(1);
+  const auto view1_end = raster_start + fml::TimeDelta::FromMillisecondsF(6);
+  recorder->RecordViewRasterTime(0, raster_start, view0_end);
+  recorder->RecordViewRasterTime(1, view1_start, view1_end);
+  const FrameTiming timing = recorder->RecordRasterEnd();
+
+  const auto view_times = recorder->GetViewRasterTimes();
+  ASSERT_EQ(view_times.size(), 2u);
+  ASSERT_EQ(view_times.at(0).raster_start, raster_start);
+  ASSERT_EQ(view_times.at(0).raster_end, view0_end);
+  ASSERT_EQ(view_times.at(1).raster_start, view1_start);
+  ASSERT_EQ(view_times.at(1).raster_end, view1_end);
+
+  // They are reported along with the other timings of the frame.
+  ASSERT_EQ(timing.GetViewRasterTimes().size(), 2u);
+  ASSERT_EQ(timing.GetViewRasterTimes().at(1).raster_start, view1_start);
+  ASSERT_EQ(timing.GetViewRasterTimes().at(1).raster_end, view1_end);
+}
+
 TEST(FrameTimingsRecorderTest, RecordRasterTimesWithCache) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
@@ -147,6 +179,23 @@ TEST(FrameTimingsRecorderTest, ThrowWhenRecordRasterBeforeBuildEnd) {
   EXPECT_EQ(status.message(), "Check failed: state_ == State::kBuildEnd.");
 }
 
+TEST(FrameTimingsRecorderTest,
+     ThrowWhenRecordViewRasterTimeBeforeRasterStart) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto st = fml::TimePoint::Now();
+  const auto en = st + fml::TimeDelta::FromMillisecondsF(16);
+  recorder->RecordVsync(st, en);
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+
+  const auto view_start = fml::TimePoint::Now();
+  fml::Status status =
+      recorder->RecordViewRasterTimeImpl(0, view_start, view_start);
+  EXPECT_FALSE(status.ok());
+  EXPECT_EQ(status.message(), "Check failed: state_ == State::kRasterStart.");
+}
+
 #endif
 
 TEST(FrameTimingsRecorderTest, RecordersHaveUniqueFrameNumbers) {
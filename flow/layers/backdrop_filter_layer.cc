@@ -45,9 +45,12 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
 void BackdropFilterLayer::Preroll(PrerollContext* context) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, true, bool(filter_));
-  if (filter_ && context->view_embedder != nullptr) {
-    context->view_embedder->PushFilterToVisitedPlatformViews(
-        filter_, context->state_stack.device_cull_rect());
+  if (filter_) {
+    context->has_preroll_side_effects = true;
+    if (context->view_embedder != nullptr) {
+      context->view_embedder->PushFilterToVisitedPlatformViews(
+          filter_, context->state_stack.device_cull_rect());
+    }
   }
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, &child_paint_bounds);
@@ -4,10 +4,13 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_embedder.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "gtest/gtest.h"
@@ -560,6 +563,155 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+// A MockLayer that counts how many times it has been prerolled.
+class PrerollCountingLayer : public MockLayer {
+ public:
+  using MockLayer::MockLayer;
+
+  void Preroll(PrerollContext* context) override {
+    preroll_count_++;
+    MockLayer::Preroll(context);
+  }
+
+  int preroll_count() const { return preroll_count_; }
+
+ private:
+  int preroll_count_ = 0;
+};
+
+TEST_F(ContainerLayerTest, RetainedSubtreeSkipsPreroll) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<PrerollCountingLayer>(child_path);
+  mock_layer->set_fake_opacity_compatible(true);
+  mock_layer->set_fake_has_texture_layer(true);
+  auto retained_layer = std::make_shared<ContainerLayer>();
+  retained_layer->Add(mock_layer);
+
+  preroll_context()->reuse_retained_prerolls = true;
+  for (int frame = 0; frame < 3; frame++) {
+    // Every frame builds a new root which retains the same subtree.
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained_layer);
+    preroll_context()->has_texture_layer = false;
+    root->Preroll(preroll_context());
+
+    EXPECT_EQ(mock_layer->preroll_count(), 1);
+    EXPECT_EQ(root->paint_bounds(), child_path.getBounds());
+    EXPECT_EQ(retained_layer->paint_bounds(), child_path.getBounds());
+    EXPECT_EQ(preroll_context()->renderable_state_flags,
+              LayerStateStack::kCallerCanApplyOpacity);
+    EXPECT_TRUE(preroll_context()->has_texture_layer);
+    EXPECT_FALSE(preroll_context()->has_platform_view);
+  }
+}
+
+TEST_F(ContainerLayerTest, RetainedSubtreeIsPrerolledWithoutReuse) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<PrerollCountingLayer>(child_path);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(mock_layer);
+
+  root->Preroll(preroll_context());
+  root->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+}
+
+TEST_F(ContainerLayerTest, RetainedSubtreeIsPrerolledWhenInputsChange) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<PrerollCountingLayer>(child_path);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(mock_layer);
+
+  preroll_context()->reuse_retained_prerolls = true;
+  root->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+  {
+    auto mutator = preroll_context()->state_stack.save();
+    mutator.translate(10.0f, 10.0f);
+    root->Preroll(preroll_context());
+    EXPECT_EQ(mock_layer->preroll_count(), 2);
+    EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(10.0f, 10.0f));
+    root->Preroll(preroll_context());
+    EXPECT_EQ(mock_layer->preroll_count(), 2);
+  }
+  {
+    auto mutator = preroll_context()->state_stack.save();
+    mutator.clipRect(SkRect::MakeWH(10.0f, 10.0f), false);
+    root->Preroll(preroll_context());
+    EXPECT_EQ(mock_layer->preroll_count(), 3);
+    EXPECT_EQ(mock_layer->parent_cull_rect(), SkRect::MakeWH(10.0f, 10.0f));
+  }
+  root->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 4);
+}
+
+TEST_F(ContainerLayerTest, RetainedSubtreeWithSideEffectsIsAlwaysPrerolled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto platform_view_layer =
+      std::make_shared<PrerollCountingLayer>(child_path);
+  platform_view_layer->set_fake_has_platform_view(true);
+  auto readback_layer = std::make_shared<PrerollCountingLayer>(child_path);
+  readback_layer->set_fake_reads_surface(true);
+  auto cacheable_layer =
+      std::make_shared<MockCacheableLayer>(child_path, DlPaint(), 0);
+  auto cacheable_container = std::make_shared<ContainerLayer>();
+  cacheable_container->Add(cacheable_layer);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(platform_view_layer);
+  root->Add(readback_layer);
+  root->Add(cacheable_container);
+
+  use_mock_raster_cache();
+  preroll_context()->reuse_retained_prerolls = true;
+  for (int frame = 1; frame <= 3; frame++) {
+    preroll_context()->has_platform_view = false;
+    preroll_context()->surface_needs_readback = false;
+    preroll_context()->raster_cached_entries->clear();
+    root->Preroll(preroll_context());
+
+    EXPECT_EQ(platform_view_layer->preroll_count(), frame);
+    EXPECT_EQ(readback_layer->preroll_count(), frame);
+    EXPECT_TRUE(preroll_context()->has_platform_view);
+    EXPECT_TRUE(preroll_context()->surface_needs_readback);
+    ASSERT_EQ(preroll_context()->raster_cached_entries->size(),
+              static_cast<const unsigned long>(1));
+  }
+}
+
+TEST_F(ContainerLayerTest, RetainedBackdropFilterUnderSaveLayerIsPrerolled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto filter = DlBlurImageFilter(5, 5, DlTileMode::kClamp);
+  auto backdrop_filter_layer = std::make_shared<BackdropFilterLayer>(
+      filter.shared(), DlBlendMode::kSrcOver);
+  backdrop_filter_layer->Add(mock_layer);
+  // The opacity layer saves a layer, which hides the readback of the
+  // backdrop filter from its parents.
+  auto opacity_layer =
+      std::make_shared<OpacityLayer>(128, SkPoint::Make(0.0f, 0.0f));
+  opacity_layer->Add(backdrop_filter_layer);
+
+  auto embedder = MockViewEmbedder();
+  preroll_context()->view_embedder = &embedder;
+  preroll_context()->reuse_retained_prerolls = true;
+  for (size_t frame = 1; frame <= 3; frame++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(opacity_layer);
+    preroll_context()->surface_needs_readback = false;
+    preroll_context()->has_preroll_side_effects = false;
+    root->Preroll(preroll_context());
+
+    EXPECT_EQ(embedder.pushed_filter_count(), frame);
+    EXPECT_FALSE(preroll_context()->surface_needs_readback);
+    EXPECT_TRUE(preroll_context()->has_preroll_side_effects);
+  }
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -11,6 +11,7 @@
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace flutter {
 
@@ -131,6 +132,19 @@ void DisplayListLayer::Paint(PaintContext& context) const {
 #endif  //  !SLIMPELLER
 
   SkScalar opacity = context.state_stack.outstanding_opacity();
+#if !SLIMPELLER
+  if (context.raster_cache && display_list_raster_cache_item_ &&
+      context.raster_cache->ShouldRecordUncachedDrawTime()) {
+    // Let the raster cache policy weigh what caching this display list would
+    // save.
+    const fml::TimePoint start = fml::TimePoint::Now();
+    context.canvas->DrawDisplayList(display_list_, opacity);
+    context.raster_cache->RecordUncachedDrawTime(
+        display_list_raster_cache_item_->GetId().value(),
+        context.canvas->GetTransform(), fml::TimePoint::Now() - start);
+    return;
+  }
+#endif  //  !SLIMPELLER
   context.canvas->DrawDisplayList(display_list_, opacity);
 }
 
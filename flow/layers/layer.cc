@@ -24,6 +24,66 @@ uint64_t Layer::NextUniqueID() {
   return id;
 }
 
+void Layer::PrerollOrReuse(PrerollContext* context) {
+  if (!context->reuse_retained_prerolls) {
+    Preroll(context);
+    return;
+  }
+
+  const SkM44 transform = context->state_stack.transform_4x4();
+  const SkRect device_cull_rect = context->state_stack.device_cull_rect();
+  if (retained_preroll_.has_value() &&
+      retained_preroll_->transform == transform &&
+      retained_preroll_->device_cull_rect == device_cull_rect &&
+      retained_preroll_->gr_context == context->gr_context
+#if !SLIMPELLER
+      && retained_preroll_->raster_cache == context->raster_cache
+#endif  //  !SLIMPELLER
+  ) {
+    context->renderable_state_flags = retained_preroll_->renderable_state_flags;
+    context->has_texture_layer = retained_preroll_->has_texture_layer;
+    return;
+  }
+  retained_preroll_.reset();
+
+  // The readback and side effect flags only accumulate during Preroll, so
+  // they are cleared here to find out whether this subtree sets them.
+  const bool prev_surface_needs_readback = context->surface_needs_readback;
+  context->surface_needs_readback = false;
+  const bool prev_has_preroll_side_effects = context->has_preroll_side_effects;
+  context->has_preroll_side_effects = false;
+  const size_t prev_raster_cached_entries =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0;
+
+  Preroll(context);
+
+  const bool subtree_needs_readback = context->surface_needs_readback;
+  context->surface_needs_readback =
+      prev_surface_needs_readback || subtree_needs_readback;
+  const bool subtree_has_side_effects = context->has_preroll_side_effects;
+  context->has_preroll_side_effects =
+      prev_has_preroll_side_effects || subtree_has_side_effects;
+  const size_t raster_cached_entries =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0;
+  if (context->has_platform_view || subtree_needs_readback ||
+      subtree_has_side_effects ||
+      raster_cached_entries != prev_raster_cached_entries) {
+    return;
+  }
+  retained_preroll_ = RetainedPreroll{
+      .transform = transform,
+      .device_cull_rect = device_cull_rect,
+      .gr_context = context->gr_context,
+#if !SLIMPELLER
+      .raster_cache = context->raster_cache,
+#endif  //  !SLIMPELLER
+      .renderable_state_flags = context->renderable_state_flags,
+      .has_texture_layer = context->has_texture_layer,
+  };
+}
+
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
     bool save_layer_is_active,
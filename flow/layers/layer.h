@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -42,6 +43,7 @@ class MockLayer;
 class ContainerLayer;
 class DisplayListLayer;
 class PerformanceOverlayLayer;
+class PlatformViewLayer;
 class TextureLayer;
 class RasterCacheItem;
 
@@ -69,6 +71,10 @@ struct PrerollContext {
   // These allow us to track properties like elevation, opacity, and the
   // presence of a texture layer during Preroll.
   bool has_texture_layer = false;
+  // Set by layers whose Preroll has effects outside of the layer tree, such
+  // as backdrop filters that push their filter to the view embedder. Unlike
+  // |surface_needs_readback|, save layers never clear it.
+  bool has_preroll_side_effects = false;
 
   // The list of flags that describe which rendering state attributes
   // (such as opacity, ColorFilter, ImageFilter) a given layer can
@@ -81,6 +87,10 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // Whether |Layer::PrerollOrReuse| may skip the Preroll of a subtree that
+  // is retained from a previous frame and sees the same inputs again.
+  bool reuse_retained_prerolls = false;
 };
 
 struct PaintContext {
@@ -162,6 +172,21 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Calls |Preroll|, unless the context allows reusing retained prerolls and
+  // this same layer instance was already prerolled under the same transform,
+  // cull rect and raster cache. Layers are immutable once built, so such a
+  // retained subtree would compute the same paint bounds and flags again,
+  // which are still stored in the layers. Only the values that the subtree
+  // reports back through the context are replayed.
+  //
+  // Subtrees whose Preroll has effects outside of the layers themselves are
+  // always prerolled: those with platform views (which are handed to the
+  // view embedder), those that read back the surface, those that report
+  // |PrerollContext::has_preroll_side_effects| (backdrop filters, even when
+  // nested under a save layer) and those that register raster cache entries
+  // (which must be marked as seen on every frame to stay alive).
+  void PrerollOrReuse(PrerollContext* context);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -257,6 +282,9 @@ class Layer {
   virtual const PerformanceOverlayLayer* as_performance_overlay_layer() const {
     return nullptr;
   }
+  virtual const PlatformViewLayer* as_platform_view_layer() const {
+    return nullptr;
+  }
   virtual const testing::MockLayer* as_mock_layer() const { return nullptr; }
 
  private:
@@ -265,6 +293,18 @@ class Layer {
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_ = false;
 
+  // The inputs and the reported results of the last Preroll of this layer
+  // that may be reused by |PrerollOrReuse|.
+  struct RetainedPreroll {
+    SkM44 transform;
+    SkRect device_cull_rect;
+    GrDirectContext* gr_context;
+    NOT_SLIMPELLER(RasterCache* raster_cache);
+    int renderable_state_flags;
+    bool has_texture_layer;
+  };
+  std::optional<RetainedPreroll> retained_preroll_;
+
   static uint64_t NextUniqueID();
 
   FML_DISALLOW_COPY_AND_ASSIGN(Layer);
@@ -35,6 +35,11 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
     return false;
   }
 
+  if (recording_) {
+    // The layers were prerolled when they were recorded.
+    return false;
+  }
+
   SkColorSpace* color_space = GetColorSpace(frame.canvas());
   LayerStateStack state_stack;
   state_stack.set_preroll_delegate(cull_rect,
@@ -56,6 +61,7 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .ui_time = frame.context().ui_time(),
       .texture_registry = frame.context().texture_registry(),
       .raster_cached_entries = &raster_cache_items_,
+      .reuse_retained_prerolls = frame.context().reuse_retained_prerolls(),
   };
 
   root_layer_->Preroll(&context);
@@ -102,6 +108,13 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     return;
   }
 
+  if (recording_) {
+    if (frame.canvas()) {
+      frame.canvas()->DrawDisplayList(recording_);
+    }
+    return;
+  }
+
   LayerStateStack state_stack;
 
   DlCanvas* canvas = frame.canvas();
@@ -134,7 +147,7 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
 
 #if !SLIMPELLER
   if (cache) {
-    cache->EvictUnusedCacheEntries();
+    cache->EvictUnusedCacheEntries(frame.gr_context());
     TryToRasterCache(raster_cache_items_, &context, ignore_raster_cache);
   }
 #endif  //  !SLIMPELLER
@@ -205,4 +218,9 @@ sk_sp<DisplayList> LayerTree::Flatten(
   return builder.Build();
 }
 
+void LayerTree::Record() {
+  TRACE_EVENT0("flutter", "LayerTree::Record");
+  recording_ = Flatten(SkRect::Make(frame_size_));
+}
+
 }  // namespace flutter
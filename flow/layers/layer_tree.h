@@ -50,6 +50,18 @@ class LayerTree {
       const std::shared_ptr<TextureRegistry>& texture_registry = nullptr,
       GrDirectContext* gr_context = nullptr);
 
+  // Flattens the layers into a display list ahead of the frame, for instance
+  // on a worker thread while the raster thread draws another view. |Preroll|
+  // and |Paint| then draw that display list instead of walking the layers
+  // again. The layers are still diffed against the previous frame, so the
+  // frame can be repainted partially.
+  //
+  // Only for layer trees that paint without the view embedder, the texture
+  // registry, the raster cache or the frame's stopwatches.
+  void Record();
+
+  bool is_recorded() const { return recording_ != nullptr; }
+
   Layer* root_layer() const { return root_layer_.get(); }
   const SkISize& frame_size() const { return frame_size_; }
 
@@ -62,6 +74,8 @@ class LayerTree {
 
   PaintRegionMap paint_region_map_;
 
+  sk_sp<DisplayList> recording_;
+
   std::vector<RasterCacheItem*> raster_cache_items_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(LayerTree);
@@ -0,0 +1,171 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/stopwatch.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr int kTilesPerRow = 32;
+constexpr int kRowsPerView = 64;
+constexpr SkScalar kTileSize = 32.0f;
+
+sk_sp<DisplayList> MakeTileDisplayList() {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(kTileSize, kTileSize),
+                   DlPaint(DlColor::kBlue()));
+  builder.DrawCircle(SkPoint::Make(kTileSize / 2, kTileSize / 2),
+                     kTileSize / 4, DlPaint(DlColor::kRed()));
+  return builder.Build();
+}
+
+// A row of tiles, the way a list item or a static part of a page usually
+// shows up in a layer tree.
+std::shared_ptr<Layer> BuildRow(int row, const sk_sp<DisplayList>& tile) {
+  auto layer = std::make_shared<TransformLayer>(
+      SkMatrix::Translate(0.0f, row * kTileSize));
+  for (int i = 0; i < kTilesPerRow; i++) {
+    layer->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(i * kTileSize, 0.0f), tile, false, false));
+  }
+  return layer;
+}
+
+}  // namespace
+
+// Prerolls a new layer tree for every frame in which only the first of
+// `state.range(0)` rows of tiles is rebuilt, while all of the other rows
+// are retained from the previous frame.
+static void BM_LayerTreePrerollMostlyStatic(benchmark::State& state,
+                                            bool reuse_retained_prerolls) {
+  const int row_count = state.range(0);
+  const sk_sp<DisplayList> tile = MakeTileDisplayList();
+  std::vector<std::shared_ptr<Layer>> rows;
+  for (int row = 0; row < row_count; row++) {
+    rows.push_back(BuildRow(row, tile));
+  }
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  auto texture_registry = std::make_shared<TextureRegistry>();
+  std::vector<RasterCacheItem*> raster_cached_entries;
+
+  for (auto _ : state) {
+    rows[0] = BuildRow(0, tile);
+    auto root = std::make_shared<ContainerLayer>();
+    for (auto& row : rows) {
+      root->Add(row);
+    }
+
+    LayerStateStack state_stack;
+    state_stack.set_preroll_delegate(
+        SkRect::MakeWH(kTilesPerRow * kTileSize, 1000.0f), SkMatrix::I());
+    raster_cached_entries.clear();
+    PrerollContext context = {
+#if !SLIMPELLER
+        .raster_cache = nullptr,
+#endif  //  !SLIMPELLER
+        .gr_context = nullptr,
+        .view_embedder = nullptr,
+        .state_stack = state_stack,
+        .dst_color_space = nullptr,
+        .surface_needs_readback = false,
+        .raster_time = raster_time,
+        .ui_time = ui_time,
+        .texture_registry = texture_registry,
+        .raster_cached_entries = &raster_cached_entries,
+        .reuse_retained_prerolls = reuse_retained_prerolls,
+    };
+    root->Preroll(&context);
+    benchmark::DoNotOptimize(root->paint_bounds());
+  }
+
+  state.counters["Layers"] = row_count * (kTilesPerRow + 1);
+}
+
+BENCHMARK_CAPTURE(BM_LayerTreePrerollMostlyStatic, Preroll, false)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_LayerTreePrerollMostlyStatic, Reuse, true)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Unit(benchmark::kMicrosecond);
+
+// Records the layer trees of `state.range(0)` views, either one after another
+// or with all but the first one on worker threads, the way the rasterizer
+// records the views of a frame when concurrent view rasterization is enabled.
+// The recordings are drawn by reference, so this is the raster thread time
+// that the workers take over.
+static void BM_LayerTreeRecordViews(benchmark::State& state, bool concurrent) {
+  const int view_count = state.range(0);
+  const sk_sp<DisplayList> tile = MakeTileDisplayList();
+  const SkISize frame_size =
+      SkRect::MakeWH(kTilesPerRow * kTileSize, kRowsPerView * kTileSize)
+          .roundOut()
+          .size();
+  std::vector<std::shared_ptr<Layer>> root_layers;
+  for (int view = 0; view < view_count; view++) {
+    auto root_layer = std::make_shared<ContainerLayer>();
+    for (int row = 0; row < kRowsPerView; row++) {
+      root_layer->Add(BuildRow(row, tile));
+    }
+    root_layers.push_back(root_layer);
+  }
+
+  auto worker_loop = fml::ConcurrentMessageLoop::Create(view_count - 1);
+  auto worker_task_runner = worker_loop->GetTaskRunner();
+
+  for (auto _ : state) {
+    std::vector<std::unique_ptr<LayerTree>> layer_trees;
+    for (const auto& root_layer : root_layers) {
+      layer_trees.push_back(
+          std::make_unique<LayerTree>(root_layer, frame_size));
+    }
+    if (concurrent) {
+      fml::CountDownLatch latch(view_count - 1);
+      for (int view = 1; view < view_count; view++) {
+        worker_task_runner->PostTask([&layer_trees, &latch, view]() {
+          layer_trees[view]->Record();
+          latch.CountDown();
+        });
+      }
+      layer_trees[0]->Record();
+      latch.Wait();
+    } else {
+      for (auto& layer_tree : layer_trees) {
+        layer_tree->Record();
+      }
+    }
+    benchmark::DoNotOptimize(layer_trees.back()->is_recorded());
+  }
+
+  state.counters["Views"] = view_count;
+}
+
+BENCHMARK_CAPTURE(BM_LayerTreeRecordViews, Serial, false)
+    ->RangeMultiplier(2)
+    ->Range(2, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_LayerTreeRecordViews, Concurrent, true)
+    ->RangeMultiplier(2)
+    ->Range(2, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -9,9 +9,11 @@
 #include <memory>
 #include <string>
 
+#include "flow/raster_cache.h"
 #include "flow/stopwatch.h"
 #include "flow/stopwatch_dl.h"
 #include "flow/stopwatch_sk.h"
+#include "flutter/common/constants.h"
 #include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkTextBlob.h"
@@ -34,7 +36,8 @@ void VisualizeStopWatch(DlCanvas* canvas,
                         bool show_graph,
                         bool show_labels,
                         const std::string& label_prefix,
-                        const std::string& font_path) {
+                        const std::string& font_path,
+                        const std::string& label_suffix = "") {
   const int label_x = 8;    // distance from x
   const int label_y = -10;  // distance from y+height
 
@@ -53,7 +56,7 @@ void VisualizeStopWatch(DlCanvas* canvas,
 
   if (show_labels) {
     auto text = PerformanceOverlayLayer::MakeStatisticsText(
-        stopwatch, label_prefix, font_path);
+        stopwatch, label_prefix, font_path, label_suffix);
     // Historically SK_ColorGRAY (== 0xFF888888) was used here
     DlPaint paint(DlColor(0xFF888888));
 #ifdef IMPELLER_SUPPORTS_RENDERING
@@ -72,7 +75,8 @@ void VisualizeStopWatch(DlCanvas* canvas,
 sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeStatisticsText(
     const Stopwatch& stopwatch,
     const std::string& label_prefix,
-    const std::string& font_path) {
+    const std::string& font_path,
+    const std::string& label_suffix) {
   SkFont font;
   sk_sp<SkFontMgr> font_mgr = txt::GetDefaultFontManager();
   if (font_path == "") {
@@ -96,12 +100,36 @@ sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeStatisticsText(
   stream.setf(std::ios::fixed | std::ios::showpoint);
   stream << std::setprecision(1);
   stream << label_prefix << "  " << "max " << max_ms_per_frame << " ms/frame, "
-         << "avg " << average_ms_per_frame << " ms/frame";
+         << "avg " << average_ms_per_frame << " ms/frame" << label_suffix;
   auto text = stream.str();
   return SkTextBlob::MakeFromText(text.c_str(), text.size(), font,
                                   SkTextEncoding::kUTF8);
 }
 
+#if !SLIMPELLER
+std::string PerformanceOverlayLayer::MakeRasterCacheStatisticsLabel(
+    const RasterCache& raster_cache) {
+  const size_t max_bytes = raster_cache.policy().max_bytes();
+  if (max_bytes == 0) {
+    return "";
+  }
+  const RasterCacheMetrics& layer_metrics = raster_cache.layer_metrics();
+  const RasterCacheMetrics& picture_metrics = raster_cache.picture_metrics();
+  std::stringstream stream;
+  stream.setf(std::ios::fixed | std::ios::showpoint);
+  stream << std::setprecision(1);
+  stream << ", cache " << raster_cache.cached_bytes() / kMegaByteSizeInBytes
+         << " of " << max_bytes / kMegaByteSizeInBytes << " MB, "
+         << layer_metrics.budget_demotion_count +
+                picture_metrics.budget_demotion_count
+         << " demoted, "
+         << layer_metrics.budget_eviction_count +
+                picture_metrics.budget_eviction_count
+         << " evicted";
+  return stream.str();
+}
+#endif  //  !SLIMPELLER
+
 PerformanceOverlayLayer::PerformanceOverlayLayer(uint64_t options,
                                                  const char* font_path)
     : options_(options) {
@@ -135,10 +163,18 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) const {
   SkScalar height = paint_bounds().height() / 2;
   auto mutator = context.state_stack.save();
 
-  VisualizeStopWatch(
-      context.canvas, context.impeller_enabled, context.raster_time, x, y,
-      width, height - padding, options_ & kVisualizeRasterizerStatistics,
-      options_ & kDisplayRasterizerStatistics, "Raster", font_path_);
+  std::string raster_label_suffix;
+#if !SLIMPELLER
+  if (context.raster_cache) {
+    raster_label_suffix = MakeRasterCacheStatisticsLabel(*context.raster_cache);
+  }
+#endif  //  !SLIMPELLER
+
+  VisualizeStopWatch(context.canvas, context.impeller_enabled,
+                     context.raster_time, x, y, width, height - padding,
+                     options_ & kVisualizeRasterizerStatistics,
+                     options_ & kDisplayRasterizerStatistics, "Raster",
+                     font_path_, raster_label_suffix);
 
   VisualizeStopWatch(context.canvas, context.impeller_enabled, context.ui_time,
                      x, y + height, width, height - padding,
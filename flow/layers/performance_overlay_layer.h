@@ -22,9 +22,19 @@ const int kVisualizeEngineStatistics = 1 << 3;
 
 class PerformanceOverlayLayer : public Layer {
  public:
-  static sk_sp<SkTextBlob> MakeStatisticsText(const Stopwatch& stopwatch,
-                                              const std::string& label_prefix,
-                                              const std::string& font_path);
+  static sk_sp<SkTextBlob> MakeStatisticsText(
+      const Stopwatch& stopwatch,
+      const std::string& label_prefix,
+      const std::string& font_path,
+      const std::string& label_suffix = "");
+
+#if !SLIMPELLER
+  // Returns the text appended to the raster statistics to show how full a
+  // raster cache with a byte budget is, and how many images were given up
+  // to stay within it in this frame. Empty if the cache has no budget.
+  static std::string MakeRasterCacheStatisticsLabel(
+      const RasterCache& raster_cache);
+#endif  //  !SLIMPELLER
 
   bool IsReplacing(DiffContext* context, const Layer* layer) const override {
     return layer->as_performance_overlay_layer() != nullptr;
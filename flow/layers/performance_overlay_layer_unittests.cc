@@ -232,6 +232,39 @@ TEST_F(PerformanceOverlayLayerTest, SimpleRasterizerStatistics) {
   EXPECT_EQ(inspector.text_positions().front(), text_position);
 }
 
+TEST_F(PerformanceOverlayLayerTest, RasterStatisticsShowRasterCacheBudget) {
+  use_skia_raster_cache();
+  ASSERT_EQ(
+      PerformanceOverlayLayer::MakeRasterCacheStatisticsLabel(*raster_cache()),
+      "");
+
+  raster_cache()->SetPolicy(
+      std::make_unique<LruRasterCachePolicy>(48 * 1024 * 1024));
+  const std::string label =
+      PerformanceOverlayLayer::MakeRasterCacheStatisticsLabel(*raster_cache());
+  ASSERT_EQ(label, ", cache 0.0 of 48.0 MB, 0 demoted, 0 evicted");
+
+  const SkRect layer_bounds = SkRect::MakeLTRB(0.0f, 0.0f, 64.0f, 64.0f);
+  auto layer =
+      std::make_shared<PerformanceOverlayLayer>(kDisplayRasterizerStatistics);
+  layer->set_paint_bounds(layer_bounds);
+  layer->Preroll(preroll_context());
+  layer->Paint(display_list_paint_context());
+
+  auto overlay_text = PerformanceOverlayLayer::MakeStatisticsText(
+      display_list_paint_context().raster_time, "Raster", "", label);
+  auto overlay_text_data = overlay_text->serialize(SkSerialProcs{});
+  ImageSizeTextBlobInspector inspector;
+  display_list()->Dispatch(inspector);
+
+#if defined(OS_FUCHSIA)
+  GTEST_SKIP() << "Expectation requires a valid default font manager";
+#endif  // OS_FUCHSIA
+  ASSERT_EQ(inspector.text_blobs().size(), 1u);
+  auto text_data = inspector.text_blobs().front()->serialize(SkSerialProcs{});
+  EXPECT_TRUE(text_data->equals(overlay_text_data.get()));
+}
+
 TEST_F(PerformanceOverlayLayerTest, MarkAsDirtyWhenResized) {
   // Regression test for https://github.com/flutter/flutter/issues/54188
 
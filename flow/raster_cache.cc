@@ -6,7 +6,10 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "flutter/common/constants.h"
@@ -16,12 +19,14 @@
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/ganesh/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkImageGanesh.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
 namespace flutter {
@@ -29,11 +34,41 @@ namespace flutter {
 RasterCacheResult::RasterCacheResult(sk_sp<DlImage> image,
                                      const SkRect& logical_rect,
                                      const char* type,
-                                     sk_sp<const DlRTree> rtree)
+                                     sk_sp<const DlRTree> rtree,
+                                     float resolution_scale)
     : image_(std::move(image)),
       logical_rect_(logical_rect),
+      type_(type),
       flow_(type),
-      rtree_(std::move(rtree)) {}
+      rtree_(std::move(rtree)),
+      resolution_scale_(resolution_scale) {}
+
+std::unique_ptr<RasterCacheResult> RasterCacheResult::MakeDownscaled(
+    GrDirectContext* gr_context) const {
+  if (!can_downscale()) {
+    return nullptr;
+  }
+  sk_sp<SkImage> sk_image = image_ ? image_->skia_image() : nullptr;
+  if (!sk_image || (sk_image->isTextureBacked() && !gr_context)) {
+    return nullptr;
+  }
+  const SkImageInfo image_info = sk_image->imageInfo().makeWH(
+      (sk_image->width() + 1) / 2, (sk_image->height() + 1) / 2);
+  sk_sp<SkSurface> surface =
+      gr_context ? SkSurfaces::RenderTarget(gr_context, skgpu::Budgeted::kYes,
+                                            image_info)
+                 : SkSurfaces::Raster(image_info);
+  if (!surface) {
+    return nullptr;
+  }
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->drawImageRect(sk_image, SkRect::Make(image_info.bounds()),
+                        SkSamplingOptions(SkFilterMode::kLinear));
+  return std::make_unique<RasterCacheResult>(
+      DlImage::Make(surface->makeImageSnapshot()), logical_rect_, type_,
+      rtree_, resolution_scale_ / 2);
+}
 
 void RasterCacheResult::draw(DlCanvas& canvas,
                              const DlPaint* paint,
@@ -43,13 +78,25 @@ void RasterCacheResult::draw(DlCanvas& canvas,
   auto matrix = RasterCacheUtil::GetIntegralTransCTM(canvas.GetTransform());
   SkRect bounds =
       RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect_, matrix);
-  FML_DCHECK(std::abs(bounds.width() - image_->dimensions().width()) <= 1 &&
-             std::abs(bounds.height() - image_->dimensions().height()) <= 1);
+  FML_DCHECK(std::abs(bounds.width() * resolution_scale_ -
+                      image_->dimensions().width()) <= 1 &&
+             std::abs(bounds.height() * resolution_scale_ -
+                      image_->dimensions().height()) <= 1);
   canvas.TransformReset();
   flow_.Step();
+  // Demoted images are scaled back up to the device bounds of the content.
+  const bool is_downscaled = resolution_scale_ != 1.0f;
+  const DlImageSampling sampling = is_downscaled
+                                       ? DlImageSampling::kLinear
+                                       : DlImageSampling::kNearestNeighbor;
   if (!preserve_rtree || !rtree_) {
-    canvas.DrawImage(image_, SkPoint{bounds.fLeft, bounds.fTop},
-                     DlImageSampling::kNearestNeighbor, paint);
+    if (is_downscaled) {
+      canvas.DrawImageRect(image_, SkRect::Make(image_->bounds()), bounds,
+                           sampling, paint);
+    } else {
+      canvas.DrawImage(image_, SkPoint{bounds.fLeft, bounds.fTop}, sampling,
+                       paint);
+    }
   } else {
     // On some platforms RTree from overlay layers is used for unobstructed
     // platform views and hit testing. To preserve the RTree raster cache must
@@ -64,8 +111,12 @@ void RasterCacheResult::draw(DlCanvas& canvas,
       SkRect device_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
           SkRect::Make(rect), matrix);
       device_rect.offset(-rtree_bounds.fLeft, -rtree_bounds.fTop);
-      canvas.DrawImageRect(image_, device_rect, device_rect,
-                           DlImageSampling::kNearestNeighbor, paint);
+      SkRect image_rect = SkRect::MakeLTRB(
+          device_rect.fLeft * resolution_scale_,
+          device_rect.fTop * resolution_scale_,
+          device_rect.fRight * resolution_scale_,
+          device_rect.fBottom * resolution_scale_);
+      canvas.DrawImageRect(image_, image_rect, device_rect, sampling, paint);
     }
   }
 }
@@ -73,7 +124,13 @@ void RasterCacheResult::draw(DlCanvas& canvas,
 RasterCache::RasterCache(size_t access_threshold,
                          size_t display_list_cache_limit_per_frame)
     : access_threshold_(access_threshold),
-      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame) {}
+      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
+      policy_(std::make_unique<DefaultRasterCachePolicy>()) {}
+
+void RasterCache::SetPolicy(std::unique_ptr<RasterCachePolicy> policy) {
+  FML_DCHECK(policy);
+  policy_ = std::move(policy);
+}
 
 /// @note Procedure doesn't copy all closures.
 std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
@@ -122,11 +179,28 @@ bool RasterCache::UpdateCacheEntry(
     sk_sp<const DlRTree> rtree) const {
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
+  if (entry.image && entry.image->resolution_scale() != 1.0f) {
+    PromoteImage(key, entry, raster_cache_context, std::move(rtree),
+                 render_function);
+    return true;
+  }
   if (!entry.image) {
-    void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
-    entry.image = Rasterize(raster_cache_context, std::move(rtree),
-                            render_function, func);
+    if (!AdmitToCache(key, entry, raster_cache_context)) {
+      GetMetricsForKind(key.kind()).policy_rejection_count++;
+      return false;
+    }
+    const fml::TimePoint start = fml::TimePoint::Now();
+    entry.display_list = raster_cache_context.display_list;
+    entry.image = RestoreFromHostTier(key, raster_cache_context, rtree);
+    if (!entry.image) {
+      void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
+      entry.image = Rasterize(raster_cache_context, std::move(rtree),
+                              render_function, func);
+    }
     if (entry.image != nullptr) {
+      entry.rasterize_time = fml::TimePoint::Now() - start;
+      entry.last_drawn_frame = frame_count_;
+      cached_bytes_ += entry.image->image_bytes();
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
           display_list_cached_this_frame_++;
@@ -141,6 +215,306 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
+RasterCacheEntryMetrics RasterCache::GetMetrics(const Entry& entry,
+                                                size_t image_bytes) const {
+  return {
+      .accesses_since_visible = entry.accesses_since_visible,
+      .hit_count = entry.hit_count,
+      .uncached_draw_time = entry.uncached_draw_time,
+      .rasterize_time = entry.rasterize_time,
+      .frames_since_drawn =
+          entry.image ? frame_count_ - entry.last_drawn_frame : 0,
+      .image_bytes = image_bytes,
+  };
+}
+
+size_t RasterCache::EstimateImageBytes(const Context& context) {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  return static_cast<size_t>(dest_rect.width()) *
+         static_cast<size_t>(dest_rect.height()) *
+         SkColorTypeBytesPerPixel(kN32_SkColorType);
+}
+
+bool RasterCache::AdmitToCache(const RasterCacheKey& key,
+                               const Entry& entry,
+                               const Context& context) const {
+  const size_t image_bytes = EstimateImageBytes(context);
+  const RasterCacheEntryMetrics candidate = GetMetrics(entry, image_bytes);
+  if (!policy_->ShouldAdmit(candidate)) {
+    return false;
+  }
+  const size_t max_bytes = policy_->max_bytes();
+  if (max_bytes == 0 || cached_bytes_ + image_bytes <= max_bytes) {
+    return true;
+  }
+  if (image_bytes > max_bytes) {
+    return false;
+  }
+  // Make room by giving up the images that are worth less than the candidate.
+  return FreeImagesDownTo(max_bytes - image_bytes, policy_->GetValue(candidate),
+                          context.gr_context);
+}
+
+bool RasterCache::FreeImagesDownTo(size_t max_bytes,
+                                   double max_value,
+                                   GrDirectContext* gr_context) const {
+  if (cached_bytes_ <= max_bytes) {
+    return true;
+  }
+  std::vector<std::pair<double, RasterCacheKey::Map<Entry>::iterator>> victims;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    const Entry& entry = it->second;
+    if (!entry.image) {
+      continue;
+    }
+    double value =
+        policy_->GetValue(GetMetrics(entry, entry.image->image_bytes()));
+    if (value < max_value) {
+      victims.emplace_back(value, it);
+    }
+  }
+  std::sort(victims.begin(), victims.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  // Demoting an image frees about three quarters of it. Images are only
+  // demoted if demoting all of the victims would be enough, otherwise the
+  // lowest valued ones are evicted right away.
+  const size_t needed_bytes = cached_bytes_ - max_bytes;
+  size_t evictable_bytes = 0;
+  size_t demotable_bytes = 0;
+  for (const auto& [value, it] : victims) {
+    const RasterCacheResult& image = *it->second.image;
+    const size_t image_bytes = image.image_bytes();
+    evictable_bytes += image_bytes;
+    if (policy_->ShouldDemote() && image.can_downscale()) {
+      demotable_bytes += image_bytes - image_bytes / 4;
+    }
+  }
+  if (evictable_bytes < needed_bytes) {
+    return false;
+  }
+  if (demotable_bytes >= needed_bytes) {
+    for (const auto& [value, it] : victims) {
+      if (cached_bytes_ <= max_bytes) {
+        break;
+      }
+      DemoteImage(it->first, it->second, gr_context);
+    }
+  }
+  for (const auto& [value, it] : victims) {
+    if (cached_bytes_ <= max_bytes) {
+      break;
+    }
+    GetMetricsForKind(it->first.kind()).budget_eviction_count++;
+    EvictImage(it->first, it->second, gr_context);
+  }
+  return true;
+}
+
+bool RasterCache::DemoteImage(const RasterCacheKey& key,
+                              Entry& entry,
+                              GrDirectContext* gr_context) const {
+  FML_DCHECK(entry.image);
+  std::unique_ptr<RasterCacheResult> image =
+      entry.image->MakeDownscaled(gr_context);
+  if (!image) {
+    return false;
+  }
+  const size_t old_bytes = entry.image->image_bytes();
+  const size_t new_bytes = image->image_bytes();
+  RasterCacheMetrics& metrics = GetMetricsForKind(key.kind());
+  metrics.budget_demotion_count++;
+  metrics.budget_demotion_bytes += old_bytes - std::min(old_bytes, new_bytes);
+  FML_DCHECK(cached_bytes_ >= old_bytes);
+  cached_bytes_ = cached_bytes_ - old_bytes + new_bytes;
+  entry.image = std::move(image);
+  return true;
+}
+
+bool RasterCache::PromoteImage(
+    const RasterCacheKey& key,
+    Entry& entry,
+    const Context& context,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& render_function) const {
+  FML_DCHECK(entry.image);
+  const size_t old_bytes = entry.image->image_bytes();
+  FML_DCHECK(cached_bytes_ >= old_bytes);
+  // Demotion and promotion use the same budget, so a promoted image is not
+  // demoted again unless other images take up the room it needed.
+  const size_t max_bytes = policy_->max_bytes();
+  if (max_bytes != 0 &&
+      cached_bytes_ - old_bytes + EstimateImageBytes(context) > max_bytes) {
+    return false;
+  }
+  const fml::TimePoint start = fml::TimePoint::Now();
+  void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
+  std::unique_ptr<RasterCacheResult> image =
+      Rasterize(context, std::move(rtree), render_function, func);
+  if (!image) {
+    return false;
+  }
+  entry.rasterize_time = fml::TimePoint::Now() - start;
+  cached_bytes_ = cached_bytes_ - old_bytes + image->image_bytes();
+  entry.image = std::move(image);
+  GetMetricsForKind(key.kind()).budget_promotion_count++;
+  if (key.kind() == RasterCacheKeyKind::kDisplayListMetrics) {
+    display_list_cached_this_frame_++;
+  }
+  return true;
+}
+
+void RasterCache::EvictImage(const RasterCacheKey& key,
+                             Entry& entry,
+                             GrDirectContext* gr_context) const {
+  FML_DCHECK(entry.image);
+  const size_t image_bytes = entry.image->image_bytes();
+  RasterCacheMetrics& metrics = GetMetricsForKind(key.kind());
+  metrics.eviction_count++;
+  metrics.eviction_bytes += image_bytes;
+  DemoteToHostTier(key, entry, gr_context);
+  FML_DCHECK(cached_bytes_ >= image_bytes);
+  cached_bytes_ -= image_bytes;
+  entry.image.reset();
+  entry.rasterize_time = fml::TimeDelta::Zero();
+}
+
+std::unique_ptr<RasterCacheResult> RasterCache::RestoreFromHostTier(
+    const RasterCacheKey& key,
+    const Context& context,
+    sk_sp<const DlRTree> rtree) const {
+  if (!host_tier_.is_enabled() || !context.display_list) {
+    return nullptr;
+  }
+  sk_sp<SkImage> host_image =
+      host_tier_.Find(*context.display_list, key.matrix());
+  if (host_image) {
+    // The tier matches on the translation free matrix, so the stored image
+    // can still be a pixel off if the integral translation moved the
+    // rounded out device bounds.
+    auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+    SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+        context.logical_rect, matrix);
+    if (host_image->width() != dest_rect.width() ||
+        host_image->height() != dest_rect.height()) {
+      host_image = nullptr;
+    }
+  }
+  if (host_image && context.gr_context) {
+    host_image = SkImages::TextureFromImage(context.gr_context, host_image,
+                                            skgpu::Mipmapped::kNo,
+                                            skgpu::Budgeted::kYes);
+  }
+  if (!host_image) {
+    host_tier_misses_this_frame_++;
+    return nullptr;
+  }
+  host_tier_hits_this_frame_++;
+  return std::make_unique<RasterCacheResult>(
+      DlImage::Make(std::move(host_image)), context.logical_rect,
+      context.flow_type, std::move(rtree));
+}
+
+void RasterCache::DemoteToHostTier(const RasterCacheKey& key,
+                                   const Entry& entry,
+                                   GrDirectContext* gr_context) const {
+  // Demoted images cannot be restored for an entry at full resolution.
+  if (!host_tier_.is_enabled() || !entry.display_list || !entry.image ||
+      entry.image->resolution_scale() != 1.0f) {
+    return;
+  }
+  if (host_tier_.Contains(*entry.display_list, key.matrix())) {
+    return;
+  }
+  sk_sp<DlImage> image = entry.image->image();
+  sk_sp<SkImage> sk_image = image ? image->skia_image() : nullptr;
+  if (!sk_image ||
+      sk_image->imageInfo().computeMinByteSize() > host_tier_.max_bytes()) {
+    return;
+  }
+  if (sk_image->isTextureBacked()) {
+    // The texture is read back asynchronously so that the raster thread
+    // does not wait for the GPU. The pixels are stored in the tier by
+    // |StoreFinishedHostTierReadbacks| in a later frame. Each readback
+    // still costs GPU bandwidth, so only a few are issued per frame. The
+    // rest are simply dropped, as they are without the host tier.
+    if (!gr_context ||
+        host_tier_readbacks_this_frame_ >= kMaxHostTierReadbacksPerFrame) {
+      picture_metrics_.host_tier_skipped_readback_count++;
+      return;
+    }
+    host_tier_readbacks_this_frame_++;
+    auto readback = std::make_shared<HostTierReadback>();
+    readback->display_list = entry.display_list;
+    readback->matrix = key.matrix();
+    readback->info = sk_image->imageInfo();
+    // The callback owns a reference of its own, as it can run after the
+    // cache has dropped the readback.
+    sk_image->asyncRescaleAndReadPixels(
+        readback->info, sk_image->bounds(), SkImage::RescaleGamma::kSrc,
+        SkImage::RescaleMode::kNearest, &OnHostTierReadbackFinished,
+        new std::shared_ptr<HostTierReadback>(readback));
+    pending_host_tier_readbacks_.push_back(std::move(readback));
+    return;
+  }
+  if (host_tier_.Put(entry.display_list, key.matrix(), sk_image)) {
+    picture_metrics_.host_tier_demotion_count++;
+    picture_metrics_.host_tier_demotion_bytes +=
+        sk_image->imageInfo().computeMinByteSize();
+  }
+}
+
+void RasterCache::OnHostTierReadbackFinished(
+    void* context,
+    std::unique_ptr<const SkImage::AsyncReadResult> result) {
+  std::unique_ptr<std::shared_ptr<HostTierReadback>> readback_ref(
+      static_cast<std::shared_ptr<HostTierReadback>*>(context));
+  HostTierReadback& readback = **readback_ref;
+  readback.finished = true;
+  // A null result means that the readback failed, for example because the
+  // context was abandoned.
+  if (!result || result->count() != 1) {
+    return;
+  }
+  readback.row_bytes = result->rowBytes(0);
+  readback.pixels = SkData::MakeWithCopy(
+      result->data(0), readback.info.computeByteSize(readback.row_bytes));
+}
+
+void RasterCache::StoreFinishedHostTierReadbacks(GrDirectContext* gr_context) {
+  if (pending_host_tier_readbacks_.empty()) {
+    return;
+  }
+  if (gr_context) {
+    // Runs the callbacks of the readbacks that the GPU has finished, without
+    // waiting for the others.
+    gr_context->checkAsyncWorkCompletion();
+  }
+  auto finished = std::partition(
+      pending_host_tier_readbacks_.begin(), pending_host_tier_readbacks_.end(),
+      [](const std::shared_ptr<HostTierReadback>& readback) {
+        return !readback->finished;
+      });
+  for (auto it = finished; it != pending_host_tier_readbacks_.end(); ++it) {
+    HostTierReadback& readback = **it;
+    if (!readback.pixels) {
+      continue;
+    }
+    sk_sp<SkImage> host_image = SkImages::RasterFromData(
+        readback.info, std::move(readback.pixels), readback.row_bytes);
+    if (host_image && host_tier_.Put(std::move(readback.display_list),
+                                     readback.matrix, host_image)) {
+      picture_metrics_.host_tier_demotion_count++;
+      picture_metrics_.host_tier_demotion_bytes +=
+          host_image->imageInfo().computeMinByteSize();
+    }
+  }
+  pending_host_tier_readbacks_.erase(finished,
+                                     pending_host_tier_readbacks_.end());
+}
+
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
                                              bool visible) const {
@@ -164,6 +538,33 @@ int RasterCache::GetAccessCount(const RasterCacheKeyID& id,
   return -1;
 }
 
+void RasterCache::RecordUncachedDrawTime(const RasterCacheKeyID& id,
+                                         const SkMatrix& matrix,
+                                         fml::TimeDelta draw_time) const {
+  auto it = cache_.find(RasterCacheKey(id, matrix));
+  if (it == cache_.end()) {
+    return;
+  }
+  Entry& entry = it->second;
+  if (entry.uncached_draw_time == fml::TimeDelta::Zero()) {
+    entry.uncached_draw_time = draw_time;
+  } else {
+    // Smooth out the frames in which the raster thread was preempted.
+    entry.uncached_draw_time = (entry.uncached_draw_time * 3 + draw_time) / 4;
+  }
+}
+
+std::optional<RasterCacheEntryMetrics> RasterCache::GetEntryMetrics(
+    const RasterCacheKeyID& id,
+    const SkMatrix& matrix) const {
+  auto it = cache_.find(RasterCacheKey(id, matrix));
+  if (it == cache_.end()) {
+    return std::nullopt;
+  }
+  const Entry& entry = it->second;
+  return GetMetrics(entry, entry.image ? entry.image->image_bytes() : 0);
+}
+
 bool RasterCache::HasEntry(const RasterCacheKeyID& id,
                            const SkMatrix& matrix) const {
   RasterCacheKey key = RasterCacheKey(id, matrix);
@@ -186,6 +587,8 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
   if (entry.image) {
     entry.image->draw(canvas, paint, preserve_rtree);
+    entry.hit_count++;
+    entry.last_drawn_frame = frame_count_;
     return true;
   }
 
@@ -193,7 +596,11 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 }
 
 void RasterCache::BeginFrame() {
+  frame_count_++;
   display_list_cached_this_frame_ = 0;
+  host_tier_hits_this_frame_ = 0;
+  host_tier_misses_this_frame_ = 0;
+  host_tier_readbacks_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -209,9 +616,16 @@ void RasterCache::UpdateMetrics() {
     }
     entry.encountered_this_frame = false;
   }
+  // Only display list entries use the host memory tier.
+  picture_metrics_.host_tier_hit_count = host_tier_hits_this_frame_;
+  picture_metrics_.host_tier_miss_count = host_tier_misses_this_frame_;
+  picture_metrics_.host_tier_count = host_tier_.count();
+  picture_metrics_.host_tier_bytes = host_tier_.bytes();
 }
 
-void RasterCache::EvictUnusedCacheEntries() {
+void RasterCache::EvictUnusedCacheEntries(GrDirectContext* gr_context) {
+  StoreFinishedHostTierReadbacks(gr_context);
+
   std::vector<RasterCacheKey::Map<Entry>::iterator> dead;
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
@@ -223,12 +637,16 @@ void RasterCache::EvictUnusedCacheEntries() {
 
   for (auto it : dead) {
     if (it->second.image) {
-      RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.eviction_count++;
-      metrics.eviction_bytes += it->second.image->image_bytes();
+      EvictImage(it->first, it->second, gr_context);
     }
     cache_.erase(it);
   }
+
+  const size_t max_bytes = policy_->max_bytes();
+  if (max_bytes > 0) {
+    FreeImagesDownTo(max_bytes, std::numeric_limits<double>::infinity(),
+                     gr_context);
+  }
 }
 
 void RasterCache::EndFrame() {
@@ -238,6 +656,9 @@ void RasterCache::EndFrame() {
 
 void RasterCache::Clear() {
   cache_.clear();
+  cached_bytes_ = 0;
+  host_tier_.Clear();
+  pending_host_tier_readbacks_.clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -269,12 +690,16 @@ size_t RasterCache::GetPictureCachedEntriesCount() const {
 void RasterCache::TraceStatsToTimeline() const {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER(
-      "flutter",                                                           //
-      "RasterCache", reinterpret_cast<int64_t>(this),                      //
-      "LayerCount", layer_metrics_.total_count(),                          //
-      "LayerMBytes", layer_metrics_.total_bytes() / kMegaByteSizeInBytes,  //
-      "PictureCount", picture_metrics_.total_count(),                      //
-      "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes);
+      "flutter",                                                             //
+      "RasterCache", reinterpret_cast<int64_t>(this),                        //
+      "LayerCount", layer_metrics_.total_count(),                            //
+      "LayerMBytes", layer_metrics_.total_bytes() / kMegaByteSizeInBytes,    //
+      "PictureCount", picture_metrics_.total_count(),                        //
+      "PictureMBytes",                                                       //
+      picture_metrics_.total_bytes() / kMegaByteSizeInBytes,                 //
+      "HostTierCount", picture_metrics_.host_tier_count,                     //
+      "HostTierMBytes",                                                      //
+      picture_metrics_.host_tier_bytes / kMegaByteSizeInBytes);
 
 #endif  // !FLUTTER_RELEASE
 }
@@ -301,7 +726,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
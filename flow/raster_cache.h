@@ -8,14 +8,21 @@
 #if !SLIMPELLER
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/display_list/dl_canvas.h"
+#include "flutter/flow/raster_cache_host_tier.h"
 #include "flutter/flow/raster_cache_key.h"
+#include "flutter/flow/raster_cache_policy.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
 
@@ -31,10 +38,20 @@ class RasterCacheResult {
   RasterCacheResult(sk_sp<DlImage> image,
                     const SkRect& logical_rect,
                     const char* type,
-                    sk_sp<const DlRTree> rtree = nullptr);
+                    sk_sp<const DlRTree> rtree = nullptr,
+                    float resolution_scale = 1.0f);
 
   virtual ~RasterCacheResult() = default;
 
+  /**
+   * @brief Create a copy of this result at half of its resolution, or return
+   * nullptr if it is already at |kMinResolutionScale| or cannot be copied.
+   * |gr_context| is the context that owns the image, or nullptr for raster
+   * images.
+   */
+  std::unique_ptr<RasterCacheResult> MakeDownscaled(
+      GrDirectContext* gr_context) const;
+
   virtual void draw(DlCanvas& canvas,
                     const DlPaint* paint,
                     bool preserve_rtree) const;
@@ -47,11 +64,28 @@ class RasterCacheResult {
     return image_ ? image_->GetApproximateByteSize() : 0;
   };
 
+  const sk_sp<DlImage>& image() const { return image_; }
+
+  /**
+   * The resolution of the image relative to the device bounds of the cached
+   * content. Images that were demoted to stay within a byte budget are drawn
+   * scaled up by the inverse of this.
+   */
+  float resolution_scale() const { return resolution_scale_; }
+
+  bool can_downscale() const {
+    return resolution_scale_ / 2 >= kMinResolutionScale;
+  }
+
+  static constexpr float kMinResolutionScale = 0.25f;
+
  private:
   sk_sp<DlImage> image_;
   SkRect logical_rect_;
+  const char* type_;
   fml::tracing::TraceFlow flow_;
   sk_sp<const DlRTree> rtree_;
+  float resolution_scale_;
 };
 
 class Layer;
@@ -80,6 +114,80 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of candidates that the |RasterCachePolicy| declined to create
+   * images for in this frame.
+   */
+  size_t policy_rejection_count = 0;
+
+  /**
+   * The number of images that were demoted to a lower resolution in this
+   * frame to stay within the byte budget of the |RasterCachePolicy|.
+   */
+  size_t budget_demotion_count = 0;
+
+  /**
+   * The number of bytes freed by demoting images to lower resolutions in
+   * this frame.
+   */
+  size_t budget_demotion_bytes = 0;
+
+  /**
+   * The number of demoted images that were rasterized at full resolution
+   * again in this frame, because the byte budget had room for them.
+   */
+  size_t budget_promotion_count = 0;
+
+  /**
+   * The number of images evicted in this frame to stay within the byte
+   * budget of the |RasterCachePolicy|. These are also counted in
+   * |eviction_count|.
+   */
+  size_t budget_eviction_count = 0;
+
+  /**
+   * The number of evicted images whose readback into the host memory tier
+   * finished in this frame.
+   */
+  size_t host_tier_demotion_count = 0;
+
+  /**
+   * The size of all of the images read back into the host memory tier in
+   * this frame.
+   */
+  size_t host_tier_demotion_bytes = 0;
+
+  /**
+   * The number of evicted images that were not read back into the host
+   * memory tier in this frame because the per frame readback limit was
+   * reached.
+   */
+  size_t host_tier_skipped_readback_count = 0;
+
+  /**
+   * The number of cache images restored from the host memory tier instead of
+   * being rasterized in this frame.
+   */
+  size_t host_tier_hit_count = 0;
+
+  /**
+   * The number of cache images that were not found in the host memory tier
+   * and had to be rasterized in this frame.
+   */
+  size_t host_tier_miss_count = 0;
+
+  /**
+   * The number of entries held by the host memory tier at the end of this
+   * frame.
+   */
+  size_t host_tier_count = 0;
+
+  /**
+   * The size of all of the entries held by the host memory tier at the end
+   * of this frame.
+   */
+  size_t host_tier_bytes = 0;
+
   /**
    * The total cache entries that had images during this frame.
    */
@@ -106,12 +214,27 @@ struct RasterCacheMetrics {
  *         encountered by the current frame.
  * - Paint stage
  *   - RasterCache::EvictUnusedCacheEntries
- *       Evict cached images that are no longer used.
+ *       Store the readbacks of earlier evictions that the GPU has finished
+ *       in the host memory tier. Evict cached images that are no longer
+ *       used. Evicted display list images are read back into the host
+ *       memory tier if it is enabled, up to |kMaxHostTierReadbacksPerFrame|
+ *       GPU images per frame.
+ *       If the remaining images exceed the byte budget of the
+ *       |RasterCachePolicy|, the ones it values least are demoted to lower
+ *       resolutions or evicted until they fit.
  *   - LayerTree::TryToPrepareRasterCache
- *       Create cache image for each cache entry if it does not exist.
+ *       Create cache image for each cache entry if it does not exist and the
+ *       |RasterCachePolicy| admits it, either by uploading a matching image
+ *       from the host memory tier or by rasterizing it. Images of entries
+ *       that the policy values less may be evicted to stay within its byte
+ *       budget. Demoted images are rasterized at full resolution again if
+ *       the budget has room for them.
  *   - LayerTree::Paint - for each layer in the tree:
  *       If layers or display lists are cached as cached images, the method
  *       `RasterCache::Draw` will be used to draw those cache images.
+ *       If the policy uses them, display lists that are drawn without the
+ *       cache report the time it took through
+ *       `RasterCache::RecordUncachedDrawTime`.
  *   - RasterCache::EndFrame:
  *       Computes used counts and memory then reports cache metrics.
  */
@@ -123,6 +246,9 @@ class RasterCache {
     const SkMatrix& matrix;
     const SkRect& logical_rect;
     const char* flow_type;
+    // The display list being cached, if any. Entries that know their display
+    // list can be demoted to and restored from the host memory tier.
+    sk_sp<const DisplayList> display_list = nullptr;
   };
   struct CacheInfo {
     const size_t accesses_since_visible;
@@ -162,12 +288,86 @@ class RasterCache {
 
   void BeginFrame();
 
-  void EvictUnusedCacheEntries();
+  /**
+   * @brief Evict the entries that were not encountered in this frame, then
+   * free images down to the byte budget of the policy, if it has one.
+   *
+   * If the host memory tier is enabled, the images of evicted display list
+   * entries are read back into it first. |gr_context| is the context that
+   * owns the cached textures, or nullptr for raster images.
+   */
+  void EvictUnusedCacheEntries(GrDirectContext* gr_context = nullptr);
 
   void EndFrame();
 
   void Clear();
 
+  /**
+   * @brief Set the byte limit of the host memory tier that keeps evicted
+   * display list images for reuse by equal display lists. 0, the default,
+   * disables the tier.
+   */
+  void SetHostTierMaxBytes(size_t max_bytes) {
+    host_tier_.set_max_bytes(max_bytes);
+  }
+
+  const RasterCacheHostTier& host_tier() const { return host_tier_; }
+
+  /**
+   * The maximum number of evicted GPU images that are read back into the
+   * host memory tier per frame. The readbacks are asynchronous, but each
+   * one still adds a GPU to CPU transfer to the frame's GPU work.
+   */
+  static constexpr size_t kMaxHostTierReadbacksPerFrame = 2;
+
+  /**
+   * @brief Replace the policy that decides which candidates get images and
+   * which images are evicted to stay within a byte budget. The default is a
+   * |DefaultRasterCachePolicy|. Images that are already cached are kept
+   * until the next admission needs room for another one.
+   */
+  void SetPolicy(std::unique_ptr<RasterCachePolicy> policy);
+
+  const RasterCachePolicy& policy() const { return *policy_; }
+
+  /**
+   * @brief Forward the byte limit of the GPU resource cache to the policy,
+   * which may derive its byte budget from it.
+   */
+  void SetResourceCacheMaxBytes(size_t max_bytes) {
+    policy_->OnResourceCacheLimitChanged(max_bytes);
+  }
+
+  /**
+   * @brief The size of all of the images currently in the cache.
+   */
+  size_t cached_bytes() const { return cached_bytes_; }
+
+  /**
+   * @brief Whether the policy uses the times reported through
+   * |RecordUncachedDrawTime|, so that they are worth measuring.
+   */
+  bool ShouldRecordUncachedDrawTime() const {
+    return policy_->UsesUncachedDrawTime();
+  }
+
+  /**
+   * @brief Record how long it took to draw the content of the entry without
+   * the cache, so that the policy can weigh its cost. Does nothing if no
+   * such entry exists.
+   */
+  void RecordUncachedDrawTime(const RasterCacheKeyID& id,
+                              const SkMatrix& matrix,
+                              fml::TimeDelta draw_time) const;
+
+  /**
+   * @brief Return the measurements of the given entry, or std::nullopt if no
+   * such entry exists.
+   */
+  std::optional<RasterCacheEntryMetrics> GetEntryMetrics(
+      const RasterCacheKeyID& id,
+      const SkMatrix& matrix) const;
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -251,19 +451,103 @@ class RasterCache {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    size_t hit_count = 0;
+    fml::TimeDelta uncached_draw_time;
+    fml::TimeDelta rasterize_time;
+    size_t last_drawn_frame = 0;
     std::unique_ptr<RasterCacheResult> image;
+    sk_sp<const DisplayList> display_list;
   };
 
+  RasterCacheEntryMetrics GetMetrics(const Entry& entry,
+                                     size_t image_bytes) const;
+
+  // The size of the full resolution image that |Rasterize| would create.
+  static size_t EstimateImageBytes(const Context& context);
+
+  // Asks the policy whether an image may be created for the entry with the
+  // given key, and evicts images it values less if that is needed to stay
+  // within its byte budget.
+  bool AdmitToCache(const RasterCacheKey& key,
+                    const Entry& entry,
+                    const Context& context) const;
+
+  // Demotes or evicts the images of the entries that the policy values less
+  // than |max_value|, lowest first, until all images fit into |max_bytes|.
+  // Nothing is given up unless that makes them fit. Returns whether they fit.
+  bool FreeImagesDownTo(size_t max_bytes,
+                        double max_value,
+                        GrDirectContext* gr_context) const;
+
+  // Replaces the image of the entry with one at half of its resolution.
+  // Returns false if the image cannot be downscaled any further.
+  bool DemoteImage(const RasterCacheKey& key,
+                   Entry& entry,
+                   GrDirectContext* gr_context) const;
+
+  // Replaces the demoted image of the entry with one rasterized at full
+  // resolution if that fits into the byte budget. Returns whether it did.
+  bool PromoteImage(
+      const RasterCacheKey& key,
+      Entry& entry,
+      const Context& context,
+      sk_sp<const DlRTree> rtree,
+      const std::function<void(DlCanvas*)>& render_function) const;
+
+  void EvictImage(const RasterCacheKey& key,
+                  Entry& entry,
+                  GrDirectContext* gr_context) const;
+
+  std::unique_ptr<RasterCacheResult> RestoreFromHostTier(
+      const RasterCacheKey& key,
+      const Context& context,
+      sk_sp<const DlRTree> rtree) const;
+
+  void DemoteToHostTier(const RasterCacheKey& key,
+                        const Entry& entry,
+                        GrDirectContext* gr_context) const;
+
+  // An evicted GPU image that is being read back into the host memory tier.
+  // Skia fills in |pixels| once the GPU is done with the image, which is
+  // usually a frame or two after the readback was issued.
+  struct HostTierReadback {
+    sk_sp<const DisplayList> display_list;
+    SkMatrix matrix;
+    SkImageInfo info;
+    bool finished = false;
+    sk_sp<SkData> pixels;
+    size_t row_bytes = 0;
+  };
+
+  static void OnHostTierReadbackFinished(
+      void* context,
+      std::unique_ptr<const SkImage::AsyncReadResult> result);
+
+  // Stores the pixels of the readbacks that finished in the host memory
+  // tier.
+  void StoreFinishedHostTierReadbacks(GrDirectContext* gr_context);
+
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
+  // The number of frames begun, which dates the last draw of each entry.
+  size_t frame_count_ = 0;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  mutable size_t host_tier_hits_this_frame_ = 0;
+  mutable size_t host_tier_misses_this_frame_ = 0;
+  mutable size_t host_tier_readbacks_this_frame_ = 0;
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
+  // The size of all of the images in |cache_|.
+  mutable size_t cached_bytes_ = 0;
+  std::unique_ptr<RasterCachePolicy> policy_;
+  mutable RasterCacheHostTier host_tier_;
+  mutable std::vector<std::shared_ptr<HostTierReadback>>
+      pending_host_tier_readbacks_;
   bool checkerboard_images_ = false;
 
   void TraceStatsToTimeline() const;
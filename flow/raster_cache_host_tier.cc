@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !SLIMPELLER
+
+#include "flutter/flow/raster_cache_host_tier.h"
+
+#include <iterator>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+RasterCacheHostTier::RasterCacheHostTier(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+RasterCacheHostTier::~RasterCacheHostTier() = default;
+
+void RasterCacheHostTier::set_max_bytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  EvictToFit(max_bytes_);
+}
+
+size_t RasterCacheHostTier::ContentHash(const DisplayList& display_list) {
+  // This only needs to separate display lists that are obviously different.
+  // Candidates that share a hash are compared with DisplayList::Equals.
+  const SkRect& bounds = display_list.bounds();
+  return fml::HashCombine(display_list.bytes(true),
+                          display_list.op_count(true),
+                          display_list.total_depth(), bounds.fLeft,
+                          bounds.fTop, bounds.fRight, bounds.fBottom);
+}
+
+RasterCacheHostTier::EntryIndex::const_iterator RasterCacheHostTier::Lookup(
+    size_t content_hash,
+    const DisplayList& display_list,
+    const SkMatrix& matrix) const {
+  auto [begin, end] = index_.equal_range(content_hash);
+  for (auto it = begin; it != end; ++it) {
+    const Entry& entry = *it->second;
+    if (entry.matrix == matrix && entry.display_list->Equals(display_list)) {
+      return it;
+    }
+  }
+  return index_.cend();
+}
+
+bool RasterCacheHostTier::Contains(const DisplayList& display_list,
+                                   const SkMatrix& matrix) const {
+  if (!is_enabled()) {
+    return false;
+  }
+  return Lookup(ContentHash(display_list), display_list, matrix) !=
+         index_.cend();
+}
+
+bool RasterCacheHostTier::Put(sk_sp<const DisplayList> display_list,
+                              const SkMatrix& matrix,
+                              sk_sp<SkImage> host_image) {
+  if (!is_enabled() || !display_list || !host_image) {
+    return false;
+  }
+  FML_DCHECK(!host_image->isTextureBacked());
+
+  size_t content_hash = ContentHash(*display_list);
+  if (Lookup(content_hash, *display_list, matrix) != index_.cend()) {
+    return true;
+  }
+
+  size_t entry_bytes =
+      host_image->imageInfo().computeMinByteSize() + display_list->bytes(true);
+  if (entry_bytes > max_bytes_) {
+    return false;
+  }
+  EvictToFit(max_bytes_ - entry_bytes);
+
+  entries_.push_front(Entry{
+      .content_hash = content_hash,
+      .display_list = std::move(display_list),
+      .matrix = matrix,
+      .image = std::move(host_image),
+      .bytes = entry_bytes,
+  });
+  index_.emplace(content_hash, entries_.begin());
+  bytes_ += entry_bytes;
+  return true;
+}
+
+sk_sp<SkImage> RasterCacheHostTier::Find(const DisplayList& display_list,
+                                         const SkMatrix& matrix) {
+  if (!is_enabled()) {
+    return nullptr;
+  }
+  auto found = Lookup(ContentHash(display_list), display_list, matrix);
+  if (found == index_.cend()) {
+    return nullptr;
+  }
+  EntryList::iterator entry = found->second;
+  entries_.splice(entries_.begin(), entries_, entry);
+  return entry->image;
+}
+
+void RasterCacheHostTier::Clear() {
+  entries_.clear();
+  index_.clear();
+  bytes_ = 0;
+}
+
+void RasterCacheHostTier::EvictToFit(size_t max_bytes) {
+  while (bytes_ > max_bytes && !entries_.empty()) {
+    EntryList::iterator victim = std::prev(entries_.end());
+    auto [begin, end] = index_.equal_range(victim->content_hash);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second == victim) {
+        index_.erase(it);
+        break;
+      }
+    }
+    bytes_ -= victim->bytes;
+    entries_.erase(victim);
+  }
+}
+
+}  // namespace flutter
+
+#endif  //  !SLIMPELLER
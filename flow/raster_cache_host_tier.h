@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_HOST_TIER_H_
+#define FLUTTER_FLOW_RASTER_CACHE_HOST_TIER_H_
+
+#if !SLIMPELLER
+
+#include <list>
+#include <unordered_map>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+
+namespace flutter {
+
+/**
+ * A host memory store for display list raster cache images that have been
+ * evicted from the GPU resident |RasterCache|.
+ *
+ * Entries in the |RasterCache| are keyed by the unique id of a display list,
+ * so a screen that is rebuilt when the app navigates back to it produces new
+ * keys and has to be rasterized again even though its content is unchanged.
+ * This tier is instead keyed by the display list content and the cache
+ * matrix. Images evicted from the GPU cache are read back and kept here, up
+ * to a byte limit, and a later cache miss for an equal display list uploads
+ * the stored pixels instead of re-rasterizing.
+ *
+ * Lookups first compare a cheap summary hash of the display list and then
+ * confirm the match with |DisplayList::Equals|, so a stored image is never
+ * used for different content. Entries hold a reference to the display list
+ * they were rendered from, which is counted against the byte limit.
+ *
+ * The tier is disabled when its byte limit is 0, which is the default.
+ */
+class RasterCacheHostTier {
+ public:
+  explicit RasterCacheHostTier(size_t max_bytes = 0);
+
+  ~RasterCacheHostTier();
+
+  bool is_enabled() const { return max_bytes_ > 0; }
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * Changes the byte limit, evicting the least recently used entries if the
+   * tier is now over budget. A limit of 0 disables the tier and drops all
+   * of its entries.
+   */
+  void set_max_bytes(size_t max_bytes);
+
+  /**
+   * @brief Whether an image for |display_list| rendered with |matrix| is
+   * already stored, in which case there is no need to read it back again.
+   */
+  bool Contains(const DisplayList& display_list, const SkMatrix& matrix) const;
+
+  /**
+   * @brief Stores |host_image|, which must not be texture backed, as the
+   * rendering of |display_list| with |matrix|. Entries are evicted in least
+   * recently used order to make room.
+   *
+   * @return false if the tier is disabled or the entry alone exceeds the
+   * byte limit.
+   */
+  bool Put(sk_sp<const DisplayList> display_list,
+           const SkMatrix& matrix,
+           sk_sp<SkImage> host_image);
+
+  /**
+   * @brief Returns the stored image for |display_list| rendered with
+   * |matrix| and marks it as most recently used, or nullptr if there is none.
+   *
+   * The entry is kept so that the image does not need to be read back again
+   * if it is evicted from the GPU cache a second time.
+   */
+  sk_sp<SkImage> Find(const DisplayList& display_list, const SkMatrix& matrix);
+
+  void Clear();
+
+  size_t count() const { return entries_.size(); }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  struct Entry {
+    size_t content_hash;
+    sk_sp<const DisplayList> display_list;
+    SkMatrix matrix;
+    sk_sp<SkImage> image;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+  using EntryIndex = std::unordered_multimap<size_t, EntryList::iterator>;
+
+  static size_t ContentHash(const DisplayList& display_list);
+
+  EntryIndex::const_iterator Lookup(size_t content_hash,
+                                    const DisplayList& display_list,
+                                    const SkMatrix& matrix) const;
+
+  void EvictToFit(size_t max_bytes);
+
+  size_t max_bytes_;
+  size_t bytes_ = 0;
+  // Most recently used entries are at the front.
+  EntryList entries_;
+  EntryIndex index_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheHostTier);
+};
+
+}  // namespace flutter
+
+#endif  //  !SLIMPELLER
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_HOST_TIER_H_
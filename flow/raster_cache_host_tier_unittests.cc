@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_host_tier.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<SkImage> MakeHostImage(int width, int height) {
+  auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(width, height));
+  return surface->makeImageSnapshot();
+}
+
+sk_sp<DisplayList> MakeDisplayList(SkScalar x) {
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.DrawRect(SkRect::MakeXYWH(x, 10, 80, 80), DlPaint(DlColor::kRed()));
+  return builder.Build();
+}
+
+size_t EntryBytes(const sk_sp<SkImage>& image, const DisplayList& dl) {
+  return image->imageInfo().computeMinByteSize() + dl.bytes(true);
+}
+
+}  // namespace
+
+TEST(RasterCacheHostTier, DisabledByDefault) {
+  RasterCacheHostTier tier;
+  ASSERT_FALSE(tier.is_enabled());
+
+  auto display_list = GetSampleDisplayList();
+  ASSERT_FALSE(tier.Put(display_list, SkMatrix::I(), MakeHostImage(10, 10)));
+  ASSERT_EQ(tier.Find(*display_list, SkMatrix::I()), nullptr);
+  ASSERT_EQ(tier.count(), 0u);
+  ASSERT_EQ(tier.bytes(), 0u);
+}
+
+TEST(RasterCacheHostTier, MatchesEqualDisplayListContent) {
+  RasterCacheHostTier tier(1024 * 1024);
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+  ASSERT_NE(display_list_1->unique_id(), display_list_2->unique_id());
+
+  auto image = MakeHostImage(10, 10);
+  ASSERT_TRUE(tier.Put(display_list_1, SkMatrix::I(), image));
+  ASSERT_TRUE(tier.Contains(*display_list_2, SkMatrix::I()));
+  ASSERT_EQ(tier.Find(*display_list_2, SkMatrix::I()), image);
+
+  // Different content or a different matrix never match.
+  ASSERT_EQ(tier.Find(*MakeDisplayList(20), SkMatrix::I()), nullptr);
+  ASSERT_EQ(tier.Find(*display_list_2, SkMatrix::Scale(2, 2)), nullptr);
+
+  // Storing the same content again does not add an entry.
+  ASSERT_TRUE(tier.Put(display_list_2, SkMatrix::I(), MakeHostImage(10, 10)));
+  ASSERT_EQ(tier.count(), 1u);
+  ASSERT_EQ(tier.bytes(), EntryBytes(image, *display_list_1));
+}
+
+TEST(RasterCacheHostTier, EvictsLeastRecentlyUsedToFitByteLimit) {
+  auto display_list_1 = MakeDisplayList(10);
+  auto display_list_2 = MakeDisplayList(20);
+  auto display_list_3 = MakeDisplayList(30);
+  auto image = MakeHostImage(10, 10);
+  size_t entry_bytes = EntryBytes(image, *display_list_1);
+
+  RasterCacheHostTier tier(entry_bytes * 2);
+  ASSERT_TRUE(tier.Put(display_list_1, SkMatrix::I(), image));
+  ASSERT_TRUE(tier.Put(display_list_2, SkMatrix::I(), image));
+  ASSERT_EQ(tier.count(), 2u);
+
+  // Touching the first entry makes the second one the eviction candidate.
+  ASSERT_NE(tier.Find(*display_list_1, SkMatrix::I()), nullptr);
+  ASSERT_TRUE(tier.Put(display_list_3, SkMatrix::I(), image));
+  ASSERT_EQ(tier.count(), 2u);
+  ASSERT_LE(tier.bytes(), tier.max_bytes());
+  ASSERT_TRUE(tier.Contains(*display_list_1, SkMatrix::I()));
+  ASSERT_FALSE(tier.Contains(*display_list_2, SkMatrix::I()));
+  ASSERT_TRUE(tier.Contains(*display_list_3, SkMatrix::I()));
+
+  // An entry larger than the whole tier is rejected without evicting.
+  ASSERT_FALSE(tier.Put(display_list_2, SkMatrix::I(), MakeHostImage(64, 64)));
+  ASSERT_EQ(tier.count(), 2u);
+
+  // Shrinking the limit evicts down to the new budget.
+  tier.set_max_bytes(entry_bytes);
+  ASSERT_EQ(tier.count(), 1u);
+  ASSERT_TRUE(tier.Contains(*display_list_3, SkMatrix::I()));
+
+  tier.set_max_bytes(0);
+  ASSERT_FALSE(tier.is_enabled());
+  ASSERT_EQ(tier.count(), 0u);
+  ASSERT_EQ(tier.bytes(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
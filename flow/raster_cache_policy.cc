@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !SLIMPELLER
+
+#include "flutter/flow/raster_cache_policy.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flutter {
+
+CostAwareRasterCachePolicy::CostAwareRasterCachePolicy(
+    size_t max_bytes,
+    fml::TimeDelta default_uncached_draw_time)
+    : max_bytes_(max_bytes),
+      default_uncached_draw_time_(default_uncached_draw_time) {}
+
+bool CostAwareRasterCachePolicy::ShouldAdmit(
+    const RasterCacheEntryMetrics& candidate) const {
+  return max_bytes_ == 0 || candidate.image_bytes <= max_bytes_;
+}
+
+double CostAwareRasterCachePolicy::GetValue(
+    const RasterCacheEntryMetrics& entry) const {
+  const fml::TimeDelta draw_time =
+      entry.uncached_draw_time == fml::TimeDelta::Zero()
+          ? default_uncached_draw_time_
+          : entry.uncached_draw_time;
+  // The reuse weight grows slowly so that entries that have been drawn from
+  // the cache for a long time can still be replaced by much costlier ones.
+  const double reuse_weight = std::log2(2.0 + entry.hit_count);
+  return draw_time.ToMicrosecondsF() * reuse_weight /
+         std::max<size_t>(entry.image_bytes, 1);
+}
+
+LruRasterCachePolicy::LruRasterCachePolicy(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+bool LruRasterCachePolicy::ShouldAdmit(
+    const RasterCacheEntryMetrics& candidate) const {
+  return max_bytes_ == 0 || candidate.image_bytes <= max_bytes_;
+}
+
+double LruRasterCachePolicy::GetValue(
+    const RasterCacheEntryMetrics& entry) const {
+  return 1.0 / (1.0 + entry.frames_since_drawn);
+}
+
+void LruRasterCachePolicy::OnResourceCacheLimitChanged(size_t max_bytes) {
+  max_bytes_ = max_bytes / kResourceCacheShareDivisor;
+}
+
+}  // namespace flutter
+
+#endif  //  !SLIMPELLER
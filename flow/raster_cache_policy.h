@@ -0,0 +1,222 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_POLICY_H_
+#define FLUTTER_FLOW_RASTER_CACHE_POLICY_H_
+
+#if !SLIMPELLER
+
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/**
+ * Measurements of a single |RasterCache| entry. They are kept for as long as
+ * the entry is encountered in every frame, whether or not it has an image.
+ */
+struct RasterCacheEntryMetrics {
+  /**
+   * The number of frames the entry has been encountered in since it was
+   * first visible.
+   */
+  size_t accesses_since_visible = 0;
+
+  /**
+   * The number of times the cached image of the entry has been drawn.
+   */
+  size_t hit_count = 0;
+
+  /**
+   * A moving average of the raster thread time spent drawing the content of
+   * the entry without the cache, or zero if it has not been measured.
+   */
+  fml::TimeDelta uncached_draw_time;
+
+  /**
+   * The raster thread time spent creating the cached image of the entry, or
+   * zero if it has none.
+   */
+  fml::TimeDelta rasterize_time;
+
+  /**
+   * The number of frames since the cached image of the entry was last drawn,
+   * or since it was created if it has not been drawn yet. Zero for an entry
+   * that is a candidate for admission.
+   */
+  size_t frames_since_drawn = 0;
+
+  /**
+   * The size of the cached image of the entry. For an entry that is a
+   * candidate for admission, this is the estimated size of the image that
+   * would be created.
+   */
+  size_t image_bytes = 0;
+};
+
+/**
+ * Decides which entries a |RasterCache| creates images for, and which images
+ * it gives up first when it runs out of its byte budget.
+ *
+ * The access threshold and the complexity heuristics of the cache items still
+ * select the candidates. The policy is consulted for each candidate right
+ * before its image would be created.
+ */
+class RasterCachePolicy {
+ public:
+  virtual ~RasterCachePolicy() = default;
+
+  /**
+   * @brief Whether creating an image for |candidate| is worth its cost,
+   * regardless of the other entries in the cache.
+   */
+  virtual bool ShouldAdmit(const RasterCacheEntryMetrics& candidate) const = 0;
+
+  /**
+   * @brief The value of keeping the image of |entry|. When a candidate does
+   * not fit into the byte budget, images of entries with a lower value than
+   * the candidate are evicted, lowest first, to make room for it. When the
+   * cache is over its budget at the end of a frame, the lowest valued images
+   * are given up until it fits again.
+   */
+  virtual double GetValue(const RasterCacheEntryMetrics& entry) const = 0;
+
+  /**
+   * @brief The maximum size of all cached images, or 0 for no limit.
+   */
+  virtual size_t max_bytes() const = 0;
+
+  /**
+   * @brief Whether images that do not fit into the byte budget are first
+   * demoted to lower resolutions before they are evicted.
+   */
+  virtual bool ShouldDemote() const { return false; }
+
+  /**
+   * @brief Whether the policy reads
+   * |RasterCacheEntryMetrics::uncached_draw_time|. Display lists are only
+   * timed when they are drawn without the cache if it does.
+   */
+  virtual bool UsesUncachedDrawTime() const { return false; }
+
+  /**
+   * @brief Called when the byte limit of the GPU resource cache, which the
+   * cached images count against, changes.
+   */
+  virtual void OnResourceCacheLimitChanged(size_t max_bytes) {}
+};
+
+/**
+ * The historic policy, which admits every candidate and has no byte budget.
+ */
+class DefaultRasterCachePolicy final : public RasterCachePolicy {
+ public:
+  DefaultRasterCachePolicy() = default;
+
+  // |RasterCachePolicy|
+  bool ShouldAdmit(const RasterCacheEntryMetrics& candidate) const override {
+    return true;
+  }
+
+  // |RasterCachePolicy|
+  double GetValue(const RasterCacheEntryMetrics& entry) const override {
+    return 0;
+  }
+
+  // |RasterCachePolicy|
+  size_t max_bytes() const override { return 0; }
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(DefaultRasterCachePolicy);
+};
+
+/**
+ * A policy that weighs the measured cost of drawing an entry without the
+ * cache against the size of its image, and keeps all images within a byte
+ * budget.
+ *
+ * The measured cost is the time the raster thread took to issue the draw
+ * calls, not the GPU time they took, so it is not a reliable reason to
+ * reject a candidate. It only decides which images are given up first: the
+ * value of an image is the raster time it saves per frame per byte, weighted
+ * by how often it has been drawn, so that an image that has been reused many
+ * times is not given up for a newcomer of the same cost.
+ *
+ * Entries that have not been measured, such as the ones for layers, are
+ * assumed to cost |default_uncached_draw_time|.
+ */
+class CostAwareRasterCachePolicy final : public RasterCachePolicy {
+ public:
+  static constexpr fml::TimeDelta kDefaultUncachedDrawTime =
+      fml::TimeDelta::FromMicroseconds(50);
+
+  explicit CostAwareRasterCachePolicy(
+      size_t max_bytes,
+      fml::TimeDelta default_uncached_draw_time = kDefaultUncachedDrawTime);
+
+  // |RasterCachePolicy|
+  bool ShouldAdmit(const RasterCacheEntryMetrics& candidate) const override;
+
+  // |RasterCachePolicy|
+  double GetValue(const RasterCacheEntryMetrics& entry) const override;
+
+  // |RasterCachePolicy|
+  size_t max_bytes() const override { return max_bytes_; }
+
+  // |RasterCachePolicy|
+  bool UsesUncachedDrawTime() const override { return true; }
+
+ private:
+  const size_t max_bytes_;
+  const fml::TimeDelta default_uncached_draw_time_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CostAwareRasterCachePolicy);
+};
+
+/**
+ * A policy that keeps all images within a share of the GPU resource cache
+ * limit, giving up the least recently drawn images first.
+ *
+ * Images over the budget are demoted to lower resolutions before they are
+ * evicted, so that content which is still on screen keeps being drawn from
+ * the cache, only blurrier, until the pressure goes away. Once the budget
+ * has room for them again, demoted images are rasterized at full resolution
+ * the next time they are prepared.
+ */
+class LruRasterCachePolicy final : public RasterCachePolicy {
+ public:
+  // The budget is the resource cache limit divided by this, which leaves the
+  // rest of the resource cache to the textures of the frame itself.
+  static constexpr size_t kResourceCacheShareDivisor = 2;
+
+  explicit LruRasterCachePolicy(size_t max_bytes = 0);
+
+  // |RasterCachePolicy|
+  bool ShouldAdmit(const RasterCacheEntryMetrics& candidate) const override;
+
+  // |RasterCachePolicy|
+  double GetValue(const RasterCacheEntryMetrics& entry) const override;
+
+  // |RasterCachePolicy|
+  size_t max_bytes() const override { return max_bytes_; }
+
+  // |RasterCachePolicy|
+  bool ShouldDemote() const override { return true; }
+
+  // |RasterCachePolicy|
+  void OnResourceCacheLimitChanged(size_t max_bytes) override;
+
+ private:
+  size_t max_bytes_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LruRasterCachePolicy);
+};
+
+}  // namespace flutter
+
+#endif  //  !SLIMPELLER
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_POLICY_H_
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_policy.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+RasterCacheEntryMetrics MakeEntryMetrics(int64_t uncached_draw_micros,
+                                         size_t image_bytes,
+                                         size_t hit_count = 0) {
+  return {
+      .accesses_since_visible = 4,
+      .hit_count = hit_count,
+      .uncached_draw_time =
+          fml::TimeDelta::FromMicroseconds(uncached_draw_micros),
+      .image_bytes = image_bytes,
+  };
+}
+
+}  // namespace
+
+TEST(RasterCachePolicy, DefaultPolicyAdmitsEverything) {
+  DefaultRasterCachePolicy policy;
+  ASSERT_EQ(policy.max_bytes(), 0u);
+  ASSERT_FALSE(policy.UsesUncachedDrawTime());
+  ASSERT_TRUE(policy.ShouldAdmit(MakeEntryMetrics(0, 1024)));
+  ASSERT_TRUE(policy.ShouldAdmit(MakeEntryMetrics(1, 1024 * 1024 * 1024)));
+}
+
+TEST(RasterCachePolicy, CostAwarePolicyOnlyRanksCheapEntries) {
+  CostAwareRasterCachePolicy policy(1024 * 1024,
+                                    fml::TimeDelta::FromMicroseconds(100));
+  ASSERT_EQ(policy.max_bytes(), 1024u * 1024u);
+  ASSERT_TRUE(policy.UsesUncachedDrawTime());
+  ASSERT_TRUE(policy.ShouldAdmit(MakeEntryMetrics(1, 1024)));
+  ASSERT_TRUE(policy.ShouldAdmit(MakeEntryMetrics(99, 1024)));
+  ASSERT_TRUE(policy.ShouldAdmit(MakeEntryMetrics(5000, 1024)));
+  ASSERT_LT(policy.GetValue(MakeEntryMetrics(99, 1024)),
+            policy.GetValue(MakeEntryMetrics(5000, 1024)));
+}
+
+TEST(RasterCachePolicy, CostAwarePolicyAdmitsUnmeasuredEntries) {
+  CostAwareRasterCachePolicy policy(1024 * 1024);
+  ASSERT_TRUE(policy.ShouldAdmit(MakeEntryMetrics(0, 1024)));
+  ASSERT_EQ(policy.GetValue(MakeEntryMetrics(0, 1024)),
+            policy.GetValue(MakeEntryMetrics(
+                CostAwareRasterCachePolicy::kDefaultUncachedDrawTime
+                    .ToMicroseconds(),
+                1024)));
+}
+
+TEST(RasterCachePolicy, CostAwarePolicyRejectsEntriesOverBudget) {
+  CostAwareRasterCachePolicy policy(1024);
+  ASSERT_TRUE(policy.ShouldAdmit(MakeEntryMetrics(5000, 1024)));
+  ASSERT_FALSE(policy.ShouldAdmit(MakeEntryMetrics(5000, 1025)));
+}
+
+TEST(RasterCachePolicy, CostAwarePolicyValuesSavedTimePerByte) {
+  CostAwareRasterCachePolicy policy(1024 * 1024);
+  const double value = policy.GetValue(MakeEntryMetrics(1000, 1024));
+  ASSERT_GT(policy.GetValue(MakeEntryMetrics(2000, 1024)), value);
+  ASSERT_LT(policy.GetValue(MakeEntryMetrics(1000, 2048)), value);
+  ASSERT_GT(policy.GetValue(MakeEntryMetrics(1000, 1024, 10)), value);
+  // Hits weigh in much less than the measured cost.
+  ASSERT_LT(policy.GetValue(MakeEntryMetrics(1000, 1024, 10)),
+            policy.GetValue(MakeEntryMetrics(4000, 1024)));
+}
+
+TEST(RasterCachePolicy, LruPolicyTakesItsBudgetFromTheResourceCache) {
+  LruRasterCachePolicy policy;
+  ASSERT_EQ(policy.max_bytes(), 0u);
+  ASSERT_TRUE(policy.ShouldDemote());
+  ASSERT_FALSE(policy.UsesUncachedDrawTime());
+  ASSERT_TRUE(policy.ShouldAdmit(MakeEntryMetrics(0, 1024 * 1024 * 1024)));
+
+  policy.OnResourceCacheLimitChanged(2048);
+  ASSERT_EQ(policy.max_bytes(),
+            2048u / LruRasterCachePolicy::kResourceCacheShareDivisor);
+  ASSERT_TRUE(policy.ShouldAdmit(MakeEntryMetrics(0, policy.max_bytes())));
+  ASSERT_FALSE(policy.ShouldAdmit(MakeEntryMetrics(0, policy.max_bytes() + 1)));
+}
+
+TEST(RasterCachePolicy, LruPolicyValuesRecentlyDrawnEntries) {
+  LruRasterCachePolicy policy(1024 * 1024);
+  RasterCacheEntryMetrics candidate = MakeEntryMetrics(0, 1024);
+  RasterCacheEntryMetrics drawn_last_frame = MakeEntryMetrics(5000, 1024, 10);
+  drawn_last_frame.frames_since_drawn = 1;
+  RasterCacheEntryMetrics drawn_long_ago = MakeEntryMetrics(5000, 1024, 10);
+  drawn_long_ago.frames_since_drawn = 30;
+  ASSERT_GT(policy.GetValue(candidate), policy.GetValue(drawn_last_frame));
+  ASSERT_GT(policy.GetValue(drawn_last_frame),
+            policy.GetValue(drawn_long_ago));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -320,6 +320,418 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, EvictedDisplayListIsRestoredFromHostTier) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetHostTierMaxBytes(1024 * 1024);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  // Equal content, but with a different unique id as it would have after
+  // the widget that produced it is rebuilt.
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  DisplayListBuilder dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  // Frame 1 and 2: the first display list reaches the threshold and is
+  // rasterized, which is a miss in the host tier.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item_1, paint_context);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+  ASSERT_EQ(cache.picture_metrics().host_tier_miss_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().host_tier_hit_count, 0u);
+  ASSERT_EQ(cache.host_tier().count(), 0u);
+
+  // Frame 3: the first display list is gone and its image is demoted.
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_EQ(cache.picture_metrics().host_tier_demotion_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().host_tier_demotion_bytes, 25600u);
+  ASSERT_EQ(cache.picture_metrics().host_tier_count, 1u);
+  ASSERT_EQ(cache.host_tier().count(), 1u);
+
+  // Frame 4 and 5: the equal display list is restored instead of rasterized.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().host_tier_hit_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().host_tier_miss_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+
+  cache.Clear();
+  ASSERT_EQ(cache.host_tier().count(), 0u);
+}
+
+TEST(RasterCache, CostAwarePolicyAdmitsCheapDisplayLists) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  ASSERT_FALSE(cache.ShouldRecordUncachedDrawTime());
+  cache.SetPolicy(std::make_unique<CostAwareRasterCachePolicy>(
+      1024 * 1024, fml::TimeDelta::FromMicroseconds(500)));
+  ASSERT_TRUE(cache.ShouldRecordUncachedDrawTime());
+
+  SkMatrix matrix = SkMatrix::I();
+  auto display_list = GetSampleDisplayList();
+  RasterCacheKeyID id(display_list->unique_id(),
+                      RasterCacheKeyType::kDisplayList);
+
+  DisplayListBuilder dummy_canvas(1000, 1000);
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  // Frame 1: the display list is drawn without the cache and measured.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item, paint_context));
+  cache.RecordUncachedDrawTime(id, matrix,
+                               fml::TimeDelta::FromMicroseconds(100));
+  cache.EndFrame();
+
+  // Frame 2: it reaches the access threshold. The measured time only ranks
+  // it against other images, so it is cached even though it is cheap.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item, paint_context));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().policy_rejection_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+
+  std::optional<RasterCacheEntryMetrics> metrics =
+      cache.GetEntryMetrics(id, matrix);
+  ASSERT_TRUE(metrics.has_value());
+  ASSERT_EQ(metrics->accesses_since_visible, 2u);
+  ASSERT_EQ(metrics->uncached_draw_time,
+            fml::TimeDelta::FromMicroseconds(100));
+  ASSERT_EQ(metrics->image_bytes, 25624u);
+}
+
+TEST(RasterCache, CostAwarePolicyKeepsTheMostValuableImagesWithinBudget) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // Only one of the images of the sample display lists fits.
+  cache.SetPolicy(std::make_unique<CostAwareRasterCachePolicy>(
+      30000, fml::TimeDelta::FromMicroseconds(10)));
+
+  SkMatrix matrix = SkMatrix::I();
+  auto cheap_display_list = GetSampleDisplayList();
+  auto costly_display_list = GetSampleDisplayList();
+  RasterCacheKeyID cheap_id(cheap_display_list->unique_id(),
+                            RasterCacheKeyType::kDisplayList);
+  RasterCacheKeyID costly_id(costly_display_list->unique_id(),
+                             RasterCacheKeyType::kDisplayList);
+
+  DisplayListBuilder dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem cheap_item(cheap_display_list, SkPoint(), true,
+                                        false);
+  DisplayListRasterCacheItem costly_item(costly_display_list, SkPoint(), true,
+                                         false);
+
+  // Frame 1: only the cheap display list is on screen.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(cheap_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(RasterCacheItemTryToRasterCache(cheap_item, paint_context));
+  cache.RecordUncachedDrawTime(cheap_id, matrix,
+                               fml::TimeDelta::FromMicroseconds(100));
+  cache.EndFrame();
+
+  // Frame 2: the cheap display list is cached, and the costly one shows up.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(cheap_item, preroll_context, matrix);
+  RasterCacheItemPreroll(costly_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(RasterCacheItemTryToRasterCache(cheap_item, paint_context));
+  ASSERT_FALSE(RasterCacheItemTryToRasterCache(costly_item, paint_context));
+  ASSERT_TRUE(cheap_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.RecordUncachedDrawTime(costly_id, matrix,
+                               fml::TimeDelta::FromMicroseconds(1000));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+  ASSERT_EQ(cache.GetEntryMetrics(cheap_id, matrix)->hit_count, 1u);
+
+  // Frame 3: the costly display list takes the place of the cheap one.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(cheap_item, preroll_context, matrix);
+  RasterCacheItemPreroll(costly_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(RasterCacheItemTryToRasterCache(costly_item, paint_context));
+  ASSERT_FALSE(RasterCacheItemTryToRasterCache(cheap_item, paint_context));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 25624u);
+  ASSERT_EQ(cache.picture_metrics().policy_rejection_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+  ASSERT_EQ(cache.GetEntryMetrics(cheap_id, matrix)->image_bytes, 0u);
+  ASSERT_EQ(cache.GetEntryMetrics(costly_id, matrix)->image_bytes, 25624u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+}
+
+TEST(RasterCache, ByteBudgetDemotesLeastRecentlyDrawnImagesFirst) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetPolicy(std::make_unique<LruRasterCachePolicy>());
+
+  SkMatrix matrix = SkMatrix::I();
+  auto recent_display_list = GetSampleDisplayList();
+  auto stale_display_list = GetSampleDisplayList();
+  RasterCacheKeyID recent_id(recent_display_list->unique_id(),
+                             RasterCacheKeyType::kDisplayList);
+  RasterCacheKeyID stale_id(stale_display_list->unique_id(),
+                            RasterCacheKeyType::kDisplayList);
+
+  DisplayListBuilder dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem recent_item(recent_display_list, SkPoint(), true,
+                                         false);
+  DisplayListRasterCacheItem stale_item(stale_display_list, SkPoint(), true,
+                                        false);
+
+  // Frame 1: both display lists are drawn without the cache.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(recent_item, preroll_context, matrix);
+  RasterCacheItemPreroll(stale_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(RasterCacheItemTryToRasterCache(recent_item, paint_context));
+  ASSERT_FALSE(RasterCacheItemTryToRasterCache(stale_item, paint_context));
+  cache.EndFrame();
+
+  // Frames 2 and 3: both are cached, but only one of them is drawn.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(recent_item, preroll_context, matrix);
+  RasterCacheItemPreroll(stale_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(RasterCacheItemTryToRasterCache(recent_item, paint_context));
+  ASSERT_TRUE(RasterCacheItemTryToRasterCache(stale_item, paint_context));
+  cache.EndFrame();
+  cache.BeginFrame();
+  RasterCacheItemPreroll(recent_item, preroll_context, matrix);
+  RasterCacheItemPreroll(stale_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(recent_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.cached_bytes(), 2u * 25624u);
+  ASSERT_EQ(cache.GetEntryMetrics(recent_id, matrix)->frames_since_drawn, 0u);
+  ASSERT_EQ(cache.GetEntryMetrics(stale_id, matrix)->frames_since_drawn, 1u);
+
+  // Frame 4: the budget shrinks, and halving the resolution of the image
+  // that has not been drawn is enough to fit into it.
+  cache.SetResourceCacheMaxBytes(2 * 40000);
+  ASSERT_EQ(cache.policy().max_bytes(), 40000u);
+  cache.BeginFrame();
+  RasterCacheItemPreroll(recent_item, preroll_context, matrix);
+  RasterCacheItemPreroll(stale_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(RasterCacheItemTryToRasterCache(recent_item, paint_context));
+  ASSERT_TRUE(RasterCacheItemTryToRasterCache(stale_item, paint_context));
+  ASSERT_TRUE(recent_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(stale_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().budget_demotion_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().budget_eviction_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 0u);
+  ASSERT_LE(cache.cached_bytes(), 40000u);
+  const size_t demoted_bytes =
+      cache.GetEntryMetrics(stale_id, matrix)->image_bytes;
+  ASSERT_LT(demoted_bytes, 25624u / 2);
+  ASSERT_EQ(cache.picture_metrics().budget_demotion_bytes,
+            25624u - demoted_bytes);
+  ASSERT_EQ(cache.GetEntryMetrics(recent_id, matrix)->image_bytes, 25624u);
+  ASSERT_EQ(cache.cached_bytes(), 25624u + demoted_bytes);
+
+  // Frame 5: demoting is not enough to fit into a tiny budget, so the images
+  // are evicted and no new ones are admitted.
+  cache.SetResourceCacheMaxBytes(2 * 1000);
+  cache.BeginFrame();
+  RasterCacheItemPreroll(recent_item, preroll_context, matrix);
+  RasterCacheItemPreroll(stale_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(RasterCacheItemTryToRasterCache(recent_item, paint_context));
+  ASSERT_FALSE(RasterCacheItemTryToRasterCache(stale_item, paint_context));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().budget_demotion_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().budget_eviction_count, 2u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 2u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 25624u + demoted_bytes);
+  ASSERT_EQ(cache.picture_metrics().policy_rejection_count, 2u);
+  ASSERT_EQ(cache.cached_bytes(), 0u);
+}
+
+TEST(RasterCache, ByteBudgetPromotesDemotedImagesWhenThereIsRoom) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetPolicy(std::make_unique<LruRasterCachePolicy>());
+
+  SkMatrix matrix = SkMatrix::I();
+  auto recent_display_list = GetSampleDisplayList();
+  auto stale_display_list = GetSampleDisplayList();
+  RasterCacheKeyID stale_id(stale_display_list->unique_id(),
+                            RasterCacheKeyType::kDisplayList);
+
+  DisplayListBuilder dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem recent_item(recent_display_list, SkPoint(), true,
+                                         false);
+  DisplayListRasterCacheItem stale_item(stale_display_list, SkPoint(), true,
+                                        false);
+
+  auto draw_frame = [&]() {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(recent_item, preroll_context, matrix);
+    RasterCacheItemPreroll(stale_item, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(recent_item, paint_context);
+    RasterCacheItemTryToRasterCache(stale_item, paint_context);
+    ASSERT_TRUE(recent_item.Draw(paint_context, &dummy_canvas, &paint));
+    cache.EndFrame();
+  };
+
+  // Frames 1 to 3: both display lists are cached at full resolution, but
+  // only one of them is drawn from the cache.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(recent_item, preroll_context, matrix);
+  RasterCacheItemPreroll(stale_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  draw_frame();
+  draw_frame();
+  ASSERT_EQ(cache.cached_bytes(), 2u * 25624u);
+
+  // Frame 4: the budget shrinks, so the image that has not been drawn is
+  // demoted.
+  cache.SetResourceCacheMaxBytes(2 * 40000);
+  draw_frame();
+  ASSERT_EQ(cache.picture_metrics().budget_demotion_count, 1u);
+  const size_t demoted_bytes =
+      cache.GetEntryMetrics(stale_id, matrix)->image_bytes;
+  ASSERT_LT(demoted_bytes, 25624u);
+
+  // Frame 5: the budget still has no room for it at full resolution.
+  draw_frame();
+  ASSERT_EQ(cache.picture_metrics().budget_promotion_count, 0u);
+  ASSERT_EQ(cache.GetEntryMetrics(stale_id, matrix)->image_bytes,
+            demoted_bytes);
+
+  // Frame 6: the budget grows again, and the image is rasterized at full
+  // resolution the next time it is prepared.
+  cache.SetResourceCacheMaxBytes(2 * 60000);
+  draw_frame();
+  ASSERT_EQ(cache.picture_metrics().budget_promotion_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().budget_demotion_count, 0u);
+  ASSERT_EQ(cache.GetEntryMetrics(stale_id, matrix)->image_bytes, 25624u);
+  ASSERT_EQ(cache.cached_bytes(), 2u * 25624u);
+
+  // Frame 7: it stays at full resolution.
+  draw_frame();
+  ASSERT_EQ(cache.picture_metrics().budget_promotion_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().budget_demotion_count, 0u);
+  ASSERT_EQ(cache.GetEntryMetrics(stale_id, matrix)->image_bytes, 25624u);
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -47,5 +47,12 @@ DlCanvas* MockViewEmbedder::CompositeEmbeddedView(int64_t view_id) {
   return canvas;
 }
 
+// |ExternalViewEmbedder|
+void MockViewEmbedder::PushFilterToVisitedPlatformViews(
+    const std::shared_ptr<const DlImageFilter>& filter,
+    const SkRect& filter_rect) {
+  pushed_filter_count_++;
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -41,13 +41,20 @@ class MockViewEmbedder : public ExternalViewEmbedder {
   // |ExternalViewEmbedder|
   DlCanvas* CompositeEmbeddedView(int64_t view_id) override;
 
+  // |ExternalViewEmbedder|
+  void PushFilterToVisitedPlatformViews(
+      const std::shared_ptr<const DlImageFilter>& filter,
+      const SkRect& filter_rect) override;
+
   std::vector<int64_t> prerolled_views() const { return prerolled_views_; }
   std::vector<int64_t> painted_views() const { return painted_views_; }
+  size_t pushed_filter_count() const { return pushed_filter_count_; }
 
  private:
   std::deque<DlCanvas*> contexts_;
   std::vector<int64_t> prerolled_views_;
   std::vector<int64_t> painted_views_;
+  size_t pushed_filter_count_ = 0;
 };
 
 }  // namespace testing
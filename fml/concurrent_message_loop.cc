@@ -11,19 +11,32 @@
 
 namespace fml {
 
+namespace {
+
+// The loop and index of the worker running on the current thread, if any.
+struct WorkerIdentity {
+  const ConcurrentMessageLoop* loop = nullptr;
+  size_t index = 0;
+};
+
+thread_local WorkerIdentity tls_worker;
+
+}  // namespace
+
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  // The deques must all exist before the first worker starts stealing.
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_tasks_.emplace_back(std::make_unique<TaskDeque>());
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
-
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
-  }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
@@ -47,66 +60,152 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     ExecuteTask(task);
     return;
   }
 
-  tasks_.push(task);
+  // Workers keep the tasks they post to themselves. That keeps related work
+  // on one thread and leaves the other deques uncontended.
+  const size_t worker_index =
+      tls_worker.loop == this
+          ? tls_worker.index
+          : next_worker_.fetch_add(1, std::memory_order_relaxed) %
+                worker_count_;
+  PushTask(*worker_tasks_[worker_index], task);
+}
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+void ConcurrentMessageLoop::PostPriorityTask(const fml::closure& task) {
+  if (!task) {
+    return;
+  }
 
-  tasks_condition_.notify_one();
+  if (shutdown_) {
+    FML_DLOG(WARNING)
+        << "Tried to post a task to shutdown concurrent message "
+           "loop. The task will be executed on the callers thread.";
+    ExecuteTask(task);
+    return;
+  }
+
+  PushTask(priority_tasks_, task);
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+void ConcurrentMessageLoop::PushTask(TaskDeque& deque,
+                                     const fml::closure& task) {
+  {
+    std::scoped_lock lock(deque.mutex);
+    deque.tasks.push_back(task);
+    pending_tasks_++;
+  }
+  WakeIdleWorker();
+}
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+fml::closure ConcurrentMessageLoop::PopTask(TaskDeque& deque,
+                                            bool from_back) {
+  std::scoped_lock lock(deque.mutex);
+  if (deque.tasks.empty()) {
+    return nullptr;
+  }
+  fml::closure task;
+  if (from_back) {
+    task = std::move(deque.tasks.back());
+    deque.tasks.pop_back();
+  } else {
+    task = std::move(deque.tasks.front());
+    deque.tasks.pop_front();
+  }
+  pending_tasks_--;
+  return task;
+}
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
-    }
+fml::closure ConcurrentMessageLoop::GetNextTask(size_t worker_index) {
+  if (auto task = PopTask(priority_tasks_, false)) {
+    return task;
+  }
+
+  // The owner takes the oldest task from its deque...
+  if (auto task = PopTask(*worker_tasks_[worker_index], false)) {
+    return task;
+  }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+  // ...while thieves take the newest from the others so that they don't fight
+  // over the same end of the deque.
+  for (size_t i = 1; i < worker_count_; ++i) {
+    const size_t victim = (worker_index + i) % worker_count_;
+    if (auto task = PopTask(*worker_tasks_[victim], true)) {
+      return task;
     }
+  }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+  return nullptr;
+}
 
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
+void ConcurrentMessageLoop::WakeIdleWorker() {
+  // A worker announces that it is idle before checking for pending tasks one
+  // last time with |tasks_mutex_| held. Since |pending_tasks_| has already been
+  // incremented, either that check sees the new task or this thread sees the
+  // idle worker. Acquiring |tasks_mutex_| makes sure the worker is actually
+  // waiting before it is notified.
+  if (idle_workers_ == 0) {
+    return;
+  }
+  {
+    std::scoped_lock lock(tasks_mutex_);
+  }
+  tasks_condition_.notify_one();
+}
+
+void ConcurrentMessageLoop::RunThreadTasks(size_t worker_index) {
+  TaskDeque& deque = *worker_tasks_[worker_index];
+  if (!deque.has_thread_tasks) {
+    return;
+  }
+
+  std::vector<fml::closure> thread_tasks;
+  {
+    std::scoped_lock lock(deque.mutex);
+    std::swap(thread_tasks, deque.thread_tasks);
+    deque.has_thread_tasks = false;
+  }
+
+  for (const auto& thread_task : thread_tasks) {
+    ExecuteTask(thread_task);
+  }
+}
+
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  tls_worker = {.loop = this, .index = worker_index};
+  const TaskDeque& deque = *worker_tasks_[worker_index];
+
+  while (true) {
+    RunThreadTasks(worker_index);
+
+    // Don't hold onto any mutex while tasks are being executed as they could
+    // themselves try to post more tasks to the message loop.
+    if (fml::closure task = GetNextTask(worker_index)) {
+      TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
       ExecuteTask(task);
+      if (shutdown_) {
+        break;
+      }
+      continue;
     }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
-    }
+    std::unique_lock lock(tasks_mutex_);
+    idle_workers_++;
+    tasks_condition_.wait(lock, [&]() {
+      return pending_tasks_ > 0 || shutdown_ || deque.has_thread_tasks;
+    });
+    idle_workers_--;
 
-    if (shutdown_now) {
+    if (shutdown_) {
+      lock.unlock();
+      RunThreadTasks(worker_index);
       break;
     }
   }
@@ -127,24 +226,14 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (const auto& deque : worker_tasks_) {
+    std::scoped_lock lock(deque->mutex);
+    deque->thread_tasks.emplace_back(task);
+    deque->has_thread_tasks = true;
   }
-  tasks_condition_.notify_all();
-}
 
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
-
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
-  std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
-  return pending_tasks;
+  std::scoped_lock lock(tasks_mutex_);
+  tasks_condition_.notify_all();
 }
 
 ConcurrentTaskRunner::ConcurrentTaskRunner(
@@ -169,14 +258,24 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
   task();
 }
 
-bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
+void ConcurrentTaskRunner::PostPriorityTask(const fml::closure& task) {
+  if (!task) {
+    return;
   }
-  return false;
+
+  if (auto loop = weak_loop_.lock()) {
+    loop->PostPriorityTask(task);
+    return;
+  }
+
+  FML_DLOG(WARNING)
+      << "Tried to post to a concurrent message loop that has already died. "
+         "Executing the task on the callers thread.";
+  task();
+}
+
+bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
+  return tls_worker.loop == this;
 }
 
 }  // namespace fml
@@ -5,10 +5,13 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -18,6 +21,16 @@ namespace fml {
 
 class ConcurrentTaskRunner;
 
+/// A pool of worker threads that run tasks posted to it concurrently.
+///
+/// Every worker owns a deque of tasks. Tasks posted from a worker are pushed
+/// onto that worker's deque and tasks posted from any other thread are
+/// distributed over the workers round-robin. A worker that runs out of work
+/// steals from the other workers before going to sleep.
+///
+/// Tasks posted via |PostPriorityTask| go into a separate lane that every
+/// worker drains before looking at its own deque, so that short, frame-critical
+/// work does not queue up behind long running tasks such as image decodes.
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -34,6 +47,8 @@ class ConcurrentMessageLoop
 
   void PostTaskToAllWorkers(const fml::closure& task);
 
+  void PostPriorityTask(const fml::closure& task);
+
   bool RunsTasksOnCurrentThread();
 
  protected:
@@ -43,22 +58,42 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  struct TaskDeque {
+    std::mutex mutex;
+    std::deque<fml::closure> tasks;
+    // Tasks posted via |PostTaskToAllWorkers| that must run on this worker.
+    std::vector<fml::closure> thread_tasks;
+    std::atomic_bool has_thread_tasks = false;
+  };
+
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<TaskDeque>> worker_tasks_;
+  TaskDeque priority_tasks_;
+  std::atomic_size_t next_worker_ = 0;
+  // The number of tasks in |priority_tasks_| and all the |worker_tasks_|.
+  std::atomic_size_t pending_tasks_ = 0;
+  std::atomic_size_t idle_workers_ = 0;
+
+  // Only used to put idle workers to sleep and to wake them up again. The task
+  // deques have their own mutexes.
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::atomic_bool shutdown_ = false;
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
 
   void PostTask(const fml::closure& task);
 
-  bool HasThreadTasksLocked() const;
+  void PushTask(TaskDeque& deque, const fml::closure& task);
+
+  fml::closure PopTask(TaskDeque& deque, bool from_back);
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  fml::closure GetNextTask(size_t worker_index);
+
+  void RunThreadTasks(size_t worker_index);
+
+  void WakeIdleWorker();
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
@@ -71,6 +106,11 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   void PostTask(const fml::closure& task) override;
 
+  /// Posts a task to the priority lane of the concurrent message loop. It runs
+  /// before any task posted via |PostTask| that has not been picked up by a
+  /// worker yet. Meant for short tasks that a frame is waiting on.
+  void PostPriorityTask(const fml::closure& task);
+
  private:
   friend ConcurrentMessageLoop;
 
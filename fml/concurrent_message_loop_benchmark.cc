@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+constexpr size_t kWorkerCount = 4;
+
+// Stands in for an image decode.
+void RunLongTask() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+}
+
+}  // namespace
+
+// Throughput of many tiny tasks, half of them posted from the workers
+// themselves like nested tessellation or decode work does.
+static void BM_ConcurrentLoopShortTaskThroughput(
+    benchmark::State& state) {  // NOLINT
+  auto loop = ConcurrentMessageLoop::Create(kWorkerCount);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t task_count = state.range(0);
+
+  for (auto _ : state) {
+    CountDownLatch latch(task_count * 2);
+    for (size_t i = 0; i < task_count; i++) {
+      task_runner->PostTask([&latch, &task_runner]() {
+        task_runner->PostTask([&latch]() { latch.CountDown(); });
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * task_count * 2);
+}
+
+// Latency of short tasks that are queued up behind long ones. With
+// |use_priority_lane| the short tasks are posted via |PostPriorityTask|.
+static void BM_ConcurrentLoopMixedTaskLatency(benchmark::State& state,
+                                              bool use_priority_lane) {
+  auto loop = ConcurrentMessageLoop::Create(kWorkerCount);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t long_task_count = kWorkerCount * 4;
+  const size_t short_task_count = state.range(0);
+
+  std::atomic<int64_t> total_latency_micros = 0;
+  size_t short_tasks_run = 0;
+
+  for (auto _ : state) {
+    CountDownLatch latch(long_task_count + short_task_count);
+    for (size_t i = 0; i < long_task_count; i++) {
+      task_runner->PostTask([&latch]() {
+        RunLongTask();
+        latch.CountDown();
+      });
+    }
+    for (size_t i = 0; i < short_task_count; i++) {
+      auto short_task = [&latch, &total_latency_micros,
+                         posted = TimePoint::Now()]() {
+        total_latency_micros += (TimePoint::Now() - posted).ToMicroseconds();
+        latch.CountDown();
+      };
+      if (use_priority_lane) {
+        task_runner->PostPriorityTask(short_task);
+      } else {
+        task_runner->PostTask(short_task);
+      }
+    }
+    latch.Wait();
+    short_tasks_run += short_task_count;
+  }
+
+  state.counters["AvgShortTaskLatencyUs"] =
+      static_cast<double>(total_latency_micros) / short_tasks_run;
+  state.SetItemsProcessed(state.iterations() *
+                          (long_task_count + short_task_count));
+}
+
+BENCHMARK(BM_ConcurrentLoopShortTaskThroughput)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentLoopMixedTaskLatency, PostTask, false)
+    ->Arg(16)
+    ->Arg(128)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ConcurrentLoopMixedTaskLatency, PostPriorityTask, true)
+    ->Arg(16)
+    ->Arg(128)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -9,6 +9,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -45,6 +46,12 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// Guards |task_source| and |task_observers| of this TaskQueue and of every
+  /// TaskQueue it owns. Producers posting to different task queues only
+  /// contend on their own queue's mutex instead of a lock shared by all
+  /// queues.
+  std::mutex tasks_mutex;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -116,6 +123,11 @@ class MessageLoopTaskQueues {
   //     b. Be subsumed by a TaskQueue (an owner can never be subsumed).
   //     c. Be independent, i.e, neither owner nor be subsumed.
   //
+  //  4. The set of queues and their merge topology is guarded by an exclusive
+  //     lock. Task and observer operations only take that lock in shared mode
+  //     and then lock the |tasks_mutex| of the owner of the affected merge
+  //     group (or of the queue itself if it is independent).
+  //
   //  Methods currently aware of the merged state of the queues:
   //  HasPendingTasks, GetNextTaskToRun, GetNumPendingTasks
   bool Merge(TaskQueueId owner, TaskQueueId subsumed);
@@ -143,6 +155,12 @@ class MessageLoopTaskQueues {
 
   ~MessageLoopTaskQueues();
 
+  /// Returns the mutex guarding the tasks and observers of the merge group
+  /// |queue_id| belongs to. That is the |tasks_mutex| of the owner if
+  /// |queue_id| is subsumed and its own otherwise. The caller must hold
+  /// |queue_meta_mutex_|.
+  std::mutex& GetMergeGroupMutexUnlocked(TaskQueueId queue_id) const;
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
@@ -151,7 +169,9 @@ class MessageLoopTaskQueues {
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  /// Guards |queue_entries_|, |task_queue_id_counter_| and the merge state
+  /// (|owner_of| and |subsumed_by|) of every entry.
+  mutable std::shared_mutex queue_meta_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_ = 0;
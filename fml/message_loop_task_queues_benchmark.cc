@@ -66,5 +66,70 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Multiple producers post to a handful of task queues while one consumer per
+// queue drains it, like the platform, UI, raster and IO threads do under heavy
+// platform channel traffic.
+static void BM_RegisterAndGetTasksMultipleProducers(
+    benchmark::State& state) {  // NOLINT
+  const int num_task_queues = 4;
+  const int num_producers = state.range(0);
+  const int num_tasks_per_producer = 1000;
+  const int num_tasks_per_queue =
+      num_producers * num_tasks_per_producer / num_task_queues;
+
+  while (state.KeepRunning()) {
+    auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+    const fml::TimePoint past = fml::TimePoint::Now();
+
+    std::vector<TaskQueueId> queue_ids;
+    queue_ids.reserve(num_task_queues);
+    for (int i = 0; i < num_task_queues; i++) {
+      queue_ids.push_back(task_queue->CreateTaskQueue());
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_producers + num_task_queues);
+
+    for (int i = 0; i < num_producers; i++) {
+      threads.emplace_back([producer = i, &task_queue, &queue_ids, past]() {
+        for (int j = 0; j < num_tasks_per_producer; j++) {
+          task_queue->RegisterTask(
+              queue_ids[(producer + j) % num_task_queues], [] {}, past);
+        }
+      });
+    }
+
+    for (int i = 0; i < num_task_queues; i++) {
+      threads.emplace_back(
+          [queue_id = queue_ids[i], &task_queue, num_tasks_per_queue]() {
+            int num_invocations = 0;
+            while (num_invocations < num_tasks_per_queue) {
+              fml::closure invocation =
+                  task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now());
+              if (invocation) {
+                num_invocations++;
+              }
+            }
+          });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (const auto& queue_id : queue_ids) {
+      task_queue->Dispose(queue_id);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_producers *
+                          num_tasks_per_producer);
+}
+
+BENCHMARK(BM_RegisterAndGetTasksMultipleProducers)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <thread>
 #include <utility>
@@ -404,6 +405,47 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+//------------------------------------------------------------------------------
+/// Verifies that tasks posted concurrently are not lost while the queues they
+/// are posted to are repeatedly merged and unmerged.
+///
+TEST(MessageLoopTaskQueue, ConcurrentRegisterTaskWhileMergingCounts) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queues->CreateTaskQueue();
+  auto raster_queue = task_queues->CreateTaskQueue();
+
+  constexpr size_t kThreadTaskCount = 500;
+
+  fml::CountDownLatch tasks_posted_latch(2);
+  std::atomic_bool tasks_posted = false;
+
+  auto post_tasks = [&](TaskQueueId queue_id) {
+    for (size_t i = 0; i < kThreadTaskCount; i++) {
+      task_queues->RegisterTask(queue_id, []() {}, ChronoTicksSinceEpoch());
+    }
+    tasks_posted_latch.CountDown();
+  };
+
+  std::thread platform_thread(post_tasks, platform_queue);
+  std::thread raster_thread(post_tasks, raster_queue);
+  std::thread merge_thread([&]() {
+    while (!tasks_posted) {
+      task_queues->Merge(platform_queue, raster_queue);
+      task_queues->Unmerge(platform_queue, raster_queue);
+    }
+  });
+
+  tasks_posted_latch.Wait();
+  tasks_posted = true;
+  platform_thread.join();
+  raster_thread.join();
+  merge_thread.join();
+
+  ASSERT_FALSE(task_queues->Owns(platform_queue, raster_queue));
+  ASSERT_EQ(task_queues->GetNumPendingTasks(platform_queue), kThreadTaskCount);
+  ASSERT_EQ(task_queues->GetNumPendingTasks(raster_queue), kThreadTaskCount);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
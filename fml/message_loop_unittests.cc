@@ -7,7 +7,9 @@
 #include "flutter/fml/message_loop.h"
 
 #include <iostream>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/concurrent_message_loop.h"
@@ -212,3 +214,87 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedFromWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 100;
+  fml::CountDownLatch posted_latch(kCount);
+  fml::CountDownLatch latch(kCount * kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&]() {
+      ASSERT_TRUE(loop->RunsTasksOnCurrentThread());
+      for (size_t j = 0; j < kCount; ++j) {
+        task_runner->PostTask([&]() { latch.CountDown(); });
+      }
+      posted_latch.CountDown();
+    });
+  }
+  posted_latch.Wait();
+  latch.Wait();
+  ASSERT_FALSE(loop->RunsTasksOnCurrentThread());
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopIdleWorkersStealTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent blocked;
+  fml::AutoResetWaitableEvent unblock;
+  fml::AutoResetWaitableEvent stolen;
+  task_runner->PostTask([&]() {
+    // Queue work on this worker's own deque and then block. The other worker
+    // has to steal it.
+    task_runner->PostTask([&]() { stolen.Signal(); });
+    blocked.Signal();
+    unblock.Wait();
+  });
+  blocked.Wait();
+  stolen.Wait();
+  unblock.Signal();
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsPriorityTasksFirst) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent blocked;
+  fml::AutoResetWaitableEvent unblock;
+  fml::CountDownLatch latch(3);
+  std::vector<int> order;
+  task_runner->PostTask([&]() {
+    blocked.Signal();
+    unblock.Wait();
+  });
+  blocked.Wait();
+  task_runner->PostTask([&]() {
+    order.push_back(1);
+    latch.CountDown();
+  });
+  task_runner->PostPriorityTask([&]() {
+    order.push_back(2);
+    latch.CountDown();
+  });
+  task_runner->PostPriorityTask([&]() {
+    order.push_back(3);
+    latch.CountDown();
+  });
+  unblock.Signal();
+  latch.Wait();
+  ASSERT_EQ(order, std::vector<int>({2, 3, 1}));
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksOnAllWorkers) {
+  const size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+  fml::CountDownLatch latch(kWorkerCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    {
+      std::scoped_lock lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), kWorkerCount);
+}
@@ -4,9 +4,11 @@
 
 #include "impeller/core/host_buffer.h"
 
+#include <algorithm>
 #include <cstring>
 #include <tuple>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/buffer_view.h"
@@ -18,6 +20,9 @@ namespace impeller {
 
 constexpr size_t kAllocatorBlockSize = 1024000;  // 1024 Kb.
 
+/// Frames that use more than this are split across several blocks.
+constexpr size_t kMaxAllocatorBlockSize = 16 * kAllocatorBlockSize;
+
 std::shared_ptr<HostBuffer> HostBuffer::Create(
     const std::shared_ptr<Allocator>& allocator,
     const std::shared_ptr<const IdleWaiter>& idle_waiter) {
@@ -26,12 +31,12 @@ std::shared_ptr<HostBuffer> HostBuffer::Create(
 
 HostBuffer::HostBuffer(const std::shared_ptr<Allocator>& allocator,
                        const std::shared_ptr<const IdleWaiter>& idle_waiter)
-    : allocator_(allocator), idle_waiter_(idle_waiter) {
-  DeviceBufferDescriptor desc;
-  desc.size = kAllocatorBlockSize;
-  desc.storage_mode = StorageMode::kHostVisible;
+    : allocator_(allocator),
+      idle_waiter_(idle_waiter),
+      block_size_(kAllocatorBlockSize) {
+  stats_.block_size = block_size_;
   for (auto i = 0u; i < kHostBufferArenaSize; i++) {
-    std::shared_ptr<DeviceBuffer> device_buffer = allocator->CreateBuffer(desc);
+    std::shared_ptr<DeviceBuffer> device_buffer = CreateBlock();
     FML_CHECK(device_buffer) << "Failed to allocate device buffer.";
     device_buffers_[i].push_back(device_buffer);
   }
@@ -74,8 +79,20 @@ BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
 BufferView HostBuffer::Emplace(size_t length,
                                size_t align,
                                const EmplaceProc& cb) {
+  if (!cb) {
+    return {};
+  }
+  return EmplaceUpTo(length, align, [&cb, length](uint8_t* buffer) {
+    cb(buffer);
+    return length;
+  });
+}
+
+BufferView HostBuffer::EmplaceUpTo(size_t max_length,
+                                   size_t align,
+                                   const EmplaceUpToProc& cb) {
   auto [range, device_buffer, raw_device_buffer] =
-      EmplaceInternal(length, align, cb);
+      EmplaceInternal(max_length, align, cb);
   if (device_buffer) {
     return BufferView(std::move(device_buffer), range);
   } else if (raw_device_buffer) {
@@ -93,46 +110,78 @@ HostBuffer::TestStateQuery HostBuffer::GetStateForTest() {
   };
 }
 
+const HostBuffer::Stats& HostBuffer::GetStats() const {
+  return stats_;
+}
+
+std::shared_ptr<DeviceBuffer> HostBuffer::CreateBlock() {
+  DeviceBufferDescriptor desc;
+  desc.size = block_size_;
+  desc.storage_mode = StorageMode::kHostVisible;
+  std::shared_ptr<DeviceBuffer> buffer = allocator_->CreateBuffer(desc);
+  if (buffer) {
+    stats_.blocks_created++;
+  }
+  return buffer;
+}
+
+std::shared_ptr<DeviceBuffer> HostBuffer::CreateOversizedBuffer(
+    size_t length) {
+  DeviceBufferDescriptor desc;
+  desc.size = length;
+  desc.storage_mode = StorageMode::kHostVisible;
+  std::shared_ptr<DeviceBuffer> buffer = allocator_->CreateBuffer(desc);
+  if (buffer) {
+    stats_.oversized_buffers_created++;
+  }
+  return buffer;
+}
+
 bool HostBuffer::MaybeCreateNewBuffer() {
-  current_buffer_++;
-  if (current_buffer_ >= device_buffers_[frame_index_].size()) {
-    DeviceBufferDescriptor desc;
-    desc.size = kAllocatorBlockSize;
-    desc.storage_mode = StorageMode::kHostVisible;
-    std::shared_ptr<DeviceBuffer> buffer = allocator_->CreateBuffer(desc);
+  std::vector<std::shared_ptr<DeviceBuffer>>& buffers =
+      device_buffers_[frame_index_];
+  size_t next_buffer = current_buffer_ + 1;
+  // Blocks left over from before the block size grew are replaced, as they
+  // may not be able to hold an emplacement of up to the block size.
+  if (next_buffer >= buffers.size() ||
+      buffers[next_buffer]->GetDeviceBufferDescriptor().size < block_size_) {
+    std::shared_ptr<DeviceBuffer> buffer = CreateBlock();
     if (!buffer) {
-      VALIDATION_LOG << "Failed to allocate host buffer of size " << desc.size;
+      VALIDATION_LOG << "Failed to allocate host buffer of size "
+                     << block_size_;
       return false;
     }
-    device_buffers_[frame_index_].push_back(std::move(buffer));
+    if (next_buffer < buffers.size()) {
+      buffers[next_buffer] = std::move(buffer);
+    } else {
+      buffers.push_back(std::move(buffer));
+    }
   }
+  frame_bytes_ += offset_;
+  current_buffer_ = next_buffer;
   offset_ = 0;
   return true;
 }
 
 std::tuple<Range, std::shared_ptr<DeviceBuffer>, DeviceBuffer*>
-HostBuffer::EmplaceInternal(size_t length,
+HostBuffer::EmplaceInternal(size_t max_length,
                             size_t align,
-                            const EmplaceProc& cb) {
+                            const EmplaceUpToProc& cb) {
   if (!cb) {
     return {};
   }
 
   // If the requested allocation is bigger than the block size, create a one-off
   // device buffer and write to that.
-  if (length > kAllocatorBlockSize) {
-    DeviceBufferDescriptor desc;
-    desc.size = length;
-    desc.storage_mode = StorageMode::kHostVisible;
+  if (max_length > block_size_) {
     std::shared_ptr<DeviceBuffer> device_buffer =
-        allocator_->CreateBuffer(desc);
+        CreateOversizedBuffer(max_length);
     if (!device_buffer) {
       return {};
     }
-    if (cb) {
-      cb(device_buffer->OnGetContents());
-      device_buffer->Flush(Range{0, length});
-    }
+    size_t length = std::min(cb(device_buffer->OnGetContents()), max_length);
+    device_buffer->Flush(Range{0, length});
+    stats_.bytes_emplaced += length;
     return std::make_tuple(Range{0, length}, std::move(device_buffer), nullptr);
   }
 
@@ -140,21 +189,23 @@ HostBuffer::EmplaceInternal(size_t length,
   if (align > 0 && offset_ % align) {
     padding = align - (offset_ % align);
   }
-  if (offset_ + padding + length > kAllocatorBlockSize) {
+  if (offset_ + padding + max_length > GetCurrentBufferSize()) {
     if (!MaybeCreateNewBuffer()) {
       return {};
     }
   } else {
     offset_ += padding;
+    stats_.padding_bytes += padding;
   }
 
   const std::shared_ptr<DeviceBuffer>& current_buffer = GetCurrentBuffer();
   auto contents = current_buffer->OnGetContents();
-  cb(contents + offset_);
+  size_t length = std::min(cb(contents + offset_), max_length);
   Range output_range(offset_, length);
   current_buffer->Flush(output_range);
 
   offset_ += length;
+  stats_.bytes_emplaced += length;
   return std::make_tuple(output_range, nullptr, current_buffer.get());
 }
 
@@ -162,12 +213,8 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>, DeviceBuffer*>
 HostBuffer::EmplaceInternal(const void* buffer, size_t length) {
   // If the requested allocation is bigger than the block size, create a one-off
   // device buffer and write to that.
-  if (length > kAllocatorBlockSize) {
-    DeviceBufferDescriptor desc;
-    desc.size = length;
-    desc.storage_mode = StorageMode::kHostVisible;
-    std::shared_ptr<DeviceBuffer> device_buffer =
-        allocator_->CreateBuffer(desc);
+  if (length > block_size_) {
+    std::shared_ptr<DeviceBuffer> device_buffer = CreateOversizedBuffer(length);
     if (!device_buffer) {
       return {};
     }
@@ -177,11 +224,12 @@ HostBuffer::EmplaceInternal(const void* buffer, size_t length) {
         return {};
       }
     }
+    stats_.bytes_emplaced += length;
     return std::make_tuple(Range{0, length}, std::move(device_buffer), nullptr);
   }
 
   auto old_length = GetLength();
-  if (old_length + length > kAllocatorBlockSize) {
+  if (old_length + length > GetCurrentBufferSize()) {
     if (!MaybeCreateNewBuffer()) {
       return {};
     }
@@ -195,6 +243,7 @@ HostBuffer::EmplaceInternal(const void* buffer, size_t length) {
     current_buffer->Flush(Range{old_length, length});
   }
   offset_ += length;
+  stats_.bytes_emplaced += length;
   return std::make_tuple(Range{old_length, length}, nullptr,
                          current_buffer.get());
 }
@@ -207,8 +256,9 @@ HostBuffer::EmplaceInternal(const void* buffer, size_t length, size_t align) {
 
   {
     auto padding = align - (GetLength() % align);
-    if (offset_ + padding < kAllocatorBlockSize) {
+    if (offset_ + padding < GetCurrentBufferSize()) {
       offset_ += padding;
+      stats_.padding_bytes += padding;
     } else if (!MaybeCreateNewBuffer()) {
       return {};
     }
@@ -221,6 +271,10 @@ const std::shared_ptr<DeviceBuffer>& HostBuffer::GetCurrentBuffer() const {
   return device_buffers_[frame_index_][current_buffer_];
 }
 
+size_t HostBuffer::GetCurrentBufferSize() const {
+  return GetCurrentBuffer()->GetDeviceBufferDescriptor().size;
+}
+
 void HostBuffer::Reset() {
   // When resetting the host buffer state at the end of the frame, check if
   // there are any unused buffers and remove them.
@@ -228,9 +282,55 @@ void HostBuffer::Reset() {
     device_buffers_[frame_index_].pop_back();
   }
 
+  UpdateHighWaterMark();
+
   offset_ = 0u;
   current_buffer_ = 0u;
   frame_index_ = (frame_index_ + 1) % kHostBufferArenaSize;
+
+  ResizeArena();
+}
+
+void HostBuffer::UpdateHighWaterMark() {
+  size_t frame_bytes = frame_bytes_ + offset_;
+  frame_bytes_ = 0u;
+  frame_bytes_history_[frame_count_ % kHostBufferHighWaterMarkFrameCount] =
+      frame_bytes;
+  frame_count_++;
+
+  size_t high_water_mark = *std::max_element(frame_bytes_history_.begin(),
+                                             frame_bytes_history_.end());
+  // Round up to a whole number of minimum sized blocks so that small changes
+  // in usage from frame to frame don't reallocate the blocks.
+  size_t block_count =
+      (high_water_mark + kAllocatorBlockSize - 1) / kAllocatorBlockSize;
+  block_size_ = std::clamp(block_count * kAllocatorBlockSize,
+                           kAllocatorBlockSize, kMaxAllocatorBlockSize);
+  stats_.high_water_mark = high_water_mark;
+  stats_.block_size = block_size_;
+
+  FML_TRACE_COUNTER("impeller",                                      //
+                    "HostBuffer", reinterpret_cast<int64_t>(this),   //
+                    "FrameKBytes", frame_bytes / 1024u,              //
+                    "HighWaterMarkKBytes", high_water_mark / 1024u,  //
+                    "BlockKBytes", block_size_ / 1024u);
+}
+
+void HostBuffer::ResizeArena() {
+  std::vector<std::shared_ptr<DeviceBuffer>>& buffers =
+      device_buffers_[frame_index_];
+  if (buffers.front()->GetDeviceBufferDescriptor().size == block_size_) {
+    return;
+  }
+  // The blocks of this arena are about to be overwritten, so they are no
+  // longer in use and can be replaced by a single block of the new size.
+  std::shared_ptr<DeviceBuffer> block = CreateBlock();
+  if (!block) {
+    // Keep using the existing blocks.
+    return;
+  }
+  buffers.clear();
+  buffers.push_back(std::move(block));
 }
 
 }  // namespace impeller
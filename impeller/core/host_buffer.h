@@ -21,12 +21,38 @@ namespace impeller {
 /// Approximately the same size as the max frames in flight.
 static const constexpr size_t kHostBufferArenaSize = 4u;
 
-/// The host buffer class manages one more 1024 Kb blocks of device buffer
+/// The number of frames over which the high-water mark of the host buffer is
+/// tracked. Blocks shrink once a peak has not been seen for this many frames.
+static const constexpr size_t kHostBufferHighWaterMarkFrameCount = 60u;
+
+/// The host buffer class manages one more blocks of device buffer
 /// allocations.
 ///
-/// These are reset per-frame.
+/// These are reset per-frame. Blocks start out at 1024 Kb and are resized to
+/// hold the most bytes used by a single frame over the last
+/// `kHostBufferHighWaterMarkFrameCount` frames, so that a frame normally
+/// fits into a single block and no extra blocks have to be created.
 class HostBuffer {
  public:
+  /// Counters that describe how the host buffer is used. Byte and buffer
+  /// counts are cumulative since the creation of the host buffer.
+  struct Stats {
+    /// The number of bytes of data emplaced, excluding padding.
+    size_t bytes_emplaced = 0u;
+    /// The number of bytes skipped to satisfy alignment requirements.
+    size_t padding_bytes = 0u;
+    /// The number of block sized device buffers that were allocated.
+    size_t blocks_created = 0u;
+    /// The number of one-off device buffers that were allocated for
+    /// emplacements larger than a block.
+    size_t oversized_buffers_created = 0u;
+    /// The most bytes used by a single frame over the last
+    /// `kHostBufferHighWaterMarkFrameCount` frames.
+    size_t high_water_mark = 0u;
+    /// The size of the blocks that are currently allocated.
+    size_t block_size = 0u;
+  };
+
   static std::shared_ptr<HostBuffer> Create(
       const std::shared_ptr<Allocator>& allocator,
       const std::shared_ptr<const IdleWaiter>& idle_waiter);
@@ -118,6 +144,25 @@ class HostBuffer {
   ///
   BufferView Emplace(size_t length, size_t align, const EmplaceProc& cb);
 
+  using EmplaceUpToProc = std::function<size_t(uint8_t* buffer)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Like |Emplace| with a callback, but for writers that only
+  ///             know an upper bound of the data they will produce. The
+  ///             callback may write up to max_length bytes and returns the
+  ///             number of bytes it actually wrote. Only those bytes are
+  ///             flushed and kept, the rest of the reservation is given back.
+  ///
+  /// @param[in]  cb            A callback that will be passed a ptr to the
+  ///                           underlying host buffer and returns the number
+  ///                           of bytes written.
+  ///
+  /// @return     The buffer view of the written bytes.
+  ///
+  BufferView EmplaceUpTo(size_t max_length,
+                         size_t align,
+                         const EmplaceUpToProc& cb);
+
   //----------------------------------------------------------------------------
   /// @brief Resets the contents of the HostBuffer to nothing so it can be
   ///        reused.
@@ -133,12 +178,17 @@ class HostBuffer {
   /// @brief Retrieve internal buffer state for test expectations.
   TestStateQuery GetStateForTest();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the usage counters of the host buffer.
+  ///
+  const Stats& GetStats() const;
+
  private:
   [[nodiscard]] std::tuple<Range, std::shared_ptr<DeviceBuffer>, DeviceBuffer*>
   EmplaceInternal(const void* buffer, size_t length);
 
   std::tuple<Range, std::shared_ptr<DeviceBuffer>, DeviceBuffer*>
-  EmplaceInternal(size_t length, size_t align, const EmplaceProc& cb);
+  EmplaceInternal(size_t max_length, size_t align, const EmplaceUpToProc& cb);
 
   std::tuple<Range, std::shared_ptr<DeviceBuffer>, DeviceBuffer*>
   EmplaceInternal(const void* buffer, size_t length, size_t align);
@@ -151,8 +201,24 @@ class HostBuffer {
   /// A false return value indicates an unrecoverable allocation failure.
   [[nodiscard]] bool MaybeCreateNewBuffer();
 
+  /// Create a block sized device buffer.
+  std::shared_ptr<DeviceBuffer> CreateBlock();
+
+  /// Create a one-off device buffer for an emplacement larger than a block.
+  std::shared_ptr<DeviceBuffer> CreateOversizedBuffer(size_t length);
+
+  /// Record the bytes used by the frame that just ended and compute the size
+  /// of the blocks needed to hold the frames in the high-water mark window.
+  void UpdateHighWaterMark();
+
+  /// Ensure the blocks of the arena that is about to be reused match the
+  /// current block size.
+  void ResizeArena();
+
   const std::shared_ptr<DeviceBuffer>& GetCurrentBuffer() const;
 
+  size_t GetCurrentBufferSize() const;
+
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
   explicit HostBuffer(const std::shared_ptr<Allocator>& allocator,
@@ -169,6 +235,13 @@ class HostBuffer {
   size_t current_buffer_ = 0u;
   size_t offset_ = 0u;
   size_t frame_index_ = 0u;
+  size_t block_size_;
+  /// Bytes used in the blocks of the current frame before the current block.
+  size_t frame_bytes_ = 0u;
+  std::array<size_t, kHostBufferHighWaterMarkFrameCount> frame_bytes_history_ =
+      {};
+  size_t frame_count_ = 0u;
+  Stats stats_;
 };
 
 }  // namespace impeller
@@ -28,6 +28,8 @@
 #include "impeller/entity/geometry/ellipse_geometry.h"
 #include "impeller/entity/geometry/fill_path_geometry.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/geometry_prepass.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/entity/geometry/rect_geometry.h"
 #include "impeller/entity/geometry/round_rect_geometry.h"
 #include "impeller/geometry/color.h"
@@ -1164,6 +1166,33 @@ void FirstPassDispatcher::drawDisplayList(
   FML_DCHECK(stack_depth == stack_.size());
 }
 
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawPath(const DlPath& path) {
+  GeometryPrepass& prepass = renderer_.GetGeometryPrepass();
+  if (!prepass.IsEnabled() || paint_.style != Paint::Style::kStroke) {
+    return;
+  }
+
+  // Mirror |DlDispatcherBase::SimplifyOrDrawPath|, shapes that it draws
+  // without a path geometry do not need to be prepared.
+  DlRect rect;
+  bool closed;
+  if (path.IsRect(&rect, &closed) && closed) {
+    return;
+  }
+  SkRRect rrect;
+  if (path.IsSkRRect(&rrect) && rrect.isSimple()) {
+    return;
+  }
+  if (path.IsOval(&rect)) {
+    return;
+  }
+
+  prepass.AddStroke(path.GetPath(), paint_.stroke_width, paint_.stroke_miter,
+                    paint_.stroke_cap, paint_.stroke_join,
+                    matrix_.GetMaxBasisLengthXY());
+}
+
 // |flutter::DlOpReceiver|
 void FirstPassDispatcher::setDrawStyle(flutter::DlDrawStyle style) {
   paint_.style = ToStyle(style);
@@ -1270,6 +1299,11 @@ std::shared_ptr<Texture> DisplayListToTexture(
   impeller::FirstPassDispatcher collector(
       context.GetContentContext(), impeller::Matrix(), Rect::MakeSize(size));
   display_list->Dispatch(collector, sk_cull_rect);
+  GeometryPrepass& geometry_prepass =
+      context.GetContentContext().GetGeometryPrepass();
+  if (geometry_prepass.IsEnabled()) {
+    geometry_prepass.Prepare();
+  }
   impeller::CanvasDlDispatcher impeller_dispatcher(
       context.GetContentContext(),               //
       target,                                    //
@@ -1281,6 +1315,7 @@ std::shared_ptr<Texture> DisplayListToTexture(
   impeller_dispatcher.SetBackdropData(data, count);
   display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
   impeller_dispatcher.FinishRecording();
+  geometry_prepass.Reset();
 
   if (reset_host_buffer) {
     context.GetContentContext().GetTransientsBuffer().Reset();
@@ -1300,6 +1335,10 @@ bool RenderToOnscreen(ContentContext& context,
                                      cull_rect.right(), cull_rect.bottom());
   FirstPassDispatcher collector(context, impeller::Matrix(), ip_cull_rect);
   display_list->Dispatch(collector, cull_rect);
+  GeometryPrepass& geometry_prepass = context.GetGeometryPrepass();
+  if (geometry_prepass.IsEnabled()) {
+    geometry_prepass.Prepare();
+  }
 
   impeller::CanvasDlDispatcher impeller_dispatcher(
       context,                                   //
@@ -1312,6 +1351,8 @@ bool RenderToOnscreen(ContentContext& context,
   impeller_dispatcher.SetBackdropData(data, count);
   display_list->Dispatch(impeller_dispatcher, cull_rect);
   impeller_dispatcher.FinishRecording();
+  geometry_prepass.Reset();
+  context.GetTessellationCache().EndFrame();
   if (reset_host_buffer) {
     context.GetTransientsBuffer().Reset();
   }
@@ -345,6 +345,9 @@ class FirstPassDispatcher : public flutter::IgnoreAttributeDispatchHelper,
   void drawDisplayList(const sk_sp<flutter::DisplayList> display_list,
                        DlScalar opacity) override;
 
+  // |flutter::DlOpReceiver|
+  void drawPath(const DlPath& path) override;
+
   // |flutter::DlOpReceiver|
   void setDrawStyle(flutter::DlDrawStyle style) override;
 
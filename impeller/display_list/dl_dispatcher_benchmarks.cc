@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/display_list/aiks_context.h"
+#include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/entity/geometry/geometry_prepass.h"
+#include "impeller/entity/vk/entity_shaders_vk.h"
+#include "impeller/entity/vk/framebuffer_blend_shaders_vk.h"
+#include "impeller/entity/vk/modern_shaders_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+#include "include/core/SkPath.h"
+
+namespace impeller {
+
+namespace {
+
+/// The number of stroked paths in a frame, roughly what a busy chart or
+/// hand drawn canvas would submit.
+constexpr size_t kStrokesPerFrame = 256u;
+
+constexpr ISize kFrameSize = ISize(1024, 1024);
+
+std::vector<std::shared_ptr<fml::Mapping>> ShaderLibraryMappings() {
+  return {
+      std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_vk_data,
+                                             impeller_entity_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_vk_data,
+                                             impeller_modern_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_framebuffer_blend_shaders_vk_data,
+          impeller_framebuffer_blend_shaders_vk_length),
+  };
+}
+
+/// Record a frame of |count| distinct curvy strokes so that every stroke
+/// needs its own expansion.
+sk_sp<flutter::DisplayList> CreateStrokeHeavyDisplayList(size_t count) {
+  flutter::DisplayListBuilder builder;
+  flutter::DlPaint paint;
+  paint.setDrawStyle(flutter::DlDrawStyle::kStroke)
+      .setStrokeWidth(4.0f)
+      .setStrokeMiter(4.0f)
+      .setStrokeCap(flutter::DlStrokeCap::kRound)
+      .setStrokeJoin(flutter::DlStrokeJoin::kRound);
+  builder.Translate(10.0f, 300.0f);
+  builder.Scale(2.0f, 2.0f);
+  for (size_t i = 0; i < count; i++) {
+    Scalar offset = static_cast<Scalar>(i % 32);
+    SkPath path;
+    path.moveTo(0, offset);
+    for (int segment = 0; segment < 8; segment++) {
+      Scalar x = segment * 50.0f;
+      path.cubicTo(x + 10, 80 + offset, x + 40, -40 - offset, x + 50, offset);
+      path.quadTo(x + 75, 60, x + 100, offset);
+    }
+    builder.DrawPath(path, paint);
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+/// Measures the raster thread cost of dispatching a stroke heavy frame
+/// through |DlDispatcher|, with and without the geometry prepass. The
+/// Vulkan driver is mocked so that only Impeller's own work is timed.
+///
+/// The reported CPU time is the time of the benchmark thread alone, which
+/// stands in for the raster thread. Work that the prepass hands to the
+/// concurrent worker pool is deliberately not counted, so the wall time is
+/// not used.
+static void BM_DispatchStrokes(benchmark::State& state,
+                               bool enable_parallel_geometry) {
+  std::shared_ptr<ContextVK> context =
+      testing::MockVulkanContextBuilder()
+          .SetSettingsCallback([&](ContextVK::Settings& settings) {
+            settings.shader_libraries_data = ShaderLibraryMappings();
+            settings.enable_parallel_geometry = enable_parallel_geometry;
+          })
+          .Build();
+  if (!context) {
+    state.SkipWithError("Could not create a mock Vulkan context.");
+    return;
+  }
+  AiksContext aiks_context(context, TypographerContextSkia::Make());
+  if (!aiks_context.IsValid()) {
+    state.SkipWithError("Could not create the Aiks context.");
+    return;
+  }
+  ContentContext& content_context = aiks_context.GetContentContext();
+  if (context->GetShouldEnableParallelGeometry()) {
+    content_context.GetGeometryPrepass().SetWorkerTaskRunner(
+        context->GetConcurrentWorkerTaskRunner());
+  }
+
+  RenderTarget render_target =
+      RenderTargetAllocator(context->GetResourceAllocator())
+          .CreateOffscreen(*context, kFrameSize, /*mip_count=*/1);
+  sk_sp<flutter::DisplayList> display_list =
+      CreateStrokeHeavyDisplayList(kStrokesPerFrame);
+  SkIRect cull_rect = SkIRect::MakeWH(kFrameSize.width, kFrameSize.height);
+
+  while (state.KeepRunning()) {
+    RenderToOnscreen(content_context, render_target, display_list, cull_rect,
+                     /*reset_host_buffer=*/true);
+
+    // The mock driver records every call it receives.
+    state.PauseTiming();
+    testing::ClearMockVulkanFunctions(context->GetDevice());
+    state.ResumeTiming();
+  }
+  state.counters["Strokes"] = benchmark::Counter(
+      kStrokesPerFrame * state.iterations(), benchmark::Counter::kIsRate);
+
+  context->Shutdown();
+}
+
+BENCHMARK_CAPTURE(BM_DispatchStrokes, serial, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DispatchStrokes, parallel_geometry, true)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace impeller
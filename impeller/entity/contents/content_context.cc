@@ -14,6 +14,8 @@
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/geometry_prepass.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_descriptor.h"
@@ -246,6 +248,8 @@ ContentContext::ContentContext(
       lazy_glyph_atlas_(
           std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
       tessellator_(std::make_shared<Tessellator>()),
+      geometry_prepass_(std::make_shared<GeometryPrepass>()),
+      tessellation_cache_(std::make_shared<TessellationCache>()),
       render_target_cache_(render_target_allocator == nullptr
                                ? std::make_shared<RenderTargetCache>(
                                      context_->GetResourceAllocator())
@@ -548,6 +552,14 @@ Tessellator& ContentContext::GetTessellator() const {
   return *tessellator_;
 }
 
+GeometryPrepass& ContentContext::GetGeometryPrepass() const {
+  return *geometry_prepass_;
+}
+
+TessellationCache& ContentContext::GetTessellationCache() const {
+  return *tessellation_cache_;
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
@@ -361,6 +361,8 @@ struct ContentContextOptions {
 };
 
 class Tessellator;
+class GeometryPrepass;
+class TessellationCache;
 class RenderTargetCache;
 
 class ContentContext {
@@ -376,6 +378,14 @@ class ContentContext {
 
   Tessellator& GetTessellator() const;
 
+  /// @brief  The frame scoped store of geometry generated ahead of encoding.
+  ///
+  ///         Disabled unless a worker task runner has been provided to it.
+  GeometryPrepass& GetGeometryPrepass() const;
+
+  /// @brief  The cache of path tessellations that are reused across frames.
+  TessellationCache& GetTessellationCache() const;
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetFastGradientPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(fast_gradient_pipelines_, opts);
@@ -1002,6 +1012,8 @@ class ContentContext {
 
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
+  std::shared_ptr<GeometryPrepass> geometry_prepass_;
+  std::shared_ptr<TessellationCache> tessellation_cache_;
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
   std::shared_ptr<HostBuffer> host_buffer_;
   std::shared_ptr<Texture> empty_texture_;
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
 #include <limits>
 #include <utility>
 
@@ -157,17 +158,18 @@ TEST_P(HostBufferTest, UnusedBuffersAreDiscardedWhenResetting) {
   EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 2u);
   EXPECT_EQ(buffer->GetStateForTest().current_frame, 0u);
 
-  // Reset until we get back to this frame.
+  // Reset until we get back to this frame. The two blocks are replaced by a
+  // single block that is large enough to hold the whole frame.
   for (auto i = 0; i < 4; i++) {
     buffer->Reset();
   }
 
   EXPECT_EQ(buffer->GetStateForTest().current_buffer, 0u);
-  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 2u);
+  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 1u);
   EXPECT_EQ(buffer->GetStateForTest().current_frame, 0u);
 
-  // Now when we reset, the buffer should get dropped.
-  // Reset until we get back to this frame.
+  // The block stays at the larger size while the frame is within the
+  // high-water mark window.
   for (auto i = 0; i < 4; i++) {
     buffer->Reset();
   }
@@ -175,6 +177,83 @@ TEST_P(HostBufferTest, UnusedBuffersAreDiscardedWhenResetting) {
   EXPECT_EQ(buffer->GetStateForTest().current_buffer, 0u);
   EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 1u);
   EXPECT_EQ(buffer->GetStateForTest().current_frame, 0u);
+  EXPECT_EQ(buffer->GetStats().block_size, 2048000u);
+}
+
+TEST_P(HostBufferTest, BlocksAreSizedToTheFrameHighWaterMark) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                   GetContext()->GetIdleWaiter());
+
+  for (auto i = 0; i < 3; i++) {
+    auto view = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+    ASSERT_TRUE(view);
+  }
+  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 3u);
+  EXPECT_EQ(buffer->GetStats().block_size, 1024000u);
+
+  buffer->Reset();
+
+  EXPECT_EQ(buffer->GetStats().high_water_mark, 3060000u);
+  EXPECT_EQ(buffer->GetStats().block_size, 3072000u);
+
+  // The next frame fits into a single block.
+  size_t blocks_created = buffer->GetStats().blocks_created;
+  for (auto i = 0; i < 3; i++) {
+    auto view = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+    ASSERT_TRUE(view);
+  }
+  EXPECT_EQ(buffer->GetStateForTest().current_buffer, 0u);
+  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 1u);
+  EXPECT_EQ(buffer->GetStats().blocks_created, blocks_created);
+  EXPECT_EQ(buffer->GetStats().oversized_buffers_created, 0u);
+}
+
+TEST_P(HostBufferTest, BlocksShrinkAfterIdleFrames) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                   GetContext()->GetIdleWaiter());
+
+  for (auto i = 0; i < 3; i++) {
+    auto view = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+    ASSERT_TRUE(view);
+  }
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetStats().block_size, 3072000u);
+
+  // The peak is remembered while it is within the high-water mark window.
+  for (auto i = 1u; i < kHostBufferHighWaterMarkFrameCount; i++) {
+    auto view = buffer->Emplace(1000, 0, [](uint8_t* data) {});
+    ASSERT_TRUE(view);
+    buffer->Reset();
+  }
+  EXPECT_EQ(buffer->GetStats().block_size, 3072000u);
+
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetStats().high_water_mark, 1000u);
+  EXPECT_EQ(buffer->GetStats().block_size, 1024000u);
+}
+
+TEST_P(HostBufferTest, StatsTrackEmplacedBytesAndPadding) {
+  struct Length2 {
+    uint8_t pad[2];
+  };
+  struct alignas(16) Align16 {
+    uint8_t pad[2];
+  };
+
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                   GetContext()->GetIdleWaiter());
+  size_t blocks_created = buffer->GetStats().blocks_created;
+  EXPECT_EQ(blocks_created, kHostBufferArenaSize);
+
+  auto view = buffer->Emplace(Length2{});
+  view = buffer->Emplace(Align16{});
+  view = buffer->Emplace(64, 16, [](uint8_t*) {});
+  view = buffer->Emplace(nullptr, 1024000 + 10, 0);
+
+  EXPECT_EQ(buffer->GetStats().bytes_emplaced, 2u + 16u + 64u + 1024010u);
+  EXPECT_EQ(buffer->GetStats().padding_bytes, 14u);
+  EXPECT_EQ(buffer->GetStats().blocks_created, blocks_created);
+  EXPECT_EQ(buffer->GetStats().oversized_buffers_created, 1u);
 }
 
 TEST_P(HostBufferTest, EmplaceWithProcIsAligned) {
@@ -188,6 +267,28 @@ TEST_P(HostBufferTest, EmplaceWithProcIsAligned) {
   EXPECT_EQ(view.GetRange(), Range(32, 64));
 }
 
+TEST_P(HostBufferTest, EmplaceUpToKeepsOnlyTheWrittenBytes) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                   GetContext()->GetIdleWaiter());
+
+  BufferView view = buffer->EmplaceUpTo(64, 16, [](uint8_t* data) {
+    std::memset(data, 0xAB, 24);
+    return 24u;
+  });
+  EXPECT_EQ(view.GetRange(), Range(0, 24));
+  EXPECT_EQ(buffer->GetStats().bytes_emplaced, 24u);
+
+  // The unused part of the reservation is handed to the next emplacement.
+  view = buffer->Emplace(64, 16, [](uint8_t*) {});
+  EXPECT_EQ(view.GetRange(), Range(32, 64));
+
+  // Writers that need more than a block still get a one-off buffer that is
+  // trimmed to what they wrote.
+  view = buffer->EmplaceUpTo(1024000 + 10, 0, [](uint8_t*) { return 100u; });
+  EXPECT_EQ(view.GetRange(), Range(0, 100));
+  EXPECT_EQ(buffer->GetStats().oversized_buffers_created, 1u);
+}
+
 static constexpr const size_t kMagicFailingAllocation = 1024000 * 2;
 
 class FailingAllocator : public Allocator {
@@ -4,9 +4,11 @@
 
 #include "impeller/entity/contents/text_contents.h"
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
@@ -95,10 +97,9 @@ bool TextContents::Render(const ContentContext& renderer,
   }
 
   // Information shared by all glyph draw calls.
-  pass.SetCommandLabel("TextFrame");
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  pass.SetPipeline(renderer.GetGlyphAtlasPipeline(opts));
+  auto pipeline = renderer.GetGlyphAtlasPipeline(opts);
 
   using VS = GlyphAtlasPipeline::VertexShader;
   using FS = GlyphAtlasPipeline::FragmentShader;
@@ -107,21 +108,20 @@ bool TextContents::Render(const ContentContext& renderer,
   VS::FrameInfo frame_info;
   frame_info.mvp =
       Entity::GetShaderTransform(entity.GetShaderClipDepth(), pass, Matrix());
-  ISize atlas_size = atlas->GetTexture()->GetSize();
   bool is_translation_scale = entity.GetTransform().IsTranslationScaleOnly();
   Matrix entity_transform = entity.GetTransform();
   Matrix basis_transform = entity_transform.Basis();
 
-  VS::BindFrameInfo(pass,
-                    renderer.GetTransientsBuffer().EmplaceUniform(frame_info));
+  BufferView frame_info_view =
+      renderer.GetTransientsBuffer().EmplaceUniform(frame_info);
 
   FS::FragInfo frag_info;
   frag_info.use_text_color = force_text_color_ ? 1.0 : 0.0;
   frag_info.text_color = ToVector(color.Premultiply());
   frag_info.is_color_glyph = type == GlyphAtlas::Type::kColorBitmap;
 
-  FS::BindFragInfo(pass,
-                   renderer.GetTransientsBuffer().EmplaceUniform(frag_info));
+  BufferView frag_info_view =
+      renderer.GetTransientsBuffer().EmplaceUniform(frag_info);
 
   SamplerDescriptor sampler_desc;
   if (is_translation_scale) {
@@ -140,12 +140,8 @@ bool TextContents::Render(const ContentContext& renderer,
   // No mipmaps for glyph atlas (glyphs are generated at exact scales).
   sampler_desc.mip_filter = MipFilter::kBase;
 
-  FS::BindGlyphAtlasSampler(
-      pass,                 // command
-      atlas->GetTexture(),  // texture
-      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-          sampler_desc)  // sampler
-  );
+  const std::unique_ptr<const Sampler>& sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
 
   // Common vertex information for all glyphs.
   // All glyphs are given the same vertex information in the form of a
@@ -165,12 +161,33 @@ bool TextContents::Render(const ContentContext& renderer,
   }
   vertex_count *= 6;
 
+  // Glyphs are grouped by the page of the atlas that contains them, and each
+  // page is drawn with a separate draw call.
+  const size_t page_count = atlas->GetPageCount();
+  FML_DCHECK(page_count <= GlyphAtlas::kMaxPageCount);
+  std::array<size_t, GlyphAtlas::kMaxPageCount> page_vertex_counts = {};
+  std::array<ISize, GlyphAtlas::kMaxPageCount> atlas_sizes;
+  for (size_t page = 0u; page < page_count; page++) {
+    atlas_sizes[page] = atlas->GetTexture(page)->GetSize();
+  }
+
   BufferView buffer_view = host_buffer.Emplace(
       vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
       [&](uint8_t* contents) {
         VS::PerVertexData vtx;
         VS::PerVertexData* vtx_contents =
             reinterpret_cast<VS::PerVertexData*>(contents);
+        // With a single page, the vertices are written in place. Otherwise
+        // they are generated in glyph order and then moved into per page
+        // ranges, so that the runs are only walked once.
+        std::vector<VS::PerVertexData> glyph_order_vertices;
+        std::vector<uint8_t> glyph_pages;
+        VS::PerVertexData* vtx_out = vtx_contents;
+        if (page_count > 1u) {
+          glyph_order_vertices.resize(vertex_count);
+          glyph_pages.reserve(vertex_count / unit_points.size());
+          vtx_out = glyph_order_vertices.data();
+        }
         size_t i = 0u;
         size_t bounds_offset = 0u;
         for (const TextRun& run : frame_->GetRuns()) {
@@ -205,6 +222,7 @@ bool TextContents::Render(const ContentContext& renderer,
             bounds_offset++;
             auto atlas_glyph_bounds = frame_bounds.atlas_bounds;
             auto glyph_bounds = frame_bounds.glyph_bounds;
+            size_t glyph_page = frame_bounds.page;
 
             // If frame_bounds.is_placeholder is true, this is the first frame
             // the glyph has been rendered and so its atlas position was not
@@ -236,7 +254,12 @@ bool TextContents::Render(const ContentContext& renderer,
               }
               atlas_glyph_bounds =
                   maybe_atlas_glyph_bounds.value().atlas_bounds;
+              glyph_page = maybe_atlas_glyph_bounds.value().page;
             }
+            if (glyph_page >= page_count) {
+              continue;
+            }
+            const ISize atlas_size = atlas_sizes[glyph_page];
 
             Rect scaled_bounds = glyph_bounds.Scale(1.0 / rounded_scale);
             // For each glyph, we compute two rectangles. One for the vertex
@@ -271,17 +294,54 @@ bool TextContents::Render(const ContentContext& renderer,
               }
               vtx.uv = uv_origin + (uv_size * point);
               vtx.position = position;
-              vtx_contents[i++] = vtx;
+              vtx_out[i++] = vtx;
+            }
+            page_vertex_counts[glyph_page] += unit_points.size();
+            if (page_count > 1u) {
+              glyph_pages.push_back(glyph_page);
             }
           }
         }
-      });
 
-  pass.SetVertexBuffer(std::move(buffer_view));
-  pass.SetIndexBuffer({}, IndexType::kNone);
-  pass.SetElementCount(vertex_count);
+        if (page_count > 1u) {
+          std::array<size_t, GlyphAtlas::kMaxPageCount> page_offsets;
+          size_t offset = 0u;
+          for (size_t page = 0u; page < page_count; page++) {
+            page_offsets[page] = offset;
+            offset += page_vertex_counts[page];
+          }
+          for (size_t glyph = 0u; glyph < glyph_pages.size(); glyph++) {
+            size_t& page_offset = page_offsets[glyph_pages[glyph]];
+            std::copy_n(&glyph_order_vertices[glyph * unit_points.size()],
+                        unit_points.size(), &vtx_contents[page_offset]);
+            page_offset += unit_points.size();
+          }
+        }
+      });
 
-  return pass.Draw().ok();
+  size_t base_vertex = 0u;
+  for (size_t page = 0u; page < page_count; page++) {
+    if (page_vertex_counts[page] == 0u) {
+      continue;
+    }
+    pass.SetCommandLabel("TextFrame");
+    pass.SetPipeline(pipeline);
+    VS::BindFrameInfo(pass, frame_info_view);
+    FS::BindFragInfo(pass, frag_info_view);
+    FS::BindGlyphAtlasSampler(pass,                     // command
+                              atlas->GetTexture(page),  // texture
+                              sampler                   // sampler
+    );
+    pass.SetVertexBuffer(buffer_view);
+    pass.SetIndexBuffer({}, IndexType::kNone);
+    pass.SetBaseVertex(base_vertex);
+    pass.SetElementCount(page_vertex_counts[page]);
+    if (!pass.Draw().ok()) {
+      return false;
+    }
+    base_vertex += page_vertex_counts[page];
+  }
+  return true;
 }
 
 std::optional<GlyphProperties> TextContents::GetGlyphProperties() const {
@@ -27,6 +27,7 @@ GeometryResult Geometry::ComputePositionGeometry(
     const Entity& entity,
     RenderPass& pass) {
   using VT = SolidFillVertexShader::PerVertexData;
+  static_assert(sizeof(VT) == sizeof(Point));
 
   size_t count = generator.GetVertexCount();
 
@@ -37,14 +38,7 @@ GeometryResult Geometry::ComputePositionGeometry(
               .vertex_buffer = renderer.GetTransientsBuffer().Emplace(
                   count * sizeof(VT), alignof(VT),
                   [&generator](uint8_t* buffer) {
-                    auto vertices = reinterpret_cast<VT*>(buffer);
-                    generator.GenerateVertices([&vertices](const Point& p) {
-                      *vertices++ = {
-                          .position = p,
-                      };
-                    });
-                    FML_DCHECK(vertices == reinterpret_cast<VT*>(buffer) +
-                                               generator.GetVertexCount());
+                    generator.WriteVertices(reinterpret_cast<Point*>(buffer));
                   }),
               .vertex_count = count,
               .index_type = IndexType::kNone,
@@ -0,0 +1,182 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/geometry_prepass.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/geometry/stroke_path_geometry.h"
+
+namespace impeller {
+
+namespace {
+
+// Strokes are handed out in small batches so that the overhead of the shared
+// counter stays low while still balancing work between threads when a few
+// paths are much larger than the rest.
+constexpr size_t kStrokesPerBatch = 4u;
+
+struct PrepareState {
+  explicit PrepareState(size_t p_batch_count)
+      : batch_count(p_batch_count), completed_batches(p_batch_count) {}
+
+  const size_t batch_count;
+  std::atomic_size_t next_batch = 0u;
+  fml::CountDownLatch completed_batches;
+};
+
+}  // namespace
+
+std::size_t GeometryPrepass::StrokeKey::Hash::operator()(
+    const StrokeKey& key) const {
+  return fml::HashCombine(key.path_identity, key.stroke_width, key.miter_limit,
+                          key.stroke_cap, key.stroke_join, key.scale);
+}
+
+bool GeometryPrepass::StrokeKey::Equal::operator()(const StrokeKey& lhs,
+                                                   const StrokeKey& rhs) const {
+  return lhs.path_identity == rhs.path_identity &&
+         lhs.stroke_width == rhs.stroke_width &&
+         lhs.miter_limit == rhs.miter_limit &&
+         lhs.stroke_cap == rhs.stroke_cap &&
+         lhs.stroke_join == rhs.stroke_join && lhs.scale == rhs.scale;
+}
+
+GeometryPrepass::GeometryPrepass() = default;
+
+GeometryPrepass::~GeometryPrepass() = default;
+
+void GeometryPrepass::SetWorkerTaskRunner(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner) {
+  worker_task_runner_ = std::move(worker_task_runner);
+}
+
+bool GeometryPrepass::IsEnabled() const {
+  return worker_task_runner_ != nullptr;
+}
+
+void GeometryPrepass::AddStroke(const Path& path,
+                                Scalar stroke_width,
+                                Scalar miter_limit,
+                                Cap stroke_cap,
+                                Join stroke_join,
+                                Scalar scale) {
+  // Strokes recorded while a prepared frame is still being encoded (for
+  // example by a nested snapshot) are simply tessellated serially.
+  if (prepared_ || stroke_width < 0.0 || scale == 0) {
+    return;
+  }
+  StrokeKey key{
+      .path_identity = path.GetIdentity(),
+      .stroke_width = stroke_width,
+      .miter_limit = miter_limit,
+      .stroke_cap = stroke_cap,
+      .stroke_join = stroke_join,
+      .scale = scale,
+  };
+  auto [_, inserted] = job_index_.try_emplace(key, jobs_.size());
+  if (!inserted) {
+    return;
+  }
+  jobs_.push_back(StrokeJob{
+      .path = path,
+      .stroke_width = stroke_width,
+      .miter_limit = miter_limit,
+      .stroke_cap = stroke_cap,
+      .stroke_join = stroke_join,
+      .scale = scale,
+  });
+}
+
+void GeometryPrepass::GenerateJob(StrokeJob& job) const {
+  job.vertices = StrokePathGeometry::GenerateStrokeVertices(
+      job.path, job.stroke_width, job.miter_limit, job.stroke_cap,
+      job.stroke_join, job.scale);
+}
+
+void GeometryPrepass::Prepare() {
+  TRACE_EVENT0("impeller", "GeometryPrepass::Prepare");
+  if (prepared_) {
+    return;
+  }
+  prepared_ = true;
+  stats_.prepared_strokes += jobs_.size();
+
+  size_t batch_count =
+      (jobs_.size() + kStrokesPerBatch - 1) / kStrokesPerBatch;
+  if (batch_count <= 1 || !worker_task_runner_) {
+    for (StrokeJob& job : jobs_) {
+      GenerateJob(job);
+    }
+    return;
+  }
+
+  // Each job writes only to its own slot, so the only shared state is the
+  // batch counter. The raster thread claims batches too and only waits for
+  // batches that have been claimed, never for worker tasks that have not
+  // started yet: the pool is shared with pipeline compilation and a task may
+  // sit in the queue well past this frame. Such a task finds no batches left
+  // and returns without touching |jobs_|.
+  auto state = std::make_shared<PrepareState>(batch_count);
+  auto run_batches = [this, state]() {
+    size_t batch;
+    while ((batch = state->next_batch.fetch_add(
+                1u, std::memory_order_relaxed)) < state->batch_count) {
+      size_t begin = batch * kStrokesPerBatch;
+      size_t end = std::min(begin + kStrokesPerBatch, jobs_.size());
+      for (size_t i = begin; i < end; i++) {
+        GenerateJob(jobs_[i]);
+      }
+      state->completed_batches.CountDown();
+    }
+  };
+
+  size_t worker_count = std::min<size_t>(
+      batch_count - 1, std::max(1u, std::thread::hardware_concurrency()));
+  for (size_t i = 0; i < worker_count; i++) {
+    worker_task_runner_->PostTask(run_batches);
+  }
+  run_batches();
+  state->completed_batches.Wait();
+}
+
+const std::vector<GeometryPrepass::VertexData>* GeometryPrepass::FindStroke(
+    const Path& path,
+    Scalar stroke_width,
+    Scalar miter_limit,
+    Cap stroke_cap,
+    Join stroke_join,
+    Scalar scale) const {
+  if (!prepared_ || job_index_.empty()) {
+    return nullptr;
+  }
+  StrokeKey key{
+      .path_identity = path.GetIdentity(),
+      .stroke_width = stroke_width,
+      .miter_limit = miter_limit,
+      .stroke_cap = stroke_cap,
+      .stroke_join = stroke_join,
+      .scale = scale,
+  };
+  auto found = job_index_.find(key);
+  if (found == job_index_.end()) {
+    stats_.misses++;
+    return nullptr;
+  }
+  stats_.hits++;
+  return &jobs_[found->second].vertices;
+}
+
+void GeometryPrepass::Reset() {
+  jobs_.clear();
+  job_index_.clear();
+  prepared_ = false;
+}
+
+}  // namespace impeller
@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_GEOMETRY_PREPASS_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_GEOMETRY_PREPASS_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "impeller/entity/solid_fill.vert.h"
+#include "impeller/geometry/path.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A frame scoped store of stroke vertices that are generated
+///             ahead of entity encoding.
+///
+///             Recording a frame is serial: every |Geometry| tessellates its
+///             path on the raster thread while the render pass is encoded.
+///             Stroke expansion is by far the most expensive part of that
+///             work and only depends on the path, the stroke parameters and
+///             the transform scale, none of which are tied to the render
+///             pass. When a worker task runner is provided, the first pass
+///             over a display list records the stroked paths it sees here,
+///             |Prepare| expands them on the concurrent loop and the
+///             |StrokePathGeometry| instances created while encoding pick up
+///             the prepared vertices. Only the copy into the |HostBuffer|
+///             remains on the raster thread, so command ordering is
+///             unchanged.
+///
+///             Fills are not prepared: convex tessellation already streams
+///             directly into host buffer memory, so precomputing them would
+///             only add a copy.
+///
+///             This class is not thread safe. |AddStroke|, |Prepare|,
+///             |FindStroke| and |Reset| must all be called from the raster
+///             thread; only the work spawned by |Prepare| runs elsewhere.
+///
+class GeometryPrepass {
+ public:
+  using VertexData = SolidFillVertexShader::PerVertexData;
+
+  struct Stats {
+    /// The number of distinct strokes prepared.
+    size_t prepared_strokes = 0u;
+    /// The number of lookups that found prepared vertices.
+    size_t hits = 0u;
+    /// The number of lookups that had to fall back to tessellating on the
+    /// raster thread.
+    size_t misses = 0u;
+  };
+
+  GeometryPrepass();
+
+  ~GeometryPrepass();
+
+  /// @brief  Enables the prepass by providing the runner used to expand
+  ///         strokes. Passing nullptr disables it, which is the default.
+  void SetWorkerTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
+  /// @brief  Whether strokes should be recorded for this frame.
+  bool IsEnabled() const;
+
+  /// @brief  Record a stroke that will be drawn in the current frame.
+  ///
+  ///         Duplicate strokes of the same path data with the same
+  ///         parameters are only generated once.
+  void AddStroke(const Path& path,
+                 Scalar stroke_width,
+                 Scalar miter_limit,
+                 Cap stroke_cap,
+                 Join stroke_join,
+                 Scalar scale);
+
+  /// @brief  Generate the vertices for all recorded strokes.
+  ///
+  ///         Work is split between the worker task runner and the calling
+  ///         thread, and this call blocks until every recorded stroke is
+  ///         ready. Without a worker task runner, the strokes are generated
+  ///         inline.
+  void Prepare();
+
+  /// @brief  Look up the vertices prepared for a stroke, or nullptr if the
+  ///         stroke was not recorded and prepared in this frame.
+  const std::vector<VertexData>* FindStroke(const Path& path,
+                                            Scalar stroke_width,
+                                            Scalar miter_limit,
+                                            Cap stroke_cap,
+                                            Join stroke_join,
+                                            Scalar scale) const;
+
+  /// @brief  Drop all recorded and prepared strokes. Called once the frame
+  ///         has been encoded.
+  void Reset();
+
+  /// @brief  Counters accumulated over all frames since creation.
+  const Stats& GetStats() const { return stats_; }
+
+ private:
+  struct StrokeKey {
+    const void* path_identity;
+    Scalar stroke_width;
+    Scalar miter_limit;
+    Cap stroke_cap;
+    Join stroke_join;
+    Scalar scale;
+
+    struct Hash {
+      std::size_t operator()(const StrokeKey& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const StrokeKey& lhs, const StrokeKey& rhs) const;
+    };
+  };
+
+  struct StrokeJob {
+    // Holding a copy of the path keeps the shared path data, and therefore
+    // the identity used in |StrokeKey|, alive until |Reset|.
+    Path path;
+    Scalar stroke_width;
+    Scalar miter_limit;
+    Cap stroke_cap;
+    Join stroke_join;
+    Scalar scale;
+    std::vector<VertexData> vertices;
+  };
+
+  void GenerateJob(StrokeJob& job) const;
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  std::vector<StrokeJob> jobs_;
+  std::unordered_map<StrokeKey, size_t, StrokeKey::Hash, StrokeKey::Equal>
+      job_index_;
+  bool prepared_ = false;
+  mutable Stats stats_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GeometryPrepass);
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_GEOMETRY_PREPASS_H_
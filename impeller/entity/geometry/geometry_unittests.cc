@@ -3,11 +3,14 @@
 // found in the LICENSE file.
 
 #include <memory>
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/geometry_prepass.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
@@ -152,5 +155,180 @@ TEST(EntityGeometryTest, AlphaCoverageStrokePaths) {
   EXPECT_EQ(Geometry::MakeStrokePath({}, 40)->ComputeAlphaCoverage(matrix), 1);
 }
 
+TEST(EntityGeometryTest, GeometryPrepassMatchesSerialStrokes) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  GeometryPrepass prepass;
+  prepass.SetWorkerTaskRunner(loop->GetTaskRunner());
+  ASSERT_TRUE(prepass.IsEnabled());
+
+  std::vector<Path> paths;
+  for (int i = 0; i < 20; i++) {
+    paths.push_back(PathBuilder{}
+                        .MoveTo({0, 0})
+                        .CubicCurveTo({10, 40.0f + i}, {60, -20}, {100, 0})
+                        .QuadraticCurveTo({120, 50}, {80, 80.0f + i})
+                        .TakePath());
+  }
+  for (const Path& path : paths) {
+    prepass.AddStroke(path, 5, 4, Cap::kRound, Join::kRound, 2);
+  }
+  prepass.Prepare();
+
+  for (const Path& path : paths) {
+    auto* prepared =
+        prepass.FindStroke(path, 5, 4, Cap::kRound, Join::kRound, 2);
+    ASSERT_NE(prepared, nullptr);
+    EXPECT_SOLID_VERTICES_NEAR(
+        *prepared, StrokePathGeometry::GenerateStrokeVertices(
+                       path, 5, 4, Cap::kRound, Join::kRound, 2));
+  }
+  EXPECT_EQ(prepass.GetStats().prepared_strokes, 20u);
+  EXPECT_EQ(prepass.GetStats().hits, 20u);
+}
+
+TEST(EntityGeometryTest, GeometryPrepassKeysOnPathIdentityAndParameters) {
+  GeometryPrepass prepass;
+  // Without a worker task runner the strokes are generated inline.
+  EXPECT_FALSE(prepass.IsEnabled());
+
+  Path path = PathBuilder{}.MoveTo({0, 0}).LineTo({100, 100}).TakePath();
+  Path copy = path;
+  Path same_contents =
+      PathBuilder{}.MoveTo({0, 0}).LineTo({100, 100}).TakePath();
+
+  prepass.AddStroke(path, 5, 4, Cap::kButt, Join::kMiter, 1);
+  prepass.AddStroke(copy, 5, 4, Cap::kButt, Join::kMiter, 1);
+  prepass.Prepare();
+  EXPECT_EQ(prepass.GetStats().prepared_strokes, 1u);
+
+  EXPECT_NE(prepass.FindStroke(copy, 5, 4, Cap::kButt, Join::kMiter, 1),
+            nullptr);
+  EXPECT_EQ(
+      prepass.FindStroke(same_contents, 5, 4, Cap::kButt, Join::kMiter, 1),
+      nullptr);
+  EXPECT_EQ(prepass.FindStroke(path, 6, 4, Cap::kButt, Join::kMiter, 1),
+            nullptr);
+  EXPECT_EQ(prepass.FindStroke(path, 5, 4, Cap::kButt, Join::kMiter, 2),
+            nullptr);
+  EXPECT_EQ(prepass.GetStats().hits, 1u);
+  EXPECT_EQ(prepass.GetStats().misses, 3u);
+
+  prepass.Reset();
+  EXPECT_EQ(prepass.FindStroke(path, 5, 4, Cap::kButt, Join::kMiter, 1),
+            nullptr);
+}
+
+TEST(EntityGeometryTest, TessellationCacheQuantizesScaleUpward) {
+  EXPECT_EQ(TessellationCache::QuantizeScale(1.0f), 1.0f);
+  EXPECT_EQ(TessellationCache::QuantizeScale(2.0f), 2.0f);
+  EXPECT_EQ(TessellationCache::QuantizeScale(0.5f), 0.5f);
+  for (Scalar scale = 0.1f; scale < 10.0f; scale += 0.37f) {
+    Scalar quantized = TessellationCache::QuantizeScale(scale);
+    EXPECT_GE(quantized, scale);
+    EXPECT_LT(quantized, scale * 1.05f);
+  }
+  EXPECT_EQ(TessellationCache::QuantizeScale(0.0f), 0.0f);
+}
+
+TEST(EntityGeometryTest, TessellationCacheIsDisabledByDefault) {
+  TessellationCache cache;
+  EXPECT_FALSE(cache.IsEnabled());
+
+  Path path = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  auto layout = TessellationCache::FillLayout::kTriangleStrip;
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(cache.FindOrTessellateFill(path, 1.0f, layout), nullptr);
+  }
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+}
+
+TEST(EntityGeometryTest, TessellationCacheAdmitsFillsOnSecondMiss) {
+  TessellationCache cache(TessellationCache::kRecommendedMaxBytes);
+  Path path = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  Path copy = path;
+  Path same_contents = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  auto layout = TessellationCache::FillLayout::kTriangleStrip;
+
+  EXPECT_EQ(cache.FindOrTessellateFill(path, 1.0f, layout), nullptr);
+  const TessellationCache::Fill* fill =
+      cache.FindOrTessellateFill(path, 1.0f, layout);
+  ASSERT_NE(fill, nullptr);
+  EXPECT_EQ(cache.FindOrTessellateFill(copy, 1.0f, layout), fill);
+
+  std::vector<Point> points;
+  std::vector<uint16_t> indices;
+  Tessellator::TessellateConvexInternal(path, points, indices, 1.0f);
+  EXPECT_EQ(fill->points, points);
+  EXPECT_EQ(fill->indices, indices);
+
+  // The key is the path data identity, not its contents, and the layout and
+  // scale are part of the key.
+  EXPECT_EQ(cache.FindOrTessellateFill(same_contents, 1.0f, layout), nullptr);
+  EXPECT_EQ(cache.FindOrTessellateFill(path, 2.0f, layout), nullptr);
+  EXPECT_EQ(cache.FindOrTessellateFill(
+                path, 1.0f, TessellationCache::FillLayout::kRestartTriangleFan),
+            nullptr);
+
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(cache.GetStats().hits, 1u);
+  EXPECT_EQ(cache.GetStats().misses, 5u);
+  EXPECT_EQ(cache.GetStats().insertions, 1u);
+  EXPECT_NEAR(cache.GetStats().GetHitRate(), 1.0f / 6.0f, kEhCloseEnough);
+}
+
+TEST(EntityGeometryTest, TessellationCacheStoresStrokes) {
+  TessellationCache cache(TessellationCache::kRecommendedMaxBytes);
+  Path path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .CubicCurveTo({10, 40}, {60, -20}, {100, 0})
+                  .TakePath();
+  auto vertices = StrokePathGeometry::GenerateStrokeVertices(
+      path, 5, 4, Cap::kRound, Join::kRound, 2);
+
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(cache.FindStroke(path, 5, 4, Cap::kRound, Join::kRound, 2),
+              nullptr);
+    cache.StoreStroke(path, 5, 4, Cap::kRound, Join::kRound, 2, vertices);
+  }
+  auto* cached = cache.FindStroke(path, 5, 4, Cap::kRound, Join::kRound, 2);
+  ASSERT_NE(cached, nullptr);
+  EXPECT_SOLID_VERTICES_NEAR(*cached, vertices);
+  EXPECT_EQ(cache.FindStroke(path, 5, 4, Cap::kButt, Join::kRound, 2),
+            nullptr);
+}
+
+TEST(EntityGeometryTest, TessellationCacheEvictsLeastRecentlyUsed) {
+  std::vector<Path> paths;
+  for (int i = 0; i < 3; i++) {
+    paths.push_back(PathBuilder{}.AddCircle({100.0f + i, 100}, 10).TakePath());
+  }
+  auto layout = TessellationCache::FillLayout::kTriangleStrip;
+
+  TessellationCache cache(TessellationCache::kRecommendedMaxBytes);
+  for (int i = 0; i < 2; i++) {
+    cache.FindOrTessellateFill(paths[0], 1.0f, layout);
+    cache.FindOrTessellateFill(paths[1], 1.0f, layout);
+  }
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  // Make the second path the least recently used and shrink the cache to
+  // fit only two entries.
+  cache.FindOrTessellateFill(paths[0], 1.0f, layout);
+  size_t max_bytes = cache.GetByteSize() + 1u;
+  cache.SetMaxBytes(max_bytes);
+  for (int i = 0; i < 2; i++) {
+    cache.FindOrTessellateFill(paths[2], 1.0f, layout);
+  }
+  EXPECT_LE(cache.GetByteSize(), max_bytes);
+  EXPECT_EQ(cache.GetStats().evictions, 1u);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_NE(cache.FindOrTessellateFill(paths[0], 1.0f, layout), nullptr);
+  EXPECT_NE(cache.FindOrTessellateFill(paths[2], 1.0f, layout), nullptr);
+
+  cache.SetMaxBytes(0u);
+  EXPECT_FALSE(cache.IsEnabled());
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+  EXPECT_EQ(cache.FindOrTessellateFill(paths[0], 1.0f, layout), nullptr);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,9 +4,17 @@
 
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/geometry_prepass.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/path_component.h"
@@ -17,43 +25,116 @@ using VS = SolidFillVertexShader;
 
 namespace {
 
+// Caps and joins are plain function pointers rather than std::function so
+// that emitting them costs a direct call per contour end and per corner.
 template <typename VertexWriter>
-using CapProc = std::function<void(VertexWriter& vtx_builder,
-                                   const Point& position,
-                                   const Point& offset,
-                                   Scalar scale,
-                                   bool reverse)>;
+using CapProc = void (*)(VertexWriter& vtx_builder,
+                         const Point& position,
+                         const Point& offset,
+                         Scalar scale,
+                         bool reverse);
 
 template <typename VertexWriter>
-using JoinProc = std::function<void(VertexWriter& vtx_builder,
-                                    const Point& position,
-                                    const Point& start_offset,
-                                    const Point& end_offset,
-                                    Scalar miter_limit,
-                                    Scalar scale)>;
+using JoinProc = void (*)(VertexWriter& vtx_builder,
+                          const Point& position,
+                          const Point& start_offset,
+                          const Point& end_offset,
+                          Scalar miter_limit,
+                          Scalar scale);
+
+static_assert(sizeof(VS::PerVertexData) == sizeof(Point));
+
+/// Stores |center| + |offset| and |center| - |offset| to |output|, the two
+/// sides of the stroke at one point, with a single 4 lane add.
+inline void StoreVertexPair(Point* output,
+                            const Point& center,
+                            const Point& offset) {
+#if defined(__SSE2__)
+  __m128 centers = _mm_setr_ps(center.x, center.y, center.x, center.y);
+  __m128 offsets = _mm_setr_ps(offset.x, offset.y, -offset.x, -offset.y);
+  _mm_storeu_ps(reinterpret_cast<float*>(output), _mm_add_ps(centers, offsets));
+#elif defined(__ARM_NEON)
+  float32x2_t centers = vld1_f32(reinterpret_cast<const float*>(&center));
+  float32x2_t offsets = vld1_f32(reinterpret_cast<const float*>(&offset));
+  vst1q_f32(reinterpret_cast<float*>(output),
+            vcombine_f32(vadd_f32(centers, offsets),
+                         vsub_f32(centers, offsets)));
+#else
+  output[0] = center + offset;
+  output[1] = center - offset;
+#endif
+}
 
 class PositionWriter {
  public:
+  void Reserve(size_t count) { data_.reserve(count); }
+
   void AppendVertex(const Point& point) {
     data_.emplace_back(SolidFillVertexShader::PerVertexData{.position = point});
   }
 
+  void AppendVertexPair(const Point& center, const Point& offset) {
+    size_t count = data_.size();
+    data_.resize(count + 2);
+    StoreVertexPair(&data_[count].position, center, offset);
+  }
+
   const std::vector<SolidFillVertexShader::PerVertexData>& GetData() const {
     return data_;
   }
 
+  std::vector<SolidFillVertexShader::PerVertexData> TakeData() {
+    return std::move(data_);
+  }
+
  private:
   std::vector<SolidFillVertexShader::PerVertexData> data_ = {};
 };
 
+/// Writes the vertices straight to a fixed size range, such as one emplaced
+/// on the host buffer. Vertices past |capacity| are dropped and the writer
+/// is marked as overflowed so that the caller can start over with a
+/// |PositionWriter|.
+class BoundedPositionWriter {
+ public:
+  BoundedPositionWriter(SolidFillVertexShader::PerVertexData* data,
+                        size_t capacity)
+      : data_(data), capacity_(capacity) {}
+
+  void Reserve(size_t count) {}
+
+  void AppendVertex(const Point& point) {
+    if (count_ < capacity_) {
+      data_[count_].position = point;
+    }
+    count_++;
+  }
+
+  void AppendVertexPair(const Point& center, const Point& offset) {
+    if (count_ + 2 <= capacity_) {
+      StoreVertexPair(&data_[count_].position, center, offset);
+    }
+    count_ += 2;
+  }
+
+  size_t GetCount() const { return count_; }
+
+  bool HasOverflowed() const { return count_ > capacity_; }
+
+ private:
+  SolidFillVertexShader::PerVertexData* data_;
+  size_t capacity_;
+  size_t count_ = 0;
+};
+
 template <typename VertexWriter>
 class StrokeGenerator {
  public:
   StrokeGenerator(const Path::Polyline& p_polyline,
                   const Scalar p_stroke_width,
                   const Scalar p_scaled_miter_limit,
-                  const JoinProc<VertexWriter>& p_join_proc,
-                  const CapProc<VertexWriter>& p_cap_proc,
+                  const JoinProc<VertexWriter> p_join_proc,
+                  const CapProc<VertexWriter> p_cap_proc,
                   const Scalar p_scale)
       : polyline(p_polyline),
         stroke_width(p_stroke_width),
@@ -192,17 +273,12 @@ class StrokeGenerator {
 
       Point offset_vector = offset.GetVector();
 
-      vtx.position = polyline.GetPoint(point_i) + offset_vector;
-      vtx_builder.AppendVertex(vtx.position);
-      vtx.position = polyline.GetPoint(point_i) - offset_vector;
-      vtx_builder.AppendVertex(vtx.position);
+      vtx_builder.AppendVertexPair(polyline.GetPoint(point_i), offset_vector);
 
       // For line components, two additional points need to be appended
       // prior to appending a join connecting the next component.
-      vtx.position = polyline.GetPoint(point_i + 1) + offset_vector;
-      vtx_builder.AppendVertex(vtx.position);
-      vtx.position = polyline.GetPoint(point_i + 1) - offset_vector;
-      vtx_builder.AppendVertex(vtx.position);
+      vtx_builder.AppendVertexPair(polyline.GetPoint(point_i + 1),
+                                   offset_vector);
 
       previous_offset = offset;
       offset = ComputeOffset(point_i + 2, contour_start_point_i,
@@ -229,10 +305,8 @@ class StrokeGenerator {
          point_i++) {
       bool is_end_of_component = point_i == component_end_index - 1;
 
-      vtx.position = polyline.GetPoint(point_i) + offset.GetVector();
-      vtx_builder.AppendVertex(vtx.position);
-      vtx.position = polyline.GetPoint(point_i) - offset.GetVector();
-      vtx_builder.AppendVertex(vtx.position);
+      vtx_builder.AppendVertexPair(polyline.GetPoint(point_i),
+                                   offset.GetVector());
 
       previous_offset = offset;
       offset = ComputeOffset(point_i + 2, contour_start_point_i,
@@ -257,10 +331,7 @@ class StrokeGenerator {
             Scalar signed_angle = angle_total < 0 ? -angle : angle;
             Point offset =
                 previous_offset.GetVector().Rotate(Radians(signed_angle));
-            vtx.position = polyline.GetPoint(point_i) + offset;
-            vtx_builder.AppendVertex(vtx.position);
-            vtx.position = polyline.GetPoint(point_i) - offset;
-            vtx_builder.AppendVertex(vtx.position);
+            vtx_builder.AppendVertexPair(polyline.GetPoint(point_i), offset);
 
             angle += kAngleThreshold;
           }
@@ -279,10 +350,8 @@ class StrokeGenerator {
         Point last_component_offset = is_last_component
                                           ? offset.GetVector()
                                           : previous_offset.GetVector();
-        vtx.position = polyline.GetPoint(point_i + 1) + last_component_offset;
-        vtx_builder.AppendVertex(vtx.position);
-        vtx.position = polyline.GetPoint(point_i + 1) - last_component_offset;
-        vtx_builder.AppendVertex(vtx.position);
+        vtx_builder.AppendVertexPair(polyline.GetPoint(point_i + 1),
+                                     last_component_offset);
         // Generate join from the current line to the next line.
         if (!is_last_component) {
           join_proc(vtx_builder, polyline.GetPoint(point_i + 1),
@@ -296,8 +365,8 @@ class StrokeGenerator {
   const Path::Polyline& polyline;
   const Scalar stroke_width;
   const Scalar scaled_miter_limit;
-  const JoinProc<VertexWriter>& join_proc;
-  const CapProc<VertexWriter>& cap_proc;
+  const JoinProc<VertexWriter> join_proc;
+  const CapProc<VertexWriter> cap_proc;
   const Scalar scale;
 
   SeparatedVector2 previous_offset;
@@ -312,11 +381,7 @@ void CreateButtCap(VertexWriter& vtx_builder,
                    Scalar scale,
                    bool reverse) {
   Point orientation = offset * (reverse ? -1 : 1);
-  VS::PerVertexData vtx;
-  vtx.position = position + orientation;
-  vtx_builder.AppendVertex(vtx.position);
-  vtx.position = position - orientation;
-  vtx_builder.AppendVertex(vtx.position);
+  vtx_builder.AppendVertexPair(position, orientation);
 }
 
 template <typename VertexWriter>
@@ -342,11 +407,9 @@ void CreateRoundCap(VertexWriter& vtx_builder,
         forward + orientation * PathBuilder::kArcApproximationMagic, forward);
   }
 
-  Point vtx = position + orientation;
-  vtx_builder.AppendVertex(vtx);
-  vtx = position - orientation;
-  vtx_builder.AppendVertex(vtx);
+  vtx_builder.AppendVertexPair(position, orientation);
 
+  Point vtx;
   arc.ToLinearPathComponents(scale, [&vtx_builder, &vtx, forward_normal,
                                      position](const Point& point) {
     vtx = position + point;
@@ -365,14 +428,9 @@ void CreateSquareCap(VertexWriter& vtx_builder,
   Point orientation = offset * (reverse ? -1 : 1);
   Point forward(offset.y, -offset.x);
 
-  Point vtx = position + orientation;
-  vtx_builder.AppendVertex(vtx);
-  vtx = position - orientation;
-  vtx_builder.AppendVertex(vtx);
-  vtx = position + orientation + forward;
-  vtx_builder.AppendVertex(vtx);
-  vtx = position - orientation + forward;
-  vtx_builder.AppendVertex(vtx);
+  vtx_builder.AppendVertexPair(position, orientation);
+  vtx_builder.AppendVertex(position + orientation + forward);
+  vtx_builder.AppendVertex(position - orientation + forward);
 }
 
 template <typename VertexWriter>
@@ -478,11 +536,16 @@ void CreateSolidStrokeVertices(VertexWriter& vtx_builder,
                                const Path::Polyline& polyline,
                                Scalar stroke_width,
                                Scalar scaled_miter_limit,
-                               const JoinProc<VertexWriter>& join_proc,
-                               const CapProc<VertexWriter>& cap_proc,
+                               const JoinProc<VertexWriter> join_proc,
+                               const CapProc<VertexWriter> cap_proc,
                                Scalar scale) {
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
+  // Every polyline point produces at least two vertices and every contour
+  // adds a few more for its caps or closing join. Reserving that up front
+  // avoids most of the reallocations as the strip grows.
+  vtx_builder.Reserve(polyline.points->size() * 2 +
+                      polyline.contours.size() * 8);
+  StrokeGenerator<VertexWriter> stroke_generator(
+      polyline, stroke_width, scaled_miter_limit, join_proc, cap_proc, scale);
   stroke_generator.Generate(vtx_builder);
 }
 
@@ -510,6 +573,60 @@ CapProc<VertexWriter> GetCapProc(Cap stroke_cap) {
       return &CreateSquareCap<VertexWriter>;
   }
 }
+
+/// An upper bound of the vertices that |CreateSolidStrokeVertices| makes for
+/// |polyline|, except for the extra vertices that bridge very sharp turns
+/// inside of curves, which are rare enough to be left to the overflow check
+/// of |BoundedPositionWriter|.
+size_t ComputeMaxStrokeVertexCount(const Path::Polyline& polyline,
+                                   Scalar stroke_width,
+                                   Join stroke_join,
+                                   Cap stroke_cap,
+                                   Scalar scale) {
+  // Round caps and joins are at most a quarter circle of the stroke radius
+  // and emit 2 vertices per point of its polyline.
+  Scalar radius = stroke_width * 0.5f;
+  Scalar handle = radius * PathBuilder::kArcApproximationMagic;
+  size_t arc_vertex_count =
+      2 * CubicPathComponent({radius, 0}, {radius, handle}, {handle, radius},
+                             {0, radius})
+              .CountLinearPathComponents(scale);
+
+  size_t cap_vertex_count = 0;
+  switch (stroke_cap) {
+    case Cap::kButt:
+      cap_vertex_count = 2;
+      break;
+    case Cap::kRound:
+      cap_vertex_count = 2 + arc_vertex_count;
+      break;
+    case Cap::kSquare:
+      cap_vertex_count = 4;
+      break;
+  }
+  size_t join_vertex_count = 0;
+  switch (stroke_join) {
+    case Join::kBevel:
+      join_vertex_count = 3;
+      break;
+    case Join::kMiter:
+      join_vertex_count = 4;
+      break;
+    case Join::kRound:
+      join_vertex_count = 3 + arc_vertex_count;
+      break;
+  }
+
+  size_t join_count = polyline.contours.size();
+  for (const Path::PolylineContour& contour : polyline.contours) {
+    join_count += contour.components.size();
+  }
+  // Line segments emit 4 vertices each, every contour may add 4 to pick up
+  // the pen and either 2 caps or a closing join.
+  return polyline.points->size() * 4 +
+         polyline.contours.size() * (4 + 2 * cap_vertex_count) +
+         join_count * join_vertex_count;
+}
 }  // namespace
 
 std::vector<SolidFillVertexShader::PerVertexData>
@@ -520,13 +637,34 @@ StrokePathGeometry::GenerateSolidStrokeVertices(const Path::Polyline& polyline,
                                                 Cap stroke_cap,
                                                 Scalar scale) {
   auto scaled_miter_limit = stroke_width * miter_limit * 0.5f;
-  auto join_proc = GetJoinProc<PositionWriter>(stroke_join);
-  auto cap_proc = GetCapProc<PositionWriter>(stroke_cap);
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
   PositionWriter vtx_builder;
-  stroke_generator.Generate(vtx_builder);
-  return vtx_builder.GetData();
+  CreateSolidStrokeVertices(vtx_builder, polyline, stroke_width,
+                            scaled_miter_limit,
+                            GetJoinProc<PositionWriter>(stroke_join),
+                            GetCapProc<PositionWriter>(stroke_cap), scale);
+  return vtx_builder.TakeData();
+}
+
+std::vector<SolidFillVertexShader::PerVertexData>
+StrokePathGeometry::GenerateStrokeVertices(const Path& path,
+                                           Scalar stroke_width,
+                                           Scalar miter_limit,
+                                           Cap stroke_cap,
+                                           Join stroke_join,
+                                           Scalar scale) {
+  if (stroke_width < 0.0 || scale == 0) {
+    return {};
+  }
+  Scalar min_size = kMinStrokeSize / scale;
+  Scalar clamped_stroke_width = std::max(stroke_width, min_size);
+
+  PositionWriter position_writer;
+  auto polyline = path.CreatePolyline(scale);
+  CreateSolidStrokeVertices(position_writer, polyline, clamped_stroke_width,
+                            miter_limit * stroke_width * 0.5f,
+                            GetJoinProc<PositionWriter>(stroke_join),
+                            GetCapProc<PositionWriter>(stroke_cap), scale);
+  return position_writer.TakeData();
 }
 
 StrokePathGeometry::StrokePathGeometry(const Path& path,
@@ -574,31 +712,87 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
     return {};
   }
 
-  Scalar min_size = kMinStrokeSize / max_basis;
-  Scalar stroke_width = std::max(stroke_width_, min_size);
-
   auto& host_buffer = renderer.GetTransientsBuffer();
   auto scale = entity.GetTransform().GetMaxBasisLengthXY();
 
+  // Use the vertices expanded ahead of time by the geometry prepass if this
+  // stroke was recorded in the first pass over the display list.
+  const std::vector<SolidFillVertexShader::PerVertexData>* vertices =
+      renderer.GetGeometryPrepass().FindStroke(path_, stroke_width_,
+                                               miter_limit_, stroke_cap_,
+                                               stroke_join_, scale);
   PositionWriter position_writer;
-  auto polyline = renderer.GetTessellator().CreateTempPolyline(path_, scale);
-  CreateSolidStrokeVertices(position_writer, polyline, stroke_width,
-                            miter_limit_ * stroke_width_ * 0.5f,
-                            GetJoinProc<PositionWriter>(stroke_join_),
-                            GetCapProc<PositionWriter>(stroke_cap_), scale);
-
-  BufferView buffer_view =
-      host_buffer.Emplace(position_writer.GetData().data(),
-                          position_writer.GetData().size() *
-                              sizeof(SolidFillVertexShader::PerVertexData),
-                          alignof(SolidFillVertexShader::PerVertexData));
+  TessellationCache& tessellation_cache = renderer.GetTessellationCache();
+  bool store_in_cache = false;
+  Scalar min_size = kMinStrokeSize / max_basis;
+  Scalar stroke_width = std::max(stroke_width_, min_size);
+  Scalar miter_limit = miter_limit_ * stroke_width_ * 0.5f;
+  if (!vertices && tessellation_cache.IsEnabled()) {
+    // The stroke width is clamped with the exact scale, only the polyline
+    // and round cap and join subdivisions use the quantized one.
+    scale = TessellationCache::QuantizeScale(scale);
+    vertices = tessellation_cache.FindStroke(
+        path_, stroke_width, miter_limit, stroke_cap_, stroke_join_, scale);
+    store_in_cache = !vertices;
+  }
+  BufferView buffer_view;
+  size_t vertex_count = 0;
+  bool written_to_host_buffer = false;
+  if (!vertices) {
+    auto polyline = renderer.GetTessellator().CreateTempPolyline(path_, scale);
+    if (!store_in_cache) {
+      // Nothing needs these vertices after this frame, so expand the stroke
+      // straight into the host buffer instead of copying it there.
+      size_t max_vertex_count = ComputeMaxStrokeVertexCount(
+          polyline, stroke_width, stroke_join_, stroke_cap_, scale);
+      buffer_view = host_buffer.EmplaceUpTo(
+          max_vertex_count * sizeof(SolidFillVertexShader::PerVertexData),
+          alignof(SolidFillVertexShader::PerVertexData),
+          [&](uint8_t* data) -> size_t {
+            BoundedPositionWriter writer(
+                reinterpret_cast<SolidFillVertexShader::PerVertexData*>(data),
+                max_vertex_count);
+            CreateSolidStrokeVertices(
+                writer, polyline, stroke_width, miter_limit,
+                GetJoinProc<BoundedPositionWriter>(stroke_join_),
+                GetCapProc<BoundedPositionWriter>(stroke_cap_), scale);
+            if (writer.HasOverflowed()) {
+              return 0u;
+            }
+            written_to_host_buffer = true;
+            vertex_count = writer.GetCount();
+            return vertex_count * sizeof(SolidFillVertexShader::PerVertexData);
+          });
+    }
+    if (!written_to_host_buffer) {
+      CreateSolidStrokeVertices(position_writer, polyline, stroke_width,
+                                miter_limit,
+                                GetJoinProc<PositionWriter>(stroke_join_),
+                                GetCapProc<PositionWriter>(stroke_cap_), scale);
+      vertices = &position_writer.GetData();
+    }
+  }
+
+  if (!written_to_host_buffer) {
+    buffer_view =
+        host_buffer.Emplace(vertices->data(),
+                            vertices->size() *
+                                sizeof(SolidFillVertexShader::PerVertexData),
+                            alignof(SolidFillVertexShader::PerVertexData));
+    vertex_count = vertices->size();
+  }
+  if (store_in_cache) {
+    tessellation_cache.StoreStroke(path_, stroke_width, miter_limit,
+                                   stroke_cap_, stroke_join_, scale,
+                                   position_writer.TakeData());
+  }
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
       .vertex_buffer =
           {
               .vertex_buffer = buffer_view,
-              .vertex_count = position_writer.GetData().size(),
+              .vertex_count = vertex_count,
               .index_type = IndexType::kNone,
           },
       .transform = entity.GetShaderTransform(pass),
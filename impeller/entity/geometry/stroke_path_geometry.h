@@ -31,6 +31,20 @@ class StrokePathGeometry final : public Geometry {
 
   Scalar ComputeAlphaCoverage(const Matrix& transform) const override;
 
+  /// @brief  Generate the triangle strip for |path| stroked with the given
+  ///         parameters at the transform |scale|.
+  ///
+  ///         This produces exactly the vertices |GetPositionBuffer| would
+  ///         upload, but does not touch any renderer state and so may be
+  ///         called from any thread.
+  static std::vector<SolidFillVertexShader::PerVertexData>
+  GenerateStrokeVertices(const Path& path,
+                         Scalar stroke_width,
+                         Scalar miter_limit,
+                         Cap stroke_cap,
+                         Join stroke_join,
+                         Scalar scale);
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
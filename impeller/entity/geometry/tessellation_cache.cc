@@ -0,0 +1,302 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/tessellation_cache.h"
+
+#include <cmath>
+#include <iterator>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/geometry/path_component.h"
+
+namespace impeller {
+
+namespace {
+
+// Scales are quantized in steps of a 16th of an octave, about 4.4%.
+constexpr Scalar kScaleStepsPerOctave = 16.0f;
+
+}  // namespace
+
+Scalar TessellationCache::Stats::GetHitRate() const {
+  size_t lookups = hits + misses;
+  if (lookups == 0u) {
+    return 0.0f;
+  }
+  return static_cast<Scalar>(hits) / static_cast<Scalar>(lookups);
+}
+
+std::size_t TessellationCache::Key::Hash::operator()(const Key& key) const {
+  if (key.is_stroke) {
+    return fml::HashCombine(key.path_identity, key.scale, key.stroke_width,
+                            key.miter_limit, key.stroke_cap, key.stroke_join);
+  }
+  return fml::HashCombine(key.path_identity, key.scale, key.fill_type,
+                          key.fill_layout);
+}
+
+bool TessellationCache::Key::Equal::operator()(const Key& lhs,
+                                               const Key& rhs) const {
+  if (lhs.path_identity != rhs.path_identity || lhs.scale != rhs.scale ||
+      lhs.is_stroke != rhs.is_stroke) {
+    return false;
+  }
+  if (lhs.is_stroke) {
+    return lhs.stroke_width == rhs.stroke_width &&
+           lhs.miter_limit == rhs.miter_limit &&
+           lhs.stroke_cap == rhs.stroke_cap &&
+           lhs.stroke_join == rhs.stroke_join;
+  }
+  return lhs.fill_type == rhs.fill_type && lhs.fill_layout == rhs.fill_layout;
+}
+
+TessellationCache::TessellationCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() = default;
+
+void TessellationCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  EvictToFit(max_bytes_);
+}
+
+Scalar TessellationCache::QuantizeScale(Scalar scale) {
+  if (!(scale > 0.0f) || !std::isfinite(scale)) {
+    return scale;
+  }
+  return std::exp2(std::ceil(std::log2(scale) * kScaleStepsPerOctave) /
+                   kScaleStepsPerOctave);
+}
+
+TessellationCache::Key TessellationCache::MakeFillKey(const Path& path,
+                                                      Scalar scale,
+                                                      FillLayout layout) {
+  return Key{
+      .path_identity = path.GetIdentity(),
+      .scale = scale,
+      .is_stroke = false,
+      .fill_type = path.GetFillType(),
+      .fill_layout = layout,
+      .stroke_width = 0.0f,
+      .miter_limit = 0.0f,
+      .stroke_cap = Cap::kButt,
+      .stroke_join = Join::kMiter,
+  };
+}
+
+TessellationCache::Key TessellationCache::MakeStrokeKey(const Path& path,
+                                                        Scalar stroke_width,
+                                                        Scalar miter_limit,
+                                                        Cap stroke_cap,
+                                                        Join stroke_join,
+                                                        Scalar scale) {
+  return Key{
+      .path_identity = path.GetIdentity(),
+      .scale = scale,
+      .is_stroke = true,
+      .fill_type = FillType::kNonZero,
+      .fill_layout = FillLayout::kTriangleStrip,
+      .stroke_width = stroke_width,
+      .miter_limit = miter_limit,
+      .stroke_cap = stroke_cap,
+      .stroke_join = stroke_join,
+  };
+}
+
+TessellationCache::Entry* TessellationCache::Find(const Key& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    stats_.misses++;
+    return nullptr;
+  }
+  stats_.hits++;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return &*found->second;
+}
+
+bool TessellationCache::Admit(const Key& key) {
+  size_t hash = Key::Hash{}(key);
+  size_t& slot = admission_filter_[hash % kAdmissionSlots];
+  if (slot == hash) {
+    return true;
+  }
+  slot = hash;
+  return false;
+}
+
+TessellationCache::Entry* TessellationCache::Insert(Entry entry) {
+  if (entry.bytes > max_bytes_) {
+    return nullptr;
+  }
+  EvictToFit(max_bytes_ - entry.bytes);
+  bytes_ += entry.bytes;
+  entries_.push_front(std::move(entry));
+  index_.emplace(entries_.front().key, entries_.begin());
+  stats_.insertions++;
+  return &entries_.front();
+}
+
+void TessellationCache::EvictToFit(size_t max_bytes) {
+  while (bytes_ > max_bytes && !entries_.empty()) {
+    EntryList::iterator victim = std::prev(entries_.end());
+    index_.erase(victim->key);
+    bytes_ -= victim->bytes;
+    entries_.erase(victim);
+    stats_.evictions++;
+  }
+}
+
+const TessellationCache::Fill* TessellationCache::FindOrTessellateFill(
+    const Path& path,
+    Scalar scale,
+    FillLayout layout) {
+  if (!IsEnabled()) {
+    return nullptr;
+  }
+  Key key = MakeFillKey(path, scale, layout);
+  if (Entry* entry = Find(key)) {
+    return &entry->fill;
+  }
+  if (!Admit(key)) {
+    return nullptr;
+  }
+
+  Entry entry{.key = key, .path = path};
+  Fill& fill = entry.fill;
+  switch (layout) {
+    case FillLayout::kTriangleStrip:
+      Tessellator::TessellateConvexInternal(path, fill.points, fill.indices,
+                                            scale);
+      break;
+    case FillLayout::kRestartTriangleStrip:
+    case FillLayout::kRestartTriangleFan: {
+      const auto [point_count, contour_count] = path.CountStorage(scale);
+      fill.points.resize(point_count);
+      fill.indices.resize(point_count + contour_count);
+      size_t index_count;
+      if (layout == FillLayout::kRestartTriangleFan) {
+        FanVertexWriter writer(fill.points.data(), fill.indices.data());
+        path.WritePolyline(scale, writer);
+        index_count = writer.GetIndexCount();
+      } else {
+        StripVertexWriter writer(fill.points.data(), fill.indices.data());
+        path.WritePolyline(scale, writer);
+        index_count = writer.GetIndexCount();
+      }
+      fill.indices.resize(index_count);
+      break;
+    }
+  }
+  entry.bytes = sizeof(Entry) + fill.points.size() * sizeof(Point) +
+                fill.indices.size() * sizeof(uint16_t);
+
+  // A tessellation larger than the whole cache is dropped and the caller
+  // tessellates directly.
+  if (Entry* inserted = Insert(std::move(entry))) {
+    return &inserted->fill;
+  }
+  return nullptr;
+}
+
+VertexBuffer TessellationCache::TessellateConvex(
+    Tessellator& tessellator,
+    const Path& path,
+    HostBuffer& host_buffer,
+    Scalar scale,
+    bool supports_primitive_restart,
+    bool supports_triangle_fan) {
+  FillLayout layout = FillLayout::kTriangleStrip;
+  if (supports_primitive_restart) {
+    layout = supports_triangle_fan ? FillLayout::kRestartTriangleFan
+                                   : FillLayout::kRestartTriangleStrip;
+  }
+  const Fill* fill = FindOrTessellateFill(path, scale, layout);
+  if (!fill) {
+    return tessellator.TessellateConvex(path, host_buffer, scale,
+                                        supports_primitive_restart,
+                                        supports_triangle_fan);
+  }
+  if (fill->points.empty()) {
+    return VertexBuffer{
+        .vertex_buffer = {},
+        .index_buffer = {},
+        .vertex_count = 0u,
+        .index_type = IndexType::k16bit,
+    };
+  }
+
+  BufferView vertex_buffer = host_buffer.Emplace(
+      fill->points.data(), sizeof(Point) * fill->points.size(),
+      alignof(Point));
+
+  BufferView index_buffer = host_buffer.Emplace(
+      fill->indices.data(), sizeof(uint16_t) * fill->indices.size(),
+      alignof(uint16_t));
+
+  return VertexBuffer{
+      .vertex_buffer = std::move(vertex_buffer),
+      .index_buffer = std::move(index_buffer),
+      .vertex_count = fill->indices.size(),
+      .index_type = IndexType::k16bit,
+  };
+}
+
+const std::vector<TessellationCache::VertexData>* TessellationCache::FindStroke(
+    const Path& path,
+    Scalar stroke_width,
+    Scalar miter_limit,
+    Cap stroke_cap,
+    Join stroke_join,
+    Scalar scale) {
+  if (!IsEnabled()) {
+    return nullptr;
+  }
+  Entry* entry = Find(MakeStrokeKey(path, stroke_width, miter_limit,
+                                    stroke_cap, stroke_join, scale));
+  return entry ? &entry->stroke_vertices : nullptr;
+}
+
+void TessellationCache::StoreStroke(const Path& path,
+                                    Scalar stroke_width,
+                                    Scalar miter_limit,
+                                    Cap stroke_cap,
+                                    Join stroke_join,
+                                    Scalar scale,
+                                    std::vector<VertexData> vertices) {
+  if (!IsEnabled()) {
+    return;
+  }
+  Key key = MakeStrokeKey(path, stroke_width, miter_limit, stroke_cap,
+                          stroke_join, scale);
+  if (index_.find(key) != index_.end() || !Admit(key)) {
+    return;
+  }
+  size_t bytes = sizeof(Entry) + vertices.size() * sizeof(VertexData);
+  Insert(Entry{
+      .key = key,
+      .path = path,
+      .stroke_vertices = std::move(vertices),
+      .bytes = bytes,
+  });
+}
+
+void TessellationCache::EndFrame() {
+  FML_TRACE_COUNTER("impeller",                                           //
+                    "TessellationCache", reinterpret_cast<int64_t>(this),  //
+                    "Hits", stats_.hits - last_frame_stats_.hits,          //
+                    "Misses", stats_.misses - last_frame_stats_.misses,    //
+                    "Entries", entries_.size(),                            //
+                    "KBytes", bytes_ / 1024u);
+  last_frame_stats_ = stats_;
+}
+
+void TessellationCache::Clear() {
+  entries_.clear();
+  index_.clear();
+  admission_filter_ = {};
+  bytes_ = 0u;
+}
+
+}  // namespace impeller
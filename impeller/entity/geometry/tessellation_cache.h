@@ -0,0 +1,228 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
+
+#include <array>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/entity/solid_fill.vert.h"
+#include "impeller/geometry/path.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of path tessellations that
+///             outlives a single frame.
+///
+///             A |Path| converted from a retained display list keeps the
+///             same immutable data from frame to frame, so a static scene
+///             tessellates the same fills and expands the same strokes
+///             every frame. This cache keys the generated vertices by the
+///             identity of the path data, the fill or stroke parameters and
+///             a quantized transform scale, so that later draws only copy
+///             the vertices into the |HostBuffer|.
+///
+///             The transform scale is rounded up to a 16th of an octave and
+///             the quantized value is used to generate the vertices, which
+///             lets small scale animations share entries while never
+///             producing fewer subdivisions than the exact scale would.
+///             Integral power of two scales are unchanged.
+///
+///             The cache is disabled until it is given a byte limit, which
+///             the embedder sets from
+///             |Settings::impeller_tessellation_cache_max_bytes|. Tessellating
+///             at the quantized scale can add subdivisions compared to the
+///             uncached path, so enabling it may change the rendered output
+///             slightly.
+///
+///             A key is only admitted on its second miss so that paths that
+///             are drawn once, or rebuilt every frame, do not churn the
+///             cache. Entries hold a reference to their path data, which
+///             also keeps the identity from being reused while cached.
+///
+///             This class is not thread safe and must only be used from the
+///             raster thread.
+///
+class TessellationCache {
+ public:
+  using VertexData = SolidFillVertexShader::PerVertexData;
+
+  /// The index layout of a convex tessellation, which depends on the device
+  /// capabilities.
+  enum class FillLayout {
+    /// Indexed triangle strip with degenerate triangles between contours.
+    kTriangleStrip,
+    /// Indexed triangle strip separated by primitive restart indices.
+    kRestartTriangleStrip,
+    /// Indexed triangle fan separated by primitive restart indices.
+    kRestartTriangleFan,
+  };
+
+  struct Fill {
+    std::vector<Point> points;
+    std::vector<uint16_t> indices;
+  };
+
+  struct Stats {
+    /// The number of lookups that found cached vertices.
+    size_t hits = 0u;
+    /// The number of lookups that had to tessellate.
+    size_t misses = 0u;
+    /// The number of tessellations added to the cache.
+    size_t insertions = 0u;
+    /// The number of entries evicted to stay within the byte limit.
+    size_t evictions = 0u;
+
+    /// @brief  The fraction of lookups that were hits, or 0 if there were
+    ///         none.
+    Scalar GetHitRate() const;
+  };
+
+  /// A byte limit that holds the paths of a typical static scene.
+  static constexpr size_t kRecommendedMaxBytes = 2u * 1024u * 1024u;
+
+  /// @brief  Create a cache with the given byte limit. The default of 0
+  ///         leaves it disabled.
+  explicit TessellationCache(size_t max_bytes = 0u);
+
+  ~TessellationCache();
+
+  /// @brief  Change the byte limit, evicting entries as needed. A limit of 0
+  ///         disables the cache.
+  void SetMaxBytes(size_t max_bytes);
+
+  bool IsEnabled() const { return max_bytes_ > 0u; }
+
+  /// @brief  Round |scale| up to the granularity used by cache keys.
+  static Scalar QuantizeScale(Scalar scale);
+
+  /// @brief  Tessellate the convex |path| into the |host_buffer| the same
+  ///         way as |Tessellator::TessellateConvex|, reusing a cached
+  ///         tessellation when possible.
+  ///
+  ///         |scale| must already be quantized with |QuantizeScale|.
+  VertexBuffer TessellateConvex(Tessellator& tessellator,
+                                const Path& path,
+                                HostBuffer& host_buffer,
+                                Scalar scale,
+                                bool supports_primitive_restart,
+                                bool supports_triangle_fan);
+
+  /// @brief  Look up the tessellation of |path|, generating and caching it
+  ///         if the key is admitted.
+  ///
+  /// @return The cached tessellation, or nullptr if it was not cached and
+  ///         the caller should tessellate directly.
+  const Fill* FindOrTessellateFill(const Path& path,
+                                   Scalar scale,
+                                   FillLayout layout);
+
+  /// @brief  Look up the vertices of a stroke previously passed to
+  ///         |StoreStroke|, or nullptr if there are none.
+  const std::vector<VertexData>* FindStroke(const Path& path,
+                                            Scalar stroke_width,
+                                            Scalar miter_limit,
+                                            Cap stroke_cap,
+                                            Join stroke_join,
+                                            Scalar scale);
+
+  /// @brief  Offer the vertices generated after a |FindStroke| miss. They
+  ///         are only kept if the key is admitted and fits the byte limit.
+  void StoreStroke(const Path& path,
+                   Scalar stroke_width,
+                   Scalar miter_limit,
+                   Cap stroke_cap,
+                   Join stroke_join,
+                   Scalar scale,
+                   std::vector<VertexData> vertices);
+
+  /// @brief  Record the statistics of the frame that was just encoded to
+  ///         the timeline.
+  void EndFrame();
+
+  void Clear();
+
+  size_t GetEntryCount() const { return entries_.size(); }
+
+  size_t GetByteSize() const { return bytes_; }
+
+  /// @brief  Counters accumulated since creation.
+  const Stats& GetStats() const { return stats_; }
+
+ private:
+  struct Key {
+    const void* path_identity;
+    Scalar scale;
+    bool is_stroke;
+    // Fills only.
+    FillType fill_type;
+    FillLayout fill_layout;
+    // Strokes only.
+    Scalar stroke_width;
+    Scalar miter_limit;
+    Cap stroke_cap;
+    Join stroke_join;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const;
+    };
+  };
+
+  struct Entry {
+    Key key;
+    Path path;
+    Fill fill;
+    std::vector<VertexData> stroke_vertices;
+    size_t bytes = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  // The number of recently missed key hashes remembered for admission.
+  static constexpr size_t kAdmissionSlots = 1024u;
+
+  static Key MakeFillKey(const Path& path, Scalar scale, FillLayout layout);
+
+  static Key MakeStrokeKey(const Path& path,
+                           Scalar stroke_width,
+                           Scalar miter_limit,
+                           Cap stroke_cap,
+                           Join stroke_join,
+                           Scalar scale);
+
+  Entry* Find(const Key& key);
+
+  bool Admit(const Key& key);
+
+  Entry* Insert(Entry entry);
+
+  void EvictToFit(size_t max_bytes);
+
+  size_t max_bytes_;
+  size_t bytes_ = 0u;
+  // Most recently used entries are at the front.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash, Key::Equal> index_;
+  std::array<size_t, kAdmissionSlots> admission_filter_ = {};
+  Stats stats_;
+  Stats last_frame_stats_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TessellationCache);
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
@@ -7,6 +7,7 @@
 #include "flutter/impeller/entity/solid_fill.vert.h"
 
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/tessellator/tessellator_libtess.h"
@@ -35,6 +36,11 @@ Path CreateCubic(bool closed);
 Path CreateQuadratic(bool closed);
 /// Create a rounded rect.
 Path CreateRRect();
+/// A circle large enough to need thousands of polyline points.
+Path CreateLargeCircle();
+/// A long wave of cubic and quadratic components, the kind of path a chart
+/// or a handwriting canvas strokes.
+Path CreateLargeWave(bool closed);
 }  // namespace
 
 static TessellatorLibtess tess;
@@ -116,6 +122,107 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+/// Measures drawing the same path every frame with the tessellation cache.
+/// Each iteration copies the cached vertices and indices, which stands in
+/// for the upload to the host buffer that a hit still pays for.
+template <class... Args>
+static void BM_ConvexCached(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+
+  TessellationCache cache(TessellationCache::kRecommendedMaxBytes);
+  std::vector<Point> points;
+  std::vector<uint16_t> indices;
+  points.reserve(2048);
+  indices.reserve(2048);
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    const TessellationCache::Fill* fill = cache.FindOrTessellateFill(
+        path, 1.0f, TessellationCache::FillLayout::kTriangleStrip);
+    if (fill) {
+      points.assign(fill->points.begin(), fill->points.end());
+      indices.assign(fill->indices.begin(), fill->indices.end());
+    } else {
+      Tessellator::TessellateConvexInternal(path, points, indices, 1.0f);
+    }
+    single_point_count = indices.size();
+    point_count += indices.size();
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["TotalPointCount"] = point_count;
+  state.counters["HitRate"] = cache.GetStats().GetHitRate();
+}
+
+/// Measures stroking the same path every frame with the tessellation cache,
+/// the counterpart of |BM_StrokePolyline| for static content.
+template <class... Args>
+static void BM_StrokeCached(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+  auto cap = std::get<Cap>(args_tuple);
+  auto join = std::get<Join>(args_tuple);
+
+  const Scalar stroke_width = 5.0f;
+  const Scalar miter_limit = 10.0f;
+  const Scalar scale = 1.0f;
+
+  TessellationCache cache(TessellationCache::kRecommendedMaxBytes);
+  std::vector<SolidFillVertexShader::PerVertexData> vertices;
+  vertices.reserve(2048);
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    const auto* cached = cache.FindStroke(path, stroke_width, miter_limit, cap,
+                                          join, scale);
+    if (cached) {
+      vertices.assign(cached->begin(), cached->end());
+    } else {
+      vertices = StrokePathGeometry::GenerateStrokeVertices(
+          path, stroke_width, miter_limit, cap, join, scale);
+      cache.StoreStroke(path, stroke_width, miter_limit, cap, join, scale,
+                        vertices);
+    }
+    single_point_count = vertices.size();
+    point_count += single_point_count;
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["TotalPointCount"] = point_count;
+  state.counters["HitRate"] = cache.GetStats().GetHitRate();
+}
+
+/// Measures writing the vertices of a filled circle with the given radius
+/// straight into preallocated memory, as the circle, oval and round rect
+/// geometries do with host buffer memory.
+static void BM_FilledCircleVertices(benchmark::State& state) {
+  Tessellator tessellator;
+  auto generator = tessellator.FilledCircle(Matrix(), {}, state.range(0));
+  std::vector<Point> vertices(generator.GetVertexCount());
+  while (state.KeepRunning()) {
+    generator.WriteVertices(vertices.data());
+    benchmark::DoNotOptimize(vertices.data());
+  }
+  state.counters["SinglePointCount"] = vertices.size();
+  state.counters["Vertices"] = benchmark::Counter(
+      vertices.size() * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+/// The stroked circle counterpart of |BM_FilledCircleVertices|.
+static void BM_StrokedCircleVertices(benchmark::State& state) {
+  Tessellator tessellator;
+  Scalar radius = state.range(0);
+  auto generator =
+      tessellator.StrokedCircle(Matrix(), {}, radius, radius * 0.1f);
+  std::vector<Point> vertices(generator.GetVertexCount());
+  while (state.KeepRunning()) {
+    generator.WriteVertices(vertices.data());
+    benchmark::DoNotOptimize(vertices.data());
+  }
+  state.counters["SinglePointCount"] = vertices.size();
+  state.counters["Vertices"] = benchmark::Counter(
+      vertices.size() * state.iterations(), benchmark::Counter::kIsRate);
+}
+
 #define MAKE_STROKE_BENCHMARK_CAPTURE(path, cap, join, closed)         \
   BENCHMARK_CAPTURE(BM_StrokePolyline, stroke_##path##_##cap##_##join, \
                     Create##path(closed), Cap::k##cap, Join::k##join)
@@ -136,6 +243,21 @@ BENCHMARK_CAPTURE(BM_Polyline, unclosed_quad_polyline, CreateQuadratic(false));
 MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(Quadratic, false);
 
 BENCHMARK_CAPTURE(BM_Convex, rrect_convex, CreateRRect(), true);
+BENCHMARK_CAPTURE(BM_ConvexCached, rrect_convex_cached, CreateRRect());
+BENCHMARK_CAPTURE(BM_Convex, large_circle_convex, CreateLargeCircle());
+BENCHMARK_CAPTURE(BM_Polyline, large_wave_polyline, CreateLargeWave(false));
+MAKE_STROKE_BENCHMARK_CAPTURE(LargeWave, Butt, Miter, false);
+MAKE_STROKE_BENCHMARK_CAPTURE(LargeWave, Round, Round, false);
+MAKE_STROKE_BENCHMARK_CAPTURE(LargeWave, Square, Bevel, false);
+BENCHMARK(BM_FilledCircleVertices)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_StrokedCircleVertices)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(BM_Convex, cubic_convex, CreateCubic(true));
+BENCHMARK_CAPTURE(BM_ConvexCached, cubic_convex_cached, CreateCubic(true));
+BENCHMARK_CAPTURE(BM_StrokeCached,
+                  stroke_Cubic_Round_Round_cached,
+                  CreateCubic(false),
+                  Cap::kRound,
+                  Join::kRound);
 // A round rect has no ends so we don't need to try it with all cap values
 // but it does have joins and even though they should all be almost
 // colinear, we run the benchmark against all 3 join values.
@@ -152,6 +274,26 @@ Path CreateRRect() {
       .TakePath();
 }
 
+Path CreateLargeCircle() {
+  return PathBuilder{}.AddCircle({2000, 2000}, 2000).TakePath();
+}
+
+Path CreateLargeWave(bool closed) {
+  PathBuilder builder;
+  builder.MoveTo({0, 0});
+  for (int i = 0; i < 512; i++) {
+    Scalar x = i * 20.0f;
+    Scalar amplitude = 20.0f + (i % 7) * 10.0f;
+    builder.CubicCurveTo({x + 5, amplitude}, {x + 10, -amplitude},
+                         {x + 15, 0});
+    builder.QuadraticCurveTo({x + 17.5f, amplitude * 0.5f}, {x + 20, 0});
+  }
+  if (closed) {
+    builder.Close();
+  }
+  return builder.TakePath();
+}
+
 Path CreateCubic(bool closed) {
   auto builder = PathBuilder{};
   builder  //
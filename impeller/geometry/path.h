@@ -196,6 +196,13 @@ class Path {
   /// Determine required storage for points and number of contours.
   std::pair<size_t, size_t> CountStorage(Scalar scale) const;
 
+  /// Returns an opaque identity that is shared by all copies of this path.
+  ///
+  /// The underlying data is immutable, so two paths with the same identity
+  /// are guaranteed to describe the same geometry. The identity is only
+  /// meaningful while a path referencing the data is alive.
+  const void* GetIdentity() const { return data_.get(); }
+
  private:
   friend class PathBuilder;
 
@@ -407,7 +407,8 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
 
     resource_.Swap(ImageResource(ImageVMA{allocator, allocation, image},
                                  std::move(image_view),
-                                 std::move(rt_image_view)));
+                                 std::move(rt_image_view)),
+                   allocation_info.size);
     is_valid_ = true;
   }
 
@@ -214,6 +214,8 @@ static const char* GetExtensionName(OptionalDeviceExtensionVK ext) {
       return "VK_KHR_portability_subset";
     case OptionalDeviceExtensionVK::kEXTImageCompressionControl:
       return VK_EXT_IMAGE_COMPRESSION_CONTROL_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kKHRTimelineSemaphore:
+      return VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kLast:
       return "Unknown";
   }
@@ -404,6 +406,10 @@ CapabilitiesVK::GetEnabledDeviceFeatures(
     supported_chain
         .unlink<vk::PhysicalDeviceImageCompressionControlFeaturesEXT>();
   }
+  if (!IsExtensionInList(enabled_extensions.value(),
+                         OptionalDeviceExtensionVK::kKHRTimelineSemaphore)) {
+    supported_chain.unlink<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+  }
 
   device.getFeatures2(&supported_chain.get());
 
@@ -449,6 +455,19 @@ CapabilitiesVK::GetEnabledDeviceFeatures(
         .unlink<vk::PhysicalDeviceImageCompressionControlFeaturesEXT>();
   }
 
+  // VK_KHR_timeline_semaphore
+  if (IsExtensionInList(enabled_extensions.value(),
+                        OptionalDeviceExtensionVK::kKHRTimelineSemaphore)) {
+    auto& required =
+        required_chain.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+    const auto& supported =
+        supported_chain.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+
+    required.timelineSemaphore = supported.timelineSemaphore;
+  } else {
+    required_chain.unlink<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+  }
+
   // Vulkan 1.1
   {
     auto& required =
@@ -591,6 +610,12 @@ bool CapabilitiesVK::SetPhysicalDevice(
           .get<vk::PhysicalDeviceImageCompressionControlFeaturesEXT>()
           .imageCompressionControl;
 
+  supports_timeline_semaphores_ =
+      enabled_features
+          .isLinked<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>() &&
+      enabled_features.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>()
+          .timelineSemaphore;
+
   max_render_pass_attachment_size_ =
       ISize{device_properties_.limits.maxFramebufferWidth,
             device_properties_.limits.maxFramebufferHeight};
@@ -692,6 +717,10 @@ bool CapabilitiesVK::SupportsTextureFixedRateCompression() const {
   return supports_texture_fixed_rate_compression_;
 }
 
+bool CapabilitiesVK::SupportsTimelineSemaphores() const {
+  return supports_timeline_semaphores_;
+}
+
 std::optional<vk::ImageCompressionFixedRateFlagBitsEXT>
 CapabilitiesVK::GetSupportedFRCRate(CompressionType compression_type,
                                     const FRCFormatDescriptor& desc) const {
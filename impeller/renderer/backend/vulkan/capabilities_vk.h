@@ -140,6 +140,14 @@ enum class OptionalDeviceExtensionVK : uint32_t {
   ///
   kEXTImageCompressionControl,
 
+  //----------------------------------------------------------------------------
+  /// For tracking the completion of submissions with one semaphore per queue
+  /// instead of a fence per submission.
+  ///
+  /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_timeline_semaphore.html
+  ///
+  kKHRTimelineSemaphore,
+
   kLast,
 };
 
@@ -198,7 +206,8 @@ class CapabilitiesVK final : public Capabilities,
       vk::StructureChain<vk::PhysicalDeviceFeatures2,
                          vk::PhysicalDeviceSamplerYcbcrConversionFeaturesKHR,
                          vk::PhysicalDevice16BitStorageFeatures,
-                         vk::PhysicalDeviceImageCompressionControlFeaturesEXT>;
+                         vk::PhysicalDeviceImageCompressionControlFeaturesEXT,
+                         vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>;
 
   std::optional<PhysicalDeviceFeatures> GetEnabledDeviceFeatures(
       const vk::PhysicalDevice& physical_device) const;
@@ -268,6 +277,14 @@ class CapabilitiesVK final : public Capabilities,
   ///
   bool SupportsTextureFixedRateCompression() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the completion of queue submissions can be tracked
+  ///             with timeline semaphores.
+  ///
+  /// @return     If VK_KHR_timeline_semaphore is enabled on the device.
+  ///
+  bool SupportsTimelineSemaphores() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the fixed compression rate supported by the context for
   ///             the given format and usage.
@@ -296,6 +313,7 @@ class CapabilitiesVK final : public Capabilities,
   bool supports_compute_subgroups_ = false;
   bool supports_device_transient_textures_ = false;
   bool supports_texture_fixed_rate_compression_ = false;
+  bool supports_timeline_semaphores_ = false;
   ISize max_render_pass_attachment_size_ = ISize{0, 0};
   bool is_valid_ = false;
 
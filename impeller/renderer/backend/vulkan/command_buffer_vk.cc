@@ -162,6 +162,20 @@ fml::StatusOr<vk::DescriptorSet> CommandBufferVK::AllocateDescriptorSets(
                                                                       context);
 }
 
+fml::StatusOr<vk::DescriptorSet> CommandBufferVK::GetOrCreateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    const ContextVK& context,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count) {
+  if (!IsValid()) {
+    return fml::Status(fml::StatusCode::kUnknown, "command encoder invalid");
+  }
+
+  return tracked_objects_->GetDescriptorPool().GetOrCreateDescriptorSet(
+      layout, context, writes, write_count,
+      tracked_objects_->GetDescriptorSetScope());
+}
+
 void CommandBufferVK::PushDebugGroup(std::string_view label) const {
   if (!HasValidationLayers()) {
     return;
@@ -76,6 +76,15 @@ class CommandBufferVK final
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context);
 
+  /// @brief Get a descriptor set for the given [layout] with the given
+  ///        [writes] applied, reusing an identical set created by this
+  ///        command buffer if there is one.
+  fml::StatusOr<vk::DescriptorSet> GetOrCreateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      const ContextVK& context,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count);
+
   // Visible for testing.
   DescriptorPoolVK& GetDescriptorPool() const;
 
@@ -53,32 +53,50 @@ fml::Status CommandQueueVK::Submit(
     VALIDATION_LOG << "Device lost.";
     return fml::Status(fml::StatusCode::kCancelled, "Device lost.");
   }
+  // Call the completion callback with true when the submission is done and do
+  // not call it when `reset` is collected.
+  fml::closure on_completed = [completion_callback,
+                               tracked_objects =
+                                   std::move(tracked_objects)]() mutable {
+    // Ensure tracked objects are destructed before calling any final
+    // callbacks.
+    tracked_objects.clear();
+    if (completion_callback) {
+      completion_callback(CommandBuffer::Status::kCompleted);
+    }
+  };
+
+  vk::SubmitInfo submit_info;
+  submit_info.setCommandBuffers(vk_buffers);
+
+  const auto& fence_waiter = context->GetFenceWaiter();
+  if (fence_waiter->UsesTimelineSemaphores()) {
+    // The submission signals the queue timeline. No fence is necessary.
+    auto status = fence_waiter->Submit(*context->GetGraphicsQueue(),
+                                       submit_info, on_completed);
+    if (status != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
+      return fml::Status(fml::StatusCode::kCancelled,
+                         "Failed to submit queue: ");
+    }
+    reset.Release();
+    return fml::Status();
+  }
+
   auto [fence_result, fence] = context->GetDevice().createFenceUnique({});
   if (fence_result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to create fence: " << vk::to_string(fence_result);
     return fml::Status(fml::StatusCode::kCancelled, "Failed to create fence.");
   }
 
-  vk::SubmitInfo submit_info;
-  submit_info.setCommandBuffers(vk_buffers);
   auto status = context->GetGraphicsQueue()->Submit(submit_info, *fence);
   if (status != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
     return fml::Status(fml::StatusCode::kCancelled, "Failed to submit queue: ");
   }
 
-  // Submit will proceed, call callback with true when it is done and do not
-  // call when `reset` is collected.
-  auto added_fence = context->GetFenceWaiter()->AddFence(
-      std::move(fence), [completion_callback, tracked_objects = std::move(
-                                                  tracked_objects)]() mutable {
-        // Ensure tracked objects are destructed before calling any final
-        // callbacks.
-        tracked_objects.clear();
-        if (completion_callback) {
-          completion_callback(CommandBuffer::Status::kCompleted);
-        }
-      });
+  auto added_fence =
+      fence_waiter->AddFence(std::move(fence), std::move(on_completed));
   if (!added_fence) {
     return fml::Status(fml::StatusCode::kCancelled, "Failed to add fence.");
   }
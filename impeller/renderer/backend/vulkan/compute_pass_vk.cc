@@ -56,13 +56,7 @@ void ComputePassVK::SetPipeline(
   command_buffer_vk.bindPipeline(vk::PipelineBindPoint::eCompute,
                                  pipeline_vk.GetPipeline());
   pipeline_layout_ = pipeline_vk.GetPipelineLayout();
-
-  auto descriptor_result = command_buffer_->AllocateDescriptorSets(
-      pipeline_vk.GetDescriptorSetLayout(), ContextVK::Cast(*context_));
-  if (!descriptor_result.ok()) {
-    return;
-  }
-  descriptor_set_ = descriptor_result.value();
+  descriptor_set_layout_ = pipeline_vk.GetDescriptorSetLayout();
   pipeline_valid_ = true;
 }
 
@@ -79,12 +73,19 @@ fml::Status ComputePassVK::Compute(const ISize& grid_size) {
   }
 
   const ContextVK& context_vk = ContextVK::Cast(*context_);
-  for (auto i = 0u; i < descriptor_write_offset_; i++) {
-    write_workspace_[i].dstSet = descriptor_set_;
+  auto descriptor_result = command_buffer_->GetOrCreateDescriptorSet(
+      descriptor_set_layout_, context_vk, write_workspace_.data(),
+      descriptor_write_offset_);
+  if (!descriptor_result.ok()) {
+    bound_image_offset_ = 0u;
+    bound_buffer_offset_ = 0u;
+    descriptor_write_offset_ = 0u;
+    has_label_ = false;
+    pipeline_valid_ = false;
+    return fml::Status(fml::StatusCode::kAborted,
+                       "Could not allocate descriptor sets.");
   }
-
-  context_vk.GetDevice().updateDescriptorSets(descriptor_write_offset_,
-                                              write_workspace_.data(), 0u, {});
+  const vk::DescriptorSet descriptor_set = descriptor_result.value();
   const vk::CommandBuffer& command_buffer_vk =
       command_buffer_->GetCommandBuffer();
 
@@ -93,7 +94,7 @@ fml::Status ComputePassVK::Compute(const ISize& grid_size) {
       pipeline_layout_,                 // layout
       0,                                // first set
       1,                                // set count
-      &descriptor_set_,                 // sets
+      &descriptor_set,                  // sets
       0,                                // offset count
       nullptr                           // offsets
   );
@@ -36,7 +36,7 @@ class ComputePassVK final : public ComputePass {
   size_t descriptor_write_offset_ = 0u;
   bool has_label_ = false;
   bool pipeline_valid_ = false;
-  vk::DescriptorSet descriptor_set_ = {};
+  vk::DescriptorSetLayout descriptor_set_layout_ = {};
   vk::PipelineLayout pipeline_layout_ = {};
 
   ComputePassVK(std::shared_ptr<const Context> context,
@@ -375,10 +375,11 @@ void ContextVK::Setup(Settings settings) {
   /// Setup the pipeline library.
   ///
   auto pipeline_library = std::shared_ptr<PipelineLibraryVK>(
-      new PipelineLibraryVK(device_holder,                         //
-                            caps,                                  //
-                            std::move(settings.cache_directory),   //
-                            raster_message_loop_->GetTaskRunner()  //
+      new PipelineLibraryVK(device_holder,                          //
+                            caps,                                   //
+                            std::move(settings.cache_directory),    //
+                            raster_message_loop_->GetTaskRunner(),  //
+                            settings.enable_pipeline_warm_up        //
                             ));
 
   if (!pipeline_library->IsValid()) {
@@ -400,13 +401,7 @@ void ContextVK::Setup(Settings settings) {
   }
 
   //----------------------------------------------------------------------------
-  /// Create the fence waiter.
-  ///
-  auto fence_waiter =
-      std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(device_holder));
-
-  //----------------------------------------------------------------------------
-  /// Create the resource manager and command pool recycler.
+  /// Create the resource manager and fence waiter.
   ///
   auto resource_manager = ResourceManagerVK::Create();
   if (!resource_manager) {
@@ -414,6 +409,14 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
+  auto fence_waiter = std::shared_ptr<FenceWaiterVK>(
+      new FenceWaiterVK(device_holder, resource_manager,
+                        caps->SupportsTimelineSemaphores()));
+
+  //----------------------------------------------------------------------------
+  /// Create the command pool recycler.
+  ///
+
   auto command_pool_recycler =
       std::make_shared<CommandPoolRecyclerVK>(weak_from_this());
   if (!command_pool_recycler) {
@@ -475,6 +478,8 @@ void ContextVK::Setup(Settings settings) {
   device_name_ = std::string(physical_device_properties.deviceName);
   command_queue_vk_ = std::make_shared<CommandQueueVK>(weak_from_this());
   should_disable_surface_control_ = settings.disable_surface_control;
+  should_enable_parallel_geometry_ = settings.enable_parallel_geometry;
+  tessellation_cache_max_bytes_ = settings.tessellation_cache_max_bytes;
   should_batch_cmd_buffers_ = driver_info_->CanBatchSubmitCommandBuffers();
   is_valid_ = true;
 
@@ -717,4 +722,12 @@ bool ContextVK::GetShouldDisableSurfaceControlSwapchain() const {
   return should_disable_surface_control_;
 }
 
+bool ContextVK::GetShouldEnableParallelGeometry() const {
+  return should_enable_parallel_geometry_;
+}
+
+size_t ContextVK::GetTessellationCacheMaxBytes() const {
+  return tessellation_cache_max_bytes_;
+}
+
 }  // namespace impeller
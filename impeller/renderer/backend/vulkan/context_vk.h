@@ -81,6 +81,15 @@ class ContextVK final : public Context,
     bool enable_validation = false;
     bool enable_gpu_tracing = false;
     bool disable_surface_control = false;
+    /// Expand stroke geometry on the concurrent worker pool ahead of
+    /// encoding. See |GeometryPrepass|.
+    bool enable_parallel_geometry = false;
+    /// The byte limit of the path tessellations reused across frames, or 0
+    /// to disable the cache. See |TessellationCache|.
+    size_t tessellation_cache_max_bytes = 0;
+    /// Precompile the pipelines recorded by previous runs in the cache
+    /// directory on the concurrent worker pool. See |PipelineLibraryVK|.
+    bool enable_pipeline_warm_up = true;
     /// If validations are requested but cannot be enabled, log a fatal error.
     bool fatal_missing_validations = false;
 
@@ -222,6 +231,14 @@ class ContextVK final : public Context,
   /// disabled, even if the device is capable of supporting it.
   bool GetShouldDisableSurfaceControlSwapchain() const;
 
+  /// @brief Whether renderers created for this context should generate
+  /// stroke geometry on the concurrent worker task runner.
+  bool GetShouldEnableParallelGeometry() const;
+
+  /// @brief The byte limit of the tessellation cache of renderers created
+  /// for this context, or 0 to leave it disabled.
+  size_t GetTessellationCacheMaxBytes() const;
+
   // | Context |
   bool EnqueueCommandBuffer(
       std::shared_ptr<CommandBuffer> command_buffer) override;
@@ -282,6 +299,8 @@ class ContextVK final : public Context,
   mutable DescriptorPoolMap IPLR_GUARDED_BY(desc_pool_mutex_)
       cached_descriptor_pool_;
   bool should_disable_surface_control_ = false;
+  bool should_enable_parallel_geometry_ = false;
+  size_t tessellation_cache_max_bytes_ = 0;
   bool should_batch_cmd_buffers_ = false;
   std::vector<std::shared_ptr<CommandBuffer>> pending_command_buffers_;
 
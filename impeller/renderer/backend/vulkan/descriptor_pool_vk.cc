@@ -4,8 +4,11 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include <algorithm>
 #include <optional>
 
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "vulkan/vulkan_enums.hpp"
@@ -13,29 +16,13 @@
 
 namespace impeller {
 
-struct DescriptorPoolSize {
-  size_t buffer_bindings;
-  size_t texture_bindings;
-  size_t storage_bindings;
-  size_t subpass_bindings;
-};
-
-/// Descriptor pools are always allocated with the following sizes.
-static const constexpr DescriptorPoolSize kDefaultBindingSize =
-    DescriptorPoolSize{
-        .buffer_bindings = 512u,   // Buffer Bindings
-        .texture_bindings = 256u,  // Texture Bindings
-        .storage_bindings = 32,
-        .subpass_bindings = 4u  // Subpass Bindings
-    };
-
 // Holds the command pool in a background thread, recyling it when not in use.
 class BackgroundDescriptorPoolVK final {
  public:
   BackgroundDescriptorPoolVK(BackgroundDescriptorPoolVK&&) = default;
 
   explicit BackgroundDescriptorPoolVK(
-      vk::UniqueDescriptorPool&& pool,
+      DescriptorPoolAndSize&& pool,
       std::weak_ptr<DescriptorPoolRecyclerVK> recycler)
       : pool_(std::move(pool)), recycler_(std::move(recycler)) {}
 
@@ -59,8 +46,7 @@ class BackgroundDescriptorPoolVK final {
   BackgroundDescriptorPoolVK& operator=(const BackgroundDescriptorPoolVK&) =
       delete;
 
-  vk::UniqueDescriptorPool pool_;
-  uint32_t allocated_capacity_;
+  DescriptorPoolAndSize pool_;
   std::weak_ptr<DescriptorPoolRecyclerVK> recycler_;
 };
 
@@ -81,6 +67,13 @@ DescriptorPoolVK::~DescriptorPoolVK() {
     return;
   }
 
+  FML_TRACE_COUNTER("impeller",                                           //
+                    "DescriptorPoolVK", reinterpret_cast<int64_t>(this),  //
+                    "AllocatedSets", stats_.allocated_sets,               //
+                    "UpdatedSets", stats_.updated_sets,                   //
+                    "ReusedSets", stats_.reused_sets);
+  recycler->RecordFrameUsage(usage_, stats_);
+
   for (auto i = 0u; i < pools_.size(); i++) {
     auto reset_pool_when_dropped =
         BackgroundDescriptorPoolVK(std::move(pools_[i]), recycler);
@@ -95,21 +88,29 @@ fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSets(
     const vk::DescriptorSetLayout& layout,
     const ContextVK& context_vk) {
   if (pools_.empty()) {
-    CreateNewPool(context_vk);
+    fml::Status status = CreateNewPool(context_vk);
+    if (!status.ok()) {
+      return status;
+    }
   }
 
   vk::DescriptorSetAllocateInfo set_info;
-  set_info.setDescriptorPool(pools_.back().get());
+  set_info.setDescriptorPool(pools_.back().pool.get());
   set_info.setPSetLayouts(&layout);
   set_info.setDescriptorSetCount(1);
 
   vk::DescriptorSet set;
   auto result = context_vk.GetDevice().allocateDescriptorSets(&set_info, &set);
+  stats_.allocated_sets++;
   if (result == vk::Result::eErrorOutOfPoolMemory) {
     // If the pool ran out of memory, we need to create a new pool.
-    CreateNewPool(context_vk);
-    set_info.setDescriptorPool(pools_.back().get());
+    fml::Status status = CreateNewPool(context_vk);
+    if (!status.ok()) {
+      return status;
+    }
+    set_info.setDescriptorPool(pools_.back().pool.get());
     result = context_vk.GetDevice().allocateDescriptorSets(&set_info, &set);
+    stats_.allocated_sets++;
   }
 
   if (result != vk::Result::eSuccess) {
@@ -120,9 +121,101 @@ fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSets(
   return set;
 }
 
+template <class T>
+static uint64_t HandleToKey(T handle) {
+  return reinterpret_cast<uint64_t>(static_cast<typename T::CType>(handle));
+}
+
+std::size_t DescriptorPoolVK::DescriptorSetKeyHash::operator()(
+    const std::vector<uint64_t>& key) const {
+  std::size_t seed = fml::HashCombine();
+  for (uint64_t value : key) {
+    fml::HashCombineSeed(seed, value);
+  }
+  return seed;
+}
+
+fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::GetOrCreateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    const ContextVK& context_vk,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    uint64_t scope) {
+  // The key is the scope and layout followed by the binding, type and
+  // resources of every write. Only single descriptor writes are made by the
+  // encoders.
+  key_workspace_.clear();
+  key_workspace_.push_back(scope);
+  key_workspace_.push_back(HandleToKey(layout));
+  for (size_t i = 0; i < write_count; i++) {
+    const vk::WriteDescriptorSet& write = writes[i];
+    FML_DCHECK(write.descriptorCount == 1u);
+    key_workspace_.push_back(
+        (static_cast<uint64_t>(write.dstBinding) << 32) |
+        static_cast<uint64_t>(write.descriptorType));
+    if (write.pBufferInfo) {
+      key_workspace_.push_back(HandleToKey(write.pBufferInfo->buffer));
+      key_workspace_.push_back(write.pBufferInfo->offset);
+      key_workspace_.push_back(write.pBufferInfo->range);
+    }
+    if (write.pImageInfo) {
+      key_workspace_.push_back(HandleToKey(write.pImageInfo->imageView));
+      key_workspace_.push_back(HandleToKey(write.pImageInfo->sampler));
+      key_workspace_.push_back(
+          static_cast<uint64_t>(write.pImageInfo->imageLayout));
+    }
+  }
+
+  auto found = descriptor_sets_.find(key_workspace_);
+  if (found != descriptor_sets_.end()) {
+    stats_.reused_sets++;
+    return found->second;
+  }
+
+  fml::StatusOr<vk::DescriptorSet> set =
+      AllocateDescriptorSets(layout, context_vk);
+  if (!set.ok()) {
+    return set;
+  }
+
+  for (size_t i = 0; i < write_count; i++) {
+    writes[i].dstSet = set.value();
+    switch (writes[i].descriptorType) {
+      case vk::DescriptorType::eUniformBuffer:
+        usage_.buffer_bindings++;
+        break;
+      case vk::DescriptorType::eCombinedImageSampler:
+        usage_.texture_bindings++;
+        break;
+      case vk::DescriptorType::eStorageBuffer:
+        usage_.storage_bindings++;
+        break;
+      case vk::DescriptorType::eInputAttachment:
+        usage_.subpass_bindings++;
+        break;
+      default:
+        break;
+    }
+  }
+  context_vk.GetDevice().updateDescriptorSets(write_count, writes, 0u, {});
+  stats_.updated_sets++;
+
+  descriptor_sets_.emplace(key_workspace_, set.value());
+  return set;
+}
+
+const DescriptorPoolVK::Stats& DescriptorPoolVK::GetStats() const {
+  return stats_;
+}
+
+const DescriptorPoolSize& DescriptorPoolVK::GetUsage() const {
+  return usage_;
+}
+
 fml::Status DescriptorPoolVK::CreateNewPool(const ContextVK& context_vk) {
-  auto new_pool = context_vk.GetDescriptorPoolRecycler()->Get();
-  if (!new_pool) {
+  DescriptorPoolAndSize new_pool =
+      context_vk.GetDescriptorPoolRecycler()->Get();
+  if (!new_pool.pool) {
     return fml::Status(fml::StatusCode::kUnknown,
                        "Failed to create descriptor pool");
   }
@@ -130,14 +223,17 @@ fml::Status DescriptorPoolVK::CreateNewPool(const ContextVK& context_vk) {
   return fml::Status();
 }
 
-void DescriptorPoolRecyclerVK::Reclaim(vk::UniqueDescriptorPool&& pool) {
+void DescriptorPoolRecyclerVK::Reclaim(DescriptorPoolAndSize&& pool) {
   // Reset the pool on a background thread.
   auto strong_context = context_.lock();
   if (!strong_context) {
     return;
   }
+  if (!pool.pool) {
+    return;
+  }
   auto device = strong_context->GetDevice();
-  device.resetDescriptorPool(pool.get());
+  device.resetDescriptorPool(pool.pool.get());
 
   // Move the pool to the recycled list.
   Lock recycled_lock(recycled_mutex_);
@@ -148,16 +244,18 @@ void DescriptorPoolRecyclerVK::Reclaim(vk::UniqueDescriptorPool&& pool) {
   }
 }
 
-vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Get() {
+DescriptorPoolAndSize DescriptorPoolRecyclerVK::Get() {
+  DescriptorPoolSize size = GetPoolSize();
   // Recycle a pool with a matching minumum capcity if it is available.
-  auto recycled_pool = Reuse();
+  auto recycled_pool = Reuse(size);
   if (recycled_pool.has_value()) {
     return std::move(recycled_pool.value());
   }
-  return Create();
+  return Create(size);
 }
 
-vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Create() {
+DescriptorPoolAndSize DescriptorPoolRecyclerVK::Create(
+    const DescriptorPoolSize& size) {
   auto strong_context = context_.lock();
   if (!strong_context) {
     VALIDATION_LOG << "Unable to create a descriptor pool";
@@ -166,36 +264,111 @@ vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Create() {
 
   std::vector<vk::DescriptorPoolSize> pools = {
       vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler,
-                             kDefaultBindingSize.texture_bindings},
+                             static_cast<uint32_t>(size.texture_bindings)},
       vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer,
-                             kDefaultBindingSize.buffer_bindings},
+                             static_cast<uint32_t>(size.buffer_bindings)},
       vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer,
-                             kDefaultBindingSize.storage_bindings},
+                             static_cast<uint32_t>(size.storage_bindings)},
       vk::DescriptorPoolSize{vk::DescriptorType::eInputAttachment,
-                             kDefaultBindingSize.subpass_bindings}};
+                             static_cast<uint32_t>(size.subpass_bindings)}};
   vk::DescriptorPoolCreateInfo pool_info;
-  pool_info.setMaxSets(kDefaultBindingSize.texture_bindings +
-                       kDefaultBindingSize.buffer_bindings +
-                       kDefaultBindingSize.storage_bindings +
-                       kDefaultBindingSize.subpass_bindings);
+  pool_info.setMaxSets(size.GetTotal());
   pool_info.setPoolSizes(pools);
   auto [result, pool] =
       strong_context->GetDevice().createDescriptorPoolUnique(pool_info);
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Unable to create a descriptor pool";
+    return {};
   }
-  return std::move(pool);
+  {
+    Lock lock(size_mutex_);
+    stats_.created_pools++;
+  }
+  return DescriptorPoolAndSize{.pool = std::move(pool), .size = size};
 }
 
-std::optional<vk::UniqueDescriptorPool> DescriptorPoolRecyclerVK::Reuse() {
+std::optional<DescriptorPoolAndSize> DescriptorPoolRecyclerVK::Reuse(
+    const DescriptorPoolSize& size) {
   Lock lock(recycled_mutex_);
-  if (recycled_.empty()) {
-    return std::nullopt;
+  while (!recycled_.empty()) {
+    auto recycled = std::move(recycled_[recycled_.size() - 1]);
+    recycled_.pop_back();
+    // Pools of a different size than the current one are dropped, so that
+    // the recycled pools converge on the current size.
+    if (recycled.size == size) {
+      return recycled;
+    }
+  }
+  return std::nullopt;
+}
+
+// Returns the smallest power of two multiple of |minimum| that is at least
+// |value|.
+static size_t RoundUpToPowerOfTwoMultiple(size_t value, size_t minimum) {
+  size_t result = minimum;
+  while (result < value) {
+    result *= 2;
+  }
+  return result;
+}
+
+void DescriptorPoolRecyclerVK::RecordFrameUsage(
+    const DescriptorPoolSize& usage,
+    const DescriptorPoolVK::Stats& stats) {
+  Lock lock(size_mutex_);
+  stats_.allocated_sets += stats.allocated_sets;
+  stats_.updated_sets += stats.updated_sets;
+  stats_.reused_sets += stats.reused_sets;
+
+  if (!pool_size_.Contains(usage)) {
+    // Grow right away so that the next frame fits into a single pool.
+    pool_size_ = DescriptorPoolSize{
+        .buffer_bindings = RoundUpToPowerOfTwoMultiple(
+            usage.buffer_bindings, pool_size_.buffer_bindings),
+        .texture_bindings = RoundUpToPowerOfTwoMultiple(
+            usage.texture_bindings, pool_size_.texture_bindings),
+        .storage_bindings = RoundUpToPowerOfTwoMultiple(
+            usage.storage_bindings, pool_size_.storage_bindings),
+        .subpass_bindings = RoundUpToPowerOfTwoMultiple(
+            usage.subpass_bindings, pool_size_.subpass_bindings),
+    };
+    frames_below_half_size_ = 0u;
+    return;
+  }
+
+  if (pool_size_ == kDefaultPoolSize) {
+    return;
   }
+  DescriptorPoolSize half_size = DescriptorPoolSize{
+      .buffer_bindings = std::max(pool_size_.buffer_bindings / 2,
+                                  kDefaultPoolSize.buffer_bindings),
+      .texture_bindings = std::max(pool_size_.texture_bindings / 2,
+                                   kDefaultPoolSize.texture_bindings),
+      .storage_bindings = std::max(pool_size_.storage_bindings / 2,
+                                   kDefaultPoolSize.storage_bindings),
+      .subpass_bindings = std::max(pool_size_.subpass_bindings / 2,
+                                   kDefaultPoolSize.subpass_bindings),
+  };
+  if (!half_size.Contains(usage)) {
+    frames_below_half_size_ = 0u;
+    return;
+  }
+  // Only shrink after a period of lower usage, as recycled pools of the old
+  // size are dropped.
+  if (++frames_below_half_size_ >= kPoolShrinkFrameCount) {
+    pool_size_ = half_size;
+    frames_below_half_size_ = 0u;
+  }
+}
+
+DescriptorPoolSize DescriptorPoolRecyclerVK::GetPoolSize() const {
+  Lock lock(size_mutex_);
+  return pool_size_;
+}
 
-  auto recycled = std::move(recycled_[recycled_.size() - 1]);
-  recycled_.pop_back();
-  return recycled;
+DescriptorPoolRecyclerVK::Stats DescriptorPoolRecyclerVK::GetStats() const {
+  Lock lock(size_mutex_);
+  return stats_;
 }
 
 }  // namespace impeller
@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_POOL_VK_H_
 
 #include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 #include "fml/status_or.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -13,6 +15,45 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      The number of descriptors of each type that a descriptor pool
+///             holds, or that a frame used.
+///
+struct DescriptorPoolSize {
+  size_t buffer_bindings = 0u;
+  size_t texture_bindings = 0u;
+  size_t storage_bindings = 0u;
+  size_t subpass_bindings = 0u;
+
+  constexpr size_t GetTotal() const {
+    return buffer_bindings + texture_bindings + storage_bindings +
+           subpass_bindings;
+  }
+
+  constexpr bool Contains(const DescriptorPoolSize& other) const {
+    return buffer_bindings >= other.buffer_bindings &&
+           texture_bindings >= other.texture_bindings &&
+           storage_bindings >= other.storage_bindings &&
+           subpass_bindings >= other.subpass_bindings;
+  }
+
+  constexpr bool operator==(const DescriptorPoolSize& other) const {
+    return buffer_bindings == other.buffer_bindings &&
+           texture_bindings == other.texture_bindings &&
+           storage_bindings == other.storage_bindings &&
+           subpass_bindings == other.subpass_bindings;
+  }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A descriptor pool along with the number of descriptors it was
+///             created to hold.
+///
+struct DescriptorPoolAndSize {
+  vk::UniqueDescriptorPool pool;
+  DescriptorPoolSize size;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A per-frame descriptor pool. Descriptors
 ///             from this pool don't need to be freed individually. Instead, the
@@ -24,8 +65,22 @@ namespace impeller {
 ///
 ///             Encoders create pools as necessary as they have the same
 ///             threading and lifecycle restrictions.
+///
+///             Descriptor sets are never updated after they are first
+///             written. Draws of the same command buffer that bind the same
+///             resources to the same layout share a descriptor set.
 class DescriptorPoolVK {
  public:
+  /// Counters of the descriptor set operations performed on a pool.
+  struct Stats {
+    /// The number of calls to vkAllocateDescriptorSets.
+    size_t allocated_sets = 0u;
+    /// The number of calls to vkUpdateDescriptorSets.
+    size_t updated_sets = 0u;
+    /// The number of requests served by an existing descriptor set.
+    size_t reused_sets = 0u;
+  };
+
   explicit DescriptorPoolVK(std::weak_ptr<const ContextVK> context);
 
   ~DescriptorPoolVK();
@@ -34,9 +89,53 @@ class DescriptorPoolVK {
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context_vk);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set of the given [layout] with the given
+  ///             descriptor [writes] applied.
+  ///
+  ///             If a descriptor set with the same layout and writes was
+  ///             created from this pool for the same [scope] before, it is
+  ///             returned and no descriptors are allocated or updated.
+  ///             Otherwise a new set is allocated, the `dstSet` of the writes
+  ///             is pointed at it, and it is updated.
+  ///
+  ///             The resources referenced by the writes must stay alive for
+  ///             as long as the [scope] is in use, as the handles of
+  ///             destroyed resources may be reused by new ones. Command
+  ///             buffers use a unique scope that tracks their resources.
+  ///
+  fml::StatusOr<vk::DescriptorSet> GetOrCreateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      const ContextVK& context_vk,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      uint64_t scope);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The descriptor set operations performed on this pool.
+  ///
+  const Stats& GetStats() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of descriptors of each type written into the
+  ///             descriptor sets created from this pool.
+  ///
+  const DescriptorPoolSize& GetUsage() const;
+
  private:
+  struct DescriptorSetKeyHash {
+    std::size_t operator()(const std::vector<uint64_t>& key) const;
+  };
+
   std::weak_ptr<const ContextVK> context_;
-  std::vector<vk::UniqueDescriptorPool> pools_;
+  std::vector<DescriptorPoolAndSize> pools_;
+  std::unordered_map<std::vector<uint64_t>,
+                     vk::DescriptorSet,
+                     DescriptorSetKeyHash>
+      descriptor_sets_;
+  std::vector<uint64_t> key_workspace_;
+  Stats stats_;
+  DescriptorPoolSize usage_;
 
   fml::Status CreateNewPool(const ContextVK& context_vk);
 
@@ -51,11 +150,33 @@ class DescriptorPoolVK {
 class DescriptorPoolRecyclerVK final
     : public std::enable_shared_from_this<DescriptorPoolRecyclerVK> {
  public:
+  /// Counters of the descriptor set operations of all the pools handed out
+  /// by a recycler.
+  struct Stats {
+    size_t allocated_sets = 0u;
+    size_t updated_sets = 0u;
+    size_t reused_sets = 0u;
+    /// The number of calls to vkCreateDescriptorPool.
+    size_t created_pools = 0u;
+  };
+
   ~DescriptorPoolRecyclerVK() = default;
 
   /// The maximum number of descriptor pools this recycler will hold onto.
   static constexpr size_t kMaxRecycledPools = 32u;
 
+  /// The smallest size of the descriptor pools that are created.
+  static constexpr DescriptorPoolSize kDefaultPoolSize = DescriptorPoolSize{
+      .buffer_bindings = 512u,   // Buffer Bindings
+      .texture_bindings = 256u,  // Texture Bindings
+      .storage_bindings = 32u,   // Storage Bindings
+      .subpass_bindings = 4u     // Subpass Bindings
+  };
+
+  /// The number of consecutive frames that have to fit into half of the pool
+  /// size before it is halved.
+  static constexpr size_t kPoolShrinkFrameCount = 60u;
+
   /// @brief      Creates a recycler for the given |ContextVK|.
   ///
   /// @param[in]  context The context to create the recycler for.
@@ -66,30 +187,56 @@ class DescriptorPoolRecyclerVK final
   ///
   ///             This may create a new descriptor pool if no existing pools had
   ///             the necessary capacity.
-  vk::UniqueDescriptorPool Get();
+  DescriptorPoolAndSize Get();
 
   /// @brief      Returns the descriptor pool to be reset on a background
   ///             thread.
   ///
   /// @param[in]  pool The pool to recycler.
-  void Reclaim(vk::UniqueDescriptorPool&& pool);
+  void Reclaim(DescriptorPoolAndSize&& pool);
+
+  /// @brief      Records the descriptors used by a per-frame descriptor pool
+  ///             that is being collected.
+  ///
+  ///             The size of the pools handed out grows to fit the usage of
+  ///             the largest frame, so that a frame normally needs a single
+  ///             pool, and shrinks again once frames have used less than
+  ///             half of it for |kPoolShrinkFrameCount| frames.
+  ///
+  /// @param[in]  usage  The descriptors the frame wrote.
+  /// @param[in]  stats  The descriptor set operations of the frame.
+  void RecordFrameUsage(const DescriptorPoolSize& usage,
+                        const DescriptorPoolVK::Stats& stats);
+
+  /// @brief      The size of the descriptor pools that are currently handed
+  ///             out.
+  DescriptorPoolSize GetPoolSize() const;
+
+  /// @brief      The descriptor set operations of all the collected pools.
+  Stats GetStats() const;
 
  private:
   std::weak_ptr<ContextVK> context_;
 
   Mutex recycled_mutex_;
-  std::vector<vk::UniqueDescriptorPool> recycled_ IPLR_GUARDED_BY(
+  std::vector<DescriptorPoolAndSize> recycled_ IPLR_GUARDED_BY(
       recycled_mutex_);
 
+  mutable Mutex size_mutex_;
+  DescriptorPoolSize pool_size_ IPLR_GUARDED_BY(size_mutex_) =
+      kDefaultPoolSize;
+  size_t frames_below_half_size_ IPLR_GUARDED_BY(size_mutex_) = 0u;
+  Stats stats_ IPLR_GUARDED_BY(size_mutex_);
+
   /// @brief      Creates a new |vk::CommandPool|.
   ///
   /// @returns    Returns a |std::nullopt| if a pool could not be created.
-  vk::UniqueDescriptorPool Create();
+  DescriptorPoolAndSize Create(const DescriptorPoolSize& size);
 
   /// @brief      Reuses a recycled |vk::CommandPool|, if available.
   ///
   /// @returns    Returns a |std::nullopt| if a pool was not available.
-  std::optional<vk::UniqueDescriptorPool> Reuse();
+  std::optional<DescriptorPoolAndSize> Reuse(const DescriptorPoolSize& size);
 
   DescriptorPoolRecyclerVK(const DescriptorPoolRecyclerVK&) = delete;
 
@@ -20,7 +20,7 @@ TEST(DescriptorPoolRecyclerVKTest, GetDescriptorPoolRecyclerCreatesNewPools) {
   auto const pool2 = context->GetDescriptorPoolRecycler()->Get();
 
   // The two descriptor pools should be different.
-  EXPECT_NE(pool1.get(), pool2.get());
+  EXPECT_NE(pool1.pool.get(), pool2.pool.get());
 
   context->Shutdown();
 }
@@ -146,5 +146,91 @@ TEST(DescriptorPoolRecyclerVKTest, MultipleCommandBuffersShareDescriptorPool) {
   context->Shutdown();
 }
 
+TEST(DescriptorPoolRecyclerVKTest, ReusesDescriptorSetsForIdenticalBindings) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    DescriptorPoolVK pool(context);
+
+    vk::DescriptorBufferInfo buffer_info;
+    buffer_info.buffer = vk::Buffer(reinterpret_cast<VkBuffer>(0x1));
+    buffer_info.offset = 0u;
+    buffer_info.range = 256u;
+
+    vk::WriteDescriptorSet write_set;
+    write_set.dstBinding = 0u;
+    write_set.descriptorCount = 1u;
+    write_set.descriptorType = vk::DescriptorType::eUniformBuffer;
+    write_set.pBufferInfo = &buffer_info;
+
+    EXPECT_TRUE(
+        pool.GetOrCreateDescriptorSet({}, *context, &write_set, 1u, 1u).ok());
+    EXPECT_TRUE(
+        pool.GetOrCreateDescriptorSet({}, *context, &write_set, 1u, 1u).ok());
+    EXPECT_EQ(pool.GetStats().allocated_sets, 1u);
+    EXPECT_EQ(pool.GetStats().updated_sets, 1u);
+    EXPECT_EQ(pool.GetStats().reused_sets, 1u);
+
+    // A different binding needs a new descriptor set.
+    buffer_info.offset = 256u;
+    EXPECT_TRUE(
+        pool.GetOrCreateDescriptorSet({}, *context, &write_set, 1u, 1u).ok());
+    EXPECT_EQ(pool.GetStats().allocated_sets, 2u);
+
+    // Descriptor sets are not shared between scopes.
+    EXPECT_TRUE(
+        pool.GetOrCreateDescriptorSet({}, *context, &write_set, 1u, 2u).ok());
+    EXPECT_EQ(pool.GetStats().allocated_sets, 3u);
+    EXPECT_EQ(pool.GetStats().updated_sets, 3u);
+    EXPECT_EQ(pool.GetUsage().buffer_bindings, 3u);
+
+    auto const called = GetMockVulkanFunctions(context->GetDevice());
+    EXPECT_EQ(std::count(called->begin(), called->end(),
+                         "vkAllocateDescriptorSets"),
+              3u);
+    EXPECT_EQ(
+        std::count(called->begin(), called->end(), "vkUpdateDescriptorSets"),
+        3u);
+  }
+
+  // The counters are handed to the recycler when the pool is collected.
+  auto const stats = context->GetDescriptorPoolRecycler()->GetStats();
+  EXPECT_EQ(stats.allocated_sets, 3u);
+  EXPECT_EQ(stats.updated_sets, 3u);
+  EXPECT_EQ(stats.reused_sets, 1u);
+
+  context->Shutdown();
+}
+
+TEST(DescriptorPoolRecyclerVKTest, PoolSizeFollowsFrameUsage) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const recycler = context->GetDescriptorPoolRecycler();
+
+  EXPECT_EQ(recycler->GetPoolSize(),
+            DescriptorPoolRecyclerVK::kDefaultPoolSize);
+
+  // A frame that needed more descriptors than a pool holds grows the pools.
+  DescriptorPoolSize usage = DescriptorPoolRecyclerVK::kDefaultPoolSize;
+  usage.buffer_bindings = 1500u;
+  recycler->RecordFrameUsage(usage, {});
+  EXPECT_EQ(recycler->GetPoolSize().buffer_bindings, 2048u);
+  EXPECT_EQ(recycler->GetPoolSize().texture_bindings, 256u);
+
+  auto const pool = recycler->Get();
+  EXPECT_EQ(pool.size, recycler->GetPoolSize());
+
+  // The pools shrink once frames have fit into half of them for a while.
+  usage.buffer_bindings = 100u;
+  for (auto i = 1u; i < DescriptorPoolRecyclerVK::kPoolShrinkFrameCount;
+       i++) {
+    recycler->RecordFrameUsage(usage, {});
+  }
+  EXPECT_EQ(recycler->GetPoolSize().buffer_bindings, 2048u);
+  recycler->RecordFrameUsage(usage, {});
+  EXPECT_EQ(recycler->GetPoolSize().buffer_bindings, 1024u);
+
+  context->Shutdown();
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -20,7 +20,8 @@ DeviceBufferVK::DeviceBufferVK(DeviceBufferDescriptor desc,
                 BufferResource{
                     std::move(buffer),  //
                     info                //
-                }),
+                },
+                info.size),
       is_host_coherent_(is_host_coherent) {}
 
 DeviceBufferVK::~DeviceBufferVK() = default;
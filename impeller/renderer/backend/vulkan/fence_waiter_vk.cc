@@ -12,6 +12,8 @@
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
+#include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 
 namespace impeller {
 
@@ -52,8 +54,12 @@ class WaitSetEntry {
   WaitSetEntry& operator=(WaitSetEntry&&) = delete;
 };
 
-FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder)
-    : device_holder_(std::move(device_holder)) {
+FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder,
+                             std::weak_ptr<ResourceManagerVK> resource_manager,
+                             bool use_timeline_semaphores)
+    : device_holder_(std::move(device_holder)),
+      resource_manager_(std::move(resource_manager)),
+      use_timeline_semaphores_(use_timeline_semaphores) {
   waiter_thread_ = std::make_unique<std::thread>([&]() { Main(); });
 }
 
@@ -79,6 +85,108 @@ bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
   return true;
 }
 
+bool FenceWaiterVK::UsesTimelineSemaphores() const {
+  return use_timeline_semaphores_;
+}
+
+vk::Result FenceWaiterVK::Submit(const QueueVK& queue,
+                                 vk::SubmitInfo submit_info,
+                                 const fml::closure& callback) {
+  FML_DCHECK(use_timeline_semaphores_);
+  if (!use_timeline_semaphores_ || !callback) {
+    return vk::Result::eErrorFeatureNotPresent;
+  }
+  auto device_holder = device_holder_.lock();
+  if (!device_holder) {
+    return vk::Result::eErrorDeviceLost;
+  }
+
+  // Timeline values must be signaled in increasing order. Hold the lock
+  // across the submission so that values are assigned in submission order.
+  std::scoped_lock submit_lock(submit_mutex_);
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    if (terminate_) {
+      return vk::Result::eErrorDeviceLost;
+    }
+  }
+
+  TimelineVK* timeline = GetTimeline(queue, device_holder->GetDevice());
+  if (!timeline) {
+    return vk::Result::eErrorInitializationFailed;
+  }
+  const uint64_t value = timeline->last_submitted_value + 1u;
+
+  // Append the timeline to the semaphores signaled by the submission. Binary
+  // semaphores ignore their entries in the values array.
+  std::vector<vk::Semaphore> signal_semaphores(
+      submit_info.pSignalSemaphores,
+      submit_info.pSignalSemaphores + submit_info.signalSemaphoreCount);
+  signal_semaphores.push_back(timeline->semaphore.get());
+  std::vector<uint64_t> signal_values(signal_semaphores.size(), 0u);
+  signal_values.back() = value;
+
+  vk::TimelineSemaphoreSubmitInfoKHR timeline_info;
+  timeline_info.setSignalSemaphoreValues(signal_values);
+  timeline_info.pNext = submit_info.pNext;
+  submit_info.setSignalSemaphores(signal_semaphores);
+  submit_info.pNext = &timeline_info;
+
+  const auto result = queue.Submit(submit_info, {});
+  if (result != vk::Result::eSuccess) {
+    return result;
+  }
+  timeline->last_submitted_value = value;
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    timeline->pending.emplace_back(value, fml::ScopedCleanupClosure(callback));
+  }
+  wait_set_cv_.notify_one();
+  return result;
+}
+
+FenceWaiterVK::TimelineVK* FenceWaiterVK::GetTimeline(
+    const QueueVK& queue,
+    const vk::Device& device) {
+  for (const auto& timeline : timelines_) {
+    if (timeline->queue == &queue) {
+      return timeline.get();
+    }
+  }
+
+  vk::SemaphoreTypeCreateInfoKHR type_info;
+  type_info.semaphoreType = vk::SemaphoreType::eTimeline;
+  type_info.initialValue = 0u;
+  vk::SemaphoreCreateInfo semaphore_info;
+  semaphore_info.pNext = &type_info;
+  auto [result, semaphore] = device.createSemaphoreUnique(semaphore_info);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create timeline semaphore: "
+                   << vk::to_string(result);
+    return nullptr;
+  }
+
+  auto timeline = std::make_unique<TimelineVK>();
+  timeline->queue = &queue;
+  timeline->semaphore = std::move(semaphore);
+  TimelineVK* timeline_ptr = timeline.get();
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    timelines_.emplace_back(std::move(timeline));
+  }
+  return timeline_ptr;
+}
+
+bool FenceWaiterVK::HasPendingWorkLocked() const {
+  if (!wait_set_.empty()) {
+    return true;
+  }
+  return std::any_of(timelines_.begin(), timelines_.end(),
+                     [](const auto& timeline) {
+                       return !timeline->pending.empty();
+                     });
+}
+
 static std::vector<vk::Fence> GetFencesForWaitSet(const WaitSet& set) {
   std::vector<vk::Fence> fences;
   for (const auto& entry : set) {
@@ -102,9 +210,9 @@ void FenceWaiterVK::Main() {
     {
       std::unique_lock lock(wait_set_mutex_);
 
-      // If there are no fences to wait on, wait on the condition variable.
+      // If there is no work to wait on, wait on the condition variable.
       wait_set_cv_.wait(lock,
-                        [&]() { return !wait_set_.empty() || terminate_; });
+                        [&]() { return HasPendingWorkLocked() || terminate_; });
 
       // Still under the lock, check if the waiter has been terminated.
       terminate = terminate_;
@@ -122,20 +230,34 @@ void FenceWaiterVK::Main() {
 }
 
 void FenceWaiterVK::WaitUntilEmpty() {
-  // Note, there is no lock because once terminate_ is set to true, no other
-  // fence can be added to the wait set. Just in case, here's a FML_DCHECK:
+  // Once terminate_ is set to true, no other fence or submission can be added.
+  // Just in case, here's a FML_DCHECK:
   FML_DCHECK(terminate_) << "Fence waiter must be terminated.";
-  while (!wait_set_.empty() && Wait()) {
+  auto has_pending_work = [&]() {
+    std::scoped_lock lock(wait_set_mutex_);
+    return HasPendingWorkLocked();
+  };
+  while (has_pending_work() && Wait()) {
     // Intentionally empty.
   }
 }
 
 bool FenceWaiterVK::Wait() {
-  // Snapshot the wait set and wait on the fences.
+  // Snapshot the wait set and the timelines with outstanding submissions.
   WaitSet wait_set;
+  std::vector<TimelineVK*> timelines;
+  std::vector<vk::Semaphore> semaphores;
+  std::vector<uint64_t> semaphore_values;
   {
     std::scoped_lock lock(wait_set_mutex_);
     wait_set = wait_set_;
+    for (const auto& timeline : timelines_) {
+      if (!timeline->pending.empty()) {
+        timelines.push_back(timeline.get());
+        semaphores.push_back(timeline->semaphore.get());
+        semaphore_values.push_back(timeline->pending.front().first);
+      }
+    }
   }
 
   using namespace std::literals::chrono_literals;
@@ -152,15 +274,29 @@ bool FenceWaiterVK::Wait() {
   // to be signaled at an abnormally long deadline is the only one in the set,
   // a timeout will bail out the wait.
   auto fences = GetFencesForWaitSet(wait_set);
-  if (fences.empty()) {
+  if (fences.empty() && semaphores.empty()) {
     return true;
   }
 
-  auto result = device.waitForFences(
-      /*fenceCount=*/fences.size(),
-      /*pFences=*/fences.data(),
-      /*waitAll=*/false,
-      /*timeout=*/std::chrono::nanoseconds{100ms}.count());
+  vk::Result result;
+  if (!fences.empty()) {
+    // Fences and semaphores cannot be waited on in the same call. If both are
+    // outstanding, wake up frequently to check on the timelines.
+    const auto timeout = semaphores.empty() ? 100ms : 1ms;
+    result = device.waitForFences(
+        /*fenceCount=*/fences.size(),
+        /*pFences=*/fences.data(),
+        /*waitAll=*/false,
+        /*timeout=*/std::chrono::nanoseconds{timeout}.count());
+  } else {
+    // Wait for the oldest outstanding submission on any of the queues.
+    vk::SemaphoreWaitInfoKHR wait_info;
+    wait_info.flags = vk::SemaphoreWaitFlagBits::eAny;
+    wait_info.setSemaphores(semaphores);
+    wait_info.setValues(semaphore_values);
+    result = device.waitSemaphoresKHR(
+        wait_info, /*timeout=*/std::chrono::nanoseconds{100ms}.count());
+  }
   if (!(result == vk::Result::eSuccess || result == vk::Result::eTimeout)) {
     VALIDATION_LOG << "Fence waiter encountered an unexpected error. Tearing "
                       "down the waiter thread.";
@@ -177,10 +313,23 @@ bool FenceWaiterVK::Wait() {
     wait_set.clear();
   }
 
+  // Find out how far along each timeline is.
+  std::vector<uint64_t> completed_values(timelines.size(), 0u);
+  for (size_t i = 0; i < timelines.size(); i++) {
+    auto value = device.getSemaphoreCounterValueKHR(semaphores[i]);
+    if (value.result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not read timeline semaphore value: "
+                     << vk::to_string(value.result);
+      return false;
+    }
+    completed_values[i] = value.value;
+  }
+
   // Quickly acquire the wait set lock and erase signaled entries. Make sure
   // the mutex is unlocked before calling the destructors of the erased
   // entries. These might touch allocators.
   WaitSet erased_entries;
+  std::vector<fml::ScopedCleanupClosure> completed_submissions;
   {
     static constexpr auto is_signalled = [](const auto& entry) {
       return entry->IsSignalled();
@@ -193,12 +342,37 @@ bool FenceWaiterVK::Wait() {
     wait_set_.erase(
         std::remove_if(wait_set_.begin(), wait_set_.end(), is_signalled),
         wait_set_.end());
+
+    for (size_t i = 0; i < timelines.size(); i++) {
+      auto& pending = timelines[i]->pending;
+      while (!pending.empty() && pending.front().first <= completed_values[i]) {
+        completed_submissions.emplace_back(std::move(pending.front().second));
+        pending.pop_front();
+      }
+    }
+  }
+
+  if (erased_entries.empty() && completed_submissions.empty()) {
+    return true;
   }
 
   {
     TRACE_EVENT0("impeller", "ClearSignaledFences");
+    // The callbacks release the resources tracked by the command buffers.
+    // Collect everything they free in a single batch.
+    auto resource_manager = resource_manager_.lock();
+    if (resource_manager) {
+      resource_manager->BeginEpoch();
+    }
     // Erase the erased entries which will invoke callbacks.
     erased_entries.clear();  // Bit redundant because of scope but hey.
+    // Invoke the callbacks of completed submissions in submission order.
+    for (auto& callback : completed_submissions) {
+      callback.Reset();
+    }
+    if (resource_manager) {
+      resource_manager->EndEpoch();
+    }
   }
 
   return true;
@@ -6,8 +6,12 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_FENCE_WAITER_VK_H_
 
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -16,10 +20,23 @@
 namespace impeller {
 
 class ContextVK;
+class QueueVK;
+class ResourceManagerVK;
 class WaitSetEntry;
 
 using WaitSet = std::vector<std::shared_ptr<WaitSetEntry>>;
 
+//------------------------------------------------------------------------------
+/// @brief      Invokes callbacks on a dedicated thread once the GPU has
+///             finished work submitted to a queue.
+///
+///             Completion is either tracked with a fence per submission
+///             (`AddFence`) or, if the device supports timeline semaphores,
+///             with a single timeline semaphore per queue (`Submit`). The
+///             latter avoids creating a fence for every submission and waits
+///             on all queues with one call. Callbacks for submissions to the
+///             same queue are invoked in submission order.
+///
 class FenceWaiterVK {
  public:
   ~FenceWaiterVK();
@@ -30,17 +47,64 @@ class FenceWaiterVK {
 
   bool AddFence(vk::UniqueFence fence, const fml::closure& callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether `Submit` tracks completion with timeline semaphores.
+  ///             If not, callers must use `AddFence`.
+  ///
+  bool UsesTimelineSemaphores() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submit work to the queue and invoke the callback once it has
+  ///             completed. The submission signals the timeline semaphore of
+  ///             the queue. May only be used if `UsesTimelineSemaphores`.
+  ///
+  /// @param[in]  queue        The queue to submit to.
+  /// @param[in]  submit_info  The submission. Must not signal other timeline
+  ///                          semaphores.
+  /// @param[in]  callback     Invoked when the work has completed or the
+  ///                          waiter is torn down. Dropped if the submission
+  ///                          fails.
+  ///
+  /// @return     The result of the queue submission.
+  ///
+  vk::Result Submit(const QueueVK& queue,
+                    vk::SubmitInfo submit_info,
+                    const fml::closure& callback);
+
  private:
   friend class ContextVK;
 
+  struct TimelineVK {
+    const QueueVK* queue = nullptr;
+    vk::UniqueSemaphore semaphore;
+    // The value signaled by the last submission. Guarded by submit_mutex_.
+    uint64_t last_submitted_value = 0u;
+    // Callbacks in submission order. Guarded by wait_set_mutex_.
+    std::deque<std::pair<uint64_t, fml::ScopedCleanupClosure>> pending;
+  };
+
   std::weak_ptr<DeviceHolderVK> device_holder_;
+  std::weak_ptr<ResourceManagerVK> resource_manager_;
+  const bool use_timeline_semaphores_;
   std::unique_ptr<std::thread> waiter_thread_;
+  // Orders the assignment of timeline values with the queue submissions that
+  // signal them. Acquired before wait_set_mutex_.
+  std::mutex submit_mutex_;
   std::mutex wait_set_mutex_;
   std::condition_variable wait_set_cv_;
   WaitSet wait_set_;
+  // Created lazily, one per queue. Only ever appended to while holding both
+  // submit_mutex_ and wait_set_mutex_.
+  std::vector<std::unique_ptr<TimelineVK>> timelines_;
   bool terminate_ = false;
 
-  explicit FenceWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder);
+  FenceWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder,
+                std::weak_ptr<ResourceManagerVK> resource_manager,
+                bool use_timeline_semaphores);
+
+  TimelineVK* GetTimeline(const QueueVK& queue, const vk::Device& device);
+
+  bool HasPendingWorkLocked() const;
 
   void Main();
 
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <vector>
+
 #include "fml/synchronization/waitable_event.h"
 #include "gtest/gtest.h"  // IWYU pragma: keep
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"  // IWYU pragma: keep
@@ -126,5 +129,40 @@ TEST(FenceWaiterVKTest, InProgressFencesStillWaitIfTerminated) {
   signal.Wait();
 }
 
+TEST(FenceWaiterVKTest, DoesNotUseTimelineSemaphoresIfUnsupported) {
+  auto const context = MockVulkanContextBuilder().Build();
+  EXPECT_FALSE(context->GetFenceWaiter()->UsesTimelineSemaphores());
+}
+
+TEST(FenceWaiterVKTest, ExecutesTimelineCallbacksInSubmissionOrder) {
+  auto const context =
+      MockVulkanContextBuilder()
+          .SetDeviceExtensions(
+              {"VK_KHR_swapchain", "VK_KHR_timeline_semaphore"})
+          .Build();
+  auto const waiter = context->GetFenceWaiter();
+  ASSERT_TRUE(waiter->UsesTimelineSemaphores());
+
+  std::vector<int> order;
+  auto signal = fml::ManualResetWaitableEvent();
+  const auto& queue = *context->GetGraphicsQueue();
+  EXPECT_EQ(waiter->Submit(queue, {}, [&order]() { order.push_back(1); }),
+            vk::Result::eSuccess);
+  EXPECT_EQ(waiter->Submit(queue, {},
+                           [&order, &signal]() {
+                             order.push_back(2);
+                             signal.Signal();
+                           }),
+            vk::Result::eSuccess);
+  signal.Wait();
+
+  EXPECT_EQ(order, std::vector<int>({1, 2}));
+
+  // No per-submission fences are necessary.
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::find(called->begin(), called->end(), "vkCreateFence"),
+            called->end());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,6 +4,10 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
 #include "flutter/fml/file.h"
 #include "impeller/base/allocation.h"
 #include "impeller/base/validation.h"
@@ -12,6 +16,8 @@ namespace impeller {
 
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
+static constexpr const char* kPipelineManifestFileName =
+    "flutter.impeller.vkmanifest";
 
 bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
                               const VkPhysicalDeviceProperties& props,
@@ -114,4 +120,346 @@ bool PipelineCacheHeaderVK::IsCompatibleWith(
          std::memcmp(uuid, o.uuid, VK_UUID_SIZE) == 0;
 }
 
+namespace {
+
+//------------------------------------------------------------------------------
+/// The header prepended to the manifest of used pipelines. Unlike the
+/// pipeline cache data, the manifest does not depend on the driver. Bump the
+/// version whenever the encoding of entries changes.
+///
+struct PipelineManifestHeaderVK {
+  uint32_t magic = 0xC0DEF00E;
+  uint32_t version = 1u;
+  uint32_t abi = sizeof(void*);
+  uint32_t entry_count = 0u;
+  uint64_t data_size = 0u;
+  uint64_t checksum = 0u;
+};
+
+// FNV-1a. Guards against truncated or otherwise corrupt manifests. The
+// manifest drives pipeline creation so it must not be trusted blindly.
+uint64_t ComputeManifestChecksum(const uint8_t* data, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+class ManifestWriter {
+ public:
+  template <class T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    data_.insert(data_.end(), bytes, bytes + sizeof(T));
+  }
+
+  void WriteString(const std::string& string) {
+    Write<uint32_t>(string.size());
+    data_.insert(data_.end(), string.begin(), string.end());
+  }
+
+  const std::vector<uint8_t>& GetData() const { return data_; }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+class ManifestReader {
+ public:
+  ManifestReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  template <class T>
+  bool Read(T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (size_ - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(std::string& string) {
+    uint32_t length = 0u;
+    if (!Read(length) || size_ - offset_ < length) {
+      return false;
+    }
+    string.assign(reinterpret_cast<const char*>(data_ + offset_), length);
+    offset_ += length;
+    return true;
+  }
+
+  bool IsAtEnd() const { return offset_ == size_; }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_ = 0u;
+};
+
+template <class T>
+void WriteOptional(ManifestWriter& writer, const std::optional<T>& value) {
+  writer.Write<uint8_t>(value.has_value());
+  if (value.has_value()) {
+    writer.Write(value.value());
+  }
+}
+
+template <class T>
+bool ReadOptional(ManifestReader& reader, std::optional<T>& value) {
+  uint8_t has_value = 0u;
+  if (!reader.Read(has_value)) {
+    return false;
+  }
+  if (!has_value) {
+    value = std::nullopt;
+    return true;
+  }
+  T read_value;
+  if (!reader.Read(read_value)) {
+    return false;
+  }
+  value = read_value;
+  return true;
+}
+
+void WriteEntry(ManifestWriter& writer, const PipelineManifestEntryVK& entry) {
+  writer.WriteString(entry.label);
+  writer.Write<uint32_t>(entry.entrypoints.size());
+  for (const auto& [stage, name] : entry.entrypoints) {
+    writer.Write(stage);
+    writer.WriteString(name);
+  }
+  writer.Write<uint32_t>(entry.specialization_constants.size());
+  for (const auto& constant : entry.specialization_constants) {
+    writer.Write(constant);
+  }
+  writer.Write(entry.sample_count);
+  writer.Write(entry.winding_order);
+  writer.Write(entry.cull_mode);
+  writer.Write(entry.primitive_type);
+  writer.Write(entry.polygon_mode);
+  writer.Write(entry.depth_pixel_format);
+  writer.Write(entry.stencil_pixel_format);
+  writer.Write<uint32_t>(entry.color_attachments.size());
+  for (const auto& [index, attachment] : entry.color_attachments) {
+    writer.Write<uint64_t>(index);
+    writer.Write(attachment);
+  }
+  WriteOptional(writer, entry.depth_attachment);
+  WriteOptional(writer, entry.front_stencil_attachment);
+  WriteOptional(writer, entry.back_stencil_attachment);
+}
+
+bool ReadEntry(ManifestReader& reader, PipelineManifestEntryVK& entry) {
+  uint32_t count = 0u;
+  if (!reader.ReadString(entry.label) || !reader.Read(count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    ShaderStage stage;
+    std::string name;
+    if (!reader.Read(stage) || !reader.ReadString(name)) {
+      return false;
+    }
+    entry.entrypoints[stage] = std::move(name);
+  }
+  if (!reader.Read(count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    Scalar constant;
+    if (!reader.Read(constant)) {
+      return false;
+    }
+    entry.specialization_constants.push_back(constant);
+  }
+  if (!reader.Read(entry.sample_count) ||          //
+      !reader.Read(entry.winding_order) ||         //
+      !reader.Read(entry.cull_mode) ||             //
+      !reader.Read(entry.primitive_type) ||        //
+      !reader.Read(entry.polygon_mode) ||          //
+      !reader.Read(entry.depth_pixel_format) ||    //
+      !reader.Read(entry.stencil_pixel_format) ||  //
+      !reader.Read(count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    uint64_t index = 0u;
+    ColorAttachmentDescriptor attachment;
+    if (!reader.Read(index) || !reader.Read(attachment)) {
+      return false;
+    }
+    entry.color_attachments[index] = attachment;
+  }
+  return ReadOptional(reader, entry.depth_attachment) &&
+         ReadOptional(reader, entry.front_stencil_attachment) &&
+         ReadOptional(reader, entry.back_stencil_attachment);
+}
+
+}  // namespace
+
+PipelineManifestEntryVK PipelineManifestEntryVK::FromDescriptor(
+    const PipelineDescriptor& desc) {
+  PipelineManifestEntryVK entry;
+  entry.label = std::string(desc.GetLabel());
+  for (const auto& [stage, function] : desc.GetStageEntrypoints()) {
+    if (function) {
+      entry.entrypoints[stage] = function->GetName();
+    }
+  }
+  entry.specialization_constants = desc.GetSpecializationConstants();
+  entry.sample_count = desc.GetSampleCount();
+  entry.winding_order = desc.GetWindingOrder();
+  entry.cull_mode = desc.GetCullMode();
+  entry.primitive_type = desc.GetPrimitiveType();
+  entry.polygon_mode = desc.GetPolygonMode();
+  entry.depth_pixel_format = desc.GetDepthPixelFormat();
+  entry.stencil_pixel_format = desc.GetStencilPixelFormat();
+  entry.color_attachments = desc.GetColorAttachmentDescriptors();
+  entry.depth_attachment = desc.GetDepthStencilAttachmentDescriptor();
+  entry.front_stencil_attachment = desc.GetFrontStencilAttachmentDescriptor();
+  entry.back_stencil_attachment = desc.GetBackStencilAttachmentDescriptor();
+  return entry;
+}
+
+bool PipelineManifestEntryVK::UsesSameProgramAs(
+    const PipelineDescriptor& desc) const {
+  const auto& desc_entrypoints = desc.GetStageEntrypoints();
+  if (desc_entrypoints.size() != entrypoints.size() ||
+      desc.GetSpecializationConstants() != specialization_constants) {
+    return false;
+  }
+  for (const auto& [stage, function] : desc_entrypoints) {
+    auto found = entrypoints.find(stage);
+    if (!function || found == entrypoints.end() ||
+        found->second != function->GetName()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PipelineManifestEntryVK::ApplyToDescriptor(
+    PipelineDescriptor& desc) const {
+  desc.SetLabel(label);
+  desc.SetSampleCount(sample_count);
+  desc.SetWindingOrder(winding_order);
+  desc.SetCullMode(cull_mode);
+  desc.SetPrimitiveType(primitive_type);
+  desc.SetPolygonMode(polygon_mode);
+  desc.SetDepthPixelFormat(depth_pixel_format);
+  desc.SetStencilPixelFormat(stencil_pixel_format);
+  desc.SetColorAttachmentDescriptors(color_attachments);
+  desc.SetDepthStencilAttachmentDescriptor(depth_attachment);
+  desc.SetStencilAttachmentDescriptors(front_stencil_attachment,
+                                       back_stencil_attachment);
+}
+
+bool PipelineManifestEntryVK::operator==(
+    const PipelineManifestEntryVK& o) const {
+  return label == o.label &&                                        //
+         entrypoints == o.entrypoints &&                            //
+         specialization_constants == o.specialization_constants &&  //
+         sample_count == o.sample_count &&                          //
+         winding_order == o.winding_order &&                        //
+         cull_mode == o.cull_mode &&                                //
+         primitive_type == o.primitive_type &&                      //
+         polygon_mode == o.polygon_mode &&                          //
+         depth_pixel_format == o.depth_pixel_format &&              //
+         stencil_pixel_format == o.stencil_pixel_format &&          //
+         color_attachments == o.color_attachments &&                //
+         depth_attachment == o.depth_attachment &&                  //
+         front_stencil_attachment == o.front_stencil_attachment &&  //
+         back_stencil_attachment == o.back_stencil_attachment;
+}
+
+bool PipelineCacheManifestPersist(
+    const fml::UniqueFD& cache_directory,
+    const std::vector<PipelineManifestEntryVK>& entries) {
+  if (!cache_directory.is_valid()) {
+    return false;
+  }
+  const size_t entry_count =
+      std::min(entries.size(), kMaxPipelineManifestEntries);
+  ManifestWriter writer;
+  for (size_t i = 0; i < entry_count; i++) {
+    WriteEntry(writer, entries[i]);
+  }
+  const auto& data = writer.GetData();
+
+  PipelineManifestHeaderVK header;
+  header.entry_count = static_cast<uint32_t>(entry_count);
+  header.data_size = data.size();
+  header.checksum = ComputeManifestChecksum(data.data(), data.size());
+
+  auto allocation = std::make_shared<Allocation>();
+  if (!allocation->Truncate(Bytes{sizeof(header) + data.size()}, false)) {
+    VALIDATION_LOG << "Could not allocate pipeline manifest staging buffer.";
+    return false;
+  }
+  std::memcpy(allocation->GetBuffer(), &header, sizeof(header));
+  if (!data.empty()) {
+    std::memcpy(allocation->GetBuffer() + sizeof(header), data.data(),
+                data.size());
+  }
+
+  auto allocation_mapping = CreateMappingFromAllocation(allocation);
+  if (!allocation_mapping) {
+    return false;
+  }
+  if (!fml::WriteAtomically(cache_directory, kPipelineManifestFileName,
+                            *allocation_mapping)) {
+    VALIDATION_LOG << "Could not write pipeline manifest to disk.";
+    return false;
+  }
+  return true;
+}
+
+std::vector<PipelineManifestEntryVK> PipelineCacheManifestRetrieve(
+    const fml::UniqueFD& cache_directory) {
+  if (!cache_directory.is_valid()) {
+    return {};
+  }
+  auto on_disk_data = fml::FileMapping::CreateReadOnly(
+      cache_directory, kPipelineManifestFileName);
+  if (!on_disk_data ||
+      on_disk_data->GetSize() < sizeof(PipelineManifestHeaderVK)) {
+    return {};
+  }
+  PipelineManifestHeaderVK on_disk_header;
+  std::memcpy(&on_disk_header, on_disk_data->GetMapping(),
+              sizeof(on_disk_header));
+  const PipelineManifestHeaderVK current_header;
+  const uint8_t* data = on_disk_data->GetMapping() + sizeof(on_disk_header);
+  const size_t data_size = on_disk_data->GetSize() - sizeof(on_disk_header);
+  if (on_disk_header.magic != current_header.magic ||
+      on_disk_header.version != current_header.version ||
+      on_disk_header.abi != current_header.abi ||
+      on_disk_header.entry_count > kMaxPipelineManifestEntries ||
+      on_disk_header.data_size != data_size ||
+      on_disk_header.checksum != ComputeManifestChecksum(data, data_size)) {
+    FML_LOG(WARNING) << "Persisted pipeline manifest is not compatible with "
+                        "the current version of Impeller. Ignoring.";
+    return {};
+  }
+
+  ManifestReader reader(data, data_size);
+  std::vector<PipelineManifestEntryVK> entries(on_disk_header.entry_count);
+  for (auto& entry : entries) {
+    if (!ReadEntry(reader, entry)) {
+      VALIDATION_LOG << "Could not read pipeline manifest entry.";
+      return {};
+    }
+  }
+  if (!reader.IsAtEnd()) {
+    VALIDATION_LOG << "Unexpected trailing data in pipeline manifest.";
+    return {};
+  }
+  return entries;
+}
+
 }  // namespace impeller
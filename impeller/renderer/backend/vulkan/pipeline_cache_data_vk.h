@@ -5,9 +5,18 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_DATA_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_DATA_VK_H_
 
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/unique_fd.h"
+#include "impeller/core/formats.h"
+#include "impeller/core/shader_types.h"
+#include "impeller/geometry/scalar.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/pipeline_descriptor.h"
 
 namespace impeller {
 
@@ -104,6 +113,87 @@ std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
     const fml::UniqueFD& cache_directory,
     const VkPhysicalDeviceProperties& props);
 
+//------------------------------------------------------------------------------
+/// @brief      The maximum number of pipelines recorded in the manifest of
+///             pipelines persisted alongside the pipeline cache.
+///
+static constexpr size_t kMaxPipelineManifestEntries = 512u;
+
+//------------------------------------------------------------------------------
+/// @brief      A record of a pipeline used by a previous run of the
+///             application.
+///
+///             Shader functions and vertex descriptors cannot be persisted.
+///             Instead, the names of the stage entrypoints are recorded along
+///             with all the fixed function state of the pipeline. A pipeline
+///             descriptor can be reconstituted from an entry by applying it to
+///             a descriptor that uses the same shaders (see
+///             `UsesSameProgramAs`). All other fields are copied over.
+///
+struct PipelineManifestEntryVK {
+  std::string label;
+  std::map<ShaderStage, std::string> entrypoints;
+  std::vector<Scalar> specialization_constants;
+  SampleCount sample_count = SampleCount::kCount1;
+  WindingOrder winding_order = WindingOrder::kClockwise;
+  CullMode cull_mode = CullMode::kNone;
+  PrimitiveType primitive_type = PrimitiveType::kTriangle;
+  PolygonMode polygon_mode = PolygonMode::kFill;
+  PixelFormat depth_pixel_format = PixelFormat::kUnknown;
+  PixelFormat stencil_pixel_format = PixelFormat::kUnknown;
+  std::map<size_t, ColorAttachmentDescriptor> color_attachments;
+  std::optional<DepthAttachmentDescriptor> depth_attachment;
+  std::optional<StencilAttachmentDescriptor> front_stencil_attachment;
+  std::optional<StencilAttachmentDescriptor> back_stencil_attachment;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record the persistable state of the given descriptor.
+  ///
+  static PipelineManifestEntryVK FromDescriptor(
+      const PipelineDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the given descriptor uses the same stage entrypoints
+  ///             and specialization constants as the recorded pipeline.
+  ///
+  bool UsesSameProgramAs(const PipelineDescriptor& desc) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Overwrite the label and fixed function state of the given
+  ///             descriptor with the recorded values. The descriptor must
+  ///             already use the same program.
+  ///
+  void ApplyToDescriptor(PipelineDescriptor& desc) const;
+
+  bool operator==(const PipelineManifestEntryVK& o) const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Persist the manifest of used pipelines to a file in the given
+///             cache directory next to the pipeline cache data. At most
+///             `kMaxPipelineManifestEntries` entries are written.
+///
+/// @param[in]  cache_directory  The cache directory
+/// @param[in]  entries          The pipelines to record.
+///
+/// @return     If the manifest could be persisted to disk.
+///
+bool PipelineCacheManifestPersist(
+    const fml::UniqueFD& cache_directory,
+    const std::vector<PipelineManifestEntryVK>& entries);
+
+//------------------------------------------------------------------------------
+/// @brief      Retrieve the previously persisted manifest of used pipelines.
+///             Manifests written by an incompatible version of Impeller or
+///             that fail integrity checks are ignored.
+///
+/// @param[in]  cache_directory  The cache directory
+///
+/// @return     The recorded pipelines. Empty if there was no usable manifest.
+///
+std::vector<PipelineManifestEntryVK> PipelineCacheManifestRetrieve(
+    const fml::UniqueFD& cache_directory);
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_DATA_VK_H_
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/file.h"
 #include "flutter/testing/testing.h"
@@ -10,6 +12,7 @@
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 
 namespace impeller::testing {
 
@@ -92,6 +95,140 @@ TEST(PipelineCacheDataVKTest, CanCreateFromDeviceProperties) {
   }
 }
 
+static PipelineManifestEntryVK CreateTestManifestEntry() {
+  PipelineManifestEntryVK entry;
+  entry.label = "Test Pipeline V#3";
+  entry.entrypoints[ShaderStage::kVertex] = "test_vertex_main";
+  entry.entrypoints[ShaderStage::kFragment] = "test_fragment_main";
+  entry.specialization_constants = {1.0f, 0.0f};
+  entry.sample_count = SampleCount::kCount4;
+  entry.cull_mode = CullMode::kBackFace;
+  entry.primitive_type = PrimitiveType::kTriangleStrip;
+  entry.stencil_pixel_format = PixelFormat::kS8UInt;
+  entry.color_attachments[0] = ColorAttachmentDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .blending_enabled = true,
+  };
+  entry.front_stencil_attachment = StencilAttachmentDescriptor{
+      .stencil_compare = CompareFunction::kEqual,
+  };
+  return entry;
+}
+
+TEST(PipelineCacheDataVKTest, CanPersistAndRetrievePipelineManifest) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(PipelineCacheManifestRetrieve(temp_dir.fd()).empty());
+
+  std::vector<PipelineManifestEntryVK> entries = {CreateTestManifestEntry(),
+                                                  PipelineManifestEntryVK{}};
+  ASSERT_TRUE(PipelineCacheManifestPersist(temp_dir.fd(), entries));
+  ASSERT_TRUE(fml::FileExists(temp_dir.fd(), "flutter.impeller.vkmanifest"));
+
+  auto retrieved = PipelineCacheManifestRetrieve(temp_dir.fd());
+  ASSERT_EQ(retrieved.size(), 2u);
+  EXPECT_TRUE(retrieved[0] == entries[0]);
+  EXPECT_TRUE(retrieved[1] == entries[1]);
+}
+
+TEST(PipelineCacheDataVKTest, CorruptPipelineManifestsAreIgnored) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(PipelineCacheManifestPersist(temp_dir.fd(),
+                                           {CreateTestManifestEntry()}));
+  auto mapping = fml::FileMapping::CreateReadOnly(
+      temp_dir.fd(), "flutter.impeller.vkmanifest");
+  ASSERT_NE(mapping, nullptr);
+
+  // Truncated.
+  {
+    fml::NonOwnedMapping truncated(mapping->GetMapping(),
+                                   mapping->GetSize() - 1u);
+    ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(),
+                                     "flutter.impeller.vkmanifest", truncated));
+    EXPECT_TRUE(PipelineCacheManifestRetrieve(temp_dir.fd()).empty());
+  }
+
+  // Flipped bit in the entry data.
+  {
+    std::vector<uint8_t> data(mapping->GetMapping(),
+                              mapping->GetMapping() + mapping->GetSize());
+    data.back() ^= 1u;
+    fml::NonOwnedMapping corrupt(data.data(), data.size());
+    ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(),
+                                     "flutter.impeller.vkmanifest", corrupt));
+    EXPECT_TRUE(PipelineCacheManifestRetrieve(temp_dir.fd()).empty());
+  }
+}
+
+TEST(PipelineCacheDataVKTest, ManifestEntriesRecreatePipelineDescriptors) {
+  PipelineDescriptor desc;
+  desc.SetLabel("Test Pipeline V#1");
+  desc.SetSampleCount(SampleCount::kCount4);
+  desc.SetCullMode(CullMode::kFrontFace);
+  desc.SetPolygonMode(PolygonMode::kLine);
+  desc.SetStencilPixelFormat(PixelFormat::kS8UInt);
+  desc.SetColorAttachmentDescriptor(
+      0u, ColorAttachmentDescriptor{.format = PixelFormat::kB8G8R8A8UNormInt});
+  desc.SetStencilAttachmentDescriptors(StencilAttachmentDescriptor{
+      .depth_stencil_pass = StencilOperation::kIncrementClamp,
+  });
+
+  auto entry = PipelineManifestEntryVK::FromDescriptor(desc);
+
+  PipelineDescriptor prototype;
+  prototype.SetLabel("Test Pipeline");
+  ASSERT_TRUE(entry.UsesSameProgramAs(prototype));
+  entry.ApplyToDescriptor(prototype);
+  EXPECT_TRUE(prototype.IsEqual(desc));
+
+  prototype.SetSpecializationConstants({1.0f});
+  EXPECT_FALSE(entry.UsesSameProgramAs(prototype));
+}
+
+TEST(PipelineCacheDataVKTest, PipelinesInManifestAreWarmedUp) {
+  fml::ScopedTemporaryDirectory temp_dir;
+
+  PipelineManifestEntryVK variant_entry;
+  variant_entry.label = "Warm Pipeline V#0";
+  variant_entry.sample_count = SampleCount::kCount4;
+  ASSERT_TRUE(PipelineCacheManifestPersist(temp_dir.fd(), {variant_entry}));
+
+  auto context = MockVulkanContextBuilder()
+                     .SetSettingsCallback([&](auto& settings) {
+                       settings.cache_directory =
+                           fml::Duplicate(temp_dir.fd().get());
+                     })
+                     .Build();
+  ASSERT_NE(context, nullptr);
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  auto count_pipelines_created = [&]() {
+    return std::count(functions->begin(), functions->end(),
+                      "vkCreateGraphicsPipelines");
+  };
+  auto library = context->GetPipelineLibrary();
+
+  PipelineDescriptor prototype;
+  prototype.SetLabel("Warm Pipeline");
+  prototype.SetVertexDescriptor(std::make_shared<VertexDescriptor>());
+  ASSERT_TRUE(library->GetPipeline(prototype).Get());
+
+  // Variant labels depend on the order in which they are requested. The
+  // warmed up pipeline is found regardless.
+  PipelineDescriptor variant = prototype;
+  variant_entry.ApplyToDescriptor(variant);
+  variant.SetLabel("Warm Pipeline V#7");
+  auto variant_future = library->GetPipeline(variant, /*async=*/false);
+  ASSERT_TRUE(variant_future.Get());
+  EXPECT_EQ(variant_future.descriptor->GetLabel(), "Warm Pipeline V#7");
+  EXPECT_EQ(count_pipelines_created(), 2);
+
+  // Pipelines that weren't recorded are created as usual.
+  PipelineDescriptor other = prototype;
+  other.SetSampleCount(SampleCount::kCount1);
+  other.SetLabel("Warm Pipeline V#8");
+  ASSERT_TRUE(library->GetPipeline(other, /*async=*/false).Get());
+  EXPECT_EQ(count_pipelines_created(), 3);
+}
+
 using PipelineCacheDataVKPlaygroundTest = PlaygroundTest;
 INSTANTIATE_VULKAN_PLAYGROUND_SUITE(PipelineCacheDataVKPlaygroundTest);
 
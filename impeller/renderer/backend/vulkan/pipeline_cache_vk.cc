@@ -118,6 +118,21 @@ void PipelineCacheVK::PersistCacheToDisk() const {
   );
 }
 
+void PipelineCacheVK::PersistManifestToDisk(
+    const std::vector<PipelineManifestEntryVK>& entries) const {
+  if (!is_valid_) {
+    return;
+  }
+  PipelineCacheManifestPersist(cache_directory_, entries);
+}
+
+std::vector<PipelineManifestEntryVK> PipelineCacheVK::RetrieveManifest() const {
+  if (!is_valid_) {
+    return {};
+  }
+  return PipelineCacheManifestRetrieve(cache_directory_);
+}
+
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
   return CapabilitiesVK::Cast(caps_.get());
 }
@@ -8,6 +8,7 @@
 #include "flutter/fml/file.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
 
 namespace impeller {
 
@@ -33,6 +34,19 @@ class PipelineCacheVK {
 
   void PersistCacheToDisk() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Write the manifest of pipelines used by this run next to the
+  ///             cache data. Like `PersistCacheToDisk`, this performs file
+  ///             I/O and must not be called on the raster thread.
+  ///
+  void PersistManifestToDisk(
+      const std::vector<PipelineManifestEntryVK>& entries) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Read the manifest of pipelines used by the previous run.
+  ///
+  std::vector<PipelineManifestEntryVK> RetrieveManifest() const;
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolderVK> device_holder_;
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <optional>
@@ -28,7 +29,8 @@ PipelineLibraryVK::PipelineLibraryVK(
     const std::shared_ptr<DeviceHolderVK>& device_holder,
     std::shared_ptr<const Capabilities> caps,
     fml::UniqueFD cache_directory,
-    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    bool enable_warm_up)
     : device_holder_(device_holder),
       pso_cache_(std::make_shared<PipelineCacheVK>(std::move(caps),
                                                    device_holder,
@@ -39,6 +41,11 @@ PipelineLibraryVK::PipelineLibraryVK(
     return;
   }
 
+  if (enable_warm_up) {
+    Lock lock(pipelines_mutex_);
+    pending_warm_up_ = pso_cache_->RetrieveManifest();
+  }
+
   is_valid_ = true;
 }
 
@@ -155,6 +162,11 @@ std::unique_ptr<ComputePipelineVK> PipelineLibraryVK::CreateComputePipeline(
   );
 }
 
+static PipelineDescriptor WithoutLabel(PipelineDescriptor descriptor) {
+  descriptor.SetLabel("");
+  return descriptor;
+}
+
 // |PipelineLibrary|
 PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
     PipelineDescriptor descriptor,
@@ -171,11 +183,24 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
         RealizedFuture<std::shared_ptr<Pipeline<PipelineDescriptor>>>(nullptr)};
   }
 
+  if (auto warmed = TakeWarmedPipelineLocked(descriptor); warmed.has_value()) {
+    pipelines_[descriptor] = warmed.value();
+    return warmed.value();
+  }
+
+  auto pipeline_future = CreatePipelineLocked(descriptor, async);
+  pipelines_[descriptor] = pipeline_future;
+  WarmUpVariantsLocked(descriptor);
+  return pipeline_future;
+}
+
+PipelineFuture<PipelineDescriptor> PipelineLibraryVK::CreatePipelineLocked(
+    const PipelineDescriptor& descriptor,
+    bool async) {
   auto promise = std::make_shared<
       NoExceptionPromise<std::shared_ptr<Pipeline<PipelineDescriptor>>>>();
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
-  pipelines_[descriptor] = pipeline_future;
 
   auto weak_this = weak_from_this();
 
@@ -204,6 +229,49 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
   return pipeline_future;
 }
 
+std::optional<PipelineFuture<PipelineDescriptor>>
+PipelineLibraryVK::TakeWarmedPipelineLocked(
+    const PipelineDescriptor& descriptor) {
+  if (warmed_pipelines_.empty()) {
+    return std::nullopt;
+  }
+  auto found = warmed_pipelines_.find(WithoutLabel(descriptor));
+  if (found == warmed_pipelines_.end()) {
+    return std::nullopt;
+  }
+  // The pipeline itself keeps the label it was warmed up with. Only the
+  // debug names of the Vulkan objects are affected.
+  auto pipeline_future =
+      PipelineFuture<PipelineDescriptor>{descriptor, found->second.future};
+  warmed_pipelines_.erase(found);
+  return pipeline_future;
+}
+
+void PipelineLibraryVK::WarmUpVariantsLocked(
+    const PipelineDescriptor& prototype) {
+  if (pending_warm_up_.empty()) {
+    return;
+  }
+  const auto prototype_key = WithoutLabel(prototype);
+  fml::erase_if(pending_warm_up_, [&](auto entry) {
+    if (!entry->UsesSameProgramAs(prototype)) {
+      return false;
+    }
+    auto variant = prototype;
+    entry->ApplyToDescriptor(variant);
+    auto variant_key = WithoutLabel(variant);
+    if (variant_key.IsEqual(prototype_key) ||
+        pipelines_.find(variant) != pipelines_.end() ||
+        warmed_pipelines_.find(variant_key) != warmed_pipelines_.end()) {
+      return true;
+    }
+    TRACE_EVENT1("impeller", "PipelineWarmUp", "label", entry->label.c_str());
+    warmed_pipelines_[std::move(variant_key)] =
+        CreatePipelineLocked(variant, /*async=*/true);
+    return true;
+  });
+}
+
 // |PipelineLibrary|
 PipelineFuture<ComputePipelineDescriptor> PipelineLibraryVK::GetPipeline(
     ComputePipelineDescriptor descriptor,
@@ -270,16 +338,17 @@ void PipelineLibraryVK::RemovePipelinesWithEntryPoint(
     std::shared_ptr<const ShaderFunction> function) {
   Lock lock(pipelines_mutex_);
 
-  fml::erase_if(pipelines_, [&](auto item) {
+  auto uses_function = [&](auto item) {
     return item->first.GetEntrypointForStage(function->GetStage())
         ->IsEqual(*function);
-  });
+  };
+  fml::erase_if(pipelines_, uses_function);
+  fml::erase_if(warmed_pipelines_, uses_function);
 }
 
 void PipelineLibraryVK::DidAcquireSurfaceFrame() {
   if (++frames_acquired_ == 50u) {
-    if (cache_dirty_) {
-      cache_dirty_ = false;
+    if (cache_dirty_.exchange(false)) {
       PersistPipelineCacheToDisk();
     }
     frames_acquired_ = 0;
@@ -287,14 +356,35 @@ void PipelineLibraryVK::DidAcquireSurfaceFrame() {
 }
 
 void PipelineLibraryVK::PersistPipelineCacheToDisk() {
-  worker_task_runner_->PostTask(
-      [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_)]() {
-        auto cache = weak_cache.lock();
-        if (!cache) {
-          return;
+  // Writes are coalesced. If the previous write is still in flight, try
+  // again on the next interval instead of racing it for the same files.
+  if (persist_pending_.exchange(true)) {
+    cache_dirty_ = true;
+    return;
+  }
+  worker_task_runner_->PostTask([weak_this = weak_from_this()]() {
+    auto thiz = weak_this.lock();
+    if (!thiz) {
+      return;
+    }
+    TRACE_EVENT0("impeller", "PersistPipelineCacheToDisk");
+    auto& library = PipelineLibraryVK::Cast(*thiz);
+    std::vector<PipelineManifestEntryVK> manifest;
+    {
+      Lock lock(library.pipelines_mutex_);
+      manifest.reserve(
+          std::min(library.pipelines_.size(), kMaxPipelineManifestEntries));
+      for (const auto& [descriptor, _] : library.pipelines_) {
+        if (manifest.size() == kMaxPipelineManifestEntries) {
+          break;
         }
-        cache->PersistCacheToDisk();
-      });
+        manifest.push_back(PipelineManifestEntryVK::FromDescriptor(descriptor));
+      }
+    }
+    library.pso_cache_->PersistCacheToDisk();
+    library.pso_cache_->PersistManifestToDisk(manifest);
+    library.persist_pending_ = false;
+  });
 }
 
 const std::shared_ptr<PipelineCacheVK>& PipelineLibraryVK::GetPSOCache() const {
@@ -28,6 +28,11 @@ class PipelineLibraryVK final
   // |PipelineLibrary|
   ~PipelineLibraryVK() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Periodically persists the pipeline cache and the manifest of
+  ///             used pipelines. The snapshot and the file I/O both happen on
+  ///             a worker thread.
+  ///
   void DidAcquireSurfaceFrame();
 
   const std::shared_ptr<PipelineCacheVK>& GetPSOCache() const;
@@ -45,15 +50,26 @@ class PipelineLibraryVK final
   Mutex compute_pipelines_mutex_;
   ComputePipelineMap compute_pipelines_ IPLR_GUARDED_BY(
       compute_pipelines_mutex_);
+  // Pipelines recorded by the previous run that have not been warmed up yet.
+  // They are precompiled as soon as a pipeline using the same program is
+  // requested.
+  std::vector<PipelineManifestEntryVK> pending_warm_up_ IPLR_GUARDED_BY(
+      pipelines_mutex_);
+  // Pipelines precompiled from the manifest. These are keyed by descriptors
+  // with their labels cleared since variant labels depend on the order in
+  // which variants are requested.
+  PipelineMap warmed_pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
   std::atomic_size_t frames_acquired_ = 0u;
   bool is_valid_ = false;
-  bool cache_dirty_ = false;
+  std::atomic_bool cache_dirty_ = false;
+  std::atomic_bool persist_pending_ = false;
 
   PipelineLibraryVK(
       const std::shared_ptr<DeviceHolderVK>& device_holder,
       std::shared_ptr<const Capabilities> caps,
       fml::UniqueFD cache_directory,
-      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+      bool enable_warm_up);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -77,6 +93,16 @@ class PipelineLibraryVK final
   std::unique_ptr<ComputePipelineVK> CreateComputePipeline(
       const ComputePipelineDescriptor& desc);
 
+  PipelineFuture<PipelineDescriptor> CreatePipelineLocked(
+      const PipelineDescriptor& descriptor,
+      bool async) IPLR_REQUIRES(pipelines_mutex_);
+
+  std::optional<PipelineFuture<PipelineDescriptor>> TakeWarmedPipelineLocked(
+      const PipelineDescriptor& descriptor) IPLR_REQUIRES(pipelines_mutex_);
+
+  void WarmUpVariantsLocked(const PipelineDescriptor& prototype)
+      IPLR_REQUIRES(pipelines_mutex_);
+
   void PersistPipelineCacheToDisk();
 
   PipelineLibraryVK(const PipelineLibraryVK&) = delete;
@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 
+#include <algorithm>
+
 #include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
@@ -30,6 +32,10 @@ ResourceManagerVK::~ResourceManagerVK() {
          "before the ResourceManager is destroyed (i.e. at the end of a test).";
   Terminate();
   waiter_.join();
+  // Collect anything reclaimed after the thread exited.
+  while (reclaimables_ != nullptr) {
+    CollectReclaimables();
+  }
 }
 
 void ResourceManagerVK::Start() {
@@ -45,42 +51,111 @@ void ResourceManagerVK::Start() {
 
   bool should_exit = false;
   while (!should_exit) {
-    std::unique_lock lock(reclaimables_mutex_);
+    {
+      std::unique_lock lock(wake_mutex_);
 
-    // Wait until there are reclaimable resource or if the manager should be
-    // torn down.
-    reclaimables_cv_.wait(
-        lock, [&]() { return !reclaimables_.empty() || should_exit_; });
+      // Wait until resources have been reclaimed or if the manager should be
+      // torn down.
+      wake_cv_.wait(lock, [&]() { return wake_requested_ || should_exit_; });
 
-    // Don't reclaim resources when the lock is being held as this may gate
-    // further reclaimables from being registered.
-    Reclaimables resources_to_collect;
-    std::swap(resources_to_collect, reclaimables_);
+      // Clear the request before taking the queue. Resources pushed after
+      // this point will request another wakeup.
+      wake_requested_ = false;
 
-    // We can't read the ivar outside the lock. Read it here instead.
-    should_exit = should_exit_;
+      // We can't read the ivar outside the lock. Read it here instead.
+      should_exit = should_exit_;
+    }
 
-    // We know what to collect. Unlock before doing anything else.
-    lock.unlock();
+    CollectReclaimables();
+  }
+}
 
-    // Claim all resources while tracing.
-    {
-      TRACE_EVENT0("Impeller", "ReclaimResources");
-      resources_to_collect.clear();  // Redundant because of scope but here so
-                                     // we can add a trace around it.
-    }
+void ResourceManagerVK::CollectReclaimables() {
+  ResourceVK* resource = reclaimables_.exchange(nullptr);
+  if (!resource) {
+    return;
   }
+
+  TRACE_EVENT0("Impeller", "ReclaimResources");
+  const auto now = Clock::now();
+  uint64_t count = 0u;
+  uint64_t bytes = 0u;
+  int64_t max_latency_ns = 0;
+  int64_t total_latency_ns = 0;
+  while (resource) {
+    ResourceVK* next = resource->next_reclaimable_;
+    const int64_t latency_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now - resource->reclaimed_at_)
+            .count();
+    max_latency_ns = std::max(max_latency_ns, latency_ns);
+    total_latency_ns += latency_ns;
+    bytes += resource->bytes_;
+    count++;
+    delete resource;
+    resource = next;
+  }
+
+  // Only the reclamation thread (or the destructor after it has been joined)
+  // updates the stats.
+  reclaimed_count_ += count;
+  reclaimed_bytes_ += bytes;
+  batch_count_++;
+  total_latency_ns_ += total_latency_ns;
+  if (max_latency_ns > max_latency_ns_) {
+    max_latency_ns_ = max_latency_ns;
+  }
+  FML_TRACE_COUNTER("impeller", "ResourceManagerVK",
+                    reinterpret_cast<int64_t>(this),  //
+                    "BatchCount", count,              //
+                    "BatchBytes", bytes,              //
+                    "MaxLatencyUs", max_latency_ns / 1000);
 }
 
 void ResourceManagerVK::Reclaim(std::unique_ptr<ResourceVK> resource) {
   if (!resource) {
     return;
   }
+  ResourceVK* node = resource.release();
+  node->reclaimed_at_ = Clock::now();
+  node->next_reclaimable_ = reclaimables_.load(std::memory_order_relaxed);
+  while (!reclaimables_.compare_exchange_weak(node->next_reclaimable_, node)) {
+    // Intentionally empty. The failed exchange reloads the head.
+  }
+  // Only the resource that makes the queue non-empty needs to wake the
+  // thread. While an epoch is open, the wakeup is deferred to its end.
+  if (node->next_reclaimable_ == nullptr && open_epochs_ == 0u) {
+    RequestWake();
+  }
+}
+
+void ResourceManagerVK::BeginEpoch() {
+  open_epochs_++;
+}
+
+void ResourceManagerVK::EndEpoch() {
+  FML_DCHECK(open_epochs_ > 0u);
+  if (--open_epochs_ == 0u && reclaimables_ != nullptr) {
+    RequestWake();
+  }
+}
+
+void ResourceManagerVK::RequestWake() {
   {
-    std::scoped_lock lock(reclaimables_mutex_);
-    reclaimables_.emplace_back(std::move(resource));
+    std::scoped_lock lock(wake_mutex_);
+    wake_requested_ = true;
   }
-  reclaimables_cv_.notify_one();
+  wake_cv_.notify_one();
+}
+
+ResourceManagerVK::Stats ResourceManagerVK::GetStats() const {
+  Stats stats;
+  stats.reclaimed_count = reclaimed_count_;
+  stats.reclaimed_bytes = reclaimed_bytes_;
+  stats.batch_count = batch_count_;
+  stats.max_latency = std::chrono::nanoseconds(max_latency_ns_.load());
+  stats.total_latency = std::chrono::nanoseconds(total_latency_ns_.load());
+  return stats;
 }
 
 void ResourceManagerVK::Terminate() {
@@ -88,10 +163,10 @@ void ResourceManagerVK::Terminate() {
   FML_DCHECK(!should_exit_);
 
   {
-    std::scoped_lock lock(reclaimables_mutex_);
+    std::scoped_lock lock(wake_mutex_);
     should_exit_ = true;
   }
-  reclaimables_cv_.notify_one();
+  wake_cv_.notify_one();
 }
 
 }  // namespace impeller
@@ -5,14 +5,21 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RESOURCE_MANAGER_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RESOURCE_MANAGER_VK_H_
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <thread>
-#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "impeller/base/timing.h"
 
 namespace impeller {
 
+class ResourceManagerVK;
+
 //------------------------------------------------------------------------------
 /// @brief      A resource that may be reclaimed by a |ResourceManagerVK|.
 ///
@@ -24,6 +31,17 @@ namespace impeller {
 class ResourceVK {
  public:
   virtual ~ResourceVK() = default;
+
+ protected:
+  explicit ResourceVK(size_t bytes = 0u) : bytes_(bytes) {}
+
+ private:
+  friend class ResourceManagerVK;
+
+  // Bookkeeping for the reclamation queue of |ResourceManagerVK|.
+  size_t bytes_ = 0u;
+  TimePoint reclaimed_at_;
+  ResourceVK* next_reclaimable_ = nullptr;
 };
 
 //------------------------------------------------------------------------------
@@ -31,8 +49,15 @@ class ResourceVK {
 ///             reclaimed.
 ///
 ///             Reclaimed resources are collected in a batch on a separate
-///             thread. In the future, the resource manager may allow resource
-///             pooling/reuse, delaying reclamation past frame workloads, etc...
+///             thread. Reclaiming a resource does not take a lock. Resources
+///             are pushed onto a lock-free queue and the thread is only woken
+///             when the queue goes from empty to non-empty.
+///
+///             Most resources die when the fence of the last command buffer
+///             referencing them is signaled. The |FenceWaiterVK| brackets
+///             those callbacks in an epoch (`BeginEpoch`/`EndEpoch`) so that
+///             everything freed by a batch of signaled fences is collected
+///             with a single wakeup.
 ///
 class ResourceManagerVK final
     : public std::enable_shared_from_this<ResourceManagerVK> {
@@ -63,6 +88,40 @@ class ResourceManagerVK final
   ///             handle to a resource, which will call this method.
   void Reclaim(std::unique_ptr<ResourceVK> resource);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Defer waking the reclamation thread until the matching call
+  ///             to `EndEpoch`. Epochs may be nested and may overlap across
+  ///             threads.
+  ///
+  void BeginEpoch();
+
+  //----------------------------------------------------------------------------
+  /// @brief      End an epoch started with `BeginEpoch`. If this was the last
+  ///             open epoch and resources were reclaimed during it, they are
+  ///             collected in one batch.
+  ///
+  void EndEpoch();
+
+  struct Stats {
+    /// The number of resources destroyed.
+    uint64_t reclaimed_count = 0u;
+    /// The sum of the sizes of the destroyed resources. Only resources that
+    /// declare their size (buffers and images) are counted.
+    uint64_t reclaimed_bytes = 0u;
+    /// The number of times the reclamation thread collected resources.
+    uint64_t batch_count = 0u;
+    /// The largest delay between a resource being reclaimed and destroyed.
+    std::chrono::nanoseconds max_latency = {};
+    /// The sum of the delays between resources being reclaimed and
+    /// destroyed.
+    std::chrono::nanoseconds total_latency = {};
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The totals for all resources collected so far.
+  ///
+  Stats GetStats() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Destroys the resource manager.
   ///
@@ -71,13 +130,22 @@ class ResourceManagerVK final
   ~ResourceManagerVK();
 
  private:
-  using Reclaimables = std::vector<std::unique_ptr<ResourceVK>>;
-
   ResourceManagerVK();
-  std::mutex reclaimables_mutex_;
-  std::condition_variable reclaimables_cv_;
-  Reclaimables reclaimables_;
+  // The head of an intrusive lock-free stack of resources, linked by
+  // |ResourceVK::next_reclaimable_|. Producers push, the reclamation thread
+  // takes the entire stack at once.
+  std::atomic<ResourceVK*> reclaimables_ = nullptr;
+  std::atomic_uint32_t open_epochs_ = 0u;
+  // The mutex only guards sleeping and waking the reclamation thread.
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  bool wake_requested_ = false;
   bool should_exit_ = false;
+  std::atomic_uint64_t reclaimed_count_ = 0u;
+  std::atomic_uint64_t reclaimed_bytes_ = 0u;
+  std::atomic_uint64_t batch_count_ = 0u;
+  std::atomic_int64_t max_latency_ns_ = 0;
+  std::atomic_int64_t total_latency_ns_ = 0;
   // This should be initialized last since it references the other instance
   // variables.
   std::thread waiter_;
@@ -95,6 +163,13 @@ class ResourceManagerVK final
   /// collected when the resource manager is collected.
   void Terminate();
 
+  void RequestWake();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys all resources currently in the queue.
+  ///
+  void CollectReclaimables();
+
   ResourceManagerVK(const ResourceManagerVK&) = delete;
 
   ResourceManagerVK& operator=(const ResourceManagerVK&) = delete;
@@ -116,8 +191,10 @@ class ResourceVKT : public ResourceVK {
   /// @brief      Construct a resource from a move-constructible resource.
   ///
   /// @param[in]  resource  The resource to move.
-  explicit ResourceVKT(ResourceType&& resource)
-      : resource_(std::move(resource)) {}
+  /// @param[in]  bytes     The size of the resource, if known. Used for
+  ///                       statistics only.
+  explicit ResourceVKT(ResourceType&& resource, size_t bytes = 0u)
+      : ResourceVK(bytes), resource_(std::move(resource)) {}
 
   /// @brief      Returns a pointer to the resource.
   const ResourceType* Get() const { return &resource_; }
@@ -159,11 +236,14 @@ class UniqueResourceVKT final {
   ///
   /// @param[in]  resource_manager  The resource manager.
   /// @param[in]  resource          The resource to move.
+  /// @param[in]  bytes             The size of the resource, if known.
   explicit UniqueResourceVKT(std::weak_ptr<ResourceManagerVK> resource_manager,
-                             ResourceType&& resource)
+                             ResourceType&& resource,
+                             size_t bytes = 0u)
       : resource_manager_(std::move(resource_manager)),
-        resource_(
-            std::make_unique<ResourceVKT<ResourceType>>(std::move(resource))) {}
+        resource_(std::make_unique<ResourceVKT<ResourceType>>(
+            std::move(resource),
+            bytes)) {}
 
   ~UniqueResourceVKT() { Reset(); }
 
@@ -178,9 +258,11 @@ class UniqueResourceVKT final {
   /// @brief      Reclaims the existing resource, if any, and replaces it.
   ///
   /// @param[in]  other   The (new) resource to move.
-  void Swap(ResourceType&& other) {
+  /// @param[in]  bytes   The size of the new resource, if known.
+  void Swap(ResourceType&& other, size_t bytes = 0u) {
     Reset();
-    resource_ = std::make_unique<ResourceVKT<ResourceType>>(std::move(other));
+    resource_ =
+        std::make_unique<ResourceVKT<ResourceType>>(std::move(other), bytes);
   }
 
   /// @brief      Reclaims the existing resource, if any.
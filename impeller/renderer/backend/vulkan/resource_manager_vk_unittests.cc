@@ -84,5 +84,49 @@ TEST(ResourceManagerVKTest, IsThreadSafe) {
   EXPECT_EQ(manager.lock(), nullptr);
 }
 
+TEST(ResourceManagerVKTest, ResourcesAreNotCollectedDuringAnEpoch) {
+  auto const manager = ResourceManagerVK::Create();
+
+  auto waiter = fml::AutoResetWaitableEvent();
+  auto rattle = fml::ScopedCleanupClosure([&waiter]() { waiter.Signal(); });
+
+  manager->BeginEpoch();
+  {
+    auto resource = UniqueResourceVKT<fml::ScopedCleanupClosure>(
+        manager, std::move(rattle));
+  }
+
+  // The reclamation thread is not woken until the epoch ends.
+  EXPECT_TRUE(waiter.WaitWithTimeout(fml::TimeDelta::FromMilliseconds(50)));
+
+  manager->EndEpoch();
+  waiter.Wait();
+}
+
+TEST(ResourceManagerVKTest, ReportsReclaimedBytesAndLatency) {
+  auto const manager = ResourceManagerVK::Create();
+
+  struct MockResource {};
+
+  manager->BeginEpoch();
+  for (size_t i = 0; i < 10; i++) {
+    UniqueResourceVKT<MockResource>(manager, MockResource{}, 1024u);
+  }
+  UniqueResourceVKT<MockResource>(manager, MockResource{});
+  manager->EndEpoch();
+
+  while (manager->GetStats().reclaimed_count < 11u) {
+    std::this_thread::yield();
+  }
+
+  auto stats = manager->GetStats();
+  EXPECT_EQ(stats.reclaimed_count, 11u);
+  EXPECT_EQ(stats.reclaimed_bytes, 10u * 1024u);
+  // Everything reclaimed during the epoch is collected in one batch.
+  EXPECT_EQ(stats.batch_count, 1u);
+  EXPECT_GE(stats.total_latency, stats.max_latency);
+  EXPECT_GT(stats.max_latency.count(), 0);
+}
+
 }  // namespace testing
 }  // namespace impeller
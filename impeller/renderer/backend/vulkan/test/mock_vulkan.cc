@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -42,7 +44,9 @@ struct MockSwapchainKHR {
   size_t current_image = 0;
 };
 
-struct MockSemaphore {};
+struct MockSemaphore {
+  std::atomic<uint64_t> value = 0u;
+};
 
 struct MockFramebuffer {};
 
@@ -88,6 +92,11 @@ class MockDevice final {
     called_functions_->push_back(function);
   }
 
+  void ClearCalledFunctions() {
+    Lock lock(called_functions_mutex_);
+    called_functions_->clear();
+  }
+
  private:
   MockDevice(const MockDevice&) = delete;
 
@@ -110,6 +119,8 @@ void noop() {}
 
 static thread_local std::vector<std::string> g_instance_extensions;
 
+static thread_local std::vector<std::string> g_device_extensions;
+
 VkResult vkEnumerateInstanceExtensionProperties(
     const char* pLayerName,
     uint32_t* pPropertyCount,
@@ -204,14 +215,35 @@ VkResult vkEnumerateDeviceExtensionProperties(
     uint32_t* pPropertyCount,
     VkExtensionProperties* pProperties) {
   if (!pProperties) {
-    *pPropertyCount = 1;
+    *pPropertyCount = g_device_extensions.size();
   } else {
-    strcpy(pProperties[0].extensionName, "VK_KHR_swapchain");
-    pProperties[0].specVersion = 0;
+    uint32_t count = 0;
+    for (const std::string& ext : g_device_extensions) {
+      strncpy(pProperties[count].extensionName, ext.c_str(),
+              sizeof(VkExtensionProperties::extensionName));
+      pProperties[count].specVersion = 0;
+      count++;
+    }
   }
   return VK_SUCCESS;
 }
 
+void vkGetPhysicalDeviceFeatures2(VkPhysicalDevice physicalDevice,
+                                  VkPhysicalDeviceFeatures2* pFeatures) {
+  const bool has_timeline_semaphores =
+      std::find(g_device_extensions.begin(), g_device_extensions.end(),
+                "VK_KHR_timeline_semaphore") != g_device_extensions.end();
+  auto* next = reinterpret_cast<VkBaseOutStructure*>(pFeatures->pNext);
+  while (next) {
+    if (next->sType ==
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES) {
+      reinterpret_cast<VkPhysicalDeviceTimelineSemaphoreFeatures*>(next)
+          ->timelineSemaphore = has_timeline_semaphores;
+    }
+    next = next->pNext;
+  }
+}
+
 VkResult vkCreateDevice(VkPhysicalDevice physicalDevice,
                         const VkDeviceCreateInfo* pCreateInfo,
                         const VkAllocationCallbacks* pAllocator,
@@ -510,6 +542,22 @@ VkResult vkQueueSubmit(VkQueue queue,
                        uint32_t submitCount,
                        const VkSubmitInfo* pSubmits,
                        VkFence fence) {
+  // Submissions complete immediately. Signal any timeline semaphores.
+  for (uint32_t i = 0; i < submitCount; i++) {
+    auto* next = reinterpret_cast<const VkBaseInStructure*>(pSubmits[i].pNext);
+    while (next) {
+      if (next->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO) {
+        auto* timeline_info =
+            reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(next);
+        for (uint32_t j = 0; j < timeline_info->signalSemaphoreValueCount;
+             j++) {
+          reinterpret_cast<MockSemaphore*>(pSubmits[i].pSignalSemaphores[j])
+              ->value = timeline_info->pSignalSemaphoreValues[j];
+        }
+      }
+      next = next->pNext;
+    }
+  }
   return VK_SUCCESS;
 }
 
@@ -625,6 +673,15 @@ VkResult vkAllocateDescriptorSets(
   return VK_SUCCESS;
 }
 
+void vkUpdateDescriptorSets(VkDevice device,
+                            uint32_t descriptorWriteCount,
+                            const VkWriteDescriptorSet* pDescriptorWrites,
+                            uint32_t descriptorCopyCount,
+                            const VkCopyDescriptorSet* pDescriptorCopies) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkUpdateDescriptorSets");
+}
+
 VkResult vkGetPhysicalDeviceSurfaceFormatsKHR(
     VkPhysicalDevice physicalDevice,
     VkSurfaceKHR surface,
@@ -725,6 +782,21 @@ void vkDestroySemaphore(VkDevice device,
   delete reinterpret_cast<MockSemaphore*>(semaphore);
 }
 
+VkResult vkGetSemaphoreCounterValue(VkDevice device,
+                                    VkSemaphore semaphore,
+                                    uint64_t* pValue) {
+  *pValue = reinterpret_cast<MockSemaphore*>(semaphore)->value;
+  return VK_SUCCESS;
+}
+
+VkResult vkWaitSemaphores(VkDevice device,
+                          const VkSemaphoreWaitInfo* pWaitInfo,
+                          uint64_t timeout) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkWaitSemaphores");
+  return VK_SUCCESS;
+}
+
 VkResult vkAcquireNextImageKHR(VkDevice device,
                                VkSwapchainKHR swapchain,
                                uint64_t timeout,
@@ -767,6 +839,9 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkGetPhysicalDeviceQueueFamilyProperties;
   } else if (strcmp("vkEnumerateDeviceExtensionProperties", pName) == 0) {
     return (PFN_vkVoidFunction)vkEnumerateDeviceExtensionProperties;
+  } else if (strcmp("vkGetPhysicalDeviceFeatures2", pName) == 0 ||
+             strcmp("vkGetPhysicalDeviceFeatures2KHR", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetPhysicalDeviceFeatures2;
   } else if (strcmp("vkCreateDevice", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateDevice;
   } else if (strcmp("vkCreateInstance", pName) == 0) {
@@ -867,6 +942,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkResetDescriptorPool;
   } else if (strcmp("vkAllocateDescriptorSets", pName) == 0) {
     return (PFN_vkVoidFunction)vkAllocateDescriptorSets;
+  } else if (strcmp("vkUpdateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkUpdateDescriptorSets;
   } else if (strcmp("vkGetPhysicalDeviceSurfaceFormatsKHR", pName) == 0) {
     return (PFN_vkVoidFunction)vkGetPhysicalDeviceSurfaceFormatsKHR;
   } else if (strcmp("vkGetPhysicalDeviceSurfaceCapabilitiesKHR", pName) == 0) {
@@ -881,6 +958,12 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkGetSwapchainImagesKHR;
   } else if (strcmp("vkCreateSemaphore", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateSemaphore;
+  } else if (strcmp("vkGetSemaphoreCounterValue", pName) == 0 ||
+             strcmp("vkGetSemaphoreCounterValueKHR", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetSemaphoreCounterValue;
+  } else if (strcmp("vkWaitSemaphores", pName) == 0 ||
+             strcmp("vkWaitSemaphoresKHR", pName) == 0) {
+    return (PFN_vkVoidFunction)vkWaitSemaphores;
   } else if (strcmp("vkDestroySemaphore", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroySemaphore;
   } else if (strcmp("vkDestroySurfaceKHR", pName) == 0) {
@@ -899,6 +982,7 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
 
 MockVulkanContextBuilder::MockVulkanContextBuilder()
     : instance_extensions_({"VK_KHR_surface", "VK_MVK_macos_surface"}),
+      device_extensions_({"VK_KHR_swapchain"}),
       format_properties_callback_([](VkPhysicalDevice physicalDevice,
                                      VkFormat format,
                                      VkFormatProperties* pFormatProperties) {
@@ -925,6 +1009,7 @@ std::shared_ptr<ContextVK> MockVulkanContextBuilder::Build() {
     settings_callback_(settings);
   }
   g_instance_extensions = instance_extensions_;
+  g_device_extensions = device_extensions_;
   g_instance_layers = instance_layers_;
   g_format_properties_callback = format_properties_callback_;
   g_physical_device_properties_callback = physical_properties_callback_;
@@ -939,6 +1024,11 @@ std::shared_ptr<std::vector<std::string>> GetMockVulkanFunctions(
   return mock_device->GetCalledFunctions();
 }
 
+void ClearMockVulkanFunctions(VkDevice device) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->ClearCalledFunctions();
+}
+
 void SetSwapchainImageSize(ISize size) {
   currentImageSize = size;
 }
@@ -21,6 +21,11 @@ namespace testing {
 std::shared_ptr<std::vector<std::string>> GetMockVulkanFunctions(
     VkDevice device);
 
+/// @brief Forget the functions recorded for |device| so far. Long running
+///        callers, like benchmarks, use this to keep the record from growing
+///        without bound.
+void ClearMockVulkanFunctions(VkDevice device);
+
 // A test-controlled version of |vk::Fence|.
 class MockFence final {
  public:
@@ -83,6 +88,12 @@ class MockVulkanContextBuilder {
     return *this;
   }
 
+  MockVulkanContextBuilder& SetDeviceExtensions(
+      const std::vector<std::string>& device_extensions) {
+    device_extensions_ = device_extensions;
+    return *this;
+  }
+
   MockVulkanContextBuilder& SetInstanceLayers(
       const std::vector<std::string>& instance_layers) {
     instance_layers_ = instance_layers;
@@ -117,6 +128,7 @@ class MockVulkanContextBuilder {
  private:
   std::function<void(ContextVK::Settings&)> settings_callback_;
   std::vector<std::string> instance_extensions_;
+  std::vector<std::string> device_extensions_;
   std::vector<std::string> instance_layers_;
   std::optional<ContextVK::EmbedderData> embedder_data_;
   std::function<void(VkPhysicalDevice physicalDevice,
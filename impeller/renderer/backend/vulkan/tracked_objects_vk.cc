@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/tracked_objects_vk.h"
 
+#include <atomic>
+
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 
@@ -15,6 +17,8 @@ TrackedObjectsVK::TrackedObjectsVK(
     std::shared_ptr<DescriptorPoolVK> descriptor_pool,
     std::unique_ptr<GPUProbe> probe)
     : desc_pool_(std::move(descriptor_pool)), probe_(std::move(probe)) {
+  static std::atomic<uint64_t> next_descriptor_set_scope = 1u;
+  descriptor_set_scope_ = next_descriptor_set_scope++;
   if (!pool) {
     return;
   }
@@ -77,6 +81,10 @@ DescriptorPoolVK& TrackedObjectsVK::GetDescriptorPool() {
   return *desc_pool_;
 }
 
+uint64_t TrackedObjectsVK::GetDescriptorSetScope() const {
+  return descriptor_set_scope_;
+}
+
 GPUProbe& TrackedObjectsVK::GetGPUProbe() const {
   return *probe_.get();
 }
@@ -37,6 +37,10 @@ class TrackedObjectsVK {
 
   DescriptorPoolVK& GetDescriptorPool();
 
+  /// @brief A value unique to this object, under which descriptor sets of
+  ///        resources tracked by it can be reused.
+  uint64_t GetDescriptorSetScope() const;
+
   GPUProbe& GetGPUProbe() const;
 
  private:
@@ -48,6 +52,7 @@ class TrackedObjectsVK {
   std::vector<std::shared_ptr<const DeviceBuffer>> tracked_buffers_;
   std::vector<std::shared_ptr<const TextureSourceVK>> tracked_textures_;
   std::unique_ptr<GPUProbe> probe_;
+  uint64_t descriptor_set_scope_ = 0u;
   bool is_valid_ = false;
 
   TrackedObjectsVK(const TrackedObjectsVK&) = delete;
@@ -272,12 +272,14 @@ using TessellatedVertexProc = Tessellator::TessellatedVertexProc;
 using EllipticalVertexGenerator = Tessellator::EllipticalVertexGenerator;
 
 EllipticalVertexGenerator::EllipticalVertexGenerator(
-    EllipticalVertexGenerator::GeneratorProc& generator,
+    GeneratorProc<Point*>& write_generator,
+    GeneratorProc<VertexProcOutput>& proc_generator,
     Trigs&& trigs,
     PrimitiveType triangle_type,
     size_t vertices_per_trig,
     Data&& data)
-    : impl_(generator),
+    : write_impl_(write_generator),
+      proc_impl_(proc_generator),
       trigs_(std::move(trigs)),
       data_(data),
       vertices_per_trig_(vertices_per_trig) {}
@@ -288,14 +290,16 @@ EllipticalVertexGenerator Tessellator::FilledCircle(
     Scalar radius) {
   size_t divisions =
       ComputeQuadrantDivisions(view_transform.GetMaxBasisLengthXY() * radius);
-  return EllipticalVertexGenerator(Tessellator::GenerateFilledCircle,
-                                   GetTrigsForDivisions(divisions),
-                                   PrimitiveType::kTriangleStrip, 4,
-                                   {
-                                       .reference_centers = {center, center},
-                                       .radii = {radius, radius},
-                                       .half_width = -1.0f,
-                                   });
+  return EllipticalVertexGenerator(
+      Tessellator::GenerateFilledCircle<Point*>,
+      Tessellator::GenerateFilledCircle<VertexProcOutput>,
+      GetTrigsForDivisions(divisions),
+      PrimitiveType::kTriangleStrip, 4,
+      {
+          .reference_centers = {center, center},
+          .radii = {radius, radius},
+          .half_width = -1.0f,
+      });
 }
 
 EllipticalVertexGenerator Tessellator::StrokedCircle(
@@ -306,14 +310,16 @@ EllipticalVertexGenerator Tessellator::StrokedCircle(
   if (half_width > 0) {
     auto divisions = ComputeQuadrantDivisions(
         view_transform.GetMaxBasisLengthXY() * radius + half_width);
-    return EllipticalVertexGenerator(Tessellator::GenerateStrokedCircle,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 8,
-                                     {
-                                         .reference_centers = {center, center},
-                                         .radii = {radius, radius},
-                                         .half_width = half_width,
-                                     });
+    return EllipticalVertexGenerator(
+        Tessellator::GenerateStrokedCircle<Point*>,
+        Tessellator::GenerateStrokedCircle<VertexProcOutput>,
+        GetTrigsForDivisions(divisions),
+        PrimitiveType::kTriangleStrip, 8,
+        {
+            .reference_centers = {center, center},
+            .radii = {radius, radius},
+            .half_width = half_width,
+        });
   } else {
     return FilledCircle(view_transform, center, radius);
   }
@@ -329,14 +335,16 @@ EllipticalVertexGenerator Tessellator::RoundCapLine(
   if (length > kEhCloseEnough) {
     auto divisions =
         ComputeQuadrantDivisions(view_transform.GetMaxBasisLengthXY() * radius);
-    return EllipticalVertexGenerator(Tessellator::GenerateRoundCapLine,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 4,
-                                     {
-                                         .reference_centers = {p0, p1},
-                                         .radii = {radius, radius},
-                                         .half_width = -1.0f,
-                                     });
+    return EllipticalVertexGenerator(
+        Tessellator::GenerateRoundCapLine<Point*>,
+        Tessellator::GenerateRoundCapLine<VertexProcOutput>,
+        GetTrigsForDivisions(divisions),
+        PrimitiveType::kTriangleStrip, 4,
+        {
+            .reference_centers = {p0, p1},
+            .radii = {radius, radius},
+            .half_width = -1.0f,
+        });
   } else {
     return FilledCircle(view_transform, p0, radius);
   }
@@ -353,14 +361,16 @@ EllipticalVertexGenerator Tessellator::FilledEllipse(
   auto divisions = ComputeQuadrantDivisions(
       view_transform.GetMaxBasisLengthXY() * max_radius);
   auto center = bounds.GetCenter();
-  return EllipticalVertexGenerator(Tessellator::GenerateFilledEllipse,
-                                   GetTrigsForDivisions(divisions),
-                                   PrimitiveType::kTriangleStrip, 4,
-                                   {
-                                       .reference_centers = {center, center},
-                                       .radii = bounds.GetSize() * 0.5f,
-                                       .half_width = -1.0f,
-                                   });
+  return EllipticalVertexGenerator(
+      Tessellator::GenerateFilledEllipse<Point*>,
+      Tessellator::GenerateFilledEllipse<VertexProcOutput>,
+      GetTrigsForDivisions(divisions),
+      PrimitiveType::kTriangleStrip, 4,
+      {
+          .reference_centers = {center, center},
+          .radii = bounds.GetSize() * 0.5f,
+          .half_width = -1.0f,
+      });
 }
 
 EllipticalVertexGenerator Tessellator::FilledRoundRect(
@@ -374,27 +384,30 @@ EllipticalVertexGenerator Tessellator::FilledRoundRect(
         view_transform.GetMaxBasisLengthXY() * max_radius);
     auto upper_left = bounds.GetLeftTop() + radii;
     auto lower_right = bounds.GetRightBottom() - radii;
-    return EllipticalVertexGenerator(Tessellator::GenerateFilledRoundRect,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 4,
-                                     {
-                                         .reference_centers =
-                                             {
-                                                 upper_left,
-                                                 lower_right,
-                                             },
-                                         .radii = radii,
-                                         .half_width = -1.0f,
-                                     });
+    return EllipticalVertexGenerator(
+        Tessellator::GenerateFilledRoundRect<Point*>,
+        Tessellator::GenerateFilledRoundRect<VertexProcOutput>,
+        GetTrigsForDivisions(divisions),
+        PrimitiveType::kTriangleStrip, 4,
+        {
+            .reference_centers =
+                {
+                    upper_left,
+                    lower_right,
+                },
+            .radii = radii,
+            .half_width = -1.0f,
+        });
   } else {
     return FilledEllipse(view_transform, bounds);
   }
 }
 
-void Tessellator::GenerateFilledCircle(
+template <typename VertexOutput>
+VertexOutput Tessellator::GenerateFilledCircle(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexOutput output) {
   auto center = data.reference_centers[0];
   auto radius = data.radii.width;
 
@@ -405,8 +418,8 @@ void Tessellator::GenerateFilledCircle(
   // Quadrant 1 connecting with Quadrant 4:
   for (auto& trig : trigs) {
     auto offset = trig * radius;
-    proc({center.x - offset.x, center.y + offset.y});
-    proc({center.x - offset.x, center.y - offset.y});
+    *output++ = {center.x - offset.x, center.y + offset.y};
+    *output++ = {center.x - offset.x, center.y - offset.y};
   }
 
   // The second half of the circle should be iterated in reverse, but
@@ -416,15 +429,18 @@ void Tessellator::GenerateFilledCircle(
   // Quadrant 2 connecting with Quadrant 2:
   for (auto& trig : trigs) {
     auto offset = trig * radius;
-    proc({center.x + offset.y, center.y + offset.x});
-    proc({center.x + offset.y, center.y - offset.x});
+    *output++ = {center.x + offset.y, center.y + offset.x};
+    *output++ = {center.x + offset.y, center.y - offset.x};
   }
+
+  return output;
 }
 
-void Tessellator::GenerateStrokedCircle(
+template <typename VertexOutput>
+VertexOutput Tessellator::GenerateStrokedCircle(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexOutput output) {
   auto center = data.reference_centers[0];
 
   FML_DCHECK(center == data.reference_centers[1]);
@@ -443,8 +459,8 @@ void Tessellator::GenerateStrokedCircle(
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x - outer.x, center.y - outer.y});
-    proc({center.x - inner.x, center.y - inner.y});
+    *output++ = {center.x - outer.x, center.y - outer.y};
+    *output++ = {center.x - inner.x, center.y - inner.y};
   }
 
   // The even quadrants of the circle should be iterated in reverse, but
@@ -455,31 +471,34 @@ void Tessellator::GenerateStrokedCircle(
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x + outer.y, center.y - outer.x});
-    proc({center.x + inner.y, center.y - inner.x});
+    *output++ = {center.x + outer.y, center.y - outer.x};
+    *output++ = {center.x + inner.y, center.y - inner.x};
   }
 
   // Quadrant 3:
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x + outer.x, center.y + outer.y});
-    proc({center.x + inner.x, center.y + inner.y});
+    *output++ = {center.x + outer.x, center.y + outer.y};
+    *output++ = {center.x + inner.x, center.y + inner.y};
   }
 
   // Quadrant 4:
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x - outer.y, center.y + outer.x});
-    proc({center.x - inner.y, center.y + inner.x});
+    *output++ = {center.x - outer.y, center.y + outer.x};
+    *output++ = {center.x - inner.y, center.y + inner.x};
   }
+
+  return output;
 }
 
-void Tessellator::GenerateRoundCapLine(
+template <typename VertexOutput>
+VertexOutput Tessellator::GenerateRoundCapLine(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexOutput output) {
   auto p0 = data.reference_centers[0];
   auto p1 = data.reference_centers[1];
   auto radius = data.radii.width;
@@ -494,8 +513,8 @@ void Tessellator::GenerateRoundCapLine(
   for (auto& trig : trigs) {
     auto relative_along = along * trig.cos;
     auto relative_across = across * trig.sin;
-    proc(p0 - relative_along + relative_across);
-    proc(p0 - relative_along - relative_across);
+    *output++ = p0 - relative_along + relative_across;
+    *output++ = p0 - relative_along - relative_across;
   }
 
   // The second half of the round caps should be iterated in reverse, but
@@ -504,15 +523,18 @@ void Tessellator::GenerateRoundCapLine(
   for (auto& trig : trigs) {
     auto relative_along = along * trig.sin;
     auto relative_across = across * trig.cos;
-    proc(p1 + relative_along + relative_across);
-    proc(p1 + relative_along - relative_across);
+    *output++ = p1 + relative_along + relative_across;
+    *output++ = p1 + relative_along - relative_across;
   }
+
+  return output;
 }
 
-void Tessellator::GenerateFilledEllipse(
+template <typename VertexOutput>
+VertexOutput Tessellator::GenerateFilledEllipse(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexOutput output) {
   auto center = data.reference_centers[0];
   auto radii = data.radii;
 
@@ -522,8 +544,8 @@ void Tessellator::GenerateFilledEllipse(
   // Quadrant 1 connecting with Quadrant 4:
   for (auto& trig : trigs) {
     auto offset = trig * radii;
-    proc({center.x - offset.x, center.y + offset.y});
-    proc({center.x - offset.x, center.y - offset.y});
+    *output++ = {center.x - offset.x, center.y + offset.y};
+    *output++ = {center.x - offset.x, center.y - offset.y};
   }
 
   // The second half of the circle should be iterated in reverse, but
@@ -533,15 +555,18 @@ void Tessellator::GenerateFilledEllipse(
   // Quadrant 2 connecting with Quadrant 2:
   for (auto& trig : trigs) {
     auto offset = Point(trig.sin * radii.width, trig.cos * radii.height);
-    proc({center.x + offset.x, center.y + offset.y});
-    proc({center.x + offset.x, center.y - offset.y});
+    *output++ = {center.x + offset.x, center.y + offset.y};
+    *output++ = {center.x + offset.x, center.y - offset.y};
   }
+
+  return output;
 }
 
-void Tessellator::GenerateFilledRoundRect(
+template <typename VertexOutput>
+VertexOutput Tessellator::GenerateFilledRoundRect(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexOutput output) {
   Scalar left = data.reference_centers[0].x;
   Scalar top = data.reference_centers[0].y;
   Scalar right = data.reference_centers[1].x;
@@ -553,8 +578,8 @@ void Tessellator::GenerateFilledRoundRect(
   // Quadrant 1 connecting with Quadrant 4:
   for (auto& trig : trigs) {
     auto offset = trig * radii;
-    proc({left - offset.x, bottom + offset.y});
-    proc({left - offset.x, top - offset.y});
+    *output++ = {left - offset.x, bottom + offset.y};
+    *output++ = {left - offset.x, top - offset.y};
   }
 
   // The second half of the round rect should be iterated in reverse, but
@@ -564,9 +589,11 @@ void Tessellator::GenerateFilledRoundRect(
   // Quadrant 2 connecting with Quadrant 2:
   for (auto& trig : trigs) {
     auto offset = Point(trig.sin * radii.width, trig.cos * radii.height);
-    proc({right + offset.x, bottom + offset.y});
-    proc({right + offset.x, top - offset.y});
+    *output++ = {right + offset.x, bottom + offset.y};
+    *output++ = {right + offset.x, top - offset.y};
   }
+
+  return output;
 }
 
 }  // namespace impeller
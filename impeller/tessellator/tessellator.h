@@ -78,8 +78,9 @@ class Tessellator {
   using TessellatedVertexProc = std::function<void(const Point& p)>;
 
   /// @brief  An object which produces a list of vertices as |Point|s that
-  ///         tessellate a previously provided shape and delivers the vertices
-  ///         through a |TessellatedVertexProc| callback.
+  ///         tessellate a previously provided shape and either writes them
+  ///         directly to memory or delivers them through a
+  ///         |TessellatedVertexProc| callback.
   ///
   ///         The object can also provide advance information on how many
   ///         vertices it will generate.
@@ -113,7 +114,16 @@ class Tessellator {
     /// @brief  Generate the vertices and deliver them in the necessary
     ///         order (as required by the PrimitiveType) to the given
     ///         callback function.
+    ///
+    ///         Prefer |WriteVertices| on hot paths, which avoids invoking a
+    ///         |std::function| for every vertex.
     virtual void GenerateVertices(const TessellatedVertexProc& proc) const = 0;
+
+    /// @brief  Generate the vertices in the necessary order (as required by
+    ///         the PrimitiveType) and write them to |output|, which must have
+    ///         room for exactly |GetVertexCount| points. This is usually
+    ///         memory that was just allocated from a |HostBuffer|.
+    virtual void WriteVertices(Point* output) const = 0;
   };
 
   /// @brief  The |VertexGenerator| implementation common to all shapes
@@ -132,7 +142,13 @@ class Tessellator {
 
     /// |VertexGenerator|
     void GenerateVertices(const TessellatedVertexProc& proc) const override {
-      impl_(trigs_, data_, proc);
+      proc_impl_(trigs_, data_, VertexProcOutput(proc));
+    }
+
+    /// |VertexGenerator|
+    void WriteVertices(Point* output) const override {
+      Point* end = write_impl_(trigs_, data_, output);
+      FML_DCHECK(end == output + GetVertexCount());
     }
 
    private:
@@ -151,16 +167,41 @@ class Tessellator {
       const Scalar half_width;
     };
 
-    typedef void GeneratorProc(const Trigs& trigs,
-                               const Data& data,
-                               const TessellatedVertexProc& proc);
+    /// An output iterator that hands each vertex written through it to a
+    /// |TessellatedVertexProc|.
+    class VertexProcOutput {
+     public:
+      explicit VertexProcOutput(const TessellatedVertexProc& proc)
+          : proc_(proc) {}
+
+      VertexProcOutput& operator*() { return *this; }
+
+      VertexProcOutput& operator++(int) { return *this; }
+
+      void operator=(const Point& vertex) { proc_(vertex); }
+
+     private:
+      const TessellatedVertexProc& proc_;
+    };
 
-    GeneratorProc& impl_;
+    /// Writes the vertices for |data| to |output| and returns the end of
+    /// the written range. Implementations are plain loops over the trig
+    /// samples that store straight to |output|, which is either memory or a
+    /// |VertexProcOutput|, so that they stay cheap enough to run for every
+    /// oval, round rect and round cap.
+    template <typename VertexOutput>
+    using GeneratorProc = VertexOutput(const Trigs& trigs,
+                                       const Data& data,
+                                       VertexOutput output);
+
+    GeneratorProc<Point*>& write_impl_;
+    GeneratorProc<VertexProcOutput>& proc_impl_;
     const Trigs trigs_;
     const Data data_;
     const size_t vertices_per_trig_;
 
-    EllipticalVertexGenerator(GeneratorProc& generator,
+    EllipticalVertexGenerator(GeneratorProc<Point*>& write_generator,
+                              GeneratorProc<VertexProcOutput>& proc_generator,
                               Trigs&& trigs,
                               PrimitiveType triangle_type,
                               size_t vertices_per_trig,
@@ -298,26 +339,37 @@ class Tessellator {
 
   Trigs GetTrigsForDivisions(size_t divisions);
 
-  static void GenerateFilledCircle(const Trigs& trigs,
-                                   const EllipticalVertexGenerator::Data& data,
-                                   const TessellatedVertexProc& proc);
+  using VertexProcOutput = EllipticalVertexGenerator::VertexProcOutput;
 
-  static void GenerateStrokedCircle(const Trigs& trigs,
-                                    const EllipticalVertexGenerator::Data& data,
-                                    const TessellatedVertexProc& proc);
+  template <typename VertexOutput>
+  static VertexOutput GenerateFilledCircle(
+      const Trigs& trigs,
+      const EllipticalVertexGenerator::Data& data,
+      VertexOutput output);
 
-  static void GenerateRoundCapLine(const Trigs& trigs,
-                                   const EllipticalVertexGenerator::Data& data,
-                                   const TessellatedVertexProc& proc);
+  template <typename VertexOutput>
+  static VertexOutput GenerateStrokedCircle(
+      const Trigs& trigs,
+      const EllipticalVertexGenerator::Data& data,
+      VertexOutput output);
 
-  static void GenerateFilledEllipse(const Trigs& trigs,
-                                    const EllipticalVertexGenerator::Data& data,
-                                    const TessellatedVertexProc& proc);
+  template <typename VertexOutput>
+  static VertexOutput GenerateRoundCapLine(
+      const Trigs& trigs,
+      const EllipticalVertexGenerator::Data& data,
+      VertexOutput output);
+
+  template <typename VertexOutput>
+  static VertexOutput GenerateFilledEllipse(
+      const Trigs& trigs,
+      const EllipticalVertexGenerator::Data& data,
+      VertexOutput output);
 
-  static void GenerateFilledRoundRect(
+  template <typename VertexOutput>
+  static VertexOutput GenerateFilledRoundRect(
       const Trigs& trigs,
       const EllipticalVertexGenerator::Data& data,
-      const TessellatedVertexProc& proc);
+      VertexOutput output);
 
   Tessellator(const Tessellator&) = delete;
 
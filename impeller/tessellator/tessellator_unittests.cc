@@ -496,6 +496,33 @@ TEST(TessellatorTest, FilledRoundRectTessellationVertices) {
        Rect::MakeXYWH(5000, 10000, 2000, 3000), {50, 70});
 }
 
+TEST(TessellatorTest, WriteVerticesMatchesGenerateVertices) {
+  auto tessellator = std::make_shared<Tessellator>();
+  Matrix transform = Matrix::MakeScale({2.0f, 2.0f, 1.0f});
+
+  auto test = [](const Tessellator::VertexGenerator& generator) {
+    std::vector<Point> generated;
+    generator.GenerateVertices([&generated](const Point& p) {  //
+      generated.push_back(p);
+    });
+
+    // Pad the output to check that exactly GetVertexCount points are written.
+    size_t vertex_count = generator.GetVertexCount();
+    std::vector<Point> written(vertex_count + 1, Point(-1, -1));
+    generator.WriteVertices(written.data());
+    EXPECT_EQ(written.back(), Point(-1, -1));
+    written.pop_back();
+    EXPECT_EQ(written, generated);
+  };
+
+  test(tessellator->FilledCircle(transform, {10, 20}, 30));
+  test(tessellator->StrokedCircle(transform, {10, 20}, 30, 5));
+  test(tessellator->RoundCapLine(transform, {10, 20}, {100, 50}, 8));
+  test(tessellator->FilledEllipse(transform, Rect::MakeXYWH(0, 0, 100, 40)));
+  test(tessellator->FilledRoundRect(transform, Rect::MakeXYWH(0, 0, 100, 40),
+                                    {10, 12}));
+}
+
 TEST(TessellatorTest, EarlyReturnEmptyConvexShape) {
   // This path is not technically empty (it has a size in one dimension),
   // but is otherwise completely flat.
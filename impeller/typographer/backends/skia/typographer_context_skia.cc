@@ -4,6 +4,7 @@
 
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <numeric>
@@ -204,6 +205,120 @@ static ISize ComputeNextAtlasSize(
   return {};
 }
 
+/// Remove least recently used glyphs that are not part of the current use
+/// generation from the last page of the atlas until the glyphs of [pairs]
+/// starting at [start_index] fit into that page, and append their positions
+/// to [glyph_positions]. Only the regions of the evicted glyphs are reused, so
+/// the remaining glyphs do not need to be rendered again.
+///
+/// Returns false if the glyphs do not fit even after every glyph that is not
+/// in use has been evicted, in which case the atlas must be rebuilt.
+static bool EvictColdGlyphs(
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+    const std::vector<FontGlyphPair>& pairs,
+    std::vector<Rect>& glyph_positions,
+    const std::vector<Rect>& glyph_sizes,
+    size_t start_index) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  const std::shared_ptr<GlyphAtlas>& atlas = atlas_context->GetGlyphAtlas();
+  const ISize atlas_size = atlas_context->GetAtlasSize();
+  const size_t page = atlas->GetPageCount() - 1;
+  if (!atlas->GetTexture(page) || atlas_size.IsEmpty()) {
+    return false;
+  }
+
+  // Earlier pages are full and only change when the atlas is rebuilt.
+  std::vector<GlyphAtlas::PlacedGlyph> placed_glyphs =
+      atlas->GetPlacedGlyphs();
+  placed_glyphs.erase(
+      std::remove_if(placed_glyphs.begin(), placed_glyphs.end(),
+                     [page](const GlyphAtlas::PlacedGlyph& placed) {
+                       return placed.page != page;
+                     }),
+      placed_glyphs.end());
+  const uint64_t use_generation = atlas->GetUseGeneration();
+
+  // The packer returned by ComputeNextAtlasSize only covers the region added
+  // by the last growth of the page and cannot release regions. Replace it
+  // with one that covers the whole page and has every glyph reserved.
+  std::shared_ptr<RectanglePacker> rect_packer = atlas_context->GetRectPacker();
+  if (!rect_packer || !rect_packer->SupportsRemoval() ||
+      atlas_context->GetHeightAdjustment() != 0) {
+    rect_packer =
+        RectanglePacker::MaxRectsFactory(atlas_size.width, atlas_size.height);
+    for (const GlyphAtlas::PlacedGlyph& placed : placed_glyphs) {
+      // Glyphs are positioned in the center of their padded region.
+      ISize size = ISize::Ceil(placed.atlas_bounds.GetSize());
+      IPoint16 location_in_atlas{
+          static_cast<int16_t>(placed.atlas_bounds.GetLeft() - 1),
+          static_cast<int16_t>(placed.atlas_bounds.GetTop() - 1)};
+      if (!rect_packer->ReserveRect(location_in_atlas,     //
+                                    size.width + kPadding,  //
+                                    size.height + kPadding  //
+                                    )) {
+        return false;
+      }
+    }
+    atlas_context->UpdateRectPacker(rect_packer);
+    atlas_context->UpdateGlyphAtlas(atlas, atlas_size, 0);
+  }
+
+  std::vector<GlyphAtlas::PlacedGlyph> cold_glyphs;
+  std::copy_if(placed_glyphs.begin(), placed_glyphs.end(),
+               std::back_inserter(cold_glyphs),
+               [use_generation](const GlyphAtlas::PlacedGlyph& placed) {
+                 return placed.last_use_generation < use_generation;
+               });
+  if (cold_glyphs.empty()) {
+    return false;
+  }
+  std::sort(cold_glyphs.begin(), cold_glyphs.end(),
+            [](const GlyphAtlas::PlacedGlyph& a,
+               const GlyphAtlas::PlacedGlyph& b) {
+              return a.last_use_generation < b.last_use_generation;
+            });
+
+  // Evict at least as much area as the missing glyphs need, doubling the
+  // amount whenever they still do not fit. The packer recomputes its free
+  // regions once per batch of evictions.
+  int64_t evict_area = 0;
+  for (size_t i = start_index; i < pairs.size(); i++) {
+    ISize glyph_size = ISize::Ceil(glyph_sizes[i].GetSize());
+    evict_area +=
+        (glyph_size.width + kPadding) * (glyph_size.height + kPadding);
+  }
+
+  size_t next_cold_index = 0;
+  size_t next_index = start_index;
+  while (true) {
+    int64_t evicted_area = 0;
+    while (evicted_area < evict_area && next_cold_index < cold_glyphs.size()) {
+      const GlyphAtlas::PlacedGlyph& cold = cold_glyphs[next_cold_index++];
+      ISize size = ISize::Ceil(cold.atlas_bounds.GetSize());
+      IPoint16 location_in_atlas{
+          static_cast<int16_t>(cold.atlas_bounds.GetLeft() - 1),
+          static_cast<int16_t>(cold.atlas_bounds.GetTop() - 1)};
+      rect_packer->FreeRect(location_in_atlas, size.width + kPadding,
+                            size.height + kPadding);
+      atlas->RemoveGlyph(cold.pair);
+      evicted_area += (size.width + kPadding) * (size.height + kPadding);
+    }
+    next_index = PairsFitInAtlasOfSize(pairs, atlas_size, glyph_positions,
+                                       glyph_sizes, /*height_adjustment=*/0,
+                                       rect_packer, next_index);
+    if (next_index == pairs.size()) {
+      break;
+    }
+    if (next_cold_index == cold_glyphs.size()) {
+      return false;
+    }
+    evict_area *= 2;
+  }
+
+  atlas_context->RecordEvictions(next_cold_index);
+  return true;
+}
+
 static void DrawGlyph(SkCanvas* canvas,
                       const SkPoint position,
                       const ScaledFont& scaled_font,
@@ -283,7 +398,7 @@ static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
     if (!data.has_value()) {
       continue;
     }
-    auto [pos, bounds, placeholder] = data.value();
+    auto [pos, bounds, placeholder, page] = data.value();
     FML_DCHECK(!placeholder);
     Size size = pos.GetSize();
     if (size.IsEmpty()) {
@@ -300,8 +415,7 @@ static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
   BufferView buffer_view = host_buffer.Emplace(
       bitmap.getAddr(0, 0),
       texture->GetSize().Area() *
-          BytesPerPixelForPixelFormat(
-              atlas.GetTexture()->GetTextureDescriptor().format),
+          BytesPerPixelForPixelFormat(texture->GetTextureDescriptor().format),
       DefaultUniformAlignment());
 
   return blit_pass->AddCopy(std::move(buffer_view),  //
@@ -327,7 +441,7 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
     if (!data.has_value()) {
       continue;
     }
-    auto [pos, bounds, placeholder] = data.value();
+    auto [pos, bounds, placeholder, page] = data.value();
     FML_DCHECK(!placeholder);
 
     Size size = pos.GetSize();
@@ -361,8 +475,8 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
     // benchmarks as substantially faster on a number of Android devices.
     BufferView buffer_view = host_buffer.Emplace(
         bitmap.getAddr(0, 0),
-        size.Area() * BytesPerPixelForPixelFormat(
-                          atlas.GetTexture()->GetTextureDescriptor().format),
+        size.Area() *
+            BytesPerPixelForPixelFormat(texture->GetTextureDescriptor().format),
         DefaultUniformAlignment());
 
     // convert_to_read is set to false so that the texture remains in a transfer
@@ -413,6 +527,7 @@ TypographerContextSkia::CollectNewGlyphs(
     const std::vector<std::shared_ptr<TextFrame>>& text_frames) {
   std::vector<FontGlyphPair> new_glyphs;
   std::vector<Rect> glyph_sizes;
+  const uint64_t use_generation = atlas->AdvanceUseGeneration();
   for (const auto& frame : text_frames) {
     // TODO(jonahwilliams): unless we destroy the atlas (which we know about),
     // we could probably guarantee that a text frame that is complete does not
@@ -450,7 +565,8 @@ TypographerContextSkia::CollectNewGlyphs(
         SubpixelGlyph subpixel_glyph(glyph_position.glyph, subpixel,
                                      frame->GetProperties());
         const auto& font_glyph_bounds =
-            font_glyph_atlas->FindGlyphBounds(subpixel_glyph);
+            font_glyph_atlas->FindGlyphBoundsAndMarkUsed(subpixel_glyph,
+                                                         use_generation);
 
         if (!font_glyph_bounds.has_value()) {
           new_glyphs.push_back(FontGlyphPair{scaled_font, subpixel_glyph});
@@ -509,8 +625,10 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   std::vector<Rect> glyph_positions;
   glyph_positions.reserve(new_glyphs.size());
   size_t first_missing_index = 0;
+  // New glyphs are only ever added to the last page.
+  size_t page = last_atlas->GetPageCount() - 1;
 
-  if (last_atlas->GetTexture()) {
+  if (last_atlas->GetTexture(page)) {
     // Append all glyphs that fit into the current atlas.
     first_missing_index = AppendToExistingAtlas(
         last_atlas, new_glyphs, glyph_positions, glyph_sizes,
@@ -523,7 +641,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // ---------------------------------------------------------------------------
     for (size_t i = 0; i < first_missing_index; i++) {
       last_atlas->AddTypefaceGlyphPositionAndBounds(
-          new_glyphs[i], glyph_positions[i], glyph_sizes[i]);
+          new_glyphs[i], glyph_positions[i], glyph_sizes[i], page);
     }
 
     std::shared_ptr<CommandBuffer> cmd_buffer = context.CreateCommandBuffer();
@@ -541,7 +659,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // the uploads into the blit pass.
     // ---------------------------------------------------------------------------
     if (!UpdateAtlasBitmap(*last_atlas, blit_pass, host_buffer,
-                           last_atlas->GetTexture(), new_glyphs, 0,
+                           last_atlas->GetTexture(page), new_glyphs, 0,
                            first_missing_index)) {
       return nullptr;
     }
@@ -556,26 +674,70 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   const int64_t max_texture_height =
       context.GetResourceAllocator()->GetMaxTextureSizeSupported().height;
 
-  // IF the current atlas size is as big as it can get, then "GC" and create an
-  // atlas with only the required glyphs. OpenGLES cannot reliably perform the
-  // blit required here, as 1) it requires attaching textures as read and write
-  // framebuffers which has substantially smaller size limits that max textures
-  // and 2) is missing a GLES 2.0 implementation and cap check.
+  // IF the last page is as big as it can get, then first evict the least
+  // recently used glyphs on it that are not part of this frame to make room,
+  // then start a new page, and once there are too many pages "GC" and create
+  // an atlas with only the required glyphs. OpenGLES cannot reliably perform
+  // the blit required to grow a page, as 1) it requires attaching textures as
+  // read and write framebuffers which has substantially smaller size limits
+  // that max textures and 2) is missing a GLES 2.0 implementation and cap
+  // check.
   bool blit_old_atlas = true;
   std::shared_ptr<GlyphAtlas> new_atlas = last_atlas;
   if (atlas_context->GetAtlasSize().height >= max_texture_height ||
       context.GetBackendType() == Context::BackendType::kOpenGLES) {
+    if (EvictColdGlyphs(atlas_context, new_glyphs, glyph_positions,
+                        glyph_sizes, first_missing_index)) {
+      FML_DCHECK(new_glyphs.size() == glyph_positions.size());
+      for (size_t i = first_missing_index; i < new_glyphs.size(); i++) {
+        last_atlas->AddTypefaceGlyphPositionAndBounds(
+            new_glyphs[i], glyph_positions[i], glyph_sizes[i], page);
+      }
+
+      std::shared_ptr<CommandBuffer> cmd_buffer =
+          context.CreateCommandBuffer();
+      std::shared_ptr<BlitPass> blit_pass = cmd_buffer->CreateBlitPass();
+
+      fml::ScopedCleanupClosure closure([&]() {
+        blit_pass->EncodeCommands(context.GetResourceAllocator());
+        if (!context.EnqueueCommandBuffer(std::move(cmd_buffer))) {
+          VALIDATION_LOG << "Failed to submit glyph atlas command buffer";
+        }
+      });
+
+      // Only the new glyphs are drawn, over the regions of evicted glyphs.
+      if (!UpdateAtlasBitmap(*last_atlas, blit_pass, host_buffer,
+                             last_atlas->GetTexture(page), new_glyphs,
+                             first_missing_index, new_glyphs.size())) {
+        return nullptr;
+      }
+      return last_atlas;
+    }
+
     blit_old_atlas = false;
-    new_atlas = std::make_shared<GlyphAtlas>(type);
+    if (last_atlas->GetTexture(page) &&
+        last_atlas->GetPageCount() < GlyphAtlas::kMaxPageCount) {
+      // The glyphs that did not fit go to a new page. The glyphs that were
+      // already added to the previous page stay there.
+      atlas_context->RecordPageAddition();
+      page = last_atlas->AddPage();
+      glyph_positions.resize(first_missing_index);
+    } else {
+      if (last_atlas->GetTexture(page)) {
+        atlas_context->RecordRebuild();
+      }
+      new_atlas = std::make_shared<GlyphAtlas>(type);
+      page = 0;
 
-    auto [update_glyphs, update_sizes] =
-        CollectNewGlyphs(new_atlas, text_frames);
-    new_glyphs = std::move(update_glyphs);
-    glyph_sizes = std::move(update_sizes);
+      auto [update_glyphs, update_sizes] =
+          CollectNewGlyphs(new_atlas, text_frames);
+      new_glyphs = std::move(update_glyphs);
+      glyph_sizes = std::move(update_sizes);
 
-    glyph_positions.clear();
-    glyph_positions.reserve(new_glyphs.size());
-    first_missing_index = 0;
+      glyph_positions.clear();
+      glyph_positions.reserve(new_glyphs.size());
+      first_missing_index = 0;
+    }
 
     height_adjustment = 0;
     atlas_context->UpdateRectPacker(nullptr);
@@ -629,8 +791,9 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   });
 
   // Now append all remaining glyphs. This should never have any missing data...
-  auto old_texture = new_atlas->GetTexture();
-  new_atlas->SetTexture(std::move(new_texture));
+  auto old_texture = new_atlas->GetTexture(page);
+  new_atlas->SetTexture(std::move(new_texture), page);
+  atlas_context->RecordTextureAllocation();
 
   // ---------------------------------------------------------------------------
   // Step 3a: Record the positions in the glyph atlas of the newly added
@@ -638,7 +801,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   for (size_t i = first_missing_index; i < glyph_positions.size(); i++) {
     new_atlas->AddTypefaceGlyphPositionAndBounds(
-        new_glyphs[i], glyph_positions[i], glyph_sizes[i]);
+        new_glyphs[i], glyph_positions[i], glyph_sizes[i], page);
   }
 
   // ---------------------------------------------------------------------------
@@ -646,15 +809,16 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // the uploads into the blit pass.
   // ---------------------------------------------------------------------------
   if (!BulkUpdateAtlasBitmap(*new_atlas, blit_pass, host_buffer,
-                             new_atlas->GetTexture(), new_glyphs,
+                             new_atlas->GetTexture(page), new_glyphs,
                              first_missing_index, new_glyphs.size())) {
     return nullptr;
   }
 
   // Blit the old texture to the top left of the new atlas.
   if (blit_old_atlas && old_texture) {
-    blit_pass->AddCopy(old_texture, new_atlas->GetTexture(),
-                       IRect::MakeSize(new_atlas->GetTexture()->GetSize()),
+    atlas_context->RecordGrowth();
+    blit_pass->AddCopy(old_texture, new_atlas->GetTexture(page),
+                       IRect::MakeSize(new_atlas->GetTexture(page)->GetSize()),
                        {0, 0});
   }
 
@@ -4,9 +4,11 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include <algorithm>
 #include <numeric>
 #include <utility>
 
+#include "flutter/fml/logging.h"
 #include "impeller/typographer/font_glyph_pair.h"
 
 namespace impeller {
@@ -45,31 +47,145 @@ void GlyphAtlasContext::UpdateRectPacker(
   rect_packer_ = std::move(rect_packer);
 }
 
-GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
+Scalar GlyphAtlasContext::GetPackingDensity() const {
+  int64_t texture_area = 0;
+  for (size_t page = 0; page < atlas_->GetPageCount(); page++) {
+    if (const std::shared_ptr<Texture>& texture = atlas_->GetTexture(page)) {
+      texture_area += texture->GetSize().Area();
+    }
+  }
+  if (texture_area == 0) {
+    return 0.0f;
+  }
+  Scalar glyph_area = 0.0f;
+  atlas_->IterateGlyphs([&glyph_area](const ScaledFont& scaled_font,
+                                      const SubpixelGlyph& glyph,
+                                      const Rect& rect) {
+    glyph_area += rect.Area();
+    return true;
+  });
+  return glyph_area / texture_area;
+}
+
+size_t GlyphAtlasContext::GetTextureBytes() const {
+  size_t bytes = 0u;
+  for (size_t page = 0; page < atlas_->GetPageCount(); page++) {
+    if (const std::shared_ptr<Texture>& texture = atlas_->GetTexture(page)) {
+      bytes += texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    }
+  }
+  return bytes;
+}
+
+const GlyphAtlasContext::Stats& GlyphAtlasContext::GetStats() const {
+  return stats_;
+}
+
+void GlyphAtlasContext::RecordGrowth() {
+  stats_.growth_count++;
+}
+
+void GlyphAtlasContext::RecordRebuild() {
+  stats_.rebuild_count++;
+}
+
+void GlyphAtlasContext::RecordEvictions(size_t glyph_count) {
+  stats_.evicted_glyph_count += glyph_count;
+}
+
+void GlyphAtlasContext::RecordPageAddition() {
+  stats_.page_addition_count++;
+}
+
+void GlyphAtlasContext::RecordTextureAllocation() {
+  stats_.peak_texture_bytes =
+      std::max(stats_.peak_texture_bytes, GetTextureBytes());
+}
+
+GlyphAtlas::GlyphAtlas(Type type) : type_(type), textures_(1u) {}
 
 GlyphAtlas::~GlyphAtlas() = default;
 
 bool GlyphAtlas::IsValid() const {
-  return !!texture_;
+  return std::all_of(
+      textures_.begin(), textures_.end(),
+      [](const std::shared_ptr<Texture>& texture) { return !!texture; });
 }
 
 GlyphAtlas::Type GlyphAtlas::GetType() const {
   return type_;
 }
 
-const std::shared_ptr<Texture>& GlyphAtlas::GetTexture() const {
-  return texture_;
+const std::shared_ptr<Texture>& GlyphAtlas::GetTexture(size_t page) const {
+  FML_DCHECK(page < textures_.size());
+  return textures_[page];
+}
+
+void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture, size_t page) {
+  FML_DCHECK(page < textures_.size());
+  textures_[page] = std::move(texture);
 }
 
-void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
-  texture_ = std::move(texture);
+size_t GlyphAtlas::GetPageCount() const {
+  return textures_.size();
+}
+
+size_t GlyphAtlas::AddPage() {
+  FML_DCHECK(textures_.size() < kMaxPageCount);
+  textures_.emplace_back();
+  return textures_.size() - 1u;
 }
 
 void GlyphAtlas::AddTypefaceGlyphPositionAndBounds(const FontGlyphPair& pair,
                                                    Rect position,
-                                                   Rect bounds) {
+                                                   Rect bounds,
+                                                   size_t page) {
+  FML_DCHECK(page < textures_.size());
   font_atlas_map_[pair.scaled_font].positions_[pair.glyph] =
-      FrameBounds{position, bounds, /*is_placeholder=*/false};
+      FontGlyphAtlas::GlyphEntry{
+          .frame_bounds = FrameBounds{position, bounds,
+                                      /*is_placeholder=*/false, page},
+          .last_use_generation = use_generation_,
+      };
+}
+
+bool GlyphAtlas::RemoveGlyph(const FontGlyphPair& pair) {
+  auto found = font_atlas_map_.find(pair.scaled_font);
+  if (found == font_atlas_map_.end() ||
+      found->second.positions_.erase(pair.glyph) == 0u) {
+    return false;
+  }
+  if (found->second.positions_.empty()) {
+    font_atlas_map_.erase(found);
+  }
+  return true;
+}
+
+uint64_t GlyphAtlas::AdvanceUseGeneration() {
+  return ++use_generation_;
+}
+
+uint64_t GlyphAtlas::GetUseGeneration() const {
+  return use_generation_;
+}
+
+std::vector<GlyphAtlas::PlacedGlyph> GlyphAtlas::GetPlacedGlyphs() const {
+  std::vector<PlacedGlyph> placed_glyphs;
+  for (const auto& font_value : font_atlas_map_) {
+    for (const auto& glyph_value : font_value.second.positions_) {
+      const FontGlyphAtlas::GlyphEntry& entry = glyph_value.second;
+      if (entry.frame_bounds.is_placeholder) {
+        continue;
+      }
+      placed_glyphs.push_back(PlacedGlyph{
+          .pair = FontGlyphPair{font_value.first, glyph_value.first},
+          .atlas_bounds = entry.frame_bounds.atlas_bounds,
+          .page = entry.frame_bounds.page,
+          .last_use_generation = entry.last_use_generation,
+      });
+    }
+  }
+  return placed_glyphs;
 }
 
 std::optional<FrameBounds> GlyphAtlas::FindFontGlyphBounds(
@@ -111,7 +227,7 @@ size_t GlyphAtlas::IterateGlyphs(
     for (const auto& glyph_value : font_value.second.positions_) {
       count++;
       if (!iterator(font_value.first, glyph_value.first,
-                    glyph_value.second.atlas_bounds)) {
+                    glyph_value.second.frame_bounds.atlas_bounds)) {
         return count;
       }
     }
@@ -125,12 +241,23 @@ std::optional<FrameBounds> FontGlyphAtlas::FindGlyphBounds(
   if (found == positions_.end()) {
     return std::nullopt;
   }
-  return found->second;
+  return found->second.frame_bounds;
+}
+
+std::optional<FrameBounds> FontGlyphAtlas::FindGlyphBoundsAndMarkUsed(
+    const SubpixelGlyph& glyph,
+    uint64_t use_generation) {
+  auto found = positions_.find(glyph);
+  if (found == positions_.end()) {
+    return std::nullopt;
+  }
+  found->second.last_use_generation = use_generation;
+  return found->second.frame_bounds;
 }
 
 void FontGlyphAtlas::AppendGlyph(const SubpixelGlyph& glyph,
                                  const FrameBounds& frame_bounds) {
-  positions_[glyph] = frame_bounds;
+  positions_[glyph] = GlyphEntry{.frame_bounds = frame_bounds};
 }
 
 }  // namespace impeller
@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "impeller/core/texture.h"
 #include "impeller/geometry/rect.h"
@@ -27,6 +28,8 @@ struct FrameBounds {
   /// Whether [atlas_bounds] are still a placeholder and have
   /// not yet been computed.
   bool is_placeholder = true;
+  /// The page of the glyph atlas that [atlas_bounds] refer to.
+  size_t page = 0u;
 };
 
 //------------------------------------------------------------------------------
@@ -34,8 +37,30 @@ struct FrameBounds {
 ///             different fonts along with the ability to query the location of
 ///             specific font glyphs within the texture.
 ///
+///             When a single texture of the maximum size cannot hold all the
+///             glyphs that are in use, the atlas is split into several pages,
+///             each backed by its own texture. Glyphs are only added to the
+///             last page.
+///
 class GlyphAtlas {
  public:
+  //----------------------------------------------------------------------------
+  /// The number of pages the atlas may be split into before it is rebuilt
+  /// with only the glyphs that are in use.
+  static constexpr size_t kMaxPageCount = 4u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A glyph that has been assigned a location in the atlas.
+  struct PlacedGlyph {
+    FontGlyphPair pair;
+    /// The bounds of the glyph within the glyph atlas.
+    Rect atlas_bounds;
+    /// The page of the glyph atlas that contains the glyph.
+    size_t page;
+    /// The use generation in which the glyph was last requested.
+    uint64_t last_use_generation;
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      Describes how the glyphs are represented in the texture.
   enum class Type {
@@ -71,30 +96,79 @@ class GlyphAtlas {
   Type GetType() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Set the texture for the glyph atlas.
+  /// @brief      Set the texture for a page of the glyph atlas.
   ///
   /// @param[in]  texture  The texture
+  /// @param[in]  page     The page, which must be less than the page count.
   ///
-  void SetTexture(std::shared_ptr<Texture> texture);
+  void SetTexture(std::shared_ptr<Texture> texture, size_t page = 0u);
 
   //----------------------------------------------------------------------------
-  /// @brief      Get the texture for the glyph atlas.
+  /// @brief      Get the texture for a page of the glyph atlas.
+  ///
+  /// @param[in]  page     The page, which must be less than the page count.
   ///
   /// @return     The texture.
   ///
-  const std::shared_ptr<Texture>& GetTexture() const;
+  const std::shared_ptr<Texture>& GetTexture(size_t page = 0u) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the number of pages in the glyph atlas. This is always at
+  ///             least one.
+  ///
+  size_t GetPageCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Append a page without a texture to the glyph atlas. The new
+  ///             page becomes the last page, which new glyphs are added to.
+  ///
+  /// @return     The index of the new page.
+  ///
+  size_t AddPage();
 
   //----------------------------------------------------------------------------
   /// @brief      Record the location of a specific font-glyph pair within the
   ///             atlas.
   ///
+  ///             The glyph is marked as used in the current use generation.
+  ///
   /// @param[in]  pair  The font-glyph pair
   /// @param[in]  rect  The position in the atlas
   /// @param[in]  bounds The bounds of the glyph at scale
+  /// @param[in]  page  The page that contains the glyph
   ///
   void AddTypefaceGlyphPositionAndBounds(const FontGlyphPair& pair,
                                          Rect position,
-                                         Rect bounds);
+                                         Rect bounds,
+                                         size_t page = 0u);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove a font-glyph pair from the atlas. The region of the
+  ///             texture it occupied may then be reused for other glyphs.
+  ///
+  /// @return     Whether the pair was in the atlas.
+  ///
+  bool RemoveGlyph(const FontGlyphPair& pair);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start a new use generation. Glyphs that are looked up or
+  ///             added after this call are marked with the new generation,
+  ///             so glyphs with an older generation were not requested since.
+  ///
+  /// @return     The new generation.
+  ///
+  uint64_t AdvanceUseGeneration();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The current use generation.
+  ///
+  uint64_t GetUseGeneration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collect all glyphs that have a location in the atlas,
+  ///             skipping placeholders.
+  ///
+  std::vector<PlacedGlyph> GetPlacedGlyphs() const;
 
   //----------------------------------------------------------------------------
   /// @brief      Get the number of unique font-glyph pairs in this atlas.
@@ -144,7 +218,9 @@ class GlyphAtlas {
 
  private:
   const Type type_;
-  std::shared_ptr<Texture> texture_;
+  // One texture per page.
+  std::vector<std::shared_ptr<Texture>> textures_;
+  uint64_t use_generation_ = 0u;
 
   std::unordered_map<ScaledFont,
                      FontGlyphAtlas,
@@ -162,6 +238,22 @@ class GlyphAtlas {
 ///
 class GlyphAtlasContext {
  public:
+  struct Stats {
+    /// The number of times the atlas texture was replaced by a larger one
+    /// that the previous contents were copied into.
+    size_t growth_count = 0u;
+    /// The number of times the atlas was recreated and every glyph that is
+    /// still in use was rendered again.
+    size_t rebuild_count = 0u;
+    /// The number of least recently used glyphs removed from the atlas to
+    /// make room for new glyphs.
+    size_t evicted_glyph_count = 0u;
+    /// The number of pages added to the atlas instead of rebuilding it.
+    size_t page_addition_count = 0u;
+    /// The largest total size of the textures of the atlas, in bytes.
+    size_t peak_texture_bytes = 0u;
+  };
+
   explicit GlyphAtlasContext(GlyphAtlas::Type type);
 
   virtual ~GlyphAtlasContext();
@@ -171,7 +263,8 @@ class GlyphAtlasContext {
   std::shared_ptr<GlyphAtlas> GetGlyphAtlas() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the size of the current glyph atlas.
+  /// @brief      Retrieve the size of the last page of the current glyph
+  ///             atlas.
   const ISize& GetAtlasSize() const;
 
   //----------------------------------------------------------------------------
@@ -196,11 +289,39 @@ class GlyphAtlasContext {
 
   void UpdateRectPacker(std::shared_ptr<RectanglePacker> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The fraction of the atlas textures covered by glyphs, between
+  ///             0.0 and 1.0.
+  Scalar GetPackingDensity() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The total size of the textures of all pages of the current
+  ///             glyph atlas, in bytes.
+  size_t GetTextureBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Counters accumulated since this context was created.
+  const Stats& GetStats() const;
+
+  void RecordGrowth();
+
+  void RecordRebuild();
+
+  void RecordEvictions(size_t glyph_count);
+
+  void RecordPageAddition();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Update the peak texture size after a page texture of the
+  ///             current glyph atlas was created.
+  void RecordTextureAllocation();
+
  private:
   std::shared_ptr<GlyphAtlas> atlas_;
   ISize atlas_size_;
   std::shared_ptr<RectanglePacker> rect_packer_;
-  int64_t height_adjustment_;
+  int64_t height_adjustment_ = 0;
+  Stats stats_;
 
   GlyphAtlasContext(const GlyphAtlasContext&) = delete;
 
@@ -225,6 +346,20 @@ class FontGlyphAtlas {
   ///
   std::optional<FrameBounds> FindGlyphBounds(const SubpixelGlyph& glyph) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Find the location of a glyph in the atlas and mark it as used
+  ///             in the given use generation.
+  ///
+  /// @param[in]  glyph           The glyph
+  /// @param[in]  use_generation  The current use generation of the atlas.
+  ///
+  /// @return     The location of the glyph in the atlas.
+  ///             `std::nullopt` if the glyph is not in the atlas.
+  ///
+  std::optional<FrameBounds> FindGlyphBoundsAndMarkUsed(
+      const SubpixelGlyph& glyph,
+      uint64_t use_generation);
+
   //----------------------------------------------------------------------------
   /// @brief      Append the frame bounds of a glyph to this atlas.
   ///
@@ -235,8 +370,13 @@ class FontGlyphAtlas {
  private:
   friend class GlyphAtlas;
 
+  struct GlyphEntry {
+    FrameBounds frame_bounds;
+    uint64_t last_use_generation = 0u;
+  };
+
   std::unordered_map<SubpixelGlyph,
-                     FrameBounds,
+                     GlyphEntry,
                      SubpixelGlyph::Hash,
                      SubpixelGlyph::Equal>
       positions_;
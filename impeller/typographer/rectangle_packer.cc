@@ -5,6 +5,9 @@
 #include "impeller/typographer/rectangle_packer.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -171,9 +174,261 @@ void SkylineRectanglePacker::AddSkylineLevel(size_t skyline_index,
   }
 }
 
+// Pack rectangles into the maximal free rectangles of the area, using the
+// best short side fit heuristic from Jukka Jylanki's "A Thousand Ways to Pack
+// the Bin". Unlike the skyline packer, the free rectangles describe all of
+// the unused area, so rectangles can also be released and reused.
+//
+// Releasing a rectangle only records it. The free rectangles are recomputed
+// from the used rectangles on the next addition, so that a batch of
+// releases costs a single recomputation.
+class MaxRectsRectanglePacker final : public RectanglePacker {
+ public:
+  MaxRectsRectanglePacker(int w, int h) : RectanglePacker(w, h) { Reset(); }
+
+  ~MaxRectsRectanglePacker() final {}
+
+  void Reset() final {
+    area_so_far_ = 0;
+    used_regions_.clear();
+    free_regions_.clear();
+    free_regions_.push_back(Region{0, 0, width(), height()});
+    free_regions_dirty_ = false;
+  }
+
+  bool AddRect(int w, int h, IPoint16* loc) final;
+
+  Scalar PercentFull() const final {
+    return area_so_far_ / ((float)width() * height());
+  }
+
+  bool SupportsRemoval() const final { return true; }
+
+  bool ReserveRect(IPoint16 loc, int w, int h) final;
+
+  bool FreeRect(IPoint16 loc, int w, int h) final;
+
+ private:
+  struct Region {
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+
+    bool Intersects(const Region& other) const {
+      return x_ < other.x_ + other.width_ && other.x_ < x_ + width_ &&
+             y_ < other.y_ + other.height_ && other.y_ < y_ + height_;
+    }
+
+    bool Contains(const Region& other) const {
+      return x_ <= other.x_ && y_ <= other.y_ &&
+             other.x_ + other.width_ <= x_ + width_ &&
+             other.y_ + other.height_ <= y_ + height_;
+    }
+  };
+
+  // Used regions are non-empty and do not overlap, so their location is
+  // unique.
+  static uint32_t LocationKey(int x, int y) {
+    return (static_cast<uint32_t>(x) << 16) | static_cast<uint32_t>(y);
+  }
+
+  std::unordered_map<uint32_t, Region> used_regions_;
+  std::vector<Region> free_regions_;
+  // Scratch storage for the regions produced by a split.
+  std::vector<Region> split_regions_;
+  // Scratch storage for the used regions while rebuilding.
+  std::vector<Region> sorted_regions_;
+  bool free_regions_dirty_ = false;
+
+  int64_t area_so_far_;
+
+  // Remove |used| from the free regions, replacing each free region it
+  // overlaps with the maximal regions that remain.
+  void SplitFreeRegions(const Region& used);
+
+  void RebuildFreeRegionsIfNeeded();
+
+  void Place(const Region& region);
+};
+
+bool MaxRectsRectanglePacker::AddRect(int p_width,
+                                      int p_height,
+                                      IPoint16* loc) {
+  if ((unsigned)p_width > (unsigned)width() ||
+      (unsigned)p_height > (unsigned)height()) {
+    return false;
+  }
+  if (p_width == 0 || p_height == 0) {
+    loc->x_ = 0;
+    loc->y_ = 0;
+    return true;
+  }
+  RebuildFreeRegionsIfNeeded();
+
+  // Minimize the shorter leftover side, then the longer one.
+  int best_short_side = std::numeric_limits<int>::max();
+  int best_long_side = std::numeric_limits<int>::max();
+  int best_index = -1;
+  for (auto i = 0u; i < free_regions_.size(); i++) {
+    const Region& free = free_regions_[i];
+    if (free.width_ < p_width || free.height_ < p_height) {
+      continue;
+    }
+    int leftover_x = free.width_ - p_width;
+    int leftover_y = free.height_ - p_height;
+    int short_side = std::min(leftover_x, leftover_y);
+    int long_side = std::max(leftover_x, leftover_y);
+    if (short_side < best_short_side ||
+        (short_side == best_short_side && long_side < best_long_side)) {
+      best_short_side = short_side;
+      best_long_side = long_side;
+      best_index = i;
+    }
+  }
+
+  if (best_index == -1) {
+    loc->x_ = 0;
+    loc->y_ = 0;
+    return false;
+  }
+
+  const Region& free = free_regions_[best_index];
+  Region region{free.x_, free.y_, p_width, p_height};
+  Place(region);
+  loc->x_ = region.x_;
+  loc->y_ = region.y_;
+  return true;
+}
+
+bool MaxRectsRectanglePacker::ReserveRect(IPoint16 loc,
+                                          int p_width,
+                                          int p_height) {
+  Region region{loc.x(), loc.y(), p_width, p_height};
+  if (region.x_ < 0 || region.y_ < 0 || p_width < 0 || p_height < 0 ||
+      region.x_ + p_width > width() || region.y_ + p_height > height()) {
+    return false;
+  }
+  if (p_width == 0 || p_height == 0) {
+    return true;
+  }
+  RebuildFreeRegionsIfNeeded();
+
+  // Any free area is contained in at least one maximal free region.
+  bool is_free = std::any_of(
+      free_regions_.begin(), free_regions_.end(),
+      [&region](const Region& free) { return free.Contains(region); });
+  if (!is_free) {
+    return false;
+  }
+  Place(region);
+  return true;
+}
+
+bool MaxRectsRectanglePacker::FreeRect(IPoint16 loc,
+                                       int p_width,
+                                       int p_height) {
+  if (p_width == 0 || p_height == 0) {
+    return true;
+  }
+  auto found = used_regions_.find(LocationKey(loc.x(), loc.y()));
+  if (found == used_regions_.end() || found->second.width_ != p_width ||
+      found->second.height_ != p_height) {
+    return false;
+  }
+  used_regions_.erase(found);
+  area_so_far_ -= p_width * p_height;
+  free_regions_dirty_ = true;
+  return true;
+}
+
+void MaxRectsRectanglePacker::Place(const Region& region) {
+  SplitFreeRegions(region);
+  used_regions_[LocationKey(region.x_, region.y_)] = region;
+  area_so_far_ += region.width_ * region.height_;
+}
+
+void MaxRectsRectanglePacker::SplitFreeRegions(const Region& used) {
+  split_regions_.clear();
+  for (auto i = 0u; i < free_regions_.size();) {
+    Region free = free_regions_[i];
+    if (!free.Intersects(used)) {
+      i++;
+      continue;
+    }
+    free_regions_[i] = free_regions_.back();
+    free_regions_.pop_back();
+
+    if (used.x_ > free.x_) {
+      split_regions_.push_back(
+          Region{free.x_, free.y_, used.x_ - free.x_, free.height_});
+    }
+    if (used.x_ + used.width_ < free.x_ + free.width_) {
+      int x = used.x_ + used.width_;
+      split_regions_.push_back(
+          Region{x, free.y_, free.x_ + free.width_ - x, free.height_});
+    }
+    if (used.y_ > free.y_) {
+      split_regions_.push_back(
+          Region{free.x_, free.y_, free.width_, used.y_ - free.y_});
+    }
+    if (used.y_ + used.height_ < free.y_ + free.height_) {
+      int y = used.y_ + used.height_;
+      split_regions_.push_back(
+          Region{free.x_, y, free.width_, free.y_ + free.height_ - y});
+    }
+  }
+
+  // The untouched free regions are still maximal and every split region is
+  // inside one of the removed regions, so only the split regions need to be
+  // checked for containment.
+  size_t untouched_count = free_regions_.size();
+  for (auto i = 0u; i < split_regions_.size(); i++) {
+    const Region& split = split_regions_[i];
+    bool contained = false;
+    for (auto j = 0u; j < untouched_count && !contained; j++) {
+      contained = free_regions_[j].Contains(split);
+    }
+    for (auto j = 0u; j < split_regions_.size() && !contained; j++) {
+      // Of two equal regions, only the first one is kept.
+      contained = j != i && split_regions_[j].Contains(split) &&
+                  (j < i || !split.Contains(split_regions_[j]));
+    }
+    if (!contained) {
+      free_regions_.push_back(split);
+    }
+  }
+}
+
+void MaxRectsRectanglePacker::RebuildFreeRegionsIfNeeded() {
+  if (!free_regions_dirty_) {
+    return;
+  }
+  free_regions_dirty_ = false;
+  free_regions_.clear();
+  free_regions_.push_back(Region{0, 0, width(), height()});
+  // Splitting in scanline order keeps the intermediate free list short.
+  sorted_regions_.clear();
+  for (const auto& used : used_regions_) {
+    sorted_regions_.push_back(used.second);
+  }
+  std::sort(sorted_regions_.begin(), sorted_regions_.end(),
+            [](const Region& a, const Region& b) {
+              return a.y_ < b.y_ || (a.y_ == b.y_ && a.x_ < b.x_);
+            });
+  for (const Region& used : sorted_regions_) {
+    SplitFreeRegions(used);
+  }
+}
+
 std::shared_ptr<RectanglePacker> RectanglePacker::Factory(int width,
                                                           int height) {
   return std::make_shared<SkylineRectanglePacker>(width, height);
 }
 
+std::shared_ptr<RectanglePacker> RectanglePacker::MaxRectsFactory(int width,
+                                                                  int height) {
+  return std::make_shared<MaxRectsRectanglePacker>(width, height);
+}
+
 }  // namespace impeller
@@ -30,6 +30,18 @@ class RectanglePacker {
   ///
   static std::shared_ptr<RectanglePacker> Factory(int width, int height);
 
+  //----------------------------------------------------------------------------
+  /// @brief     Return an empty packer with area specified by width and height
+  ///            that supports releasing rectangles with |FreeRect| and
+  ///            placing them at fixed locations with |ReserveRect|.
+  ///
+  ///            This packer keeps a list of the maximal free rectangles of
+  ///            its area, which makes additions more expensive than with the
+  ///            packer returned by |Factory|.
+  ///
+  static std::shared_ptr<RectanglePacker> MaxRectsFactory(int width,
+                                                          int height);
+
   virtual ~RectanglePacker() {}
 
   //----------------------------------------------------------------------------
@@ -56,6 +68,31 @@ class RectanglePacker {
   ///
   virtual void Reset() = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Whether this packer implements |ReserveRect| and |FreeRect|.
+  ///
+  virtual bool SupportsRemoval() const { return false; }
+
+  //----------------------------------------------------------------------------
+  /// @brief     Mark a rectangle at a fixed location as used, as if it had
+  ///            been returned by |AddRect|.
+  ///
+  /// @return    Return true on success; false if the packer does not support
+  ///            removal or the area is not entirely free.
+  ///
+  virtual bool ReserveRect(IPoint16 loc, int width, int height) {
+    return false;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief     Release a rectangle previously returned by |AddRect| or
+  ///            passed to |ReserveRect| so that its area can be reused.
+  ///
+  /// @return    Return true on success; false if the packer does not support
+  ///            removal or there is no such rectangle.
+  ///
+  virtual bool FreeRect(IPoint16 loc, int width, int height) { return false; }
+
  protected:
   RectanglePacker(int width, int height) : width_(width), height_(height) {
     FML_DCHECK(width >= 0);
@@ -422,6 +422,87 @@ TEST(TypographerTest, RectanglePackerFillsRows) {
   EXPECT_EQ(loc.y(), 16);
 }
 
+TEST(TypographerTest, MaxRectsPackerAddsNonoverlappingRectangles) {
+  auto packer = RectanglePacker::MaxRectsFactory(200, 100);
+  ASSERT_TRUE(packer->SupportsRemoval());
+
+  std::vector<SkIRect> rects;
+  IPoint16 loc;
+  while (packer->AddRect(30, 20, &loc)) {
+    SkIRect rect = SkIRect::MakeXYWH(loc.x(), loc.y(), 30, 20);
+    ASSERT_TRUE(SkIRect::MakeWH(200, 100).contains(rect));
+    for (const SkIRect& other : rects) {
+      ASSERT_FALSE(SkIRect::Intersects(rect, other));
+    }
+    rects.push_back(rect);
+  }
+  // 6 columns of 5 rows.
+  EXPECT_EQ(rects.size(), 30u);
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 0.9));
+}
+
+TEST(TypographerTest, MaxRectsPackerReusesFreedRectangles) {
+  auto packer = RectanglePacker::MaxRectsFactory(64, 64);
+
+  IPoint16 first;
+  IPoint16 second;
+  IPoint16 loc;
+  ASSERT_TRUE(packer->AddRect(64, 32, &first));
+  ASSERT_TRUE(packer->AddRect(64, 32, &second));
+  ASSERT_FALSE(packer->AddRect(32, 32, &loc));
+
+  // Only a rectangle that was added can be freed.
+  EXPECT_FALSE(packer->FreeRect(first, 32, 32));
+  ASSERT_TRUE(packer->FreeRect(first, 64, 32));
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 0.5));
+
+  // The freed area can be split between smaller rectangles.
+  IPoint16 left;
+  IPoint16 right;
+  ASSERT_TRUE(packer->AddRect(32, 32, &left));
+  ASSERT_TRUE(packer->AddRect(32, 32, &right));
+  EXPECT_EQ(left.y(), first.y());
+  EXPECT_EQ(right.y(), first.y());
+  EXPECT_NE(left.x(), right.x());
+  EXPECT_FALSE(packer->AddRect(1, 1, &loc));
+
+  // Freeing two adjacent rectangles makes room for one spanning both.
+  ASSERT_TRUE(packer->FreeRect(left, 32, 32));
+  ASSERT_TRUE(packer->FreeRect(second, 64, 32));
+  ASSERT_TRUE(packer->AddRect(32, 64, &loc));
+  EXPECT_EQ(loc.x(), left.x());
+  EXPECT_EQ(loc.y(), 0);
+}
+
+TEST(TypographerTest, MaxRectsPackerReservesFixedRectangles) {
+  auto packer = RectanglePacker::MaxRectsFactory(64, 64);
+
+  ASSERT_TRUE(packer->ReserveRect({0, 16}, 64, 32));
+  // Overlapping or out of bounds areas cannot be reserved.
+  EXPECT_FALSE(packer->ReserveRect({16, 0}, 8, 32));
+  EXPECT_FALSE(packer->ReserveRect({60, 48}, 8, 8));
+
+  IPoint16 loc;
+  ASSERT_TRUE(packer->AddRect(64, 16, &loc));
+  EXPECT_TRUE(loc.y() == 0 || loc.y() == 48);
+  ASSERT_TRUE(packer->AddRect(64, 16, &loc));
+  EXPECT_FALSE(packer->AddRect(1, 1, &loc));
+
+  ASSERT_TRUE(packer->FreeRect({0, 16}, 64, 32));
+  ASSERT_TRUE(packer->AddRect(64, 32, &loc));
+  EXPECT_EQ(loc.y(), 16);
+}
+
+TEST(TypographerTest, SkylinePackerDoesNotSupportRemoval) {
+  auto packer = RectanglePacker::Factory(64, 64);
+  EXPECT_FALSE(packer->SupportsRemoval());
+
+  IPoint16 loc;
+  ASSERT_TRUE(packer->AddRect(16, 16, &loc));
+  EXPECT_FALSE(packer->FreeRect(loc, 16, 16));
+  EXPECT_FALSE(packer->ReserveRect({32, 32}, 16, 16));
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
   if (GetBackend() == PlaygroundBackend::kOpenGLES) {
     GTEST_SKIP() << "Atlas growth isn't supported for OpenGLES currently.";
@@ -442,8 +523,8 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
                        MakeTextFrameFromTextBlobSkia(blob));
   // Continually append new glyphs until the glyph size grows to the maximum.
   // Note that the sizes here are more or less experimentally determined, but
-  // the important expectation is that the atlas size will shrink again after
-  // growing to the maximum size.
+  // the important expectation is that once the atlas is at the maximum size,
+  // glyphs that are no longer used are evicted instead of rebuilding it.
   constexpr ISize expected_sizes[13] = {
       {4096, 4096},   //
       {4096, 4096},   //
@@ -457,11 +538,12 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
       {4096, 16384},  //
       {4096, 16384},  //
       {4096, 16384},  //
-      {4096, 4096}    // Shrinks!
+      {4096, 16384}   // Evicts!
   };
 
   SkFont sk_font_small = flutter::testing::CreateTestFontOfSize(10);
 
+  std::shared_ptr<TextFrame> frame;
   for (int i = 0; i < 13; i++) {
     SkTextBlobBuilder builder;
 
@@ -477,19 +559,144 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
     add_char(sk_font_small, 'B');
     auto blob = builder.make();
 
-    atlas =
-        CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
-                         GlyphAtlas::Type::kAlphaBitmap, 50 + i, atlas_context,
-                         MakeTextFrameFromTextBlobSkia(blob));
+    frame = MakeTextFrameFromTextBlobSkia(blob);
+    atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                             GlyphAtlas::Type::kAlphaBitmap, 50 + i,
+                             atlas_context, frame);
     ASSERT_TRUE(!!atlas);
     EXPECT_EQ(atlas->GetTexture()->GetTextureDescriptor().size,
               expected_sizes[i]);
   }
 
-  // The final atlas should contain both the "A" glyph (which was not present
-  // in the previous atlas) and the "B" glyph (which existed in the previous
-  // atlas).
-  ASSERT_EQ(atlas->GetGlyphCount(), 2u);
+  EXPECT_EQ(atlas_context->GetStats().rebuild_count, 0u);
+  EXPECT_GT(atlas_context->GetStats().evicted_glyph_count, 0u);
+
+  // The final atlas should contain both glyphs of the last frame.
+  atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                           GlyphAtlas::Type::kAlphaBitmap, 62, atlas_context,
+                           frame);
+  ASSERT_TRUE(frame->IsFrameComplete());
+  EXPECT_FALSE(frame->GetFrameBounds(0).is_placeholder);
+  EXPECT_FALSE(frame->GetFrameBounds(1).is_placeholder);
+}
+
+// Cycles through more distinct glyph sizes than fit into an atlas of the
+// maximum size, as on a text heavy screen that animates its font size.
+TEST_P(TypographerTest, GlyphAtlasEvictsGlyphsOfSizesNoLongerDrawn) {
+  if (GetBackend() == PlaygroundBackend::kOpenGLES) {
+    GTEST_SKIP() << "Atlas growth isn't supported for OpenGLES currently.";
+  }
+
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                        GetContext()->GetIdleWaiter());
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(context && context->IsValid());
+
+  constexpr int kFontSizeCount = 48;
+  constexpr int kFrameCount = kFontSizeCount * 3;
+  // The number of glyphs in "ABCDEF".
+  constexpr size_t kGlyphCount = 6u;
+
+  std::optional<ISize> size_at_first_eviction;
+  for (int i = 0; i < kFrameCount; i++) {
+    SkFont sk_font =
+        flutter::testing::CreateTestFontOfSize(20 + 2 * (i % kFontSizeCount));
+    auto blob = SkTextBlob::MakeFromString("ABCDEF", sk_font);
+    ASSERT_TRUE(blob);
+    auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+    auto atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                                  GlyphAtlas::Type::kAlphaBitmap, 16.0f,
+                                  atlas_context, frame);
+    ASSERT_TRUE(!!atlas);
+    ASSERT_TRUE(frame->IsFrameComplete());
+    for (size_t j = 0; j < kGlyphCount; j++) {
+      EXPECT_FALSE(frame->GetFrameBounds(j).is_placeholder);
+    }
+
+    // Glyphs are only evicted once the atlas cannot grow any further, and
+    // from then on it keeps its size.
+    const ISize size = atlas->GetTexture()->GetTextureDescriptor().size;
+    if (size_at_first_eviction.has_value()) {
+      EXPECT_EQ(size, size_at_first_eviction.value());
+    } else if (atlas_context->GetStats().evicted_glyph_count > 0u) {
+      size_at_first_eviction = size;
+    }
+    host_buffer->Reset();
+  }
+
+  const GlyphAtlasContext::Stats& stats = atlas_context->GetStats();
+  EXPECT_TRUE(size_at_first_eviction.has_value());
+  EXPECT_GT(stats.evicted_glyph_count, 0u);
+  EXPECT_EQ(stats.rebuild_count, 0u);
+  EXPECT_GT(atlas_context->GetPackingDensity(), 0.0f);
+  EXPECT_LE(atlas_context->GetPackingDensity(), 1.0f);
+}
+
+// Draws a growing set of large glyphs that are all in use every frame, so that
+// none of them can be evicted once the atlas reaches its maximum size.
+TEST_P(TypographerTest, GlyphAtlasAddsPagesWhenFullOfUsedGlyphs) {
+  if (GetBackend() == PlaygroundBackend::kOpenGLES) {
+    GTEST_SKIP() << "Atlas growth isn't supported for OpenGLES currently.";
+  }
+
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                        GetContext()->GetIdleWaiter());
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(context && context->IsValid());
+
+  constexpr int kFrameCount = 8;
+
+  std::shared_ptr<GlyphAtlas> atlas;
+  std::shared_ptr<TextFrame> frame;
+  for (int i = 0; i < kFrameCount; i++) {
+    // Every frame draws the glyphs of all previous frames plus a new one.
+    SkTextBlobBuilder builder;
+    for (int j = 0; j <= i; j++) {
+      SkFont sk_font = flutter::testing::CreateTestFontOfSize(50 + j);
+      char c = 'A';
+      int count = sk_font.countText(&c, 1, SkTextEncoding::kUTF8);
+      auto buffer = builder.allocRunPos(sk_font, count);
+      sk_font.textToGlyphs(&c, 1, SkTextEncoding::kUTF8, buffer.glyphs, count);
+      sk_font.getPos(buffer.glyphs, count, buffer.points(), {0, 0});
+    }
+    auto blob = builder.make();
+    ASSERT_TRUE(blob);
+
+    frame = MakeTextFrameFromTextBlobSkia(blob);
+    atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                             GlyphAtlas::Type::kAlphaBitmap, 50, atlas_context,
+                             frame);
+    ASSERT_TRUE(!!atlas);
+    ASSERT_TRUE(atlas->IsValid());
+    ASSERT_TRUE(frame->IsFrameComplete());
+    host_buffer->Reset();
+  }
+
+  const GlyphAtlasContext::Stats& stats = atlas_context->GetStats();
+  EXPECT_GT(atlas->GetPageCount(), 1u);
+  EXPECT_LE(atlas->GetPageCount(), GlyphAtlas::kMaxPageCount);
+  EXPECT_EQ(stats.page_addition_count, atlas->GetPageCount() - 1);
+  EXPECT_EQ(stats.rebuild_count, 0u);
+  EXPECT_GE(stats.peak_texture_bytes, atlas_context->GetTextureBytes());
+
+  // All glyphs of the last frame are found on one of the pages.
+  atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                           GlyphAtlas::Type::kAlphaBitmap, 50, atlas_context,
+                           frame);
+  ASSERT_TRUE(frame->IsFrameComplete());
+  bool uses_later_page = false;
+  for (size_t i = 0; i < kFrameCount; i++) {
+    const FrameBounds& bounds = frame->GetFrameBounds(i);
+    EXPECT_FALSE(bounds.is_placeholder);
+    EXPECT_LT(bounds.page, atlas->GetPageCount());
+    uses_later_page |= bounds.page > 0u;
+  }
+  EXPECT_TRUE(uses_later_page);
 }
 
 TEST_P(TypographerTest, TextFrameInitialBoundsArePlaceholder) {
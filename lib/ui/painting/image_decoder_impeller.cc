@@ -4,7 +4,10 @@
 
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/make_copyable.h"
@@ -74,6 +77,165 @@ bool IsWideGamut(const SkColorSpace* color_space) {
   float area = CalculateArea(rgb);
   return area > kSrgbGamutArea;
 }
+
+// The number of rows decoded at a time by the streaming decode path. This
+// bounds the size of the decode staging buffer.
+static constexpr int kStreamingDecodeRowsPerBatch = 32;
+
+/**
+ *  Area-averages rows of 32-bit pixels streamed top to bottom into a
+ *  destination pixmap that is no larger than the source in either dimension.
+ *  Channels are filtered independently, so any 8-bit-per-channel layout
+ *  works. Premultiplied pixels average correctly.
+ */
+class RowDownsampler {
+ public:
+  RowDownsampler(SkISize src_size, const SkPixmap& dst)
+      : dst_(dst),
+        columns_(ComputeSpans(src_size.width(), dst.width())),
+        rows_(ComputeSpans(src_size.height(), dst.height())),
+        filtered_row_(dst.width() * kChannels),
+        accumulator_(dst.width() * kChannels) {
+    FML_DCHECK(dst.info().bytesPerPixel() == kChannels);
+  }
+
+  bool AddRows(const SkPixmap& rows) {
+    if (rows.width() != static_cast<int>(columns_.size()) ||
+        src_row_ + rows.height() > static_cast<int>(rows_.size())) {
+      return false;
+    }
+    for (int y = 0; y < rows.height(); y++) {
+      FilterRow(static_cast<const uint8_t*>(rows.addr(0, y)));
+      const auto& span = rows_[src_row_++];
+      Accumulate(span.first_weight);
+      if (span.completes_first) {
+        FlushRow();
+        Accumulate(span.second_weight);
+      }
+    }
+    return true;
+  }
+
+  bool IsComplete() const { return dst_row_ == dst_.height(); }
+
+ private:
+  static constexpr int kChannels = 4;
+
+  // How a single source row or column maps onto destination rows or
+  // columns. Because the destination is never larger than the source, a
+  // source pixel covers at most two destination pixels. Weights are the
+  // fraction of a destination pixel covered.
+  struct Span {
+    int first = 0;
+    float first_weight = 0.0f;
+    float second_weight = 0.0f;
+    bool completes_first = false;
+  };
+
+  static std::vector<Span> ComputeSpans(int src, int dst) {
+    // Work in units of 1/src of a destination pixel to stay exact.
+    std::vector<Span> spans(src);
+    const float scale = 1.0f / src;
+    for (int i = 0; i < src; i++) {
+      const int64_t start = static_cast<int64_t>(i) * dst;
+      const int64_t end = start + dst;
+      auto& span = spans[i];
+      span.first = static_cast<int>(start / src);
+      const int64_t boundary = static_cast<int64_t>(span.first + 1) * src;
+      span.completes_first = end >= boundary;
+      span.first_weight = (std::min(end, boundary) - start) * scale;
+      span.second_weight = std::max<int64_t>(end - boundary, 0) * scale;
+    }
+    return spans;
+  }
+
+  void FilterRow(const uint8_t* src) {
+    std::fill(filtered_row_.begin(), filtered_row_.end(), 0.0f);
+    for (size_t x = 0; x < columns_.size(); x++, src += kChannels) {
+      const auto& span = columns_[x];
+      float* first = &filtered_row_[span.first * kChannels];
+      for (int c = 0; c < kChannels; c++) {
+        first[c] += span.first_weight * src[c];
+      }
+      if (span.second_weight > 0.0f) {
+        float* second = first + kChannels;
+        for (int c = 0; c < kChannels; c++) {
+          second[c] += span.second_weight * src[c];
+        }
+      }
+    }
+  }
+
+  void Accumulate(float weight) {
+    if (weight <= 0.0f) {
+      return;
+    }
+    for (size_t i = 0; i < accumulator_.size(); i++) {
+      accumulator_[i] += weight * filtered_row_[i];
+    }
+  }
+
+  void FlushRow() {
+    FML_DCHECK(dst_row_ < dst_.height());
+    auto* dst = static_cast<uint8_t*>(dst_.writable_addr(0, dst_row_++));
+    for (size_t i = 0; i < accumulator_.size(); i++) {
+      dst[i] = static_cast<uint8_t>(
+          std::clamp(accumulator_[i] + 0.5f, 0.0f, 255.0f));
+    }
+    std::fill(accumulator_.begin(), accumulator_.end(), 0.0f);
+  }
+
+  const SkPixmap dst_;
+  const std::vector<Span> columns_;
+  const std::vector<Span> rows_;
+  std::vector<float> filtered_row_;
+  std::vector<float> accumulator_;
+  int src_row_ = 0;
+  int dst_row_ = 0;
+};
+
+/**
+ *  Decodes the image in batches of rows and downsamples each batch straight
+ *  into a device buffer of the target size. Unlike decoding the whole image
+ *  and then scaling it, the full size image is never resident in memory.
+ *  Returns std::nullopt if the image can't be decoded this way.
+ */
+std::optional<DecompressResult> StreamingDecodeScale(
+    ImageDescriptor* descriptor,
+    const SkImageInfo& decode_info,
+    SkISize target_size,
+    const std::shared_ptr<impeller::Allocator>& allocator) {
+  TRACE_EVENT0("impeller", "StreamingDecodeScale");
+  auto scaled_allocator = std::make_shared<ImpellerAllocator>(allocator);
+  auto scaled_bitmap = std::make_shared<SkBitmap>();
+  scaled_bitmap->setInfo(decode_info.makeDimensions(target_size));
+  if (!scaled_bitmap->tryAllocPixels(scaled_allocator.get())) {
+    return std::nullopt;
+  }
+
+  RowDownsampler downsampler(decode_info.dimensions(),
+                             scaled_bitmap->pixmap());
+  const bool decoded = descriptor->get_row_batches(
+      decode_info, kStreamingDecodeRowsPerBatch,
+      [&downsampler](const SkPixmap& rows, int first_row) {
+        return downsampler.AddRows(rows);
+      });
+  if (!decoded || !downsampler.IsComplete()) {
+    return std::nullopt;
+  }
+  scaled_bitmap->setImmutable();
+
+  std::shared_ptr<impeller::DeviceBuffer> buffer =
+      scaled_allocator->GetDeviceBuffer();
+  if (!buffer) {
+    return std::nullopt;
+  }
+  buffer->Flush();
+
+  return DecompressResult{.device_buffer = std::move(buffer),
+                          .sk_bitmap = scaled_bitmap,
+                          .image_info = scaled_bitmap->info()};
+}
 }  // namespace
 
 ImageDecoderImpeller::ImageDecoderImpeller(
@@ -114,7 +276,8 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     SkISize target_size,
     impeller::ISize max_texture_size,
     bool supports_wide_gamut,
-    const std::shared_ptr<impeller::Allocator>& allocator) {
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    bool allow_streaming_decode) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     std::string decode_error("Invalid descriptor (should never happen)");
@@ -172,6 +335,26 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     return DecompressResult{.decode_error = decode_error};
   }
 
+  const bool exceeds_max_texture_size =
+      source_size.width() > max_texture_size.width ||
+      source_size.height() > max_texture_size.height;
+
+  // If the image will have to be resized on the CPU anyway, try to decode it
+  // in batches and resize each batch as it is decoded. This avoids the full
+  // size intermediate along with the second pass over it.
+  if (allow_streaming_decode && exceeds_max_texture_size &&
+      descriptor->is_compressed() && !target_size.isEmpty() &&
+      image_info.colorType() == kRGBA_8888_SkColorType &&
+      alpha_type != SkAlphaType::kUnpremul_SkAlphaType &&
+      decode_size.width() >= target_size.width() &&
+      decode_size.height() >= target_size.height()) {
+    auto result = StreamingDecodeScale(descriptor, image_info, target_size,
+                                       allocator);
+    if (result.has_value()) {
+      return std::move(result.value());
+    }
+  }
+
   auto bitmap = std::make_shared<SkBitmap>();
   bitmap->setInfo(image_info);
   auto bitmap_allocator = std::make_shared<ImpellerAllocator>(allocator);
@@ -237,8 +420,7 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
           ? std::nullopt
           : std::optional<SkImageInfo>(image_info.makeDimensions(target_size));
 
-  if (source_size.width() > max_texture_size.width ||
-      source_size.height() > max_texture_size.height) {
+  if (exceeds_max_texture_size) {
     //----------------------------------------------------------------------------
     /// 2. If the decoded image isn't the requested target size and the src size
     ///    exceeds the device max texture size, perform a slow CPU reisze.
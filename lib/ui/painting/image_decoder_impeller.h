@@ -63,12 +63,19 @@ class ImageDecoderImpeller final : public ImageDecoder {
               uint32_t target_height,
               const ImageResult& result) override;
 
+  /// @brief Decode the image into a host visible device buffer.
+  ///
+  /// @param allow_streaming_decode If the image must be resized on the CPU,
+  ///                               whether it may be decoded and resized in
+  ///                               batches of rows instead of being fully
+  ///                               decoded first.
   static DecompressResult DecompressTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
       impeller::ISize max_texture_size,
       bool supports_wide_gamut,
-      const std::shared_ptr<impeller::Allocator>& allocator);
+      const std::shared_ptr<impeller::Allocator>& allocator,
+      bool allow_streaming_decode = true);
 
   /// @brief Create a device private texture from the provided host buffer.
   ///
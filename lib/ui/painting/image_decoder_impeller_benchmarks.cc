@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/impeller/core/allocator.h"
+#include "flutter/impeller/core/device_buffer.h"
+#include "flutter/lib/ui/painting/image_decoder_impeller.h"
+#include "flutter/lib/ui/painting/image_descriptor.h"
+#include "flutter/lib/ui/painting/image_generator_registry.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
+
+namespace flutter {
+
+namespace {
+
+struct AllocationStats {
+  size_t live_bytes = 0u;
+  size_t peak_bytes = 0u;
+};
+
+class BenchmarkDeviceBuffer : public impeller::DeviceBuffer {
+ public:
+  BenchmarkDeviceBuffer(impeller::DeviceBufferDescriptor desc,
+                        std::shared_ptr<AllocationStats> stats)
+      : DeviceBuffer(desc),
+        stats_(std::move(stats)),
+        bytes_(static_cast<uint8_t*>(malloc(desc.size))) {
+    stats_->live_bytes += desc.size;
+    stats_->peak_bytes = std::max(stats_->peak_bytes, stats_->live_bytes);
+  }
+
+  ~BenchmarkDeviceBuffer() override {
+    stats_->live_bytes -= desc_.size;
+    free(bytes_);
+  }
+
+ private:
+  std::shared_ptr<AllocationStats> stats_;
+  uint8_t* bytes_;
+
+  bool SetLabel(std::string_view label) override { return true; }
+
+  bool SetLabel(std::string_view label, impeller::Range range) override {
+    return true;
+  }
+
+  uint8_t* OnGetContents() const override { return bytes_; }
+
+  bool OnCopyHostBuffer(const uint8_t* source,
+                        impeller::Range source_range,
+                        size_t offset) override {
+    memcpy(bytes_ + offset, source + source_range.offset,
+           source_range.length);
+    return true;
+  }
+};
+
+class BenchmarkAllocator : public impeller::Allocator {
+ public:
+  explicit BenchmarkAllocator(std::shared_ptr<AllocationStats> stats)
+      : stats_(std::move(stats)) {}
+
+ private:
+  std::shared_ptr<AllocationStats> stats_;
+
+  impeller::ISize GetMaxTextureSizeSupported() const override {
+    return impeller::ISize{kMaxTextureSize, kMaxTextureSize};
+  }
+
+  std::shared_ptr<impeller::DeviceBuffer> OnCreateBuffer(
+      const impeller::DeviceBufferDescriptor& desc) override {
+    return std::make_shared<BenchmarkDeviceBuffer>(desc, stats_);
+  }
+
+  std::shared_ptr<impeller::Texture> OnCreateTexture(
+      const impeller::TextureDescriptor& desc) override {
+    return nullptr;
+  }
+
+  static constexpr int64_t kMaxTextureSize = 1024;
+};
+
+// A photo sized image with enough detail that the encoder can't trivially
+// compress it away.
+sk_sp<SkData> CreateEncodedImage(int width, int height) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeN32Premul(width, height));
+  for (int y = 0; y < height; y++) {
+    auto* row = bitmap.getAddr32(0, y);
+    for (int x = 0; x < width; x++) {
+      row[x] = SkColorSetARGB(0xFF, x & 0xFF, y & 0xFF, (x ^ y) & 0xFF);
+    }
+  }
+  bitmap.setImmutable();
+  return SkPngEncoder::Encode(nullptr,
+                              SkImages::RasterFromBitmap(bitmap).get(), {});
+}
+
+}  // namespace
+
+// Decodes an image larger than the max texture size, which forces a resize on
+// the CPU. Reports the peak number of bytes held in device buffers during the
+// decode in addition to the decode latency.
+static void BM_DecompressTextureOversized(benchmark::State& state,
+                                          bool allow_streaming_decode) {
+  const int width = state.range(0);
+  const int height = width * 3 / 4;
+  auto data = CreateEncodedImage(width, height);
+  FML_CHECK(data);
+
+  ImageGeneratorRegistry registry;
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      data, registry.CreateCompatibleGenerator(data));
+  auto stats = std::make_shared<AllocationStats>();
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<BenchmarkAllocator>(stats);
+  const auto max_texture_size = allocator->GetMaxTextureSizeSupported();
+
+  for (auto _ : state) {
+    auto result = ImageDecoderImpeller::DecompressTexture(
+        descriptor.get(), SkISize::Make(width / 4, height / 4),
+        max_texture_size,
+        /*supports_wide_gamut=*/false, allocator, allow_streaming_decode);
+    FML_CHECK(result.device_buffer);
+  }
+
+  state.counters["PeakDeviceBytes"] = stats->peak_bytes;
+  state.SetItemsProcessed(state.iterations() * width * height);
+}
+
+BENCHMARK_CAPTURE(BM_DecompressTextureOversized, FullDecode, false)
+    ->RangeMultiplier(2)
+    ->Range(2048, 8192)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DecompressTextureOversized, StreamingDecode, true)
+    ->RangeMultiplier(2)
+    ->Range(2048, 8192)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
@@ -14,6 +14,7 @@
 #include "flutter/lib/ui/painting/image_decoder_no_gl_unittests.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/testing/dart_isolate_runner.h"
@@ -252,6 +253,43 @@ class UnknownImageGenerator : public ImageGenerator {
   SkImageInfo info_;
 };
 
+/// An image generator that counts how many frames it has decoded.
+class CountingImageGenerator : public ImageGenerator {
+ public:
+  explicit CountingImageGenerator(std::shared_ptr<ImageGenerator> delegate)
+      : delegate_(std::move(delegate)) {}
+  ~CountingImageGenerator() = default;
+  const SkImageInfo& GetInfo() { return delegate_->GetInfo(); }
+
+  unsigned int GetFrameCount() const { return delegate_->GetFrameCount(); }
+
+  unsigned int GetPlayCount() const { return delegate_->GetPlayCount(); }
+
+  const ImageGenerator::FrameInfo GetFrameInfo(unsigned int frame_index) {
+    return delegate_->GetFrameInfo(frame_index);
+  }
+
+  SkISize GetScaledDimensions(float scale) {
+    return delegate_->GetScaledDimensions(scale);
+  }
+
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) {
+    decoded_frame_count_++;
+    return delegate_->GetPixels(info, pixels, row_bytes, frame_index,
+                                prior_frame);
+  };
+
+  int decoded_frame_count() const { return decoded_frame_count_; }
+
+ private:
+  std::shared_ptr<ImageGenerator> delegate_;
+  int decoded_frame_count_ = 0;
+};
+
 TEST_F(ImageDecoderFixtureTest, InvalidImageResultsError) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   auto thread_task_runner = CreateNewThread();
@@ -830,6 +868,94 @@ TEST(ImageDecoderTest, VerifySimpleDecoding) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+namespace {
+// Encodes a PNG whose left half is red and whose right half is blue.
+sk_sp<SkData> CreateSplitColorPNG(int width, int height) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeN32Premul(width, height));
+  bitmap.eraseColor(SK_ColorRED);
+  bitmap.erase(SK_ColorBLUE, SkIRect::MakeLTRB(width / 2, 0, width, height));
+  bitmap.setImmutable();
+  return SkPngEncoder::Encode(nullptr,
+                              SkImages::RasterFromBitmap(bitmap).get(), {});
+}
+}  // namespace
+
+TEST(ImageDecoderTest, GeneratorDecodesRowBatchesInOrder) {
+  auto data = CreateSplitColorPNG(64, 100);
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  std::vector<std::pair<int, int>> batches;
+  const auto info = generator->GetInfo().makeColorType(kRGBA_8888_SkColorType);
+  ASSERT_TRUE(generator->GetRowBatches(
+      info, 32, [&batches](const SkPixmap& rows, int first_row) {
+        EXPECT_EQ(rows.width(), 64);
+        EXPECT_EQ(rows.getColor(0, 0), SK_ColorRED);
+        EXPECT_EQ(rows.getColor(63, rows.height() - 1), SK_ColorBLUE);
+        batches.emplace_back(first_row, rows.height());
+        return true;
+      }));
+  EXPECT_EQ(batches, (std::vector<std::pair<int, int>>{
+                         {0, 32}, {32, 32}, {64, 32}, {96, 4}}));
+
+  // Decoding stops when the callback declines a batch.
+  int calls = 0;
+  EXPECT_FALSE(
+      generator->GetRowBatches(info, 32, [&calls](const SkPixmap&, int) {
+        calls++;
+        return false;
+      }));
+  EXPECT_EQ(calls, 1);
+}
+
+#if IMPELLER_SUPPORTS_RENDERING
+TEST(ImageDecoderTest, StreamingDecodeScaleMatchesFullDecode) {
+  auto data = CreateSplitColorPNG(64, 32);
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  // The source exceeds the max texture size, so it is resized on the CPU.
+  auto streamed = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(8, 4), {16, 16},
+      /*supports_wide_gamut=*/false, allocator,
+      /*allow_streaming_decode=*/true);
+  auto full = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(8, 4), {16, 16},
+      /*supports_wide_gamut=*/false, allocator,
+      /*allow_streaming_decode=*/false);
+  ASSERT_TRUE(streamed.sk_bitmap);
+  ASSERT_TRUE(full.sk_bitmap);
+  ASSERT_TRUE(streamed.device_buffer);
+  EXPECT_EQ(streamed.sk_bitmap->dimensions(), SkISize::Make(8, 4));
+  EXPECT_EQ(streamed.sk_bitmap->dimensions(), full.sk_bitmap->dimensions());
+  EXPECT_EQ(streamed.sk_bitmap->colorType(), full.sk_bitmap->colorType());
+  EXPECT_FALSE(streamed.resize_info.has_value());
+
+  // The decoded pixels live in the device buffer.
+  EXPECT_EQ(streamed.sk_bitmap->getPixels(),
+            streamed.device_buffer->OnGetContents());
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 8; x++) {
+      EXPECT_EQ(streamed.sk_bitmap->getColor(x, y),
+                x < 4 ? SK_ColorRED : SK_ColorBLUE);
+    }
+  }
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 TEST(ImageDecoderTest, ImagesWithTransparencyArePremulAlpha) {
   auto data = flutter::testing::OpenFixtureAsSkData("heart_end.png");
   ASSERT_TRUE(data);
@@ -1146,6 +1272,104 @@ TEST_F(ImageDecoderFixtureTest, NullCheckBuffer) {
   EXPECT_FALSE(allocator.allocPixelRef(nullptr));
 }
 
+TEST(ImageDecoderTest, MultiFrameDecoderDecodesEachFrameOnceIfCached) {
+  auto gif_mapping = flutter::testing::OpenFixtureAsSkData("hello_loop_2.gif");
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  auto generator = std::make_shared<CountingImageGenerator>(
+      registry.CreateCompatibleGenerator(gif_mapping));
+  auto reference_generator = std::make_shared<CountingImageGenerator>(
+      registry.CreateCompatibleGenerator(gif_mapping));
+  const int frame_count = generator->GetFrameCount();
+  ASSERT_GT(frame_count, 1);
+
+  MultiFrameDecoder decoder(generator);
+  // A decoder without a cache budget decodes every frame every time.
+  MultiFrameDecoder reference_decoder(reference_generator, /*cache_bytes=*/0);
+  EXPECT_TRUE(decoder.CachesAllFrames());
+  EXPECT_FALSE(reference_decoder.CachesAllFrames());
+
+  for (int loop = 0; loop < 2; loop++) {
+    for (int i = 0; i < frame_count; i++) {
+      auto [frame, error] = decoder.GetFrame(i);
+      auto [expected, expected_error] = reference_decoder.GetFrame(i);
+      ASSERT_TRUE(frame.has_value()) << error;
+      ASSERT_TRUE(expected.has_value()) << expected_error;
+      ASSERT_EQ(frame->computeByteSize(), expected->computeByteSize());
+      EXPECT_EQ(memcmp(frame->getPixels(), expected->getPixels(),
+                       frame->computeByteSize()),
+                0);
+    }
+  }
+
+  EXPECT_EQ(generator->decoded_frame_count(), frame_count);
+  EXPECT_EQ(reference_generator->decoded_frame_count(), frame_count * 2);
+  EXPECT_GT(decoder.GetCachedBytes(), 0u);
+  EXPECT_EQ(reference_decoder.GetCachedBytes(), 0u);
+}
+
+TEST(ImageDecoderTest, MultiFrameDecoderDecodesAhead) {
+  auto gif_mapping = flutter::testing::OpenFixtureAsSkData("hello_loop_2.gif");
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  auto generator = std::make_shared<CountingImageGenerator>(
+      registry.CreateCompatibleGenerator(gif_mapping));
+  ASSERT_GT(generator->GetFrameCount(), 1u);
+
+  MultiFrameDecoder decoder(generator, /*cache_bytes=*/0);
+  ASSERT_TRUE(decoder.GetFrame(0).first.has_value());
+  EXPECT_EQ(generator->decoded_frame_count(), 1);
+
+  EXPECT_FALSE(decoder.HasDecodedFrame(1));
+  decoder.DecodeAhead(1);
+  EXPECT_TRUE(decoder.HasDecodedFrame(1));
+  EXPECT_EQ(generator->decoded_frame_count(), 2);
+  // Decoding ahead again is a no-op.
+  decoder.DecodeAhead(1);
+  EXPECT_EQ(generator->decoded_frame_count(), 2);
+
+  // The frame decoded ahead of time is handed out without decoding again.
+  ASSERT_TRUE(decoder.GetFrame(1).first.has_value());
+  EXPECT_EQ(generator->decoded_frame_count(), 2);
+  EXPECT_FALSE(decoder.HasDecodedFrame(1));
+  EXPECT_EQ(decoder.GetCachedBytes(), 0u);
+}
+
+TEST(ImageDecoderTest, MultiFrameDecodersShareACacheBudget) {
+  auto gif_mapping = flutter::testing::OpenFixtureAsSkData("hello_loop_2.gif");
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  auto generator = registry.CreateCompatibleGenerator(gif_mapping);
+  ASSERT_TRUE(generator);
+  const SkImageInfo frame_info =
+      generator->GetInfo().makeColorType(kN32_SkColorType);
+  const size_t animation_bytes =
+      frame_info.computeMinByteSize() * generator->GetFrameCount();
+
+  // The shared budget only fits the frames of one of the animations.
+  auto budget =
+      std::make_shared<MultiFrameCacheBudget>(animation_bytes * 3 / 2);
+  auto first = std::make_unique<MultiFrameDecoder>(
+      generator, MultiFrameDecoder::kDefaultCacheBytes, budget);
+  EXPECT_TRUE(first->CachesAllFrames());
+  EXPECT_EQ(budget->GetReservedBytes(), animation_bytes);
+
+  MultiFrameDecoder second(generator, MultiFrameDecoder::kDefaultCacheBytes,
+                           budget);
+  EXPECT_FALSE(second.CachesAllFrames());
+  EXPECT_EQ(budget->GetReservedBytes(), animation_bytes);
+
+  // Destroying a decoder returns its bytes to the budget.
+  first.reset();
+  EXPECT_EQ(budget->GetReservedBytes(), 0u);
+  MultiFrameDecoder third(generator, MultiFrameDecoder::kDefaultCacheBytes,
+                          budget);
+  EXPECT_TRUE(third.CachesAllFrames());
+}
+
 }  // namespace testing
 }  // namespace flutter
 
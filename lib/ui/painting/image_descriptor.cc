@@ -131,4 +131,14 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
                                pixmap.rowBytes());
 }
 
+bool ImageDescriptor::get_row_batches(
+    const SkImageInfo& info,
+    int rows_per_batch,
+    const ImageGenerator::RowBatchCallback& callback) const {
+  if (!generator_) {
+    return false;
+  }
+  return generator_->GetRowBatches(info, rows_per_batch, callback);
+}
+
 }  // namespace flutter
@@ -110,6 +110,16 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Decodes the image in batches of rows without materializing the
+  ///         whole image at once.
+  /// @return False if the image is not compressed, its generator can't decode
+  ///         incrementally, or decoding failed.
+  /// @see    `ImageGenerator::GetRowBatches`
+  bool get_row_batches(
+      const SkImageInfo& info,
+      int rows_per_batch,
+      const ImageGenerator::RowBatchCallback& callback) const;
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/logging.h"
@@ -16,6 +17,12 @@ namespace flutter {
 
 ImageGenerator::~ImageGenerator() = default;
 
+bool ImageGenerator::GetRowBatches(const SkImageInfo& info,
+                                   int rows_per_batch,
+                                   const RowBatchCallback& callback) {
+  return false;
+}
+
 sk_sp<SkImage> ImageGenerator::GetImage() {
   SkImageInfo info = GetInfo();
 
@@ -188,6 +195,51 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return SkPixmapUtils::Orient(output_pixmap, temp_pixmap, origin);
 }
 
+bool BuiltinSkiaCodecImageGenerator::GetRowBatches(
+    const SkImageInfo& info,
+    int rows_per_batch,
+    const RowBatchCallback& callback) {
+  // Re-orienting requires the whole image. Let the caller fall back to
+  // |GetPixels| in that case.
+  if (rows_per_batch <= 0 || !callback ||
+      codec_->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return false;
+  }
+  if (codec_->startScanlineDecode(info) != SkCodec::kSuccess) {
+    return false;
+  }
+  // Interlaced and bottom-up images can't be streamed in order.
+  if (codec_->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+    return false;
+  }
+
+  const int batch_height = std::min(rows_per_batch, info.height());
+  SkBitmap batch;
+  if (!batch.tryAllocPixels(info.makeWH(info.width(), batch_height))) {
+    FML_DLOG(ERROR) << "Failed to allocate memory for a batch of "
+                    << batch_height << " rows.";
+    return false;
+  }
+
+  for (int row = 0; row < info.height(); row += batch_height) {
+    const int row_count = std::min(batch_height, info.height() - row);
+    const int decoded = codec_->getScanlines(batch.getPixels(), row_count,
+                                             batch.rowBytes());
+    if (decoded != row_count) {
+      FML_DLOG(WARNING) << "codec could only decode " << row + decoded
+                        << " of " << info.height() << " rows.";
+      return false;
+    }
+    SkPixmap rows;
+    if (!batch.pixmap().extractSubset(
+            &rows, SkIRect::MakeWH(info.width(), row_count)) ||
+        !callback(rows, row)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(std::move(data));
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 
+#include <functional>
 #include <optional>
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/codec/SkCodec.h"
@@ -135,6 +136,34 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief  Called with each batch of rows decoded by `GetRowBatches`. The
+  ///         pixmap is only valid for the duration of the call. Returning
+  ///         false stops the decode.
+  using RowBatchCallback =
+      std::function<bool(const SkPixmap& rows, int first_row)>;
+
+  /// @brief      Decode the first frame of the image top to bottom in batches
+  ///             of at most `rows_per_batch` rows. Unlike `GetPixels`, the
+  ///             full image is never resident in memory at once, which allows
+  ///             callers to consume very large images in a streaming fashion.
+  /// @param[in]  info            The desired size and color info of the
+  ///                             decoded image. As with `GetPixels`, the size
+  ///                             must be one returned by
+  ///                             `GetScaledDimensions`.
+  /// @param[in]  rows_per_batch  The maximum number of rows handed to each
+  ///                             invocation of the callback.
+  /// @param[in]  callback        Invoked with each consecutive batch of rows.
+  /// @return     True if every row was decoded and accepted by the callback.
+  ///             False if the generator does not support incremental decoding
+  ///             for this image, in which case the callback is never invoked,
+  ///             or if decoding failed part way through.
+  /// @note       The default implementation does not support incremental
+  ///             decoding. Callers must be prepared to fall back to
+  ///             `GetPixels`.
+  virtual bool GetRowBatches(const SkImageInfo& info,
+                             int rows_per_batch,
+                             const RowBatchCallback& callback);
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -212,6 +241,11 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool GetRowBatches(const SkImageInfo& info,
+                     int rows_per_batch,
+                     const RowBatchCallback& callback) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
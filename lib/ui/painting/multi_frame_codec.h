@@ -8,14 +8,18 @@
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
 
+#include <memory>
 #include <utility>
 
 namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
-  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
+  explicit MultiFrameCodec(
+      std::shared_ptr<ImageGenerator> generator,
+      size_t frame_cache_bytes = MultiFrameDecoder::kDefaultCacheBytes);
 
   ~MultiFrameCodec() override;
 
@@ -38,8 +42,8 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
-  struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+  struct State : public std::enable_shared_from_this<State> {
+    State(std::shared_ptr<ImageGenerator> generator, size_t frame_cache_bytes);
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
@@ -50,14 +54,9 @@ class MultiFrameCodec : public Codec {
     // to on the IO thread. They are not safe to access or write on the UI
     // thread.
     int nextFrameIndex_ = 0;
-    // The last decoded frame that's required to decode any subsequent frames.
-    std::optional<SkBitmap> lastRequiredFrame_;
-    // The index of the last decoded required frame.
-    int lastRequiredFrameIndex_ = -1;
-
-    // The rectangle that should be cleared if the previous frame's disposal
-    // method was kRestoreBGColor.
-    std::optional<SkIRect> restoreBGColorRect_;
+    // Composites frames in order and caches them. The frame after the one
+    // most recently handed out is decoded ahead of time on the IO thread.
+    MultiFrameDecoder decoder_;
 
     std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
         fml::WeakPtr<GrDirectContext> resourceContext,
@@ -72,7 +71,8 @@ class MultiFrameCodec : public Codec {
         fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         size_t trace_id,
-        const std::shared_ptr<impeller::Context>& impeller_context);
+        const std::shared_ptr<impeller::Context>& impeller_context,
+        const fml::RefPtr<fml::TaskRunner>& io_task_runner);
   };
 
   // Shared across the UI and IO task runners.
@@ -0,0 +1,234 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
+
+#include <sstream>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/codec/SkCodecAnimation.h"
+
+namespace flutter {
+
+static SkImageInfo GetFrameInfo(const std::shared_ptr<ImageGenerator>& gen) {
+  SkImageInfo info = gen->GetInfo().makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    info = info.makeAlphaType(kPremul_SkAlphaType);
+  }
+  return info;
+}
+
+MultiFrameCacheBudget::MultiFrameCacheBudget(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+const std::shared_ptr<MultiFrameCacheBudget>&
+MultiFrameCacheBudget::GetShared() {
+  static const std::shared_ptr<MultiFrameCacheBudget> shared =
+      std::make_shared<MultiFrameCacheBudget>(kDefaultMaxBytes);
+  return shared;
+}
+
+bool MultiFrameCacheBudget::TryReserve(size_t bytes) {
+  size_t reserved = reserved_bytes_.load(std::memory_order_relaxed);
+  do {
+    if (bytes > max_bytes_ - reserved) {
+      return false;
+    }
+  } while (!reserved_bytes_.compare_exchange_weak(reserved, reserved + bytes,
+                                                  std::memory_order_relaxed));
+  return true;
+}
+
+void MultiFrameCacheBudget::Release(size_t bytes) {
+  FML_DCHECK(reserved_bytes_.load(std::memory_order_relaxed) >= bytes);
+  reserved_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+size_t MultiFrameCacheBudget::GetReservedBytes() const {
+  return reserved_bytes_.load(std::memory_order_relaxed);
+}
+
+size_t MultiFrameDecoder::ReserveAllFrames(
+    int frame_count,
+    const SkImageInfo& info,
+    size_t cache_bytes,
+    MultiFrameCacheBudget* shared_budget) {
+  if (frame_count <= 0 ||
+      info.computeMinByteSize() >
+          cache_bytes / static_cast<size_t>(frame_count)) {
+    return 0u;
+  }
+  const size_t bytes =
+      info.computeMinByteSize() * static_cast<size_t>(frame_count);
+  if (bytes == 0u || (shared_budget && !shared_budget->TryReserve(bytes))) {
+    return 0u;
+  }
+  return bytes;
+}
+
+MultiFrameDecoder::MultiFrameDecoder(
+    std::shared_ptr<ImageGenerator> generator,
+    size_t cache_bytes,
+    std::shared_ptr<MultiFrameCacheBudget> shared_budget)
+    : generator_(std::move(generator)),
+      frame_count_(generator_->GetFrameCount()),
+      info_(GetFrameInfo(generator_)),
+      shared_budget_(std::move(shared_budget)),
+      reserved_bytes_(ReserveAllFrames(frame_count_,
+                                       info_,
+                                       cache_bytes,
+                                       shared_budget_.get())),
+      cache_all_frames_(reserved_bytes_ > 0u) {
+  if (cache_all_frames_) {
+    cached_frames_.resize(frame_count_);
+  }
+}
+
+MultiFrameDecoder::~MultiFrameDecoder() {
+  if (shared_budget_ && reserved_bytes_ > 0u) {
+    shared_budget_->Release(reserved_bytes_);
+  }
+}
+
+bool MultiFrameDecoder::CachesAllFrames() const {
+  return cache_all_frames_;
+}
+
+bool MultiFrameDecoder::HasDecodedFrame(int frame_index) const {
+  if (ahead_frame_index_ == frame_index) {
+    return true;
+  }
+  return cache_all_frames_ && frame_index >= 0 &&
+         frame_index < frame_count_ &&
+         cached_frames_[frame_index].has_value();
+}
+
+size_t MultiFrameDecoder::GetCachedBytes() const {
+  size_t bytes = 0u;
+  for (const auto& frame : cached_frames_) {
+    if (frame.has_value()) {
+      bytes += frame->computeByteSize();
+    }
+  }
+  if (ahead_frame_index_.has_value() && ahead_frame_.first.has_value()) {
+    bytes += ahead_frame_.first->computeByteSize();
+  }
+  return bytes;
+}
+
+MultiFrameDecoder::FrameResult MultiFrameDecoder::GetFrame(int frame_index) {
+  if (ahead_frame_index_ == frame_index) {
+    ahead_frame_index_.reset();
+    return std::exchange(ahead_frame_, {});
+  }
+  if (cache_all_frames_ && cached_frames_[frame_index].has_value()) {
+    return {cached_frames_[frame_index], std::string()};
+  }
+  return DecodeFrame(frame_index);
+}
+
+void MultiFrameDecoder::DecodeAhead(int frame_index) {
+  if (frame_index < 0 || frame_index >= frame_count_ ||
+      HasDecodedFrame(frame_index)) {
+    return;
+  }
+  FrameResult result = DecodeFrame(frame_index);
+  // Successfully decoded frames are already retained in the cache.
+  if (!HasDecodedFrame(frame_index)) {
+    ahead_frame_index_ = frame_index;
+    ahead_frame_ = std::move(result);
+  }
+}
+
+MultiFrameDecoder::FrameResult MultiFrameDecoder::DecodeFrame(
+    int frame_index) {
+  TRACE_EVENT1("flutter", "MultiFrameDecoder::DecodeFrame", "frame",
+               std::to_string(frame_index).c_str());
+  SkBitmap bitmap = SkBitmap();
+  if (!bitmap.tryAllocPixels(info_)) {
+    std::ostringstream ostr;
+    ostr << "Failed to allocate memory for bitmap of size "
+         << info_.computeMinByteSize() << "B";
+    std::string decode_error = ostr.str();
+    FML_LOG(ERROR) << decode_error;
+    return {std::nullopt, decode_error};
+  }
+
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frame_index);
+
+  const int requiredFrameIndex =
+      frameInfo.required_frame.value_or(SkCodec::kNoFrame);
+
+  if (requiredFrameIndex != SkCodec::kNoFrame) {
+    // We are here when the frame said |disposal_method| is
+    // `DisposalMethod::kKeep` or `DisposalMethod::kRestorePrevious` and
+    // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
+    if (!last_required_frame_.has_value()) {
+      FML_DLOG(INFO)
+          << "Frame " << frame_index << " depends on frame "
+          << requiredFrameIndex
+          << " and no required frames are cached. Using blank slate instead.";
+    } else {
+      // Copy the previous frame's output buffer into the current frame as the
+      // starting point.
+      bitmap.writePixels(last_required_frame_->pixmap());
+      if (restore_bg_color_rect_.has_value()) {
+        bitmap.erase(SK_ColorTRANSPARENT, restore_bg_color_rect_.value());
+      }
+    }
+  }
+
+  // Write the new frame to the output buffer. The bitmap pixels as supplied
+  // are already set in accordance with the previous frame's disposal policy.
+  if (!generator_->GetPixels(info_, bitmap.getPixels(), bitmap.rowBytes(),
+                             frame_index, requiredFrameIndex)) {
+    std::ostringstream ostr;
+    ostr << "Could not getPixels for frame " << frame_index;
+    std::string decode_error = ostr.str();
+    FML_LOG(ERROR) << decode_error;
+    return {std::nullopt, decode_error};
+  }
+  // The pixels are shared with the cache and the images created from them.
+  bitmap.setImmutable();
+
+  const bool keep_current_frame =
+      frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep;
+  const bool restore_previous_frame =
+      frameInfo.disposal_method ==
+      SkCodecAnimation::DisposalMethod::kRestorePrevious;
+  const bool previous_frame_available = last_required_frame_.has_value();
+
+  // Store the current frame in `last_required_frame_` if the frame's disposal
+  // method indicates we should do so.
+  // * When the disposal method is "Keep", the stored frame should always be
+  //   overwritten with the new frame we just crafted.
+  // * When the disposal method is "RestorePrevious", the previously stored
+  //   frame should be retained and used as the backdrop for the next frame
+  //   again. If there isn't already a stored frame, that means we haven't
+  //   rendered any frames yet! When this happens, we just fall back to "Keep"
+  //   behavior and store the current frame as the backdrop of the next frame.
+
+  if (keep_current_frame ||
+      (previous_frame_available && !restore_previous_frame)) {
+    // Replace the stored frame. The `last_required_frame_` will get used as
+    // the starting backdrop for the next frame.
+    last_required_frame_ = bitmap;
+  }
+
+  if (frameInfo.disposal_method ==
+      SkCodecAnimation::DisposalMethod::kRestoreBGColor) {
+    restore_bg_color_rect_ = frameInfo.disposal_rect;
+  } else {
+    restore_bg_color_rect_.reset();
+  }
+
+  if (cache_all_frames_) {
+    cached_frames_[frame_index] = bitmap;
+  }
+  return {std::move(bitmap), std::string()};
+}
+
+}  // namespace flutter
@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_DECODER_H_
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A byte budget shared by the frame caches of all of the
+///             |MultiFrameDecoder|s that use it.
+///
+///             The per decoder budget alone would let a page with many
+///             animated images pin hundreds of megabytes of decoded frames.
+///             Decoders reserve the bytes of all of their frames from the
+///             shared budget when they are created and release them when they
+///             are destroyed. A decoder that cannot reserve its frames keeps
+///             only the frame it decodes ahead of time.
+///
+///             This class is thread safe.
+///
+class MultiFrameCacheBudget {
+ public:
+  /// The default budget for the decoded frames of all animations.
+  static constexpr size_t kDefaultMaxBytes = 128u * 1024u * 1024u;
+
+  explicit MultiFrameCacheBudget(size_t max_bytes);
+
+  //----------------------------------------------------------------------------
+  /// @return     The budget shared by all decoders in the process.
+  ///
+  static const std::shared_ptr<MultiFrameCacheBudget>& GetShared();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reserve |bytes| if that does not exceed the budget.
+  ///
+  /// @return     Whether the bytes were reserved.
+  ///
+  bool TryReserve(size_t bytes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Return |bytes| previously reserved with `TryReserve`.
+  ///
+  void Release(size_t bytes);
+
+  size_t GetReservedBytes() const;
+
+ private:
+  const size_t max_bytes_;
+  std::atomic<size_t> reserved_bytes_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MultiFrameCacheBudget);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Decodes the frames of an animated image on the CPU and caches
+///             them within a byte budget.
+///
+///             Frames are composited in order since a frame may be drawn on
+///             top of one of its predecessors depending on their disposal
+///             methods. If every frame of the animation fits in the budget,
+///             each frame is decoded exactly once and later loops of the
+///             animation are served from the cache. Otherwise, only the frame
+///             decoded ahead of time via `DecodeAhead` is retained. Caching
+///             all frames also requires them to fit in the remainder of the
+///             |MultiFrameCacheBudget| shared with other decoders.
+///
+///             This class is not thread safe. It is meant to be used on the IO
+///             task runner.
+///
+class MultiFrameDecoder {
+ public:
+  /// The default budget for the decoded frames of a single animation.
+  static constexpr size_t kDefaultCacheBytes = 32u * 1024u * 1024u;
+
+  using FrameResult = std::pair<std::optional<SkBitmap>, std::string>;
+
+  explicit MultiFrameDecoder(
+      std::shared_ptr<ImageGenerator> generator,
+      size_t cache_bytes = kDefaultCacheBytes,
+      std::shared_ptr<MultiFrameCacheBudget> shared_budget =
+          MultiFrameCacheBudget::GetShared());
+
+  ~MultiFrameDecoder();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the fully composited bitmap for a frame.
+  ///
+  /// @param[in]  frame_index  The frame to get. This must either be the frame
+  ///                          following the one previously requested or 0.
+  ///
+  /// @return     The immutable bitmap, or an error message if the frame could
+  ///             not be decoded.
+  ///
+  FrameResult GetFrame(int frame_index);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Decode the frame that is going to be requested next so that
+  ///             the following call to `GetFrame` does not have to wait on the
+  ///             decoder. Does nothing if the frame is already cached.
+  ///
+  void DecodeAhead(int frame_index);
+
+  //----------------------------------------------------------------------------
+  /// @return     Whether the decoded frames of the entire animation fit in the
+  ///             cache budget.
+  ///
+  bool CachesAllFrames() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     Whether `GetFrame` can return the frame without decoding it.
+  ///
+  bool HasDecodedFrame(int frame_index) const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of bytes of decoded frames currently retained.
+  ///
+  size_t GetCachedBytes() const;
+
+ private:
+  const std::shared_ptr<ImageGenerator> generator_;
+  const int frame_count_;
+  const SkImageInfo info_;
+  const std::shared_ptr<MultiFrameCacheBudget> shared_budget_;
+  // The bytes reserved from `shared_budget_` for all frames, or 0.
+  const size_t reserved_bytes_;
+  const bool cache_all_frames_;
+
+  // Frames that have been decoded, indexed by frame. Only populated if
+  // `cache_all_frames_`.
+  std::vector<std::optional<SkBitmap>> cached_frames_;
+  // The frame decoded by `DecodeAhead` that hasn't been requested yet.
+  std::optional<int> ahead_frame_index_;
+  FrameResult ahead_frame_;
+
+  // The last decoded frame that's required to decode any subsequent frames.
+  std::optional<SkBitmap> last_required_frame_;
+  // The rectangle that should be cleared if the previous frame's disposal
+  // method was kRestoreBGColor.
+  std::optional<SkIRect> restore_bg_color_rect_;
+
+  static size_t ReserveAllFrames(int frame_count,
+                                 const SkImageInfo& info,
+                                 size_t cache_bytes,
+                                 MultiFrameCacheBudget* shared_budget);
+
+  FrameResult DecodeFrame(int frame_index);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MultiFrameDecoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_DECODER_H_
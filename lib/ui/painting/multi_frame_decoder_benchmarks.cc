@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/lib/ui/painting/image_generator_registry.h"
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+
+// Plays an animation from one of the fixtures for a number of loops the way
+// MultiFrameCodec does: each frame is requested in turn and the frame after it
+// is decoded ahead of time.
+static void BM_MultiFrameDecoderPlayback(benchmark::State& state,
+                                         const char* fixture_name,
+                                         size_t cache_bytes) {
+  auto data = testing::OpenFixtureAsSkData(fixture_name);
+  FML_CHECK(data) << fixture_name;
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  FML_CHECK(generator) << fixture_name;
+  const int frame_count = generator->GetFrameCount();
+  const int loops = state.range(0);
+
+  for (auto _ : state) {
+    MultiFrameDecoder decoder(generator, cache_bytes);
+    for (int loop = 0; loop < loops; loop++) {
+      for (int i = 0; i < frame_count; i++) {
+        auto frame = decoder.GetFrame(i);
+        benchmark::DoNotOptimize(frame);
+        decoder.DecodeAhead((i + 1) % frame_count);
+      }
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * loops * frame_count);
+}
+
+#define MULTI_FRAME_DECODER_BENCHMARK(name, fixture)                   \
+  BENCHMARK_CAPTURE(BM_MultiFrameDecoderPlayback, name##_Uncached,     \
+                    fixture, 0u)                                       \
+      ->Arg(1)                                                         \
+      ->Arg(4)                                                         \
+      ->Unit(benchmark::kMicrosecond);                                 \
+  BENCHMARK_CAPTURE(BM_MultiFrameDecoderPlayback, name##_Cached,       \
+                    fixture, MultiFrameDecoder::kDefaultCacheBytes)    \
+      ->Arg(1)                                                         \
+      ->Arg(4)                                                         \
+      ->Unit(benchmark::kMicrosecond);
+
+MULTI_FRAME_DECODER_BENCHMARK(HelloLoopGif, "hello_loop_2.gif")
+MULTI_FRAME_DECODER_BENCHMARK(HelloLoopWebp, "hello_loop_2.webp")
+MULTI_FRAME_DECODER_BENCHMARK(FourFrameWithReuseGif,
+                              "four_frame_with_reuse.gif")
+MULTI_FRAME_DECODER_BENCHMARK(HeartWebp, "heart.webp")
+MULTI_FRAME_DECODER_BENCHMARK(AlphaAnimatedApng, "alpha_animated.apng")
+MULTI_FRAME_DECODER_BENCHMARK(DisposeOpBackgroundApng,
+                              "dispose_op_background.apng")
+
+}  // namespace flutter
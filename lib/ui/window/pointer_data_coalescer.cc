@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/pointer_data_coalescer.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+bool IsMovement(const PointerData& data) {
+  if (data.signal_kind != PointerData::SignalKind::kNone ||
+      data.synthesized) {
+    return false;
+  }
+  switch (data.change) {
+    case PointerData::Change::kHover:
+    case PointerData::Change::kMove:
+    case PointerData::Change::kPanZoomUpdate:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether |next| continues the run of movement samples ending in |last|.
+bool ContinuesRun(const PointerData& last, const PointerData& next) {
+  return last.change == next.change && last.kind == next.kind &&
+         last.buttons == next.buttons && last.view_id == next.view_id;
+}
+
+}  // namespace
+
+PointerDataCoalescer::PointerDataCoalescer(size_t samples_per_run)
+    : samples_per_run_(samples_per_run) {
+  FML_DCHECK(samples_per_run_ > 0);
+}
+
+PointerDataCoalescer::~PointerDataCoalescer() = default;
+
+void PointerDataCoalescer::Add(const PointerDataPacket& packet) {
+  size_t length = packet.GetLength();
+  pending_.reserve(pending_.size() + length);
+  for (size_t i = 0; i < length; i++) {
+    pending_.push_back(packet.GetPointerData(i));
+  }
+}
+
+bool PointerDataCoalescer::IsEmpty() const {
+  return pending_.empty();
+}
+
+size_t PointerDataCoalescer::GetPendingCount() const {
+  return pending_.size();
+}
+
+std::unique_ptr<PointerDataPacket> PointerDataCoalescer::Take() {
+  TRACE_EVENT0("flutter", "PointerDataCoalescer::Take");
+  keep_.assign(pending_.size(), true);
+  for (size_t i = 0; i < pending_.size(); i++) {
+    const PointerData& data = pending_[i];
+    auto found = open_runs_.find(data.device);
+    if (found != open_runs_.end()) {
+      std::vector<size_t>& run = found->second;
+      if (!run.empty() && IsMovement(data) &&
+          ContinuesRun(pending_[run.back()], data)) {
+        run.push_back(i);
+        continue;
+      }
+      CloseRun(run);
+    }
+    if (IsMovement(data)) {
+      open_runs_[data.device].push_back(i);
+    }
+  }
+  size_t count = pending_.size();
+  for (auto& [device, run] : open_runs_) {
+    CloseRun(run);
+  }
+  for (bool keep : keep_) {
+    if (!keep) {
+      count--;
+    }
+  }
+
+  auto packet = std::make_unique<PointerDataPacket>(count);
+  size_t index = 0;
+  for (size_t i = 0; i < pending_.size(); i++) {
+    if (keep_[i]) {
+      packet->SetPointerData(index++, pending_[i]);
+    }
+  }
+  FML_DCHECK(index == count);
+  pending_.clear();
+  return packet;
+}
+
+void PointerDataCoalescer::CloseRun(std::vector<size_t>& run) {
+  size_t length = run.size();
+  if (length > samples_per_run_) {
+    // Keeps the samples at the ends of evenly sized slices of the run, the
+    // last of which is the end of the run itself.
+    size_t next_kept = 0;
+    for (size_t slice = 1; slice <= samples_per_run_; slice++) {
+      size_t slice_end = slice * length / samples_per_run_ - 1;
+      for (; next_kept < slice_end; next_kept++) {
+        keep_[run[next_kept]] = false;
+      }
+      next_kept = slice_end + 1;
+    }
+  }
+  run.clear();
+}
+
+}  // namespace flutter
@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_POINTER_DATA_COALESCER_H_
+#define FLUTTER_LIB_UI_WINDOW_POINTER_DATA_COALESCER_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Accumulates raw pointer data packets from the platform and merges
+/// consecutive movement samples of each device.
+///
+/// High rate input devices (e.g. 1000 Hz mice and styluses) deliver many more
+/// samples per frame than the framework can make use of. A run of consecutive
+/// move, hover or pan/zoom update events of a device, with nothing else
+/// reported for that device in between, is reduced to at most
+/// `samples_per_run` samples. The samples that are kept are evenly spaced
+/// across the run and always include its last sample, so that the framework's
+/// velocity tracking and resampling still see the history of the gesture.
+///
+/// All other events, and the order of the kept events, are left untouched.
+/// Since the deltas of the samples are computed later on by
+/// `PointerDataPacketConverter`, the dropped samples don't need to be folded
+/// into the ones that are kept.
+///
+class PointerDataCoalescer {
+ public:
+  /// The number of samples kept per run by default. At 60 Hz, this keeps
+  /// roughly one sample every 4ms of a 1000 Hz stream.
+  static constexpr size_t kDefaultSamplesPerRun = 4;
+
+  explicit PointerDataCoalescer(size_t samples_per_run = kDefaultSamplesPerRun);
+
+  ~PointerDataCoalescer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends the events of a raw packet to the pending events.
+  ///
+  void Add(const PointerDataPacket& packet);
+
+  //----------------------------------------------------------------------------
+  /// @return     Whether there are no pending events.
+  ///
+  bool IsEmpty() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of pending events before coalescing.
+  ///
+  size_t GetPendingCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Coalesces the pending events into a single packet and clears
+  ///             them.
+  ///
+  std::unique_ptr<PointerDataPacket> Take();
+
+ private:
+  const size_t samples_per_run_;
+  std::vector<PointerData> pending_;
+
+  // Scratch space reused by `Take` to avoid allocating on every frame.
+  std::vector<bool> keep_;
+  std::map<int64_t, std::vector<size_t>> open_runs_;
+
+  void CloseRun(std::vector<size_t>& run);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerDataCoalescer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_POINTER_DATA_COALESCER_H_
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/pointer_data_coalescer.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+PointerData CreatePointerData(PointerData::Change change,
+                              int64_t device,
+                              int64_t time_stamp,
+                              double x) {
+  PointerData data;
+  memset(&data, 0, sizeof(PointerData));
+  data.time_stamp = time_stamp;
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kMouse;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = device;
+  data.physical_x = x;
+  data.buttons = change == PointerData::Change::kHover ? 0 : 1;
+  return data;
+}
+
+std::unique_ptr<PointerDataPacket> CreatePacket(
+    const std::vector<PointerData>& data) {
+  auto packet = std::make_unique<PointerDataPacket>(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    packet->SetPointerData(i, data[i]);
+  }
+  return packet;
+}
+
+std::vector<int64_t> GetTimeStamps(const PointerDataPacket& packet) {
+  std::vector<int64_t> time_stamps;
+  for (size_t i = 0; i < packet.GetLength(); i++) {
+    time_stamps.push_back(packet.GetPointerData(i).time_stamp);
+  }
+  return time_stamps;
+}
+
+}  // namespace
+
+TEST(PointerDataCoalescerTest, KeepsShortRuns) {
+  PointerDataCoalescer coalescer(4);
+  coalescer.Add(*CreatePacket({
+      CreatePointerData(PointerData::Change::kHover, 0, 1, 1.0),
+      CreatePointerData(PointerData::Change::kHover, 0, 2, 2.0),
+      CreatePointerData(PointerData::Change::kHover, 0, 3, 3.0),
+  }));
+  EXPECT_EQ(coalescer.GetPendingCount(), 3u);
+
+  auto packet = coalescer.Take();
+  EXPECT_EQ(GetTimeStamps(*packet), (std::vector<int64_t>{1, 2, 3}));
+  EXPECT_TRUE(coalescer.IsEmpty());
+}
+
+TEST(PointerDataCoalescerTest, KeepsEvenlySpacedSamplesOfLongRuns) {
+  PointerDataCoalescer coalescer(4);
+  // Delivered one sample per packet, as with a 1000 Hz mouse.
+  for (int64_t i = 0; i < 16; i++) {
+    coalescer.Add(*CreatePacket({
+        CreatePointerData(PointerData::Change::kHover, 0, i, i),
+    }));
+  }
+
+  auto packet = coalescer.Take();
+  EXPECT_EQ(GetTimeStamps(*packet), (std::vector<int64_t>{3, 7, 11, 15}));
+  // The last sample is the most recent position.
+  EXPECT_EQ(packet->GetPointerData(3).physical_x, 15.0);
+}
+
+TEST(PointerDataCoalescerTest, DoesNotCoalesceAcrossOtherEvents) {
+  PointerDataCoalescer coalescer(1);
+  coalescer.Add(*CreatePacket({
+      CreatePointerData(PointerData::Change::kHover, 0, 1, 1.0),
+      CreatePointerData(PointerData::Change::kHover, 0, 2, 2.0),
+      CreatePointerData(PointerData::Change::kDown, 0, 3, 2.0),
+      CreatePointerData(PointerData::Change::kMove, 0, 4, 3.0),
+      CreatePointerData(PointerData::Change::kMove, 0, 5, 4.0),
+      CreatePointerData(PointerData::Change::kUp, 0, 6, 4.0),
+  }));
+
+  auto packet = coalescer.Take();
+  EXPECT_EQ(GetTimeStamps(*packet), (std::vector<int64_t>{2, 3, 5, 6}));
+}
+
+TEST(PointerDataCoalescerTest, CoalescesDevicesIndependently) {
+  PointerDataCoalescer coalescer(1);
+  coalescer.Add(*CreatePacket({
+      CreatePointerData(PointerData::Change::kMove, 0, 1, 1.0),
+      CreatePointerData(PointerData::Change::kMove, 1, 2, 1.0),
+      CreatePointerData(PointerData::Change::kMove, 0, 3, 2.0),
+      CreatePointerData(PointerData::Change::kUp, 1, 4, 1.0),
+      CreatePointerData(PointerData::Change::kMove, 0, 5, 3.0),
+  }));
+
+  auto packet = coalescer.Take();
+  // Device 1 lifting doesn't interrupt the run of device 0.
+  EXPECT_EQ(GetTimeStamps(*packet), (std::vector<int64_t>{2, 4, 5}));
+}
+
+TEST(PointerDataCoalescerTest, DoesNotCoalesceSynthesizedOrSignalEvents) {
+  PointerDataCoalescer coalescer(1);
+  PointerData synthesized =
+      CreatePointerData(PointerData::Change::kHover, 0, 2, 2.0);
+  synthesized.synthesized = 1;
+  PointerData scroll =
+      CreatePointerData(PointerData::Change::kHover, 0, 3, 2.0);
+  scroll.signal_kind = PointerData::SignalKind::kScroll;
+  coalescer.Add(*CreatePacket({
+      CreatePointerData(PointerData::Change::kHover, 0, 1, 1.0),
+      synthesized,
+      scroll,
+  }));
+
+  auto packet = coalescer.Take();
+  EXPECT_EQ(GetTimeStamps(*packet), (std::vector<int64_t>{1, 2, 3}));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -18,23 +18,20 @@ PointerDataPacketConverter::~PointerDataPacketConverter() = default;
 
 std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
     const PointerDataPacket& packet) {
-  std::vector<PointerData> converted_pointers;
   // Converts each pointer data in the buffer and stores it in the
-  // converted_pointers.
+  // converted_pointers_, which is reused across packets so that high rate
+  // input doesn't allocate an intermediate buffer for every packet.
+  converted_pointers_.clear();
+  converted_pointers_.reserve(packet.GetLength());
   for (size_t i = 0; i < packet.GetLength(); i++) {
     PointerData pointer_data = packet.GetPointerData(i);
-    ConvertPointerData(pointer_data, converted_pointers);
+    ConvertPointerData(pointer_data, converted_pointers_);
   }
 
-  // Writes converted_pointers into converted_packet.
-  auto converted_packet =
-      std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
-  size_t count = 0;
-  for (auto& converted_pointer : converted_pointers) {
-    converted_packet->SetPointerData(count++, converted_pointer);
-  }
-
-  return converted_packet;
+  // Writes converted_pointers_ into converted_packet.
+  return std::make_unique<flutter::PointerDataPacket>(
+      reinterpret_cast<uint8_t*>(converted_pointers_.data()),
+      converted_pointers_.size() * sizeof(PointerData));
 }
 
 void PointerDataPacketConverter::ConvertPointerData(
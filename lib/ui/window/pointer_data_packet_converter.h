@@ -124,6 +124,9 @@ class PointerDataPacketConverter {
 
   int64_t pointer_ = 0;
 
+  // The converted pointer data of the packet being converted.
+  std::vector<PointerData> converted_pointers_;
+
   void ConvertPointerData(PointerData pointer_data,
                           std::vector<PointerData>& converted_pointers);
 
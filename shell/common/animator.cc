@@ -24,7 +24,8 @@ constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
 
 Animator::Animator(Delegate& delegate,
                    const TaskRunners& task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   bool enable_adaptive_pipeline_depth)
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
@@ -42,6 +43,11 @@ Animator::Animator(Delegate& delegate,
 #endif  // SHELL_ENABLE_METAL
       pending_frame_semaphore_(1),
       weak_factory_(this) {
+  if (enable_adaptive_pipeline_depth) {
+    pipeline_depth_controller_ = std::make_unique<PipelineDepthController>(
+        layer_tree_pipeline_->GetDepth());
+    layer_tree_pipeline_->SetDepthLimit(pipeline_depth_controller_->GetDepth());
+  }
 }
 
 Animator::~Animator() = default;
@@ -70,6 +76,8 @@ void Animator::BeginFrame(
 
   frame_timings_recorder_ = std::move(frame_timings_recorder);
   frame_timings_recorder_->RecordBuildStart(fml::TimePoint::Now());
+  frame_budget_ = frame_timings_recorder_->GetVsyncTargetTime() -
+                  frame_timings_recorder_->GetVsyncStartTime();
 
   size_t flow_id_count = trace_flow_ids_.size();
   std::unique_ptr<uint64_t[]> flow_ids =
@@ -288,6 +296,15 @@ void Animator::AwaitVSync() {
   }
 }
 
+void Animator::OnFrameRasterized(const FrameTiming& timing) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (!pipeline_depth_controller_) {
+    return;
+  }
+  layer_tree_pipeline_->SetDepthLimit(
+      pipeline_depth_controller_->AddFrameTiming(timing, frame_budget_));
+}
+
 void Animator::OnAllViewsRendered() {
   if (!layer_trees_tasks_.empty()) {
     EndFrame();
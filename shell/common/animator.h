@@ -45,9 +45,17 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  //--------------------------------------------------------------------------
+  /// @brief    Creates an animator.
+  ///
+  /// @param[in]  enable_adaptive_pipeline_depth  Whether to start with a
+  ///             frame pipeline depth of 1 and only deepen it while frames
+  ///             are dropped. See `PipelineDepthController`.
+  ///
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           bool enable_adaptive_pipeline_depth = false);
 
   ~Animator();
 
@@ -107,6 +115,14 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Tells the Animator the timing of a rasterized frame, which is
+  ///           used to adapt the depth of the frame pipeline if enabled.
+  ///
+  ///           This method must be called on the UI thread.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
   // Enqueue |trace_flow_id| into |trace_flow_ids_|.  The flow event will be
   // ended at either the next frame, or the next vsync interval with no active
   // rendering.
@@ -143,6 +159,9 @@ class Animator final {
   std::shared_ptr<FramePipeline> layer_tree_pipeline_;
   fml::Semaphore pending_frame_semaphore_;
   FramePipeline::ProducerContinuation producer_continuation_;
+  std::unique_ptr<PipelineDepthController> pipeline_depth_controller_;
+  // The interval between the vsyncs of the most recent frame.
+  fml::TimeDelta frame_budget_;
   bool regenerate_layer_trees_ = false;
   bool frame_scheduled_ = false;
   std::deque<uint64_t> trace_flow_ids_;
@@ -52,6 +52,43 @@ class FakeAnimatorDelegate : public Animator::Delegate {
   bool notify_idle_called_ = false;
 };
 
+namespace {
+
+// Fires every requested vsync right away, with a frame interval of 16ms.
+class FixedIntervalVsyncWaiter : public VsyncWaiter {
+ public:
+  static constexpr fml::TimeDelta kFrameInterval =
+      fml::TimeDelta::FromMilliseconds(16);
+
+  explicit FixedIntervalVsyncWaiter(const TaskRunners& task_runners)
+      : VsyncWaiter(task_runners) {}
+
+ protected:
+  void AwaitVSync() override {
+    task_runners_.GetPlatformTaskRunner()->PostTask([this] {
+      const fml::TimePoint now = fml::TimePoint::Now();
+      FireCallback(now, now + kFrameInterval);
+    });
+  }
+};
+
+FrameTiming CreateFrameTiming(fml::TimeDelta build_time,
+                              fml::TimeDelta raster_time) {
+  FrameTiming timing;
+  fml::TimePoint time = fml::TimePoint::Now();
+  timing.Set(FrameTiming::kVsyncStart, time);
+  timing.Set(FrameTiming::kBuildStart, time);
+  time = time + build_time;
+  timing.Set(FrameTiming::kBuildFinish, time);
+  timing.Set(FrameTiming::kRasterStart, time);
+  time = time + raster_time;
+  timing.Set(FrameTiming::kRasterFinish, time);
+  timing.Set(FrameTiming::kRasterFinishWallTime, time);
+  return timing;
+}
+
+}  // namespace
+
 TEST_F(ShellTest, VSyncTargetTime) {
   // Add native callbacks to listen for window.onBeginFrame
   int64_t target_time;
@@ -261,6 +298,117 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyDelegateIfPipelineIsNotEmpty) {
   PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
 }
 
+// Renders a single frame with an animator created on the UI task runner, and
+// returns the pipeline the frame was pushed to.
+static std::shared_ptr<FramePipeline> RenderOneFrame(
+    FakeAnimatorDelegate& delegate,
+    const TaskRunners& task_runners,
+    std::unique_ptr<Animator>& animator) {
+  std::shared_ptr<FramePipeline> pipeline;
+  fml::AutoResetWaitableEvent draw_latch;
+  EXPECT_CALL(delegate, OnAnimatorUpdateLatestFrameTargetTime).Times(1);
+  EXPECT_CALL(delegate, OnAnimatorDraw)
+      .WillOnce([&](std::shared_ptr<FramePipeline> frame_pipeline) {
+        pipeline = std::move(frame_pipeline);
+        draw_latch.Signal();
+      });
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    EXPECT_CALL(delegate, OnAnimatorBeginFrame).WillOnce([&] {
+      auto layer_tree =
+          std::make_unique<LayerTree>(nullptr, SkISize::Make(600, 800));
+      animator->Render(kImplicitViewId, std::move(layer_tree), 1.0);
+    });
+    animator->RequestFrame();
+  });
+  draw_latch.Wait();
+  return pipeline;
+}
+
+TEST_F(ShellTest, AnimatorAdaptsPipelineDepthToFrameTimings) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  std::unique_ptr<Animator> animator;
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<FixedIntervalVsyncWaiter>(task_runners));
+    animator = std::make_unique<Animator>(delegate, task_runners,
+                                          std::move(vsync_waiter),
+                                          /*enable_adaptive_pipeline_depth=*/
+                                          true);
+  });
+
+  std::shared_ptr<FramePipeline> pipeline =
+      RenderOneFrame(delegate, task_runners, animator);
+  ASSERT_TRUE(pipeline);
+  EXPECT_EQ(pipeline->GetDepth(), 2u);
+
+  // The build and raster phases of these frames fit into a 16ms frame
+  // interval one at a time, but not one after the other.
+  const FrameTiming overrunning_frame =
+      CreateFrameTiming(fml::TimeDelta::FromMilliseconds(10),
+                        fml::TimeDelta::FromMilliseconds(12));
+  const FrameTiming fitting_frame =
+      CreateFrameTiming(fml::TimeDelta::FromMilliseconds(4),
+                        fml::TimeDelta::FromMilliseconds(4));
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    EXPECT_EQ(pipeline->GetDepthLimit(), 1u);
+    for (size_t i = 0; i < PipelineDepthController::kDeepenThreshold; i++) {
+      animator->OnFrameRasterized(overrunning_frame);
+    }
+    EXPECT_EQ(pipeline->GetDepthLimit(), 2u);
+    for (size_t i = 0; i < PipelineDepthController::kWindowSize; i++) {
+      animator->OnFrameRasterized(fitting_frame);
+    }
+    EXPECT_EQ(pipeline->GetDepthLimit(), 1u);
+  });
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+}
+
+TEST_F(ShellTest, AnimatorKeepsPipelineDepthWithoutAdaptivePipelineDepth) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  std::unique_ptr<Animator> animator;
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<FixedIntervalVsyncWaiter>(task_runners));
+    animator = std::make_unique<Animator>(delegate, task_runners,
+                                          std::move(vsync_waiter));
+  });
+
+  std::shared_ptr<FramePipeline> pipeline =
+      RenderOneFrame(delegate, task_runners, animator);
+  ASSERT_TRUE(pipeline);
+
+  const FrameTiming fitting_frame =
+      CreateFrameTiming(fml::TimeDelta::FromMilliseconds(4),
+                        fml::TimeDelta::FromMilliseconds(4));
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    EXPECT_EQ(pipeline->GetDepthLimit(), pipeline->GetDepth());
+    for (size_t i = 0; i < PipelineDepthController::kWindowSize; i++) {
+      animator->OnFrameRasterized(fitting_frame);
+    }
+    EXPECT_EQ(pipeline->GetDepthLimit(), pipeline->GetDepth());
+  });
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -631,6 +631,14 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that a frame has been rasterized, so that
+  ///             the animator can adapt the depth of the frame pipeline.
+  ///
+  /// @param[in]  timing  The timing of the rasterized frame.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets the main port of the root isolate. Since the isolate is
   ///             created immediately in the constructor of the engine, it is
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
 
@@ -440,6 +442,130 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+namespace {
+
+// A delegate that records dispatched packets and runs the secondary vsync
+// callback only when the test simulates a vsync.
+class RecordingDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packet_lengths.push_back(packet->GetLength());
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void SimulateVsync() {
+    auto callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<size_t> packet_lengths;
+  fml::closure vsync_callback;
+};
+
+}  // namespace
+
+TEST(CoalescingPointerDataDispatcherTest, DispatchesOncePerVsync) {
+  RecordingDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate, /*samples_per_run=*/2);
+
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kHover, 0, 0);
+  auto dispatch = [&dispatcher, &data](double x) {
+    auto packet = std::make_unique<PointerDataPacket>(1);
+    data.physical_x = x;
+    packet->SetPointerData(0, data);
+    dispatcher.DispatchPacket(std::move(packet), 0);
+  };
+
+  // The first packet is not delayed.
+  dispatch(1);
+  EXPECT_EQ(delegate.packet_lengths, std::vector<size_t>({1}));
+
+  // The rest of the frame's samples are coalesced until the next vsync.
+  for (int i = 2; i <= 16; i++) {
+    dispatch(i);
+  }
+  EXPECT_EQ(delegate.packet_lengths.size(), 1u);
+  delegate.SimulateVsync();
+  EXPECT_EQ(delegate.packet_lengths, std::vector<size_t>({1, 2}));
+
+  // A vsync without input ends the dispatch in progress, so the next packet
+  // is dispatched right away again.
+  delegate.SimulateVsync();
+  delegate.SimulateVsync();
+  EXPECT_FALSE(delegate.vsync_callback);
+  dispatch(17);
+  EXPECT_EQ(delegate.packet_lengths, std::vector<size_t>({1, 2, 1}));
+}
+
+TEST_F(ShellTest, CoalescesPointerDataWhenEnabledInSettings) {
+  auto settings = CreateSettingsForFixture();
+  settings.enable_pointer_data_coalescing = true;
+  std::unique_ptr<Shell> shell = CreateShell({
+      .settings = settings,
+      .platform_view_create_callback = ShellTestPlatformViewBuilder({
+          .simulate_vsync = true,
+      }),
+  });
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("onPointerDataPacketMain");
+  fml::CountDownLatch report_latch(2);
+  std::vector<std::vector<int64_t>> result_sequences;
+  auto nativeOnPointerDataPacket = [&report_latch, &result_sequences](
+                                       Dart_NativeArguments args) {
+    Dart_Handle exception = nullptr;
+    result_sequences.push_back(
+        tonic::DartConverter<std::vector<int64_t>>::FromArguments(args, 0,
+                                                                  exception));
+    report_latch.CountDown();
+  };
+  AddNativeCallback("NativeOnPointerDataPacket",
+                    CREATE_NATIVE_ENTRY(nativeOnPointerDataPacket));
+  ASSERT_TRUE(configuration.IsValid());
+  RunEngine(shell.get(), std::move(configuration));
+
+  // The first packet is dispatched right away.
+  auto packet = std::make_unique<PointerDataPacket>(2);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 0.0, 0.0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0.0, 0.0);
+  packet->SetPointerData(1, data);
+  ShellTest::DispatchPointerData(shell.get(), std::move(packet));
+
+  // The moves that follow within the same frame are coalesced into a single
+  // packet with the default number of samples per run.
+  for (int i = 1; i <= 16; i++) {
+    packet = std::make_unique<PointerDataPacket>(1);
+    CreateSimulatedPointerData(data, PointerData::Change::kMove, i, 0.0);
+    packet->SetPointerData(0, data);
+    ShellTest::DispatchPointerData(shell.get(), std::move(packet));
+  }
+  ShellTest::VSyncFlush(shell.get());
+
+  report_latch.Wait();
+  ASSERT_EQ(result_sequences.size(), 2u);
+  ASSERT_EQ(result_sequences[0].size(), 2u);
+  ASSERT_EQ(result_sequences[1].size(),
+            PointerDataCoalescer::kDefaultSamplesPerRun);
+  for (int64_t change : result_sequences[1]) {
+    ASSERT_EQ(PointerData::Change(change), PointerData::Change::kMove);
+  }
+
+  DestroyShell(std::move(shell));
+}
+
 }  // namespace testing
 }  // namespace flutter
 
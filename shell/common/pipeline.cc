@@ -11,4 +11,54 @@ size_t GetNextPipelineTraceID() {
   return ++PipelineLastTraceID;
 }
 
+PipelineDepthController::PipelineDepthController(uint32_t max_depth)
+    : max_depth_(std::max<uint32_t>(max_depth, 1)) {}
+
+PipelineDepthController::~PipelineDepthController() = default;
+
+uint32_t PipelineDepthController::AddFrameTiming(const FrameTiming& timing,
+                                                 fml::TimeDelta frame_budget) {
+  if (frame_budget <= fml::TimeDelta::Zero()) {
+    return depth_;
+  }
+
+  // The build and raster phases of a frame run one after the other when the
+  // pipeline is not deeper than 1, regardless of the current depth.
+  const fml::TimeDelta build_time =
+      timing.Get(FrameTiming::kBuildFinish) -
+      timing.Get(FrameTiming::kBuildStart);
+  const fml::TimeDelta raster_time =
+      timing.Get(FrameTiming::kRasterFinish) -
+      timing.Get(FrameTiming::kRasterStart);
+  const bool overrun = build_time + raster_time > frame_budget;
+
+  overruns_.push_back(overrun);
+  overrun_count_ += overrun;
+  if (overruns_.size() > kWindowSize) {
+    overrun_count_ -= overruns_.front();
+    overruns_.pop_front();
+  }
+
+  if (depth_ == 1 && overrun_count_ >= kDeepenThreshold) {
+    SetDepth(2);
+  } else if (depth_ > 1 && overruns_.size() == kWindowSize &&
+             overrun_count_ == 0) {
+    SetDepth(1);
+  }
+  return depth_;
+}
+
+void PipelineDepthController::SetDepth(uint32_t depth) {
+  depth = std::min(depth, max_depth_);
+  if (depth == depth_) {
+    return;
+  }
+  depth_ = depth;
+  // Only the frames produced at the new depth count towards the next change.
+  overruns_.clear();
+  overrun_count_ = 0;
+  FML_TRACE_COUNTER("flutter", "PipelineDepthController",
+                    reinterpret_cast<int64_t>(this), "depth", depth_);
+}
+
 }  // namespace flutter
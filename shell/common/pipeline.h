@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -129,19 +131,38 @@ class Pipeline {
   };
 
   explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+      : depth_(depth),
+        empty_(depth),
+        available_(0),
+        inflight_(0),
+        depth_limit_(depth) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// The maximum depth the pipeline was created with.
+  uint32_t GetDepth() const { return depth_; }
+
+  /// The number of resources that may currently be in flight.
+  uint32_t GetDepthLimit() const { return depth_limit_.load(); }
+
+  /// Limits the number of resources that may be in flight, including the ones
+  /// reserved by a `ProducerContinuation` that has not been completed yet, to
+  /// |limit|. The limit is clamped to [1, depth] and takes effect for the
+  /// next call to |Produce| or |ProduceIfEmpty|. Resources that are already
+  /// in flight are not affected.
+  void SetDepthLimit(uint32_t limit) {
+    depth_limit_ = std::clamp<uint32_t>(limit, 1, depth_);
+  }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
-  /// If the queue is already at its maximum depth, the `ProducerContinuation`
-  /// is returned with success = false.
+  /// If the queue is already at its maximum depth or at its depth limit, the
+  /// `ProducerContinuation` is returned with success = false.
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (IsAtDepthLimit() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -162,7 +183,7 @@ class Pipeline {
   /// Prefer using |Produce|. ProducerContinuation returned by this method
   /// doesn't guarantee that the frame will be rendered.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (IsAtDepthLimit() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -213,12 +234,18 @@ class Pipeline {
   }
 
  private:
+  const uint32_t depth_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
+  std::atomic<uint32_t> depth_limit_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
+  bool IsAtDepthLimit() const {
+    return inflight_.load() >= static_cast<int>(depth_limit_.load());
+  }
+
   /// Commits a produced resource to the queue and signals the consumer that a
   /// resource is available.
   PipelineProduceResult ProducerCommit(ResourcePtr resource, size_t trace_id) {
@@ -242,6 +269,7 @@ class Pipeline {
         // Bail if the queue is not empty, opens up spaces to produce other
         // frames.
         empty_.Signal();
+        --inflight_;
         return {.success = false, .is_first_item = false};
       }
       queue_.emplace_back(std::move(resource), trace_id);
@@ -255,6 +283,51 @@ class Pipeline {
   FML_DISALLOW_COPY_AND_ASSIGN(Pipeline);
 };
 
+/// Picks the depth of the frame pipeline from the timings of the most recent
+/// frames.
+///
+/// At a depth of 1, the latency from a vsync to the frame it produces is
+/// minimal, but the UI thread can't start building a frame until the raster
+/// thread has picked up the previous one. Frames whose build and raster times
+/// add up to more than the frame budget are then dropped even if each thread
+/// would keep up on its own. At a depth of 2, the UI thread builds the next
+/// frame while the current one rasterizes, at the cost of one frame of
+/// latency.
+///
+/// The controller starts at a depth of 1 and only deepens the pipeline once
+/// |kDeepenThreshold| of the last |kWindowSize| frames overran the budget. It
+/// returns to a depth of 1 after a full window of frames that fit in the
+/// budget.
+class PipelineDepthController {
+ public:
+  static constexpr size_t kWindowSize = 30;
+  static constexpr size_t kDeepenThreshold = 3;
+
+  explicit PipelineDepthController(uint32_t max_depth);
+
+  ~PipelineDepthController();
+
+  uint32_t GetDepth() const { return depth_; }
+
+  /// Adds the timing of a rasterized frame and returns the depth that the
+  /// pipeline should use from now on. Timings without a frame budget are
+  /// ignored.
+  uint32_t AddFrameTiming(const FrameTiming& timing,
+                          fml::TimeDelta frame_budget);
+
+ private:
+  const uint32_t max_depth_;
+  uint32_t depth_ = 1;
+  // Whether each of the frames in the window overran the frame budget, oldest
+  // first.
+  std::deque<bool> overruns_;
+  size_t overrun_count_ = 0;
+
+  void SetDepth(uint32_t depth);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineDepthController);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_SHELL_COMMON_PIPELINE_H_
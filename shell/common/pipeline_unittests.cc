@@ -144,5 +144,185 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, DepthLimitIsClampedToDepth) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  ASSERT_EQ(pipeline->GetDepthLimit(), 2u);
+
+  pipeline->SetDepthLimit(0);
+  ASSERT_EQ(pipeline->GetDepthLimit(), 1u);
+
+  pipeline->SetDepthLimit(3);
+  ASSERT_EQ(pipeline->GetDepthLimit(), 2u);
+}
+
+TEST(PipelineTest, ProduceFailsAtDepthLimit) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  pipeline->SetDepthLimit(1);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_FALSE(pipeline->ProduceIfEmpty());
+
+  const int test_val_1 = 1, test_val_2 = 2;
+  PipelineProduceResult result =
+      continuation_1.Complete(std::make_unique<int>(test_val_1));
+  ASSERT_EQ(result.success, true);
+  ASSERT_FALSE(pipeline->Produce());
+
+  // Raising the limit lets the producer prepare the next resource while the
+  // previous one has not been consumed yet.
+  pipeline->SetDepthLimit(2);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+  result = continuation_2.Complete(std::make_unique<int>(test_val_2));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, false);
+
+  PipelineConsumeResult consume_result_1 = pipeline->Consume(
+      [&test_val_1](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_1); });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::MoreAvailable);
+  PipelineConsumeResult consume_result_2 = pipeline->Consume(
+      [&test_val_2](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_2); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+}
+
+TEST(PipelineTest, LoweringDepthLimitKeepsResourcesInFlight) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  pipeline->SetDepthLimit(1);
+
+  const int test_val_1 = 1, test_val_2 = 2;
+  ASSERT_EQ(continuation_1.Complete(std::make_unique<int>(test_val_1)).success,
+            true);
+  ASSERT_EQ(continuation_2.Complete(std::make_unique<int>(test_val_2)).success,
+            true);
+
+  PipelineConsumeResult consume_result_1 = pipeline->Consume(
+      [&test_val_1](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_1); });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::MoreAvailable);
+  // One resource is still in flight.
+  ASSERT_FALSE(pipeline->Produce());
+
+  PipelineConsumeResult consume_result_2 = pipeline->Consume(
+      [&test_val_2](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_2); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+  ASSERT_TRUE(pipeline->Produce());
+}
+
+TEST(PipelineTest, FailedProduceIfEmptyDoesNotCountTowardsDepthLimit) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->ProduceIfEmpty();
+
+  const int test_val_1 = 1, test_val_2 = 2;
+  PipelineProduceResult result =
+      continuation_1.Complete(std::make_unique<int>(test_val_1));
+  ASSERT_EQ(result.success, true);
+  result = continuation_2.Complete(std::make_unique<int>(test_val_2));
+  ASSERT_EQ(result.success, false);
+
+  ASSERT_TRUE(pipeline->Produce());
+}
+
+namespace {
+
+FrameTiming CreateFrameTiming(fml::TimeDelta build_time,
+                              fml::TimeDelta raster_time) {
+  FrameTiming timing;
+  fml::TimePoint time = fml::TimePoint::FromEpochDelta(fml::TimeDelta::Zero());
+  timing.Set(FrameTiming::kVsyncStart, time);
+  timing.Set(FrameTiming::kBuildStart, time);
+  time = time + build_time;
+  timing.Set(FrameTiming::kBuildFinish, time);
+  timing.Set(FrameTiming::kRasterStart, time);
+  time = time + raster_time;
+  timing.Set(FrameTiming::kRasterFinish, time);
+  timing.Set(FrameTiming::kRasterFinishWallTime, time);
+  return timing;
+}
+
+constexpr fml::TimeDelta kFrameBudget = fml::TimeDelta::FromMilliseconds(16);
+
+FrameTiming FittingFrame() {
+  return CreateFrameTiming(fml::TimeDelta::FromMilliseconds(6),
+                           fml::TimeDelta::FromMilliseconds(8));
+}
+
+// Neither phase overruns the budget on its own, but both of them together do.
+FrameTiming OverrunningFrame() {
+  return CreateFrameTiming(fml::TimeDelta::FromMilliseconds(10),
+                           fml::TimeDelta::FromMilliseconds(12));
+}
+
+}  // namespace
+
+TEST(PipelineDepthControllerTest, StartsAtDepthOne) {
+  PipelineDepthController controller(2);
+  ASSERT_EQ(controller.GetDepth(), 1u);
+  for (size_t i = 0; i < PipelineDepthController::kWindowSize * 2; i++) {
+    ASSERT_EQ(controller.AddFrameTiming(FittingFrame(), kFrameBudget), 1u);
+  }
+}
+
+TEST(PipelineDepthControllerTest, DeepensWhenFramesOverrunTheBudget) {
+  PipelineDepthController controller(2);
+  for (size_t i = 0; i < PipelineDepthController::kDeepenThreshold - 1; i++) {
+    ASSERT_EQ(controller.AddFrameTiming(OverrunningFrame(), kFrameBudget), 1u);
+    ASSERT_EQ(controller.AddFrameTiming(FittingFrame(), kFrameBudget), 1u);
+  }
+  ASSERT_EQ(controller.AddFrameTiming(OverrunningFrame(), kFrameBudget), 2u);
+}
+
+TEST(PipelineDepthControllerTest, ForgetsOverrunsOutsideOfTheWindow) {
+  PipelineDepthController controller(2);
+  for (size_t i = 0; i < PipelineDepthController::kDeepenThreshold - 1; i++) {
+    ASSERT_EQ(controller.AddFrameTiming(OverrunningFrame(), kFrameBudget), 1u);
+  }
+  for (size_t i = 0; i < PipelineDepthController::kWindowSize; i++) {
+    ASSERT_EQ(controller.AddFrameTiming(FittingFrame(), kFrameBudget), 1u);
+  }
+  ASSERT_EQ(controller.AddFrameTiming(OverrunningFrame(), kFrameBudget), 1u);
+}
+
+TEST(PipelineDepthControllerTest, ReturnsToDepthOneAfterFittingFrames) {
+  PipelineDepthController controller(2);
+  for (size_t i = 0; i < PipelineDepthController::kDeepenThreshold; i++) {
+    controller.AddFrameTiming(OverrunningFrame(), kFrameBudget);
+  }
+  ASSERT_EQ(controller.GetDepth(), 2u);
+
+  // An overrun keeps the pipeline deep for another window of frames.
+  for (size_t i = 0; i < PipelineDepthController::kWindowSize - 1; i++) {
+    ASSERT_EQ(controller.AddFrameTiming(FittingFrame(), kFrameBudget), 2u);
+  }
+  ASSERT_EQ(controller.AddFrameTiming(OverrunningFrame(), kFrameBudget), 2u);
+  for (size_t i = 0; i < PipelineDepthController::kWindowSize - 1; i++) {
+    ASSERT_EQ(controller.AddFrameTiming(FittingFrame(), kFrameBudget), 2u);
+  }
+  ASSERT_EQ(controller.AddFrameTiming(FittingFrame(), kFrameBudget), 1u);
+}
+
+TEST(PipelineDepthControllerTest, DoesNotExceedMaxDepth) {
+  PipelineDepthController controller(1);
+  for (size_t i = 0; i < PipelineDepthController::kWindowSize; i++) {
+    ASSERT_EQ(controller.AddFrameTiming(OverrunningFrame(), kFrameBudget), 1u);
+  }
+}
+
+TEST(PipelineDepthControllerTest, IgnoresFramesWithoutBudget) {
+  PipelineDepthController controller(2);
+  for (size_t i = 0; i < PipelineDepthController::kWindowSize; i++) {
+    ASSERT_EQ(controller.AddFrameTiming(OverrunningFrame(), {}), 1u);
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 #define FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 
+#include <vector>
+
+#include "flutter/lib/ui/window/pointer_data_coalescer.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -163,6 +166,47 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that delivers at most one packet per VSYNC, and coalesces the
+/// movement samples received in between with a `PointerDataCoalescer`.
+///
+/// This is meant for high rate input devices such as 1000 Hz mice and
+/// styluses, which otherwise deliver a packet to the UI thread for every
+/// sample. The shell uses it in place of the platform view's dispatcher when
+/// `Settings::enable_pointer_data_coalescing` is set.
+///
+/// Like `SmoothPointerDataDispatcher`, a packet received while no pointer data
+/// dispatch is in progress is dispatched right away, so a single event is not
+/// delayed. Packets received while a dispatch is in progress are accumulated
+/// and dispatched together as one coalesced packet at the next VSYNC. This
+/// resamples the input to the frame rate while keeping up to
+/// `samples_per_run` historical samples of each gesture per frame.
+class CoalescingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  explicit CoalescingPointerDataDispatcher(
+      Delegate& delegate,
+      size_t samples_per_run = PointerDataCoalescer::kDefaultSamplesPerRun);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+ private:
+  void DispatchPendingPackets();
+  void ScheduleSecondaryVsyncCallback();
+
+  PointerDataCoalescer coalescer_;
+  // The trace flow ids of the packets accumulated in `coalescer_`.
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  bool is_pointer_data_in_progress_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<CoalescingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
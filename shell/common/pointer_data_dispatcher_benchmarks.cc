@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/lib/ui/window/pointer_data_packet_converter.h"
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+namespace flutter {
+
+namespace {
+
+// Stands in for the engine: converts every dispatched packet the way
+// RuntimeController does before handing it to the framework, and runs the
+// secondary vsync callback when a frame is simulated.
+class BenchmarkDispatcherDelegate
+    : public PointerDataDispatcher::Delegate,
+      public PointerDataPacketConverter::Delegate {
+ public:
+  BenchmarkDispatcherDelegate() : converter_(*this) {}
+
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    auto converted = converter_.Convert(*packet);
+    benchmark::DoNotOptimize(converted);
+    dispatched_packets++;
+    dispatched_events += converted->GetLength();
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback_ = callback;
+  }
+
+  // |PointerDataPacketConverter::Delegate|
+  bool ViewExists(int64_t view_id) const override { return view_id == 0; }
+
+  void SimulateVsync() {
+    auto callback = std::move(vsync_callback_);
+    vsync_callback_ = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  size_t dispatched_packets = 0;
+  size_t dispatched_events = 0;
+
+ private:
+  PointerDataPacketConverter converter_;
+  fml::closure vsync_callback_;
+};
+
+PointerData CreateMouseSample(PointerData::Change change,
+                              int64_t device,
+                              int64_t time_stamp,
+                              double x,
+                              double y) {
+  PointerData data;
+  memset(&data, 0, sizeof(PointerData));
+  data.time_stamp = time_stamp;
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kMouse;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = device;
+  data.physical_x = x;
+  data.physical_y = y;
+  data.buttons = change == PointerData::Change::kHover ? 0 : 1;
+  data.view_id = 0;
+  return data;
+}
+
+enum class DispatcherType {
+  kDefault,
+  kSmooth,
+  kCoalescing,
+};
+
+std::unique_ptr<PointerDataDispatcher> CreateDispatcher(
+    DispatcherType type,
+    PointerDataDispatcher::Delegate& delegate) {
+  switch (type) {
+    case DispatcherType::kDefault:
+      return std::make_unique<DefaultPointerDataDispatcher>(delegate);
+    case DispatcherType::kSmooth:
+      return std::make_unique<SmoothPointerDataDispatcher>(delegate);
+    case DispatcherType::kCoalescing:
+      return std::make_unique<CoalescingPointerDataDispatcher>(delegate);
+  }
+  FML_UNREACHABLE();
+}
+
+}  // namespace
+
+// Feeds one second of a 1 kHz drag from each of `state.range(0)` devices
+// through a dispatcher with a 60 Hz vsync. Every sample arrives in its own
+// packet, as it does from the platform.
+static void BM_PointerDataDispatcher1kHz(benchmark::State& state,
+                                         DispatcherType type) {
+  constexpr int kSampleRateHz = 1000;
+  constexpr int kFrameRateHz = 60;
+  const int64_t device_count = state.range(0);
+  size_t dispatched_packets = 0;
+  size_t dispatched_events = 0;
+
+  for (auto _ : state) {
+    BenchmarkDispatcherDelegate delegate;
+    auto dispatcher = CreateDispatcher(type, delegate);
+    int frame = 0;
+    for (int64_t device = 0; device < device_count; device++) {
+      auto packet = std::make_unique<PointerDataPacket>(1);
+      packet->SetPointerData(0, CreateMouseSample(PointerData::Change::kDown,
+                                                  device, 0, 0, 0));
+      dispatcher->DispatchPacket(std::move(packet), 0);
+    }
+    for (int sample = 1; sample <= kSampleRateHz; sample++) {
+      for (int64_t device = 0; device < device_count; device++) {
+        auto packet = std::make_unique<PointerDataPacket>(1);
+        packet->SetPointerData(
+            0, CreateMouseSample(PointerData::Change::kMove, device,
+                                 sample * 1000, sample, sample * 0.5));
+        dispatcher->DispatchPacket(std::move(packet), sample);
+      }
+      // Simulates a vsync whenever a frame boundary is crossed.
+      int sample_frame = sample * kFrameRateHz / kSampleRateHz;
+      for (; frame < sample_frame; frame++) {
+        delegate.SimulateVsync();
+      }
+    }
+    delegate.SimulateVsync();
+    delegate.SimulateVsync();
+    dispatched_packets = delegate.dispatched_packets;
+    dispatched_events = delegate.dispatched_events;
+  }
+
+  state.counters["DispatchedPackets"] = dispatched_packets;
+  state.counters["DispatchedEvents"] = dispatched_events;
+  state.SetItemsProcessed(state.iterations() * kSampleRateHz * device_count);
+}
+
+BENCHMARK_CAPTURE(BM_PointerDataDispatcher1kHz,
+                  Default,
+                  DispatcherType::kDefault)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PointerDataDispatcher1kHz, Smooth, DispatcherType::kSmooth)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PointerDataDispatcher1kHz,
+                  Coalescing,
+                  DispatcherType::kCoalescing)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
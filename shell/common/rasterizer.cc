@@ -12,7 +12,10 @@
 #include "flow/frame_timings.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/base64.h"
@@ -59,6 +62,20 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+#if !SLIMPELLER
+  const Settings& settings = delegate.GetSettings();
+  RasterCache& raster_cache = compositor_context_->raster_cache();
+  raster_cache.SetHostTierMaxBytes(settings.raster_cache_host_tier_max_bytes);
+  if (settings.raster_cache_cost_aware_max_bytes > 0) {
+    raster_cache.SetPolicy(std::make_unique<CostAwareRasterCachePolicy>(
+        settings.raster_cache_cost_aware_max_bytes));
+  } else if (settings.enable_raster_cache_byte_budget) {
+    // The budget is set along with the resource cache limit.
+    raster_cache.SetPolicy(std::make_unique<LruRasterCachePolicy>());
+  }
+#endif  //  !SLIMPELLER
+  compositor_context_->set_reuse_retained_prerolls(
+      delegate.GetSettings().enable_retained_preroll_reuse);
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -648,16 +665,25 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
 
   frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
 
+  std::vector<std::optional<fml::TimePoint>> record_starts =
+      RecordLayerTrees(tasks);
+
   // Second traverse: draw all layer trees.
   std::vector<std::unique_ptr<LayerTreeTask>> resubmitted_tasks;
-  for (std::unique_ptr<LayerTreeTask>& task : tasks) {
+  for (size_t i = 0; i < tasks.size(); i++) {
+    std::unique_ptr<LayerTreeTask>& task = tasks[i];
     int64_t view_id = task->view_id;
     std::unique_ptr<LayerTree> layer_tree = std::move(task->layer_tree);
     float device_pixel_ratio = task->device_pixel_ratio;
 
+    // The raster time of a recorded view includes its recording.
+    fml::TimePoint view_raster_start =
+        record_starts[i].value_or(fml::TimePoint::Now());
     DrawSurfaceStatus status = DrawToSurfaceUnsafe(
         view_id, *layer_tree, device_pixel_ratio, presentation_time);
     FML_DCHECK(status != DrawSurfaceStatus::kDiscarded);
+    frame_timings_recorder.RecordViewRasterTime(view_id, view_raster_start,
+                                                fml::TimePoint::Now());
 
     auto& view_record = EnsureViewRecord(task->view_id);
     view_record.last_draw_status = status;
@@ -692,6 +718,69 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
   }
 }
 
+// Whether the layer can be painted into a display list on a worker thread,
+// which excludes the layers that need the view embedder, the texture registry
+// or the frame's stopwatches to paint.
+static bool CanRecordLayerOnWorker(const Layer* layer) {
+  if (layer->as_platform_view_layer() || layer->as_texture_layer() ||
+      layer->as_performance_overlay_layer()) {
+    return false;
+  }
+  const ContainerLayer* container = layer->as_container_layer();
+  if (container) {
+    for (const auto& child : container->layers()) {
+      if (!CanRecordLayerOnWorker(child.get())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::vector<std::optional<fml::TimePoint>> Rasterizer::RecordLayerTrees(
+    const std::vector<std::unique_ptr<LayerTreeTask>>& tasks) {
+  std::vector<std::optional<fml::TimePoint>> record_starts(tasks.size());
+  if (!delegate_.GetSettings().enable_concurrent_view_rasterization ||
+      tasks.size() < 2 || surface_->EnableRasterCache()) {
+    return record_starts;
+  }
+  auto worker_task_runner = delegate_.GetConcurrentWorkerTaskRunner();
+  if (!worker_task_runner) {
+    return record_starts;
+  }
+
+  std::vector<size_t> recordable;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    const Layer* root_layer = tasks[i]->layer_tree->root_layer();
+    if (root_layer && CanRecordLayerOnWorker(root_layer)) {
+      recordable.push_back(i);
+    }
+  }
+  if (recordable.size() < 2) {
+    return record_starts;
+  }
+
+  TRACE_EVENT0("flutter", "Rasterizer::RecordLayerTrees");
+  auto record = [&tasks, &record_starts](size_t index) {
+    record_starts[index] = fml::TimePoint::Now();
+    tasks[index]->layer_tree->Record();
+  };
+
+  // The raster thread records the first layer tree itself instead of idling
+  // until the workers are done.
+  fml::CountDownLatch latch(recordable.size() - 1);
+  for (size_t i = 1; i < recordable.size(); i++) {
+    worker_task_runner->PostPriorityTask(
+        [&record, &latch, index = recordable[i]]() {
+          record(index);
+          latch.CountDown();
+        });
+  }
+  record(recordable[0]);
+  latch.Wait();
+  return record_starts;
+}
+
 /// \see Rasterizer::DrawToSurfaces
 DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     int64_t view_id,
@@ -1121,6 +1210,7 @@ void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   }
 
   max_cache_bytes_ = max_bytes;
+  compositor_context_->raster_cache().SetResourceCacheMaxBytes(max_bytes);
   if (!surface_) {
     return;
   }
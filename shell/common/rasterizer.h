@@ -18,6 +18,7 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -169,6 +170,11 @@ class Rasterizer final : public SnapshotDelegate,
 
     virtual const Settings& GetSettings() const = 0;
 
+    /// The worker task runner that records the layer trees of the views of a
+    /// frame when `Settings::enable_concurrent_view_rasterization` is set.
+    virtual const std::shared_ptr<fml::ConcurrentTaskRunner>
+    GetConcurrentWorkerTaskRunner() const = 0;
+
     virtual bool ShouldDiscardLayerTree(int64_t view_id,
                                         const flutter::LayerTree& tree) = 0;
   };
@@ -727,6 +733,17 @@ class Rasterizer final : public SnapshotDelegate,
       FrameTimingsRecorder& frame_timings_recorder,
       std::vector<std::unique_ptr<LayerTreeTask>> tasks);
 
+  // Records the layer trees of the tasks with `LayerTree::Record` on the
+  // concurrent worker threads, if enabled by the settings. Returns when the
+  // recording of each task started, or std::nullopt for the tasks whose layer
+  // trees were not recorded.
+  //
+  // Only layer trees that can be painted without the view embedder, the
+  // texture registry or the frame's stopwatches are recorded, and only when
+  // the raster cache is disabled, since it can't be shared between threads.
+  std::vector<std::optional<fml::TimePoint>> RecordLayerTrees(
+      const std::vector<std::unique_ptr<LayerTreeTask>>& tasks);
+
   // Draws the layer tree to the specified view, assuming we have access to the
   // GPU.
   //
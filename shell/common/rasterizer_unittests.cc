@@ -9,8 +9,13 @@
 
 #include <memory>
 #include <optional>
+#include <thread>
 
+#include "flutter/display_list/dl_builder.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -28,6 +33,7 @@ using testing::ByMove;
 using testing::NiceMock;
 using testing::Return;
 using testing::ReturnRef;
+using testing::SaveArg;
 
 namespace flutter {
 namespace {
@@ -45,6 +51,22 @@ std::vector<std::unique_ptr<LayerTreeTask>> SingleLayerTreeList(
   return tasks;
 }
 
+// A container layer that remembers the threads it was prerolled on.
+class PrerollThreadsLayer : public ContainerLayer {
+ public:
+  void Preroll(PrerollContext* context) override {
+    preroll_threads_.push_back(std::this_thread::get_id());
+    ContainerLayer::Preroll(context);
+  }
+
+  const std::vector<std::thread::id>& preroll_threads() const {
+    return preroll_threads_;
+  }
+
+ private:
+  std::vector<std::thread::id> preroll_threads_;
+};
+
 class MockDelegate : public Rasterizer::Delegate {
  public:
   MOCK_METHOD(void,
@@ -63,6 +85,10 @@ class MockDelegate : public Rasterizer::Delegate {
               (),
               (const, override));
   MOCK_METHOD(const Settings&, GetSettings, (), (const, override));
+  MOCK_METHOD(const std::shared_ptr<fml::ConcurrentTaskRunner>,
+              GetConcurrentWorkerTaskRunner,
+              (),
+              (const, override));
   MOCK_METHOD(bool,
               ShouldDiscardLayerTree,
               (int64_t, const flutter::LayerTree&),
@@ -71,6 +97,11 @@ class MockDelegate : public Rasterizer::Delegate {
 
 class MockSurface : public Surface {
  public:
+  MockSurface() {
+    // Keeps the default of |Surface| unless a test overrides it.
+    ON_CALL(*this, EnableRasterCache).WillByDefault(Return(true));
+  }
+
   MOCK_METHOD(bool, IsValid, (), (override));
   MOCK_METHOD(std::unique_ptr<SurfaceFrame>,
               AcquireFrame,
@@ -84,6 +115,7 @@ class MockSurface : public Surface {
               (override));
   MOCK_METHOD(bool, ClearRenderContext, (), (override));
   MOCK_METHOD(bool, AllowsDrawingWhenGpuDisabled, (), (const, override));
+  MOCK_METHOD(bool, EnableRasterCache, (), (const, override));
 };
 
 class MockExternalViewEmbedder : public ExternalViewEmbedder {
@@ -743,6 +775,138 @@ TEST(RasterizerTest, drawMultipleViewsWithExternalViewEmbedder) {
   latch.Wait();
 }
 
+TEST(RasterizerTest, drawMultipleViewsConcurrently) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::kPlatform |
+                             ThreadHost::Type::kRaster | ThreadHost::Type::kIo |
+                             ThreadHost::Type::kUi);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  auto worker_loop = fml::ConcurrentMessageLoop::Create(2);
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.enable_concurrent_view_rasterization = true;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, GetConcurrentWorkerTaskRunner())
+      .WillOnce(Return(worker_loop->GetTaskRunner()));
+  FrameTiming frame_timing;
+  EXPECT_CALL(delegate, OnFrameRasterized(_))
+      .WillOnce(SaveArg<0>(&frame_timing));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  std::shared_ptr<NiceMock<MockExternalViewEmbedder>> external_view_embedder =
+      std::make_shared<NiceMock<MockExternalViewEmbedder>>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+  EXPECT_CALL(*external_view_embedder, SupportsDynamicThreadMerging)
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillOnce(Return(true));
+  // Views are only recorded concurrently without a raster cache, as with
+  // Impeller.
+  ON_CALL(*surface, EnableRasterCache()).WillByDefault(Return(false));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize::Make(100, 100))).Times(2);
+  ON_CALL(*surface, AcquireFrame).WillByDefault([](const SkISize& size) {
+    SurfaceFrame::FramebufferInfo framebuffer_info;
+    framebuffer_info.supports_readback = true;
+    return std::make_unique<SurfaceFrame>(
+        /*surface=*/
+        nullptr, framebuffer_info,
+        /*encode_callback=*/[](const SurfaceFrame&, DlCanvas*) { return true; },
+        /*submit_callback=*/[](const SurfaceFrame&) { return true; },
+        /*frame_size=*/size,
+        /*context_result=*/nullptr,
+        /*display_list_fallback=*/true);
+  });
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  EXPECT_CALL(*external_view_embedder, BeginFrame(/*context=*/nullptr,
+                                                  /*raster_thread_merger=*/_))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              PrepareFlutterView(/*frame_size=*/SkISize::Make(100, 100),
+                                 /*device_pixel_ratio=*/_))
+      .Times(2);
+  EXPECT_CALL(*external_view_embedder,
+              SubmitFlutterView(/*flutter_view_id=*/0, _, _, _))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              SubmitFlutterView(/*flutter_view_id=*/1, _, _, _))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder, EndFrame(/*should_resubmit_frame=*/false,
+                                                /*raster_thread_merger=*/_))
+      .Times(1);
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<FramePipeline>(/*depth=*/10);
+    std::vector<std::unique_ptr<LayerTreeTask>> tasks;
+    DisplayListBuilder builder;
+    builder.DrawRect(SkRect::MakeWH(10, 10), DlPaint(DlColor::kRed()));
+    sk_sp<DisplayList> display_list = builder.Build();
+    auto root_layer_0 = std::make_shared<PrerollThreadsLayer>();
+    auto root_layer_1 = std::make_shared<PrerollThreadsLayer>();
+    root_layer_0->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(0, 0), display_list, false, false));
+    root_layer_1->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(0, 0), display_list, false, false));
+    auto layer_tree_0 =
+        std::make_unique<LayerTree>(root_layer_0, SkISize::Make(100, 100));
+    auto layer_tree_1 =
+        std::make_unique<LayerTree>(root_layer_1, SkISize::Make(100, 100));
+    LayerTree* layer_tree_0_ptr = layer_tree_0.get();
+    LayerTree* layer_tree_1_ptr = layer_tree_1.get();
+    tasks.push_back(
+        std::make_unique<LayerTreeTask>(0, std::move(layer_tree_0), 1.5));
+    tasks.push_back(
+        std::make_unique<LayerTreeTask>(1, std::move(layer_tree_1), 2.0));
+    auto layer_tree_item = std::make_unique<FrameItem>(
+        std::move(tasks), CreateFinishedBuildRecorder());
+    PipelineProduceResult result =
+        pipeline->Produce().Complete(std::move(layer_tree_item));
+    EXPECT_TRUE(result.success);
+    ON_CALL(delegate, ShouldDiscardLayerTree).WillByDefault(Return(false));
+    rasterizer->Draw(pipeline);
+
+    EXPECT_EQ(rasterizer->GetLastDrawStatus(0), DrawSurfaceStatus::kSuccess);
+    EXPECT_EQ(rasterizer->GetLastDrawStatus(1), DrawSurfaceStatus::kSuccess);
+    EXPECT_EQ(rasterizer->GetLastLayerTree(0), layer_tree_0_ptr);
+    EXPECT_EQ(rasterizer->GetLastLayerTree(1), layer_tree_1_ptr);
+
+    // Both layer trees were recorded, the first one on the raster thread and
+    // the second one on a worker, and neither was prerolled again to draw
+    // its recording.
+    EXPECT_TRUE(layer_tree_0_ptr->is_recorded());
+    EXPECT_TRUE(layer_tree_1_ptr->is_recorded());
+    ASSERT_EQ(root_layer_0->preroll_threads().size(), 1u);
+    ASSERT_EQ(root_layer_1->preroll_threads().size(), 1u);
+    EXPECT_EQ(root_layer_0->preroll_threads()[0], std::this_thread::get_id());
+    EXPECT_NE(root_layer_1->preroll_threads()[0], std::this_thread::get_id());
+
+    // Each view reports its raster time, which includes its recording. The
+    // second view was recorded while the first one was still being drawn.
+    const auto& view_times = frame_timing.GetViewRasterTimes();
+    ASSERT_EQ(view_times.size(), 2u);
+    ASSERT_EQ(view_times.count(0), 1u);
+    ASSERT_EQ(view_times.count(1), 1u);
+    EXPECT_LE(view_times.at(0).raster_start, view_times.at(0).raster_end);
+    EXPECT_LE(view_times.at(1).raster_start, view_times.at(1).raster_end);
+    EXPECT_LT(view_times.at(1).raster_start, view_times.at(0).raster_end);
+    EXPECT_GE(view_times.at(0).raster_start,
+              frame_timing.Get(FrameTiming::kRasterStart));
+    EXPECT_LE(view_times.at(1).raster_end,
+              frame_timing.Get(FrameTiming::kRasterFinish));
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 TEST(RasterizerTest,
      drawWithGpuEnabledAndSurfaceAllowsDrawingWhenGpuDisabledDoesAcquireFrame) {
   std::string test_name =
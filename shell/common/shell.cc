@@ -25,6 +25,7 @@
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -310,7 +311,14 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
-  auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  PointerDataDispatcherMaker dispatcher_maker;
+  if (settings.enable_pointer_data_coalescing) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<CoalescingPointerDataDispatcher>(delegate);
+    };
+  } else {
+    dispatcher_maker = platform_view->GetDispatcherMaker();
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -334,8 +342,9 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().enable_adaptive_pipeline_depth);
 
         engine_promise.set_value(on_create_engine(
             *shell,                               //
@@ -1577,6 +1586,14 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (settings_.enable_adaptive_pipeline_depth) {
+    task_runners_.GetUITaskRunner()->PostTask([timing, engine = weak_engine_] {
+      if (engine) {
+        engine->OnFrameRasterized(timing);
+      }
+    });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
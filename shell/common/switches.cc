@@ -473,6 +473,21 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
       command_line.HasOption(FlagForSwitch(Switch::EnableOpenGLGPUTracing));
   settings.enable_vulkan_gpu_tracing =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanGPUTracing));
+  settings.impeller_enable_parallel_geometry = command_line.HasOption(
+      FlagForSwitch(Switch::ImpellerEnableParallelGeometry));
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ImpellerTessellationCacheMaxBytes))) {
+    std::string impeller_tessellation_cache_max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ImpellerTessellationCacheMaxBytes),
+        &impeller_tessellation_cache_max_bytes);
+    settings.impeller_tessellation_cache_max_bytes =
+        std::stoull(impeller_tessellation_cache_max_bytes);
+  }
+  settings.enable_concurrent_view_rasterization = command_line.HasOption(
+      FlagForSwitch(Switch::EnableConcurrentViewRasterization));
+  settings.enable_adaptive_pipeline_depth = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptivePipelineDepth));
 
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
@@ -523,6 +538,35 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RasterCacheHostTierMaxBytes))) {
+    std::string raster_cache_host_tier_max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RasterCacheHostTierMaxBytes),
+        &raster_cache_host_tier_max_bytes);
+    settings.raster_cache_host_tier_max_bytes =
+        std::stoull(raster_cache_host_tier_max_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RasterCacheCostAwareMaxBytes))) {
+    std::string raster_cache_cost_aware_max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RasterCacheCostAwareMaxBytes),
+        &raster_cache_cost_aware_max_bytes);
+    settings.raster_cache_cost_aware_max_bytes =
+        std::stoull(raster_cache_cost_aware_max_bytes);
+  }
+
+  settings.enable_raster_cache_byte_budget = command_line.HasOption(
+      FlagForSwitch(Switch::EnableRasterCacheByteBudget));
+
+  settings.enable_retained_preroll_reuse = command_line.HasOption(
+      FlagForSwitch(Switch::EnableRetainedPrerollReuse));
+
+  settings.enable_pointer_data_coalescing = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePointerDataCoalescing));
+
   settings.enable_platform_isolates =
       command_line.HasOption(FlagForSwitch(Switch::EnablePlatformIsolates));
 
@@ -262,6 +262,33 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(RasterCacheHostTierMaxBytes,
+           "raster-cache-host-tier-max-bytes",
+           "The max bytes of host memory used to keep evicted raster cache "
+           "images for reuse, or 0 to disable. Only used by the Skia "
+           "backend.")
+DEF_SWITCH(RasterCacheCostAwareMaxBytes,
+           "raster-cache-cost-aware-max-bytes",
+           "Keep all raster cache images within this many bytes, giving up "
+           "the images that save the least measured raster time per byte "
+           "first. 0, the default, caches every layer and picture that is "
+           "drawn often enough without a limit. Only used by the Skia "
+           "backend.")
+DEF_SWITCH(EnableRasterCacheByteBudget,
+           "enable-raster-cache-byte-budget",
+           "Keep raster cache images within a share of the resource cache "
+           "limit. The least recently drawn images are demoted to lower "
+           "resolutions, then evicted, when the cache is over budget. Only "
+           "used by the Skia backend.")
+DEF_SWITCH(EnableRetainedPrerollReuse,
+           "enable-retained-preroll-reuse",
+           "Skip the preroll of retained layer subtrees whose transform, cull "
+           "rect and raster cache did not change since the previous frame.")
+DEF_SWITCH(EnablePointerDataCoalescing,
+           "enable-pointer-data-coalescing",
+           "Deliver pointer input to the framework at most once per frame, "
+           "coalescing the movement samples of high rate mice and styluses "
+           "received in between.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -283,6 +310,28 @@ DEF_SWITCH(EnableVulkanGPUTracing,
            "enable-vulkan-gpu-tracing",
            "Enable tracing of GPU execution time when using the Impeller "
            "Vulkan backend.")
+DEF_SWITCH(ImpellerEnableParallelGeometry,
+           "impeller-enable-parallel-geometry",
+           "Generate stroke geometry on the Impeller worker threads ahead of "
+           "encoding each frame. On backends without a worker pool, this flag "
+           "does nothing.")
+DEF_SWITCH(ImpellerTessellationCacheMaxBytes,
+           "impeller-tessellation-cache-max-bytes",
+           "The max bytes of path tessellations that Impeller reuses across "
+           "frames, or 0, the default, to tessellate every path each frame. "
+           "Cached paths are tessellated at a slightly rounded up transform "
+           "scale. Only used by the Vulkan backend.")
+DEF_SWITCH(EnableConcurrentViewRasterization,
+           "enable-concurrent-view-rasterization",
+           "When a frame renders more than one view, record the layer tree of "
+           "each view on a separate worker thread. Drawing and submitting the "
+           "views to their surfaces stays on the raster thread.")
+DEF_SWITCH(EnableAdaptivePipelineDepth,
+           "enable-adaptive-pipeline-depth",
+           "Only let the UI thread build a frame while the previous frame is "
+           "being rasterized when recent frames were dropped, trading one "
+           "frame of latency for throughput. Otherwise, frames are built one "
+           "at a time.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
@@ -12,6 +12,8 @@
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/entity/geometry/geometry_prepass.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
@@ -60,6 +62,17 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
+  const impeller::ContextVK& context_vk =
+      delegate_ == nullptr
+          ? *impeller::SurfaceContextVK::Cast(*context).GetParent()
+          : impeller::ContextVK::Cast(*context);
+  if (context_vk.GetShouldEnableParallelGeometry()) {
+    aiks_context->GetContentContext().GetGeometryPrepass().SetWorkerTaskRunner(
+        context_vk.GetConcurrentWorkerTaskRunner());
+  }
+  aiks_context->GetContentContext().GetTessellationCache().SetMaxBytes(
+      context_vk.GetTessellationCacheMaxBytes());
+
   impeller_context_ = std::move(context);
   aiks_context_ = std::move(aiks_context);
   is_valid_ = !!aiks_context_;
@@ -48,6 +48,9 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
   settings.enable_validation = p_settings.enable_validation;
   settings.enable_gpu_tracing = p_settings.enable_gpu_tracing;
   settings.disable_surface_control = p_settings.disable_surface_control;
+  settings.enable_parallel_geometry = p_settings.enable_parallel_geometry;
+  settings.tessellation_cache_max_bytes =
+      p_settings.tessellation_cache_max_bytes;
 
   auto context = impeller::ContextVK::Create(std::move(settings));
 
@@ -26,6 +26,8 @@ class AndroidContext {
     bool enable_validation = false;
     bool enable_gpu_tracing = false;
     bool disable_surface_control = false;
+    bool enable_parallel_geometry = false;
+    size_t tessellation_cache_max_bytes = 0;
     bool quiet = false;
   };
 
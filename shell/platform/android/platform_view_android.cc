@@ -45,6 +45,10 @@ AndroidContext::ContextSettings CreateContextSettings(
   settings.enable_gpu_tracing = p_settings.enable_vulkan_gpu_tracing;
   settings.enable_validation = p_settings.enable_vulkan_validation;
   settings.disable_surface_control = p_settings.disable_surface_control;
+  settings.enable_parallel_geometry =
+      p_settings.impeller_enable_parallel_geometry;
+  settings.tessellation_cache_max_bytes =
+      p_settings.impeller_tessellation_cache_max_bytes;
   return settings;
 }
 }  // namespace
@@ -20,8 +20,13 @@ class ByteBufferStreamReader : public ByteStreamReader {
  public:
   // Createa a reader reading from |bytes|, which must have a length of |size|.
   // |bytes| must remain valid for the lifetime of this object.
-  explicit ByteBufferStreamReader(const uint8_t* bytes, size_t size)
-      : bytes_(bytes), size_(size) {}
+  //
+  // If |allow_views| is true, ReadBytesView returns pointers into |bytes|
+  // instead of requiring a copy.
+  explicit ByteBufferStreamReader(const uint8_t* bytes,
+                                  size_t size,
+                                  bool allow_views = false)
+      : bytes_(bytes), size_(size), allow_views_(allow_views) {}
 
   virtual ~ByteBufferStreamReader() = default;
 
@@ -52,11 +57,27 @@ class ByteBufferStreamReader : public ByteStreamReader {
     }
   }
 
+  // |ByteStreamReader|
+  const uint8_t* ReadBytesView(size_t length) override {
+    if (!allow_views_) {
+      return nullptr;
+    }
+    if (location_ + length > size_) {
+      std::cerr << "Invalid read in StandardCodecByteStreamReader" << std::endl;
+      return nullptr;
+    }
+    const uint8_t* view = &bytes_[location_];
+    location_ += length;
+    return view;
+  }
+
  private:
   // The buffer to read from.
   const uint8_t* bytes_;
   // The total size of the buffer.
   size_t size_;
+  // Whether reads may return pointers into the buffer.
+  bool allow_views_;
   // The current read location.
   size_t location_ = 0;
 };
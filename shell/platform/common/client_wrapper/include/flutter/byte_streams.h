@@ -26,6 +26,15 @@ class ByteStreamReader {
   // the start of the stream, unless it is already aligned.
   virtual void ReadAlignment(uint8_t alignment) = 0;
 
+  // Returns a pointer to the next |length| bytes of the stream and advances
+  // past them, without copying. The returned data is only valid for as long
+  // as the data underlying the stream is.
+  //
+  // Readers that don't allow their data to be referenced after the read
+  // return nullptr without advancing, in which case callers should use
+  // ReadBytes instead.
+  virtual const uint8_t* ReadBytesView(size_t length) { return nullptr; }
+
   // Reads and returns the next 32-bit integer from the stream.
   int32_t ReadInt32() {
     int32_t value = 0;
@@ -7,6 +7,7 @@
 
 #include <any>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
@@ -88,6 +89,53 @@ class CustomEncodableValue {
   std::any value_;
 };
 
+// A non-owning view of a typed data list (e.g., a Uint8List or Float64List)
+// in an encoded message.
+//
+// Codecs created with |borrow_typed_data| set decode typed data lists as
+// CustomEncodableValues containing one of these rather than as the owning
+// std::vector<T> alternative of EncodableValue, which avoids copying large
+// payloads such as image or sensor data. For example:
+//   const auto* bytes = std::any_cast<EncodableTypedDataView<uint8_t>>(
+//       &std::get<CustomEncodableValue>(value));
+//
+// The view references the buffer the message was decoded from, so it is
+// only valid for as long as that buffer is; for messages received on a
+// channel, that is the duration of the handler call. Use ToVector() to keep
+// the data for longer.
+//
+// Lists whose data is not suitably aligned for |T| in memory are still
+// decoded as std::vector<T>, so code using borrowing codecs must handle both.
+//
+// Views can also be encoded by the standard codecs, in which case they are
+// written exactly like the corresponding std::vector<T>.
+template <typename T>
+class EncodableTypedDataView {
+ public:
+  EncodableTypedDataView(const T* data, size_t size)
+      : data_(data), size_(size) {}
+  ~EncodableTypedDataView() = default;
+
+  const T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+
+  const T& operator[](size_t index) const {
+    assert(index < size_);
+    return data_[index];
+  }
+
+  // Returns an owning copy of the data.
+  std::vector<T> ToVector() const { return std::vector<T>(begin(), end()); }
+
+ private:
+  const T* data_;
+  size_t size_;
+};
+
 class EncodableValue;
 
 // Convenience type aliases.
@@ -62,13 +62,23 @@ class StandardCodecSerializer {
   // position in |stream|, and returns it as the corresponding EncodableValue.
   // |T| must correspond to one of the supported list value types of
   // EncodableValue.
+  //
+  // If |stream| allows its data to be referenced, the list is returned as an
+  // EncodableTypedDataView<T> wrapped in a CustomEncodableValue instead.
   template <typename T>
   EncodableValue ReadVector(ByteStreamReader* stream) const;
 
   // Writes |vector| to |stream| as a fixed-type list. |T| must correspond to
   // one of the supported list value types of EncodableValue.
   template <typename T>
-  void WriteVector(const std::vector<T> vector, ByteStreamWriter* stream) const;
+  void WriteVector(const std::vector<T>& vector,
+                   ByteStreamWriter* stream) const;
+
+  // Writes the |count| values at |data| to |stream| as a fixed-type list.
+  template <typename T>
+  void WriteTypedData(const T* data,
+                      size_t count,
+                      ByteStreamWriter* stream) const;
 };
 
 }  // namespace flutter
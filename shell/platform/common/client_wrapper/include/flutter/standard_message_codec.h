@@ -23,11 +23,16 @@ class StandardMessageCodec : public MessageCodec<EncodableValue> {
   // If provided, |serializer| must be long-lived. If no serializer is provided,
   // the default will be used.
   //
-  // The instance returned for a given |serializer| will be shared, and
-  // any instance returned from this will be long-lived, and can be safely
-  // passed to, e.g., channel constructors.
+  // If |borrow_typed_data| is true, typed data lists are decoded as
+  // EncodableTypedDataViews referencing the message rather than being copied;
+  // see EncodableTypedDataView for the lifetime requirements that implies.
+  //
+  // The instance returned for a given |serializer| and |borrow_typed_data|
+  // will be shared, and any instance returned from this will be long-lived,
+  // and can be safely passed to, e.g., channel constructors.
   static const StandardMessageCodec& GetInstance(
-      const StandardCodecSerializer* serializer = nullptr);
+      const StandardCodecSerializer* serializer = nullptr,
+      bool borrow_typed_data = false);
 
   ~StandardMessageCodec();
 
@@ -47,9 +52,11 @@ class StandardMessageCodec : public MessageCodec<EncodableValue> {
 
  private:
   // Instances should be obtained via GetInstance.
-  explicit StandardMessageCodec(const StandardCodecSerializer* serializer);
+  StandardMessageCodec(const StandardCodecSerializer* serializer,
+                       bool borrow_typed_data);
 
   const StandardCodecSerializer* serializer_;
+  const bool borrow_typed_data_;
 };
 
 }  // namespace flutter
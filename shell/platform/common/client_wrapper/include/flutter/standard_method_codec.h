@@ -23,11 +23,16 @@ class StandardMethodCodec : public MethodCodec<EncodableValue> {
   // If provided, |serializer| must be long-lived. If no serializer is provided,
   // the default will be used.
   //
-  // The instance returned for a given |extension| will be shared, and
-  // any instance returned from this will be long-lived, and can be safely
-  // passed to, e.g., channel constructors.
+  // If |borrow_typed_data| is true, typed data lists are decoded as
+  // EncodableTypedDataViews referencing the message rather than being copied;
+  // see EncodableTypedDataView for the lifetime requirements that implies.
+  //
+  // The instance returned for a given |extension| and |borrow_typed_data|
+  // will be shared, and any instance returned from this will be long-lived,
+  // and can be safely passed to, e.g., channel constructors.
   static const StandardMethodCodec& GetInstance(
-      const StandardCodecSerializer* serializer = nullptr);
+      const StandardCodecSerializer* serializer = nullptr,
+      bool borrow_typed_data = false);
 
   ~StandardMethodCodec();
 
@@ -63,9 +68,11 @@ class StandardMethodCodec : public MethodCodec<EncodableValue> {
 
  private:
   // Instances should be obtained via GetInstance.
-  explicit StandardMethodCodec(const StandardCodecSerializer* serializer);
+  StandardMethodCodec(const StandardCodecSerializer* serializer,
+                      bool borrow_typed_data);
 
   const StandardCodecSerializer* serializer_;
+  const bool borrow_typed_data_;
 };
 
 }  // namespace flutter
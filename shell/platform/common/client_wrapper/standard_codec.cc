@@ -12,6 +12,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "byte_buffer_streams.h"
@@ -44,6 +45,18 @@ enum class EncodedType {
   kFloat32List,
 };
 
+// Returns the typed data view of element type |T| held by |value|, or null if
+// |value| doesn't hold one.
+template <typename T>
+const EncodableTypedDataView<T>* GetTypedDataView(const EncodableValue& value) {
+  const auto* custom_value = std::get_if<CustomEncodableValue>(&value);
+  if (!custom_value) {
+    return nullptr;
+  }
+  return std::any_cast<EncodableTypedDataView<T>>(
+      &static_cast<const std::any&>(*custom_value));
+}
+
 // Returns the encoded type that should be written when serializing |value|.
 EncodedType EncodedTypeForValue(const EncodableValue& value) {
   switch (value.index()) {
@@ -71,6 +84,19 @@ EncodedType EncodedTypeForValue(const EncodableValue& value) {
       return EncodedType::kList;
     case 11:
       return EncodedType::kMap;
+    case 12:
+      if (GetTypedDataView<uint8_t>(value)) {
+        return EncodedType::kUInt8List;
+      } else if (GetTypedDataView<int32_t>(value)) {
+        return EncodedType::kInt32List;
+      } else if (GetTypedDataView<int64_t>(value)) {
+        return EncodedType::kInt64List;
+      } else if (GetTypedDataView<float>(value)) {
+        return EncodedType::kFloat32List;
+      } else if (GetTypedDataView<double>(value)) {
+        return EncodedType::kFloat64List;
+      }
+      break;
     case 13:
       return EncodedType::kFloat32List;
   }
@@ -78,6 +104,107 @@ EncodedType EncodedTypeForValue(const EncodableValue& value) {
   return EncodedType::kNull;
 }
 
+// Returns the number of bytes used to encode |size| as a variable-length size.
+size_t EncodedSizeLength(size_t size) {
+  if (size < 254) {
+    return 1;
+  } else if (size <= 0xffff) {
+    return 3;
+  }
+  return 5;
+}
+
+// Returns |offset| rounded up to a multiple of |alignment|.
+size_t Align(size_t offset, size_t alignment) {
+  size_t mod = offset % alignment;
+  return mod ? offset + alignment - mod : offset;
+}
+
+// Returns the offset at which a fixed-type list of |count| values of type T
+// ends if written starting at |offset|, excluding the type byte.
+template <typename T>
+size_t TypedDataEnd(size_t count, size_t offset) {
+  offset += EncodedSizeLength(count);
+  if (count == 0) {
+    return offset;
+  }
+  if (sizeof(T) > 1) {
+    offset = Align(offset, sizeof(T));
+  }
+  return offset + count * sizeof(T);
+}
+
+// Returns the offset at which the encoding of |value| by the standard
+// serializer ends if it is written starting at |offset|.
+//
+// Custom values other than typed data views are counted as their type byte
+// only, since their encoding depends on the serializer extension.
+size_t EncodedEnd(const EncodableValue& value, size_t offset) {
+  // The type byte.
+  offset += 1;
+  switch (value.index()) {
+    case 0:
+    case 1:
+      return offset;
+    case 2:
+      return offset + 4;
+    case 3:
+      return offset + 8;
+    case 4:
+      return Align(offset, 8) + 8;
+    case 5: {
+      size_t size = std::get<std::string>(value).size();
+      return offset + EncodedSizeLength(size) + size;
+    }
+    case 6:
+      return TypedDataEnd<uint8_t>(
+          std::get<std::vector<uint8_t>>(value).size(), offset);
+    case 7:
+      return TypedDataEnd<int32_t>(
+          std::get<std::vector<int32_t>>(value).size(), offset);
+    case 8:
+      return TypedDataEnd<int64_t>(
+          std::get<std::vector<int64_t>>(value).size(), offset);
+    case 9:
+      return TypedDataEnd<double>(std::get<std::vector<double>>(value).size(),
+                                  offset);
+    case 10: {
+      const auto& list = std::get<EncodableList>(value);
+      offset += EncodedSizeLength(list.size());
+      for (const auto& item : list) {
+        offset = EncodedEnd(item, offset);
+      }
+      return offset;
+    }
+    case 11: {
+      const auto& map = std::get<EncodableMap>(value);
+      offset += EncodedSizeLength(map.size());
+      for (const auto& pair : map) {
+        offset = EncodedEnd(pair.first, offset);
+        offset = EncodedEnd(pair.second, offset);
+      }
+      return offset;
+    }
+    case 12:
+      if (const auto* bytes = GetTypedDataView<uint8_t>(value)) {
+        return TypedDataEnd<uint8_t>(bytes->size(), offset);
+      } else if (const auto* int32s = GetTypedDataView<int32_t>(value)) {
+        return TypedDataEnd<int32_t>(int32s->size(), offset);
+      } else if (const auto* int64s = GetTypedDataView<int64_t>(value)) {
+        return TypedDataEnd<int64_t>(int64s->size(), offset);
+      } else if (const auto* floats = GetTypedDataView<float>(value)) {
+        return TypedDataEnd<float>(floats->size(), offset);
+      } else if (const auto* doubles = GetTypedDataView<double>(value)) {
+        return TypedDataEnd<double>(doubles->size(), offset);
+      }
+      return offset;
+    case 13:
+      return TypedDataEnd<float>(std::get<std::vector<float>>(value).size(),
+                                 offset);
+  }
+  return offset;
+}
+
 }  // namespace
 
 StandardCodecSerializer::StandardCodecSerializer() = default;
@@ -154,9 +281,21 @@ void StandardCodecSerializer::WriteValue(const EncodableValue& value,
       break;
     }
     case 12:
-      std::cerr
-          << "Unhandled custom type in StandardCodecSerializer::WriteValue. "
-          << "Custom types require codec extensions." << std::endl;
+      if (const auto* bytes = GetTypedDataView<uint8_t>(value)) {
+        WriteTypedData(bytes->data(), bytes->size(), stream);
+      } else if (const auto* int32s = GetTypedDataView<int32_t>(value)) {
+        WriteTypedData(int32s->data(), int32s->size(), stream);
+      } else if (const auto* int64s = GetTypedDataView<int64_t>(value)) {
+        WriteTypedData(int64s->data(), int64s->size(), stream);
+      } else if (const auto* floats = GetTypedDataView<float>(value)) {
+        WriteTypedData(floats->data(), floats->size(), stream);
+      } else if (const auto* doubles = GetTypedDataView<double>(value)) {
+        WriteTypedData(doubles->data(), doubles->size(), stream);
+      } else {
+        std::cerr
+            << "Unhandled custom type in StandardCodecSerializer::WriteValue. "
+            << "Custom types require codec extensions." << std::endl;
+      }
       break;
     case 13: {
       WriteVector(std::get<std::vector<float>>(value), stream);
@@ -188,7 +327,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       std::string string_value;
       string_value.resize(size);
       stream->ReadBytes(reinterpret_cast<uint8_t*>(&string_value[0]), size);
-      return EncodableValue(string_value);
+      return EncodableValue(std::move(string_value));
     }
     case EncodedType::kUInt8List:
       return ReadVector<uint8_t>(stream);
@@ -205,7 +344,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       for (size_t i = 0; i < length; ++i) {
         list_value.push_back(ReadValue(stream));
       }
-      return EncodableValue(list_value);
+      return EncodableValue(std::move(list_value));
     }
     case EncodedType::kMap: {
       size_t length = ReadSize(stream);
@@ -215,7 +354,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
         EncodableValue value = ReadValue(stream);
         map_value.emplace(std::move(key), std::move(value));
       }
-      return EncodableValue(map_value);
+      return EncodableValue(std::move(map_value));
     }
     case EncodedType::kFloat32List: {
       return ReadVector<float>(stream);
@@ -260,21 +399,41 @@ template <typename T>
 EncodableValue StandardCodecSerializer::ReadVector(
     ByteStreamReader* stream) const {
   size_t count = ReadSize(stream);
-  std::vector<T> vector;
-  vector.resize(count);
   uint8_t type_size = static_cast<uint8_t>(sizeof(T));
   if (type_size > 1) {
     stream->ReadAlignment(type_size);
   }
+  std::vector<T> vector;
+  if (count > 0) {
+    const uint8_t* bytes = stream->ReadBytesView(count * type_size);
+    if (bytes) {
+      if (reinterpret_cast<uintptr_t>(bytes) % alignof(T) == 0) {
+        return CustomEncodableValue(EncodableTypedDataView<T>(
+            reinterpret_cast<const T*>(bytes), count));
+      }
+      // The message buffer itself is misaligned, so the data can't be
+      // referenced as T.
+      vector.resize(count);
+      std::memcpy(vector.data(), bytes, count * type_size);
+      return EncodableValue(std::move(vector));
+    }
+  }
+  vector.resize(count);
   stream->ReadBytes(reinterpret_cast<uint8_t*>(vector.data()),
                     count * type_size);
-  return EncodableValue(vector);
+  return EncodableValue(std::move(vector));
 }
 
 template <typename T>
-void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
+void StandardCodecSerializer::WriteVector(const std::vector<T>& vector,
                                           ByteStreamWriter* stream) const {
-  size_t count = vector.size();
+  WriteTypedData(vector.data(), vector.size(), stream);
+}
+
+template <typename T>
+void StandardCodecSerializer::WriteTypedData(const T* data,
+                                             size_t count,
+                                             ByteStreamWriter* stream) const {
   WriteSize(count, stream);
   if (count == 0) {
     return;
@@ -283,7 +442,7 @@ void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
   if (type_size > 1) {
     stream->WriteAlignment(type_size);
   }
-  stream->WriteBytes(reinterpret_cast<const uint8_t*>(vector.data()),
+  stream->WriteBytes(reinterpret_cast<const uint8_t*>(data),
                      count * type_size);
 }
 
@@ -291,27 +450,31 @@ void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
 
 // static
 const StandardMessageCodec& StandardMessageCodec::GetInstance(
-    const StandardCodecSerializer* serializer) {
+    const StandardCodecSerializer* serializer,
+    bool borrow_typed_data) {
   if (!serializer) {
     serializer = &StandardCodecSerializer::GetInstance();
   }
-  static auto* sInstances = new std::map<const StandardCodecSerializer*,
-                                         std::unique_ptr<StandardMessageCodec>>;
-  auto it = sInstances->find(serializer);
+  static auto* sInstances =
+      new std::map<std::pair<const StandardCodecSerializer*, bool>,
+                   std::unique_ptr<StandardMessageCodec>>;
+  auto key = std::make_pair(serializer, borrow_typed_data);
+  auto it = sInstances->find(key);
   if (it == sInstances->end()) {
     // Uses new due to private constructor (to prevent API clients from
     // accidentally passing temporary codec instances to channels).
     auto emplace_result = sInstances->emplace(
-        serializer, std::unique_ptr<StandardMessageCodec>(
-                        new StandardMessageCodec(serializer)));
+        key, std::unique_ptr<StandardMessageCodec>(
+                 new StandardMessageCodec(serializer, borrow_typed_data)));
     it = emplace_result.first;
   }
   return *(it->second);
 }
 
 StandardMessageCodec::StandardMessageCodec(
-    const StandardCodecSerializer* serializer)
-    : serializer_(serializer) {}
+    const StandardCodecSerializer* serializer,
+    bool borrow_typed_data)
+    : serializer_(serializer), borrow_typed_data_(borrow_typed_data) {}
 
 StandardMessageCodec::~StandardMessageCodec() = default;
 
@@ -321,7 +484,8 @@ std::unique_ptr<EncodableValue> StandardMessageCodec::DecodeMessageInternal(
   if (!binary_message) {
     return std::make_unique<EncodableValue>();
   }
-  ByteBufferStreamReader stream(binary_message, message_size);
+  ByteBufferStreamReader stream(binary_message, message_size,
+                                borrow_typed_data_);
   return std::make_unique<EncodableValue>(serializer_->ReadValue(&stream));
 }
 
@@ -329,6 +493,7 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMessageCodec::EncodeMessageInternal(
     const EncodableValue& message) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(EncodedEnd(message, 0));
   ByteBufferStreamWriter stream(encoded.get());
   serializer_->WriteValue(message, &stream);
   return encoded;
@@ -338,34 +503,38 @@ StandardMessageCodec::EncodeMessageInternal(
 
 // static
 const StandardMethodCodec& StandardMethodCodec::GetInstance(
-    const StandardCodecSerializer* serializer) {
+    const StandardCodecSerializer* serializer,
+    bool borrow_typed_data) {
   if (!serializer) {
     serializer = &StandardCodecSerializer::GetInstance();
   }
-  static auto* sInstances = new std::map<const StandardCodecSerializer*,
-                                         std::unique_ptr<StandardMethodCodec>>;
-  auto it = sInstances->find(serializer);
+  static auto* sInstances =
+      new std::map<std::pair<const StandardCodecSerializer*, bool>,
+                   std::unique_ptr<StandardMethodCodec>>;
+  auto key = std::make_pair(serializer, borrow_typed_data);
+  auto it = sInstances->find(key);
   if (it == sInstances->end()) {
     // Uses new due to private constructor (to prevent API clients from
     // accidentally passing temporary codec instances to channels).
     auto emplace_result = sInstances->emplace(
-        serializer, std::unique_ptr<StandardMethodCodec>(
-                        new StandardMethodCodec(serializer)));
+        key, std::unique_ptr<StandardMethodCodec>(
+                 new StandardMethodCodec(serializer, borrow_typed_data)));
     it = emplace_result.first;
   }
   return *(it->second);
 }
 
 StandardMethodCodec::StandardMethodCodec(
-    const StandardCodecSerializer* serializer)
-    : serializer_(serializer) {}
+    const StandardCodecSerializer* serializer,
+    bool borrow_typed_data)
+    : serializer_(serializer), borrow_typed_data_(borrow_typed_data) {}
 
 StandardMethodCodec::~StandardMethodCodec() = default;
 
 std::unique_ptr<MethodCall<EncodableValue>>
 StandardMethodCodec::DecodeMethodCallInternal(const uint8_t* message,
                                               size_t message_size) const {
-  ByteBufferStreamReader stream(message, message_size);
+  ByteBufferStreamReader stream(message, message_size, borrow_typed_data_);
   EncodableValue method_name_value = serializer_->ReadValue(&stream);
   const auto* method_name = std::get_if<std::string>(&method_name_value);
   if (!method_name) {
@@ -382,9 +551,14 @@ StandardMethodCodec::DecodeMethodCallInternal(const uint8_t* message,
 std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeMethodCallInternal(
     const MethodCall<EncodableValue>& method_call) const {
+  EncodableValue method_name(method_call.method_name());
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  size_t end = EncodedEnd(method_name, 0);
+  encoded->reserve(method_call.arguments()
+                       ? EncodedEnd(*method_call.arguments(), end)
+                       : end + 1);
   ByteBufferStreamWriter stream(encoded.get());
-  serializer_->WriteValue(EncodableValue(method_call.method_name()), &stream);
+  serializer_->WriteValue(method_name, &stream);
   if (method_call.arguments()) {
     serializer_->WriteValue(*method_call.arguments(), &stream);
   } else {
@@ -397,6 +571,8 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeSuccessEnvelopeInternal(
     const EncodableValue* result) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  // The success flag, followed by the result.
+  encoded->reserve(result ? EncodedEnd(*result, 1) : 2);
   ByteBufferStreamWriter stream(encoded.get());
   stream.WriteByte(0);
   if (result) {
@@ -433,7 +609,8 @@ bool StandardMethodCodec::DecodeAndProcessResponseEnvelopeInternal(
     const uint8_t* response,
     size_t response_size,
     MethodResult<EncodableValue>* result) const {
-  ByteBufferStreamReader stream(response, response_size);
+  ByteBufferStreamReader stream(response, response_size,
+                                borrow_typed_data_);
   uint8_t flag = stream.ReadByte();
   switch (flag) {
     case 0: {
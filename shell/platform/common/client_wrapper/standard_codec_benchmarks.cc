@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_method_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// A message shaped like a camera frame sent over a method channel: a few
+// scalar fields and a large pixel buffer.
+EncodableValue CreateFrameMessage(size_t byte_count) {
+  std::vector<uint8_t> pixels(byte_count);
+  for (size_t i = 0; i < byte_count; i++) {
+    pixels[i] = static_cast<uint8_t>(i);
+  }
+  return EncodableValue(EncodableMap{
+      {EncodableValue("width"), EncodableValue(1920)},
+      {EncodableValue("height"), EncodableValue(1080)},
+      {EncodableValue("timestamp"), EncodableValue(INT64_C(1234567890))},
+      {EncodableValue("pixels"), EncodableValue(std::move(pixels))},
+  });
+}
+
+// A message shaped like a batch of sensor samples.
+EncodableValue CreateSamplesMessage(size_t sample_count) {
+  std::vector<double> samples(sample_count);
+  for (size_t i = 0; i < sample_count; i++) {
+    samples[i] = static_cast<double>(i) * 0.5;
+  }
+  return EncodableValue(EncodableList{
+      EncodableValue("accelerometer"),
+      EncodableValue(std::move(samples)),
+  });
+}
+
+}  // namespace
+
+static void BM_StandardMessageCodecEncodeBytes(benchmark::State& state) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  EncodableValue message = CreateFrameMessage(state.range(0));
+
+  for (auto _ : state) {
+    auto encoded = codec.EncodeMessage(message);
+    benchmark::DoNotOptimize(encoded);
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StandardMessageCodecEncodeBytesView(benchmark::State& state) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  std::vector<uint8_t> pixels(state.range(0));
+  EncodableValue message(EncodableMap{
+      {EncodableValue("width"), EncodableValue(1920)},
+      {EncodableValue("height"), EncodableValue(1080)},
+      {EncodableValue("timestamp"), EncodableValue(INT64_C(1234567890))},
+      {EncodableValue("pixels"),
+       CustomEncodableValue(
+           EncodableTypedDataView<uint8_t>(pixels.data(), pixels.size()))},
+  });
+
+  for (auto _ : state) {
+    auto encoded = codec.EncodeMessage(message);
+    benchmark::DoNotOptimize(encoded);
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StandardMessageCodecDecode(benchmark::State& state,
+                                          bool borrow_typed_data,
+                                          bool samples) {
+  const StandardMessageCodec& codec =
+      StandardMessageCodec::GetInstance(nullptr, borrow_typed_data);
+  const size_t count = state.range(0);
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(
+      samples ? CreateSamplesMessage(count) : CreateFrameMessage(count));
+
+  for (auto _ : state) {
+    auto decoded = codec.DecodeMessage(*encoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+static void BM_StandardMethodCodecRoundTrip(benchmark::State& state,
+                                            bool borrow_typed_data) {
+  const StandardMethodCodec& codec =
+      StandardMethodCodec::GetInstance(nullptr, borrow_typed_data);
+  MethodCall<> call("onFrame", std::make_unique<EncodableValue>(
+                                   CreateFrameMessage(state.range(0))));
+
+  for (auto _ : state) {
+    auto encoded = codec.EncodeMethodCall(call);
+    auto decoded = codec.DecodeMethodCall(*encoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StandardMessageCodecEncodeBytes)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StandardMessageCodecEncodeBytesView)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMessageCodecDecode, BytesCopy, false, false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMessageCodecDecode, BytesBorrow, true, false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMessageCodecDecode, Float64Copy, false, true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 7, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMessageCodecDecode, Float64Borrow, true, true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 7, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMethodCodecRoundTrip, Copy, false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_StandardMethodCodecRoundTrip, Borrow, true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
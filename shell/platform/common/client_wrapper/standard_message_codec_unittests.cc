@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
 
+#include <algorithm>
+#include <any>
 #include <map>
 #include <vector>
 
@@ -262,4 +264,91 @@ TEST(StandardMessageCodec, CanEncodeAndDecodeVariableLengthCustomType) {
                     some_data_comparator);
 }
 
+TEST(StandardMessageCodec, GetInstanceCachesBorrowingInstanceSeparately) {
+  const StandardMessageCodec& codec_a =
+      StandardMessageCodec::GetInstance(nullptr, true);
+  const StandardMessageCodec& codec_b =
+      StandardMessageCodec::GetInstance(nullptr, true);
+  EXPECT_EQ(&codec_a, &codec_b);
+  EXPECT_NE(&codec_a, &StandardMessageCodec::GetInstance(nullptr));
+}
+
+TEST(StandardMessageCodec, CanDecodeTypedDataAsViews) {
+  const StandardMessageCodec& codec =
+      StandardMessageCodec::GetInstance(nullptr, true);
+  EncodableValue value(EncodableList{
+      EncodableValue(std::vector<uint8_t>{0xba, 0x5e, 0xba, 0x11}),
+      EncodableValue(std::vector<double>{3.14159265358979311599796346854,
+                                         1000.0}),
+  });
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+
+  auto decoded = codec.DecodeMessage(*encoded);
+  const auto& list = std::get<EncodableList>(*decoded);
+  ASSERT_EQ(list.size(), 2u);
+
+  const auto* bytes = std::any_cast<EncodableTypedDataView<uint8_t>>(
+      &static_cast<const std::any&>(std::get<CustomEncodableValue>(list[0])));
+  ASSERT_NE(bytes, nullptr);
+  EXPECT_EQ(bytes->ToVector(), std::get<std::vector<uint8_t>>(
+                                   std::get<EncodableList>(value)[0]));
+  // The view references the encoded message rather than a copy.
+  EXPECT_GE(bytes->data(), encoded->data());
+  EXPECT_LE(bytes->data() + bytes->size(), encoded->data() + encoded->size());
+
+  const auto* doubles = std::any_cast<EncodableTypedDataView<double>>(
+      &static_cast<const std::any&>(std::get<CustomEncodableValue>(list[1])));
+  if (reinterpret_cast<uintptr_t>(encoded->data()) % alignof(double) == 0) {
+    ASSERT_NE(doubles, nullptr);
+    EXPECT_EQ(doubles->ToVector(), std::get<std::vector<double>>(
+                                       std::get<EncodableList>(value)[1]));
+  }
+}
+
+TEST(StandardMessageCodec, DecodesMisalignedTypedDataAsVectors) {
+  const StandardMessageCodec& codec =
+      StandardMessageCodec::GetInstance(nullptr, true);
+  std::vector<int32_t> values = {0x12345678, -1, 0};
+  auto encoded =
+      StandardMessageCodec::GetInstance().EncodeMessage(EncodableValue(values));
+  ASSERT_TRUE(encoded);
+
+  // Shift the message so that the list data is no longer aligned in memory,
+  // while its offset within the message stays the same.
+  std::vector<uint8_t> buffer(encoded->size() + 1);
+  uint8_t* message = buffer.data();
+  if (reinterpret_cast<uintptr_t>(message + 4) % alignof(int32_t) == 0) {
+    message++;
+  }
+  std::copy(encoded->begin(), encoded->end(), message);
+
+  auto decoded = codec.DecodeMessage(message, encoded->size());
+  EXPECT_EQ(*decoded, EncodableValue(values));
+}
+
+TEST(StandardMessageCodec, CanEncodeTypedDataViews) {
+  std::vector<int64_t> values = {0x1234567890abcdef, -1};
+  std::vector<uint8_t> bytes = {0x0a, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                0xef, 0xcd, 0xab, 0x90, 0x78, 0x56, 0x34, 0x12,
+                                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(
+      CustomEncodableValue(
+          EncodableTypedDataView<int64_t>(values.data(), values.size())));
+  ASSERT_TRUE(encoded);
+  EXPECT_EQ(*encoded, bytes);
+}
+
+TEST(StandardMessageCodec, ReservesExactEncodedSize) {
+  EncodableValue value(EncodableMap{
+      {EncodableValue("a"), EncodableValue(std::vector<float>(300, 1.0f))},
+      {EncodableValue("b"), EncodableValue(EncodableList{
+                                EncodableValue(1), EncodableValue(2.0),
+                                EncodableValue(std::string(70000, 'x'))})},
+  });
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+  EXPECT_EQ(encoded->capacity(), encoded->size());
+}
+
 }  // namespace flutter